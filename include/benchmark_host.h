@@ -0,0 +1,17 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_BENCHMARK_HOST_H
+#define HC_BENCHMARK_HOST_H
+
+#define BENCHMARK_HOST_STAGES_MAX  32
+#define BENCHMARK_HOST_PASSES      3
+#define BENCHMARK_HOST_WORD_SIZE   16
+#define BENCHMARK_HOST_HASHES_DIV  10
+#define BENCHMARK_HOST_TOLERANCE   10
+
+int benchmark_host (hashcat_ctx_t *hashcat_ctx, const char *install_folder, const char *shared_folder);
+
+#endif // HC_BENCHMARK_HOST_H
@@ -47,17 +47,30 @@ static const int BRAIN_SERVER_ATTACKS_MAX         = 64 * 1024;
 static const int BRAIN_SERVER_CLIENTS_MAX         = 256;
 static const int BRAIN_SERVER_REALLOC_HASH_SIZE   = 1024 * 1024;
 static const int BRAIN_SERVER_REALLOC_ATTACK_SIZE = 1024;
+static const int BRAIN_SERVER_WAL_COMPACT_DIV     = 8;
+static const int BRAIN_SERVER_COMPACT_CHUNK_SIZE  = 1024 * 1024;
+static const int BRAIN_SERVER_FILTER_BUCKET_SIZE  = 4;
+static const int BRAIN_SERVER_FILTER_BUCKETS_MIN  = 1024 * 1024;
+static const int BRAIN_SERVER_FILTER_KICKS_MAX    = 500;
+static const int BRAIN_SERVER_FILTER_LOAD_PCT     = 95;
+static const int BRAIN_SERVER_FILTERS_MAX         = 32;
 static const int BRAIN_HASH_SIZE                  = 2 * sizeof (u32);
-static const int BRAIN_LINK_VERSION_CUR           = 1;
-static const int BRAIN_LINK_VERSION_MIN           = 1;
+static const int BRAIN_LINK_VERSION_CUR           = 3;
+static const int BRAIN_LINK_VERSION_MIN           = 3;
 static const int BRAIN_LINK_CHUNK_SIZE            = 4 * 1024;
 static const int BRAIN_LINK_CANDIDATES_MAX        = 128 * 1024 * 256; // units * threads * accel
+static const int BRAIN_ATTACK_WORDLIST_SAMPLE     = 64 * 1024;
+static const int BRAIN_ATTACK_WORDLIST_CHUNK      = 64 * 1024 * 1024;
+static const int BRAIN_ATTACK_WORDLIST_CHUNKS_MIN = 4;
+static const u64 BRAIN_ATTACK_WORDLIST_VERSION    = 0x6863627261696e00 | 0x01;
 
 typedef enum brain_operation
 {
   BRAIN_OPERATION_COMMIT         = 1,
   BRAIN_OPERATION_HASH_LOOKUP    = 2,
   BRAIN_OPERATION_ATTACK_RESERVE = 3,
+  BRAIN_OPERATION_BATCH          = 4,
+  BRAIN_OPERATION_COMMIT_BATCH   = 5,
 
 } brain_operation_t;
 
@@ -65,6 +78,7 @@ typedef enum brain_client_feature
 {
   BRAIN_CLIENT_FEATURE_HASHES    = 1,
   BRAIN_CLIENT_FEATURE_ATTACKS   = 2,
+  BRAIN_CLIENT_FEATURE_PIPELINE  = 4,
 
 } brain_client_feature_t;
 
@@ -82,6 +96,8 @@ typedef struct brain_server_attack_short
 
   int client_idx;
 
+  u32 batch;
+
 } brain_server_attack_short_t;
 
 typedef struct brain_server_hash_long
@@ -94,6 +110,8 @@ typedef struct brain_server_hash_short
 {
   u32 hash[2];
 
+  u32 batch;
+
 } brain_server_hash_short_t;
 
 typedef struct brain_server_hash_unique
@@ -104,6 +122,18 @@ typedef struct brain_server_hash_unique
 
 } brain_server_hash_unique_t;
 
+typedef struct brain_server_filter
+{
+  u8 *slots;
+
+  u64 buckets_cnt;
+  u64 items_cnt;
+
+  u64 victim_bucket;
+  u64 victim_fp;
+
+} brain_server_filter_t;
+
 typedef struct brain_server_db_attack
 {
   u32 brain_attack;
@@ -125,6 +155,10 @@ typedef struct brain_server_db_attack
 
   bool write_attacks;
 
+  HCFILE wal_fp;
+  bool   wal_open;
+  i64    wal_cnt;
+
 } brain_server_db_attack_t;
 
 typedef struct brain_server_db_hash
@@ -143,6 +177,17 @@ typedef struct brain_server_db_hash
 
   bool write_hashes;
 
+  HCFILE wal_fp;
+  bool   wal_open;
+  i64    wal_cnt;
+
+  // compact long-term memory, used instead of long_buf if filter_bits is set
+
+  brain_server_filter_t *filter_buf;
+
+  int filter_cnt;
+  u32 filter_bits;
+
 } brain_server_db_hash_t;
 
 typedef struct brain_server_db_short
@@ -167,6 +212,12 @@ typedef struct brain_server_dbs
 
   int *client_slots;
 
+  // sessions to store in a filter
+
+  u32 *filter_session_buf;
+  int  filter_session_cnt;
+  u32  filter_bits;
+
 } brain_server_dbs_t;
 
 typedef struct brain_server_dumper_options
@@ -195,7 +246,7 @@ int   brain_logging                     (FILE *stream, const int client_idx, con
 
 u32   brain_compute_session             (hashcat_ctx_t *hashcat_ctx);
 u32   brain_compute_attack              (hashcat_ctx_t *hashcat_ctx);
-u64   brain_compute_attack_wordlist     (const char *filename);
+u64   brain_compute_attack_wordlist     (hashcat_ctx_t *hashcat_ctx, const char *filename);
 
 u32   brain_auth_challenge              (void);
 u64   brain_auth_hash                   (const u32 challenge, const char *pw_buf, const int pw_len);
@@ -209,19 +260,29 @@ bool  brain_send_all                    (int sockfd, void *buf, size_t len, int
 bool  brain_client_reserve              (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u64 words_off, u64 work, u64 *overlap);
 bool  brain_client_commit               (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
 bool  brain_client_lookup               (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
+bool  brain_client_lookup_send          (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
+bool  brain_client_lookup_recv          (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
+bool  brain_client_batch                (hc_device_param_t *device_param, const status_ctx_t *status_ctx);
+bool  brain_client_commit_batch         (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u32 batch);
 bool  brain_client_connect              (hc_device_param_t *device_param, const status_ctx_t *status_ctx, const char *host, const int port, const char *password, u32 brain_session, u32 brain_attack, i64 passwords_max, u64 *highest);
 void  brain_client_disconnect           (hc_device_param_t *device_param);
 void  brain_client_generate_hash        (u64 *hash, const char *line_buf, const size_t line_len);
 
-int   brain_server                      (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer);
+int   brain_server                      (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer, const char *brain_server_filter, const u32 brain_server_filter_bits);
 bool  brain_server_read_hash_dumps      (brain_server_dbs_t *brain_server_dbs, const char *path);
-bool  brain_server_write_hash_dumps     (brain_server_dbs_t *brain_server_dbs, const char *path);
+bool  brain_server_write_hash_dumps     (brain_server_dbs_t *brain_server_dbs, const char *path, const bool force);
 bool  brain_server_read_hash_dump       (brain_server_db_hash_t *brain_server_db_hash, const char *file);
-bool  brain_server_write_hash_dump      (brain_server_db_hash_t *brain_server_db_hash, const char *file);
+bool  brain_server_write_hash_dump      (brain_server_db_hash_t *brain_server_db_hash, const char *path, const bool force);
+bool  brain_server_read_hash_wal        (brain_server_db_hash_t *brain_server_db_hash, const char *file, const bool live);
+bool  brain_server_write_hash_wal       (brain_server_db_hash_t *brain_server_db_hash, const char *path, const brain_server_hash_short_t *buf, const i64 cnt);
+bool  brain_server_read_hash_filter     (brain_server_db_hash_t *brain_server_db_hash, const char *file);
+bool  brain_server_write_hash_filter    (brain_server_db_hash_t *brain_server_db_hash, const char *path);
 bool  brain_server_read_attack_dumps    (brain_server_dbs_t *brain_server_dbs, const char *path);
-bool  brain_server_write_attack_dumps   (brain_server_dbs_t *brain_server_dbs, const char *path);
+bool  brain_server_write_attack_dumps   (brain_server_dbs_t *brain_server_dbs, const char *path, const bool force);
 bool  brain_server_read_attack_dump     (brain_server_db_attack_t *brain_server_db_attack, const char *file);
-bool  brain_server_write_attack_dump    (brain_server_db_attack_t *brain_server_db_attack, const char *file);
+bool  brain_server_write_attack_dump    (brain_server_db_attack_t *brain_server_db_attack, const char *path, const bool force);
+bool  brain_server_read_attack_wal      (brain_server_db_attack_t *brain_server_db_attack, const char *file, const bool live);
+bool  brain_server_write_attack_wal     (brain_server_db_attack_t *brain_server_db_attack, const char *path, const brain_server_attack_long_t *entry);
 int   brain_server_get_client_idx       (brain_server_dbs_t *brain_server_dbs);
 
 u64   brain_server_highest_attack       (const brain_server_db_attack_t *buf);
@@ -231,6 +292,11 @@ u64   brain_server_find_attack_long     (const brain_server_attack_long_t  *buf,
 u64   brain_server_find_attack_short    (const brain_server_attack_short_t *buf, const i64 cnt, const u64 offset, const u64 length);
 i64   brain_server_find_hash_long       (const u32 *search, const brain_server_hash_long_t  *buf, const i64 cnt);
 i64   brain_server_find_hash_short      (const u32 *search, const brain_server_hash_short_t *buf, const i64 cnt);
+bool  brain_server_filter_find          (const brain_server_db_hash_t *brain_server_db_hash, const u32 *hash);
+bool  brain_server_filter_insert        (brain_server_db_hash_t *brain_server_db_hash, const u32 *hash);
+void  brain_server_filter_select        (brain_server_dbs_t *brain_server_dbs, brain_server_db_hash_t *brain_server_db_hash);
+u64   brain_server_filter_size          (const brain_server_db_hash_t *brain_server_db_hash);
+double brain_server_filter_fpr          (const brain_server_db_hash_t *brain_server_db_hash);
 int   brain_server_sort_db_hash         (const void *v1, const void *v2);
 int   brain_server_sort_db_attack       (const void *v1, const void *v2);
 int   brain_server_sort_attack_long     (const void *v1, const void *v2);
@@ -0,0 +1,20 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_BRIDGE_POOL_H
+#define HC_BRIDGE_POOL_H
+
+bridge_pool_t *bridge_pool_init    (const int threads_cnt);
+void           bridge_pool_term    (bridge_pool_t *bridge_pool);
+int            bridge_pool_threads (const bridge_pool_t *bridge_pool);
+bool           bridge_pool_run     (bridge_pool_t *bridge_pool, const u64 work_cnt, const u64 work_chunk, BRIDGE_POOL_WORK work, void *work_ctx);
+
+#if defined (_WIN32) || defined (__WIN32__)
+HC_API_CALL DWORD bridge_pool_thread (void *p);
+#else
+HC_API_CALL void *bridge_pool_thread (void *p);
+#endif
+
+#endif // HC_BRIDGE_POOL_H
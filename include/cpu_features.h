@@ -17,8 +17,23 @@
 int cpu_supports_sse2 ();
 int cpu_supports_ssse3 ();
 int cpu_supports_xop ();
+int cpu_supports_avx ();
 int cpu_supports_avx2 ();
 int cpu_supports_avx512f ();
+int cpu_supports_avx512vl ();
 int cpu_chipset_test ();
 
+// runtime ISA dispatch: on x86 the hot code of a CPU bridge is compiled once per ISA level
+// with -D BRIDGE_ISA=<level> (see BRIDGE_ISA_DISPATCH in src/Makefile), and the bridge picks
+// one variant in platform_init (). CPU_ISA_FN (name) gives each variant its own symbol name.
+
+#define CPU_ISA_CONCAT2(a,b) a ## _ ## b
+#define CPU_ISA_CONCAT(a,b)  CPU_ISA_CONCAT2 (a, b)
+
+#if defined (BRIDGE_ISA)
+#define CPU_ISA_FN(name)     CPU_ISA_CONCAT (name, BRIDGE_ISA)
+#else
+#define CPU_ISA_FN(name)     name
+#endif
+
 #endif // HC_CPU_FEATURES_H
@@ -0,0 +1,23 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_CRACK_SINK_H
+#define HC_CRACK_SINK_H
+
+#define CRACK_SINK_QUEUE_INCR 65536
+#define CRACK_SINK_SLEEP_US   50000
+
+int  crack_sink_init    (hashcat_ctx_t *hashcat_ctx);
+void crack_sink_destroy (hashcat_ctx_t *hashcat_ctx);
+int  crack_sink_push    (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, const char *pot_buf, const int pot_len, const u8 *plain_ptr, const u32 plain_len);
+void crack_sink_flush   (hashcat_ctx_t *hashcat_ctx);
+
+#if defined (_WIN32) || defined (__WIN32__)
+HC_API_CALL DWORD thread_crack_sink (void *p);
+#else
+HC_API_CALL void *thread_crack_sink (void *p);
+#endif
+
+#endif // HC_CRACK_SINK_H
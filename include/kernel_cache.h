@@ -0,0 +1,27 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_KERNEL_CACHE_H
+#define HC_KERNEL_CACHE_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define KERNEL_CACHE_PACK_VERSION   (0x6863706b63616b00 | 0x02)
+#define KERNEL_CACHE_PACK_MAX       1000000
+#define KERNEL_CACHE_INCLUDES_MAX   256
+
+int  sort_by_kernel_cache_entry (const void *s1, const void *s2);
+
+int  kernel_cache_init          (hashcat_ctx_t *hashcat_ctx);
+void kernel_cache_destroy       (hashcat_ctx_t *hashcat_ctx);
+bool kernel_cache_key           (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const char *kernel_name, const char *source_file, const char *build_options_buf, u32 *key);
+void kernel_cache_filename      (const folder_config_t *folder_config, const u32 *key, const bool is_metal, char *cached_file, const size_t cached_file_sz);
+bool kernel_cache_pack_extract  (hashcat_ctx_t *hashcat_ctx, const u32 *key, const char *cached_file);
+void kernel_cache_remember      (hashcat_ctx_t *hashcat_ctx, const u32 *key, const char *cached_file);
+int  kernel_cache_pack_write    (hashcat_ctx_t *hashcat_ctx);
+
+#endif // HC_KERNEL_CACHE_H
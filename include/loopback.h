@@ -13,11 +13,17 @@
 
 static const char LOOPBACK_FILE[] = "hashcat.loopback";
 
+#define LOOPBACK_LIVE_MAX   4096
+#define LOOPBACK_LIVE_SEEN  (1 << 17)
+
 int  loopback_init          (hashcat_ctx_t *hashcat_ctx);
 void loopback_destroy       (hashcat_ctx_t *hashcat_ctx);
 int  loopback_write_open    (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_close   (hashcat_ctx_t *hashcat_ctx);
 void loopback_write_append  (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len);
 void loopback_write_unlink  (hashcat_ctx_t *hashcat_ctx);
+bool loopback_live_push     (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len);
+bool loopback_live_pop      (hashcat_ctx_t *hashcat_ctx, u8 *plain_ptr, u32 *plain_len);
+u32  loopback_live_count    (hashcat_ctx_t *hashcat_ctx);
 
 #endif // HC_LOOPBACK_H
@@ -24,4 +24,7 @@ void  hc_free_aligned         (void **ptr);
 void *hcmalloc_bridge_aligned (const size_t sz, const int align);
 void  hcfree_bridge_aligned   (void *ptr);
 
+void  hc_alloc_count_start    (void);
+u64   hc_alloc_count_stop     (void);
+
 #endif // HC_MEMORY_H
@@ -0,0 +1,23 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_MODULE_REGISTRY_H
+#define HC_MODULE_REGISTRY_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define MODULE_REGISTRY_FILENAME  "hashcat.modules"
+#define MODULE_REGISTRY_VERSION   (0x68636d6f64726700 | 0x02)
+#define MODULE_REGISTRY_SIG_LEN   32
+#define MODULE_REGISTRY_LEN_PROBE 256
+
+int  sort_by_module_registry_entry (const void *s1, const void *s2);
+
+int  module_registry_load          (hashcat_ctx_t *hashcat_ctx, module_registry_entry_t **entries);
+bool module_registry_prefilter     (const module_registry_entry_t *entry, char **probe_buf, const int probe_cnt, const bool is_file);
+
+#endif // HC_MODULE_REGISTRY_H
@@ -22,10 +22,30 @@
 
 #define INCR_MASKS    1000
 
+// walks a range of sp_exec() candidates without decoding each index again
+
+typedef struct sp_iter
+{
+  char *pw_buf;
+
+  cs_t *root_css_buf;
+  cs_t *markov_css_buf;
+
+  u32   start;
+  u32   stop;
+
+  u32   digits[SP_PW_MAX];
+  u32   lens[SP_PW_MAX];
+
+} sp_iter_t;
+
 u32   mp_get_length (const char *mask, const u32 opts_type);
 
 void  sp_exec (u64 ctx, char *pw_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u32 start, u32 stop);
 
+void  sp_iter_init (sp_iter_t *sp_iter, u64 ctx, char *pw_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u32 start, u32 stop);
+void  sp_iter_next (sp_iter_t *sp_iter);
+
 int   mask_ctx_update_loop    (hashcat_ctx_t *hashcat_ctx);
 int   mask_ctx_init           (hashcat_ctx_t *hashcat_ctx);
 void  mask_ctx_destroy        (hashcat_ctx_t *hashcat_ctx);
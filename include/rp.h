@@ -43,6 +43,13 @@ typedef struct
 
 } rp_gen_ops_t;
 
+typedef struct
+{
+  u64 hash;
+  u32 idx;
+
+} rule_dedup_t;
+
 bool class_num       (const u8 c);
 bool class_lower     (const u8 c);
 bool class_upper     (const u8 c);
@@ -61,6 +68,8 @@ bool is_hex_notation (const char *rule_buf, u32 rule_len, u32 rule_pos);
 int cpu_rule_to_kernel_rule (char *rule_buf, u32 rule_len, kernel_rule_t *rule);
 int kernel_rule_to_cpu_rule (char *rule_buf, kernel_rule_t *rule);
 
+int  sort_by_rule_dedup (const void *s1, const void *s2);
+
 bool kernel_rules_has_noop (const kernel_rule_t *kernel_rules_buf, const u32 kernel_rules_cnt);
 
 int kernel_rules_load     (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt);
@@ -0,0 +1,25 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef HC_RULESTATS_H
+#define HC_RULESTATS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+
+int  sort_by_rulestats_rule  (const void *s1, const void *s2);
+int  sort_by_rulestats_hits  (const void *s1, const void *s2);
+
+int  rulestats_init          (hashcat_ctx_t *hashcat_ctx);
+void rulestats_destroy       (hashcat_ctx_t *hashcat_ctx);
+int  rulestats_rules_init    (hashcat_ctx_t *hashcat_ctx);
+void rulestats_rules_destroy (hashcat_ctx_t *hashcat_ctx);
+void rulestats_add           (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain);
+void rulestats_tested_add    (hashcat_ctx_t *hashcat_ctx);
+int  rulestats_write         (hashcat_ctx_t *hashcat_ctx);
+
+#endif // HC_RULESTATS_H
@@ -50,6 +50,12 @@ typedef struct extra_info_mask
   u8  out_buf[256];
   u32 out_len;
 
+  // consecutive positions are generated by counting up instead of decoding each one
+
+  sp_iter_t sp_iter;
+  u64       sp_iter_pos;
+  bool      sp_iter_valid;
+
 } extra_info_mask_t;
 
 void slow_candidates_seek (hashcat_ctx_t *hashcat_ctx, void *extra_info, const u64 cur, const u64 end);
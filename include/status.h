@@ -120,6 +120,12 @@ int         status_get_vector_width_dev               (const hashcat_ctx_t *hash
 int         status_progress_init                      (hashcat_ctx_t *hashcat_ctx);
 void        status_progress_destroy                   (hashcat_ctx_t *hashcat_ctx);
 void        status_progress_reset                     (hashcat_ctx_t *hashcat_ctx);
+void        status_progress_add_done                  (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u64 cnt);
+void        status_progress_add_rejected              (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u64 cnt);
+void        status_progress_add_rejected_all          (hashcat_ctx_t *hashcat_ctx, const u64 cnt);
+void        status_progress_set_rejected_all          (hashcat_ctx_t *hashcat_ctx, const u64 cnt);
+void        status_progress_set_restored              (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u64 cnt);
+void        status_progress_salt_shown                (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos);
 
 int         status_ctx_init                           (hashcat_ctx_t *hashcat_ctx);
 void        status_ctx_destroy                        (hashcat_ctx_t *hashcat_ctx);
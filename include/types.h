@@ -517,6 +517,7 @@ typedef enum bridge_type
   BRIDGE_TYPE_NONE                   = 0,            // no bridge support
   BRIDGE_TYPE_MATCH_TUNINGS          = (1ULL <<  1), // Disables autotune and adjusts -n, -u and -T for the backend device according to match bridge dimensions
   BRIDGE_TYPE_UPDATE_SELFTEST        = (1ULL <<  2), // updates the selftest configured in the module. Can be useful for generic hash modes such as the python one
+  BRIDGE_TYPE_THREAD_POOL            = (1ULL <<  3), // bridge advertises a single unit and spreads each launch over its own host threads, see bridge_pool_run()
 
   BRIDGE_TYPE_LAUNCH_INIT            = (1ULL << 10), // attention! not yet implemented
   BRIDGE_TYPE_LAUNCH_LOOP            = (1ULL << 11),
@@ -714,6 +715,8 @@ typedef enum user_options_defaults
   BENCHMARK_MAX            = 99999,
   BENCHMARK_MIN            = 0,
   BENCHMARK                = false,
+  BENCHMARK_HOST           = false,
+  BENCHMARK_HOST_SIZE      = 1000000,
   BITMAP_MAX               = 18,
   BITMAP_MIN               = 16,
   #ifdef WITH_BRAIN
@@ -721,9 +724,11 @@ typedef enum user_options_defaults
   BRAIN_CLIENT_FEATURES    = 2,
   BRAIN_PORT               = 6863,
   BRAIN_SERVER             = false,
+  BRAIN_SERVER_FILTER_BITS = 16,
   BRAIN_SESSION            = 0,
   #endif
   COLOR_CRACKED            = false,
+  CRACK_SINK_ASYNC         = false,
   DEBUG_MODE               = 0,
   DEPRECATED_CHECK         = true,
   DYNAMIC_X                = false,
@@ -749,6 +754,7 @@ typedef enum user_options_defaults
   INCREMENT_MIN            = 1,
   KEEP_GUESSING            = false,
   KERNEL_ACCEL             = 0,
+  KERNEL_CACHE_PREWARM     = false,
   KERNEL_LOOPS             = 0,
   KERNEL_THREADS           = 0,
   KEYSPACE                 = false,
@@ -757,7 +763,9 @@ typedef enum user_options_defaults
   LIMIT                    = 0,
   LOGFILE                  = true,
   LOOPBACK                 = false,
+  LOOPBACK_LIVE            = false,
   MACHINE_READABLE         = false,
+  MASK_BATCH               = false,
   MARKOV_CLASSIC           = false,
   MARKOV                   = true,
   MARKOV_INVERSE           = false,
@@ -790,6 +798,7 @@ typedef enum user_options_defaults
   RP_GEN_FUNC_MAX          = 4,
   RP_GEN_FUNC_MIN          = 1,
   RP_GEN_SEED              = 0,
+  RULES_DEDUP              = false,
   RUNTIME                  = 0,
   SCRYPT_TMTO              = 0,
   SEGMENT_SIZE             = 33554432,
@@ -832,6 +841,9 @@ typedef enum user_options_map
   IDX_BENCHMARK_MAX             = 0xff56,
   IDX_BENCHMARK_MIN             = 0xff57,
   IDX_BENCHMARK                 = 'b',
+  IDX_BENCHMARK_HOST            = 0xff8d,
+  IDX_BENCHMARK_HOST_BASELINE   = 0xff8e,
+  IDX_BENCHMARK_HOST_SIZE       = 0xff8f,
   IDX_BITMAP_MAX                = 0xff07,
   IDX_BITMAP_MIN                = 0xff08,
   #ifdef WITH_BRAIN
@@ -842,12 +854,15 @@ typedef enum user_options_map
   IDX_BRAIN_PORT                = 0xff0c,
   IDX_BRAIN_SERVER              = 0xff0d,
   IDX_BRAIN_SERVER_TIMER        = 0xff0e,
+  IDX_BRAIN_SERVER_FILTER       = 0xff90,
+  IDX_BRAIN_SERVER_FILTER_BITS  = 0xff91,
   IDX_BRAIN_SESSION             = 0xff0f,
   IDX_BRAIN_SESSION_WHITELIST   = 0xff10,
   #endif
   IDX_BYPASS_THRESHOLD          = 0xff84,
   IDX_BYPASS_DELAY              = 0xff85,
   IDX_COLOR_CRACKED             = 0xff59,
+  IDX_CRACK_SINK_ASYNC          = 0xff8a,
   IDX_BRIDGE_PARAMETER1         = 0xff80,
   IDX_BRIDGE_PARAMETER2         = 0xff81,
   IDX_BRIDGE_PARAMETER3         = 0xff82,
@@ -887,6 +902,8 @@ typedef enum user_options_map
   IDX_INDUCTION_DIR             = 0xff23,
   IDX_KEEP_GUESSING             = 0xff24,
   IDX_KERNEL_ACCEL              = 'n',
+  IDX_KERNEL_CACHE_PACK         = 0xff86,
+  IDX_KERNEL_CACHE_PREWARM      = 0xff87,
   IDX_KERNEL_LOOPS              = 'u',
   IDX_KERNEL_THREADS            = 'T',
   IDX_KEYBOARD_LAYOUT_MAPPING   = 0xff25,
@@ -895,7 +912,9 @@ typedef enum user_options_map
   IDX_LIMIT                     = 'l',
   IDX_LOGFILE_DISABLE           = 0xff28,
   IDX_LOOPBACK                  = 0xff29,
+  IDX_LOOPBACK_LIVE             = 0xff89,
   IDX_MACHINE_READABLE          = 0xff2a,
+  IDX_MASK_BATCH                = 0xff88,
   IDX_MARKOV_CLASSIC            = 0xff2b,
   IDX_MARKOV_DISABLE            = 0xff2c,
   IDX_MARKOV_HCSTAT2            = 0xff2d,
@@ -929,6 +948,8 @@ typedef enum user_options_map
   IDX_RP_GEN_SEED               = 0xff42,
   IDX_RULE_BUF_L                = 'j',
   IDX_RULE_BUF_R                = 'k',
+  IDX_RULES_DEDUP               = 0xff8b,
+  IDX_RULE_STATS_FILE           = 0xff8c,
   IDX_RUNTIME                   = 0xff43,
   IDX_SCRYPT_TMTO               = 0xff44,
   IDX_SEGMENT_SIZE              = 'c',
@@ -1305,6 +1326,15 @@ typedef struct hc_device_param
 
   int     at_rc;                // autotune rc
 
+  // autotune result of the previous mask, reused by --mask-batch while the kernel-loops range stays the same
+
+  bool    at_cache_valid;
+  u32     at_cache_kernel_loops_min;
+  u32     at_cache_kernel_loops_max;
+  u32     at_cache_kernel_accel;
+  u32     at_cache_kernel_loops;
+  u32     at_cache_kernel_threads;
+
   int     vector_width;
 
   u32     kernel_wgs1;
@@ -1472,6 +1502,7 @@ typedef struct hc_device_param
   u64           brain_link_send_bytes;
   u8           *brain_link_in_buf;
   u32          *brain_link_out_buf;
+  u32           brain_link_batch;
   #endif
 
   char     *scratch_buf;
@@ -1479,11 +1510,16 @@ typedef struct hc_device_param
   HCFILE    combs_fp;
   pw_t     *combs_buf;
 
+  u32      *salts_active_buf;   // salts with uncracked digests first, the cracked ones after salts_active_cnt
+  u32       salts_active_cnt;
+  u32       salts_active_done;  // hashes->salts_done at the time salts_active_buf was built
+
   void     *hooks_buf;
 
   pw_idx_t *pws_idx;
   u32      *pws_comp;
   u64       pws_cnt;
+  u64       pws_loopback_cnt;   // --loopback-live plains added on top of the pws_cnt words from the wordlist
 
   pw_pre_t *pws_pre_buf;  // for slow candidates
   u64       pws_pre_cnt;
@@ -2089,6 +2125,19 @@ typedef struct backend_ctx
 
   cl_device_type      opencl_device_types_filter;
 
+  // serializes kernel builds of identical devices during parallel session setup
+
+  hc_thread_mutex_t   mux_kernel_build[KERNEL_BUILD_LOCKS];
+
+  // the module tuning db blocks are added to the shared tuning db while other devices search it
+
+  hc_thread_mutex_t   mux_tuning_db;
+
+  // each device starts its self-test right after its own setup, the first one switches the session to STATUS_SELFTEST
+
+  hc_thread_mutex_t   mux_selftest_start;
+  bool                selftest_started;
+
 } backend_ctx_t;
 
 typedef enum kernel_workload
@@ -2191,6 +2240,46 @@ typedef struct debugfile_ctx
 
 } debugfile_ctx_t;
 
+typedef struct rulestats_entry
+{
+  char   *rule_buf;
+  u64     hits;
+  u64     tested;
+
+} rulestats_entry_t;
+
+typedef struct rulestats_ctx
+{
+  bool    enabled;
+
+  char   *filename;
+
+  u64    *hits_buf;   // indexed like straight_ctx->kernel_rules_buf
+  u32     hits_cnt;
+
+  u64     tested;     // number of words each rule was applied to, summed over all inner loops
+
+} rulestats_ctx_t;
+
+typedef struct benchmark_host_stage
+{
+  const char *stage;
+
+  u64    items;
+  u64    bytes;
+  u64    allocs;
+  double msec;
+
+} benchmark_host_stage_t;
+
+typedef struct benchmark_host_baseline
+{
+  char   stage[64];
+
+  double items_per_sec;
+
+} benchmark_host_baseline_t;
+
 typedef struct dictstat
 {
   u64 cnt;
@@ -2228,6 +2317,123 @@ typedef struct dictstat_ctx
 
 } dictstat_ctx_t;
 
+typedef struct module_registry_entry
+{
+  u32  hash_mode;
+  u32  hash_category;
+  u32  salt_type;
+  u32  attack_exec;
+  u64  opts_type;
+
+  char separator;
+
+  // leading signature of the self-test hash up to and including its separator, like $6$ or {SSHA}
+  // only set if the module rejects a hash without it
+
+  bool sig_required;
+  char sig[32];
+
+  // for modules with a plain hex self-test hash: the bare hash lengths the module accepts
+
+  bool hex_only;
+  u32  hash_len_min;
+  u32  hash_len_max;
+
+  char hash_name[256];
+
+} module_registry_entry_t;
+
+typedef struct kernel_cache_entry
+{
+  u32 key[4];
+
+  u64 offset;
+  u64 length;
+
+} kernel_cache_entry_t;
+
+typedef struct kernel_cache_local
+{
+  u32   key[4];
+
+  char *cached_file;
+
+} kernel_cache_local_t;
+
+typedef struct kernel_cache_source
+{
+  char *source_file;
+
+  u32   digest[4];  // md5 of the kernel source and all of its includes
+
+} kernel_cache_source_t;
+
+typedef struct kernel_cache_ctx
+{
+  bool enabled;
+
+  char *pack_file;
+
+  // index of the pack, sorted by key
+
+  kernel_cache_entry_t *entries;
+  u32                   entries_cnt;
+
+  // kernels used in this session, merged into the pack by --kernel-cache-prewarm
+
+  kernel_cache_local_t *local;
+  u32                   local_cnt;
+  u32                   local_alloc;
+
+  // source digests, the kernel sources are hashed once per session
+
+  kernel_cache_source_t *sources;
+  u32                    sources_cnt;
+  u32                    sources_alloc;
+
+  hc_thread_mutex_t     mux_local;  // guards local and sources
+
+} kernel_cache_ctx_t;
+
+typedef struct crack_sink_entry
+{
+  char *buf;      // outfile line followed by the potfile line
+  u32   out_len;
+  u32   pot_len;
+
+} crack_sink_entry_t;
+
+typedef struct crack_sink_ctx
+{
+  bool enabled;
+
+  crack_sink_entry_t *queue;
+  u32                 queue_cnt;
+  u32                 queue_alloc;
+
+  crack_sink_entry_t *batch;  // swapped with queue by the writer
+  u32                 batch_alloc;
+
+  hc_thread_mutex_t mux_queue;
+  hc_thread_mutex_t mux_write;
+
+} crack_sink_ctx_t;
+
+typedef struct loopback_live
+{
+  u32 len;
+  u8  buf[PW_MAX];
+
+} loopback_live_t;
+
+typedef struct loopback_seen
+{
+  u64  hash;
+  u32  len;
+  u8  *buf;
+
+} loopback_seen_t;
+
 typedef struct loopback_ctx
 {
   HCFILE  fp;
@@ -2237,6 +2443,22 @@ typedef struct loopback_ctx
 
   char   *filename;
 
+  // --loopback-live: new plains waiting to be added to the running attack
+
+  bool    live;
+
+  loopback_live_t *live_buf;
+  u32              live_head;
+  u32              live_cnt;
+
+  // plains queued during this loopback pass, to not feed the same plain twice
+  // open addressing hash set, it takes no new plains once half full and is cleared with the next pass
+
+  loopback_seen_t *live_seen;
+  u32              live_seen_cnt;
+
+  hc_thread_mutex_t mux_live;
+
 } loopback_ctx_t;
 
 typedef struct mf
@@ -2477,11 +2699,13 @@ typedef struct user_options
   bool         advice;
   bool         benchmark;
   bool         benchmark_all;
+  bool         benchmark_host;
   #ifdef WITH_BRAIN
   bool         brain_client;
   bool         brain_server;
   #endif
   bool         color_cracked;
+  bool         crack_sink_async;
   bool         force;
   bool         deprecated_check;
   bool         dynamic_x;
@@ -2491,12 +2715,15 @@ typedef struct user_options
   bool         hex_wordlist;
   increment_t  increment;
   bool         keep_guessing;
+  bool         kernel_cache_prewarm;
   bool         keyspace;
   bool         total_candidates;
   bool         left;
   bool         logfile;
   bool         loopback;
+  bool         loopback_live;
   bool         machine_readable;
+  bool         mask_batch;
   bool         markov_classic;
   bool         markov;
   bool         markov_inverse;
@@ -2514,6 +2741,7 @@ typedef struct user_options
   bool         remove;
   bool         restore;
   bool         restore_enable;
+  bool         rules_dedup;
   bool         self_test;
   bool         show;
   bool         slow_candidates;
@@ -2527,10 +2755,12 @@ typedef struct user_options
   bool         veracrypt_pim_stop_chgd;
   bool         version;
   bool         wordlist_autohex;
+  char        *benchmark_host_baseline;
   #ifdef WITH_BRAIN
   char        *brain_host;
   char        *brain_password;
   char        *brain_session_whitelist;
+  char        *brain_server_filter;
   #endif
   char        *bridge_parameter1;
   char        *bridge_parameter2;
@@ -2540,6 +2770,7 @@ typedef struct user_options
   char        *debug_file;
   char        *induction_dir;
   char        *keyboard_layout_mapping;
+  char        *kernel_cache_pack;
   char        *markov_hcstat2;
   char        *backend_devices;
   char        *opencl_device_types;
@@ -2549,6 +2780,7 @@ typedef struct user_options
   char        *restore_file_path;
   char       **rp_files;
   char        *rp_gen_func_sel;
+  char        *rule_stats_file;
   char        *separator;
   char        *truecrypt_keyfiles;
   char        *veracrypt_keyfiles;
@@ -2572,10 +2804,12 @@ typedef struct user_options
   u32          backend_info;
   u32          benchmark_max;
   u32          benchmark_min;
+  u32          benchmark_host_size;
   u32          bitmap_max;
   u32          bitmap_min;
   #ifdef WITH_BRAIN
   u32          brain_server_timer;
+  u32          brain_server_filter_bits;
   u32          brain_client_features;
   u32          brain_port;
   u32          brain_session;
@@ -3000,6 +3234,12 @@ typedef struct status_ctx
   u64 *words_progress_rejected; // progress number of words rejected per salt
   u64 *words_progress_restored; // progress number of words restored per salt
 
+  u64  words_progress_done_total;     // running sums of the per salt arrays, guarded by mux_counter
+  u64  words_progress_rejected_total;
+  u64  words_progress_restored_total;
+  u64  words_progress_shown_total;    // done + rejected + restored of the salts in salts_shown
+  u32  words_progress_shown_cnt;
+
   int bypass_digests_done_new;  // --bypass-threshold cracked counter
 
   /**
@@ -3129,6 +3369,35 @@ typedef struct bridge_ctx
 
 } bridge_ctx_t;
 
+typedef bool (*BRIDGE_POOL_WORK) (void *, const int, const u64, const u64);
+
+typedef struct bridge_pool
+{
+  int               threads_cnt;
+
+  hc_thread_mutex_t mux_cursor;
+
+  // current run
+
+  BRIDGE_POOL_WORK  work;
+  void             *work_ctx;
+
+  u64               work_cnt;
+  u64               work_chunk;
+  u64               work_cursor;
+
+  bool              work_failed;
+
+} bridge_pool_t;
+
+typedef struct bridge_pool_thread_param
+{
+  int            tid;
+
+  bridge_pool_t *bridge_pool;
+
+} bridge_pool_thread_param_t;
+
 #define MODULE_DEFAULT (void *) -1
 
 typedef void (*MODULE_INIT) (void *);
@@ -3240,6 +3509,7 @@ typedef struct hashcat_ctx
   bridge_ctx_t          *bridge_ctx;
   combinator_ctx_t      *combinator_ctx;
   cpt_ctx_t             *cpt_ctx;
+  crack_sink_ctx_t      *crack_sink_ctx;
   debugfile_ctx_t       *debugfile_ctx;
   dictstat_ctx_t        *dictstat_ctx;
   event_ctx_t           *event_ctx;
@@ -3250,6 +3520,7 @@ typedef struct hashcat_ctx
   hashes_t              *hashes;
   hwmon_ctx_t           *hwmon_ctx;
   induct_ctx_t          *induct_ctx;
+  kernel_cache_ctx_t    *kernel_cache_ctx;
   logfile_ctx_t         *logfile_ctx;
   loopback_ctx_t        *loopback_ctx;
   mask_ctx_t            *mask_ctx;
@@ -3260,6 +3531,7 @@ typedef struct hashcat_ctx
   pidfile_ctx_t         *pidfile_ctx;
   potfile_ctx_t         *potfile_ctx;
   restore_ctx_t         *restore_ctx;
+  rulestats_ctx_t       *rulestats_ctx;
   status_ctx_t          *status_ctx;
   straight_ctx_t        *straight_ctx;
   tuning_db_t           *tuning_db;
@@ -3279,6 +3551,26 @@ typedef struct thread_param
 
 } thread_param_t;
 
+typedef struct backend_session_param
+{
+  hashcat_ctx_t *hashcat_ctx;
+
+  int  backend_devices_idx;
+
+  int  rc;
+
+  int  memory_hit_warnings;
+  int  runtime_skip_warnings;
+  int  kernel_build_warnings;
+  int  kernel_create_warnings;
+  int  extra_size_warning;
+
+  u64  size_total_host;
+
+  u32  hardware_power;
+
+} backend_session_param_t;
+
 typedef struct hook_thread_param
 {
   int tid;
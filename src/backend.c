@@ -26,6 +26,10 @@
 #include "terminal.h"
 #include "hwmon.h"
 #include "autotune.h"
+#include "selftest.h"
+#include "cpu_crc32.h"
+#include "kernel_cache.h"
+#include "status.h"
 
 #if defined (__linux__)
 static const char *const  dri_card0_path = "/dev/dri/card0";
@@ -1535,100 +1539,63 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
               if (run_kernel (hashcat_ctx, device_param, KERN_RUN_2E, pws_pos, pws_cnt, true, slow_iteration, is_autotune) == -1) return -1;
             }
 
-            //bug?
-            //while (status_ctx->run_thread_level2 == false) break;
-            if (status_ctx->run_thread_level2 == false) break;
-
-            /**
-             * speed
-             */
-
-            const u32 iter1r = hashes->salts_buf[salt_pos].salt_iter  * (salt_repeats + 1);
-            const u32 iter2r = hashes->salts_buf[salt_pos].salt_iter2 * (salt_repeats + 1);
-
-            const double iter_part = (double) ((iter * salt_repeat) + loop_pos + loop_left) / (double) (iter1r + iter2r);
-
-            const u64 perf_sum_all = (u64) (pws_cnt * iter_part);
-
-            double speed_msec = hc_timer_get (device_param->timer_speed);
-
-            const u32 speed_pos = device_param->speed_pos;
-
-            device_param->speed_cnt[speed_pos] = perf_sum_all;
-
-            device_param->speed_msec[speed_pos] = speed_msec;
-
-            if (user_options->speed_only == true)
+            if (hashconfig->bridge_type & BRIDGE_TYPE_LAUNCH_LOOP)
             {
-              if (speed_msec > 4000)
+              if (device_param->is_cuda == true)
               {
-                device_param->outerloop_multi *= 1 / iter_part;
-
-                device_param->speed_pos = 1;
-
-                device_param->speed_only_finish = true;
+                if (hc_cuMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->cuda_d_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
 
-                return 0;
+                if (hc_cuStreamSynchronize (hashcat_ctx, device_param->cuda_stream) == -1) return -1;
               }
-            }
-          }
-
-          if (hashconfig->bridge_type & BRIDGE_TYPE_LAUNCH_LOOP)
-          {
-            if (device_param->is_cuda == true)
-            {
-              if (hc_cuMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->cuda_d_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
-
-              if (hc_cuStreamSynchronize (hashcat_ctx, device_param->cuda_stream) == -1) return -1;
-            }
 
-            if (device_param->is_hip == true)
-            {
-              if (hc_hipMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->hip_d_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+              if (device_param->is_hip == true)
+              {
+                if (hc_hipMemcpyDtoH (hashcat_ctx, device_param->h_tmps, device_param->hip_d_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
 
-              if (hc_hipStreamSynchronize (hashcat_ctx, device_param->hip_stream) == -1) return -1;
-            }
+                if (hc_hipStreamSynchronize (hashcat_ctx, device_param->hip_stream) == -1) return -1;
+              }
 
-            #if defined (__APPLE__)
-            if (device_param->is_metal == true)
-            {
-              if (hc_mtlMemcpyDtoH (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->h_tmps, device_param->metal_d_tmps, 0, pws_cnt * hashconfig->tmp_size) == -1) return -1;
-            }
-            #endif
+              #if defined (__APPLE__)
+              if (device_param->is_metal == true)
+              {
+                if (hc_mtlMemcpyDtoH (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->h_tmps, device_param->metal_d_tmps, 0, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+              }
+              #endif
 
-            if (device_param->is_opencl == true)
-            {
-              /* blocking */
-              if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
-            }
+              if (device_param->is_opencl == true)
+              {
+                /* blocking */
+                if (hc_clEnqueueReadBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
+              }
 
-            if (bridge_ctx->launch_loop (bridge_ctx->platform_context, device_param, hashconfig, hashes, salt_pos, pws_cnt) == false) return -1;
+              if (bridge_ctx->launch_loop (bridge_ctx->platform_context, device_param, hashconfig, hashes, salt_pos, pws_cnt) == false) return -1;
 
-            if (device_param->is_cuda == true)
-            {
-              if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_tmps, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+              if (device_param->is_cuda == true)
+              {
+                if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_tmps, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
 
-              if (hc_cuStreamSynchronize (hashcat_ctx, device_param->cuda_stream) == -1) return -1;
-            }
+                if (hc_cuStreamSynchronize (hashcat_ctx, device_param->cuda_stream) == -1) return -1;
+              }
 
-            if (device_param->is_hip == true)
-            {
-              if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_tmps, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+              if (device_param->is_hip == true)
+              {
+                if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_tmps, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
 
-              if (hc_hipStreamSynchronize (hashcat_ctx, device_param->hip_stream) == -1) return -1;
-            }
+                if (hc_hipStreamSynchronize (hashcat_ctx, device_param->hip_stream) == -1) return -1;
+              }
 
-            #if defined (__APPLE__)
-            if (device_param->is_metal == true)
-            {
-              if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_tmps, 0, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
-            }
-            #endif
+              #if defined (__APPLE__)
+              if (device_param->is_metal == true)
+              {
+                if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_tmps, 0, device_param->h_tmps, pws_cnt * hashconfig->tmp_size) == -1) return -1;
+              }
+              #endif
 
-            if (device_param->is_opencl == true)
-            {
-              /* blocking */
-              if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
+              if (device_param->is_opencl == true)
+              {
+                /* blocking */
+                if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_tmps, CL_TRUE, 0, pws_cnt * hashconfig->tmp_size, device_param->h_tmps, 0, NULL, NULL) == -1) return -1;
+              }
             }
 
             //bug?
@@ -1639,7 +1606,12 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
              * speed
              */
 
-            const u64 perf_sum_all = (u64) (pws_cnt);
+            const u32 iter1r = hashes->salts_buf[salt_pos].salt_iter  * (salt_repeats + 1);
+            const u32 iter2r = hashes->salts_buf[salt_pos].salt_iter2 * (salt_repeats + 1);
+
+            const double iter_part = (double) ((iter * salt_repeat) + loop_pos + loop_left) / (double) (iter1r + iter2r);
+
+            const u64 perf_sum_all = (u64) (pws_cnt * iter_part);
 
             double speed_msec = hc_timer_get (device_param->timer_speed);
 
@@ -1653,6 +1625,8 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
             {
               if (speed_msec > 4000)
               {
+                device_param->outerloop_multi *= 1 / iter_part;
+
                 device_param->speed_pos = 1;
 
                 device_param->speed_only_finish = true;
@@ -4086,6 +4060,35 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
   return 0;
 }
 
+static void salts_active_update (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  const hashes_t *hashes = hashcat_ctx->hashes;
+
+  // salts_done only grows and is increased after salts_shown is set, so reading it first never misses a salt
+
+  const u32 salts_done = hashes->salts_done;
+
+  if (device_param->salts_active_done == salts_done) return;
+
+  u32 salts_active_cnt   = 0;
+  u32 salts_inactive_pos = hashes->salts_cnt;
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    if (hashes->salts_shown[salt_pos] == 1)
+    {
+      device_param->salts_active_buf[--salts_inactive_pos] = salt_pos;
+    }
+    else
+    {
+      device_param->salts_active_buf[salts_active_cnt++] = salt_pos;
+    }
+  }
+
+  device_param->salts_active_cnt  = salts_active_cnt;
+  device_param->salts_active_done = salts_done;
+}
+
 int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 pws_pos, const u64 pws_cnt)
 {
   combinator_ctx_t      *combinator_ctx     = hashcat_ctx->combinator_ctx;
@@ -4151,21 +4154,74 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
   device_param->outerloop_pos   = 0;
   device_param->outerloop_left  = pws_cnt;
 
+  // iteration type
+
+  u64 innerloop_step = 0;
+  u64 innerloop_cnt  = 0;
+
+  if (user_options->slow_candidates == true)
+  {
+    innerloop_step = 1;
+    innerloop_cnt  = 1;
+  }
+  else
+  {
+    // sanity check: do NOT cast to an u32 integer type without checking that it is safe (upper bits must NOT be set)
+
+    if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+    {
+      //if ((combinator_ctx->combs_cnt >> 32) != 0) return -1;
+    }
+    else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+    {
+      //if ((mask_ctx->bfs_cnt >> 32) != 0) return -1;
+    }
+
+    if   (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL) innerloop_step = device_param->kernel_loops;
+    else                                                        innerloop_step = 1;
+
+    if      (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)  innerloop_cnt = straight_ctx->kernel_rules_cnt;
+    else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)     innerloop_cnt = combinator_ctx->combs_cnt;
+    else if (user_options_extra->attack_kern == ATTACK_KERN_BF)        innerloop_cnt = mask_ctx->bfs_cnt;
+  }
+
   // loop start: most outer loop = salt iteration, then innerloops (if multi)
+  // only salts with uncracked digests are iterated, fully cracked ones just get their progress
 
   u32 salts_cnt = hashes->salts_cnt;
 
+  u32 *salts_active_buf = NULL;
+
   if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
   {
     // We will replace in-kernel salt_pos with GID via macro
 
     salts_cnt = 1;
   }
+  else
+  {
+    salts_active_update (hashcat_ctx, device_param);
+
+    salts_active_buf = device_param->salts_active_buf;
+
+    hc_thread_mutex_lock (status_ctx->mux_counter);
+
+    for (u32 salts_inactive_idx = device_param->salts_active_cnt; salts_inactive_idx < hashes->salts_cnt; salts_inactive_idx++)
+    {
+      status_progress_add_done (hashcat_ctx, salts_active_buf[salts_inactive_idx], (pws_cnt - device_param->pws_loopback_cnt) * innerloop_cnt);
+    }
+
+    hc_thread_mutex_unlock (status_ctx->mux_counter);
+
+    salts_cnt = device_param->salts_active_cnt;
+  }
 
-  for (u32 salt_pos = 0; salt_pos < salts_cnt; salt_pos++)
+  for (u32 salts_idx = 0; salts_idx < salts_cnt; salts_idx++)
   {
     while (status_ctx->devices_status == STATUS_PAUSED) sleep (1);
 
+    const u32 salt_pos = (salts_active_buf == NULL) ? salts_idx : salts_active_buf[salts_idx];
+
     salt_t *salt_buf = &hashes->salts_buf[salt_pos];
 
     device_param->kernel_param.salt_pos_host       = salt_pos;
@@ -4185,37 +4241,6 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
       }
     }
 
-    // iteration type
-
-    u64 innerloop_step = 0;
-    u64 innerloop_cnt  = 0;
-
-    if (user_options->slow_candidates == true)
-    {
-      innerloop_step = 1;
-      innerloop_cnt  = 1;
-    }
-    else
-    {
-      // sanity check: do NOT cast to an u32 integer type without checking that it is safe (upper bits must NOT be set)
-
-      if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-      {
-        //if ((combinator_ctx->combs_cnt >> 32) != 0) return -1;
-      }
-      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-      {
-        //if ((mask_ctx->bfs_cnt >> 32) != 0) return -1;
-      }
-
-      if   (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL) innerloop_step = device_param->kernel_loops;
-      else                                                        innerloop_step = 1;
-
-      if      (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)  innerloop_cnt = straight_ctx->kernel_rules_cnt;
-      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)     innerloop_cnt = combinator_ctx->combs_cnt;
-      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)        innerloop_cnt = mask_ctx->bfs_cnt;
-    }
-
     // innerloops
 
     for (u64 innerloop_pos = 0; innerloop_pos < innerloop_cnt; innerloop_pos += innerloop_step)
@@ -4252,7 +4277,11 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
       {
         if (hashes->salts_shown[salt_pos] == 1)
         {
-          status_ctx->words_progress_done[salt_pos] += pws_cnt * innerloop_left;
+          hc_thread_mutex_lock (status_ctx->mux_counter);
+
+          status_progress_add_done (hashcat_ctx, salt_pos, (pws_cnt - device_param->pws_loopback_cnt) * innerloop_left);
+
+          hc_thread_mutex_unlock (status_ctx->mux_counter);
 
           continue;
         }
@@ -4323,18 +4352,22 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
                   if (rule_len_out < 0)
                   {
+                    hc_thread_mutex_lock (status_ctx->mux_counter);
+
                     if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
                     {
                       for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
                       {
-                        status_ctx->words_progress_rejected[association_salt_pos] += 1;
+                        status_progress_add_rejected (hashcat_ctx, association_salt_pos, 1);
                       }
                     }
                     else
                     {
-                      status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
+                      status_progress_add_rejected (hashcat_ctx, salt_pos, pws_cnt);
                     }
 
+                    hc_thread_mutex_unlock (status_ctx->mux_counter);
+
                     continue;
                   }
 
@@ -4514,18 +4547,22 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
                   if (rule_len_out < 0)
                   {
+                    hc_thread_mutex_lock (status_ctx->mux_counter);
+
                     if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
                     {
                       for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
                       {
-                        status_ctx->words_progress_rejected[association_salt_pos] += 1;
+                        status_progress_add_rejected (hashcat_ctx, association_salt_pos, 1);
                       }
                     }
                     else
                     {
-                      status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
+                      status_progress_add_rejected (hashcat_ctx, salt_pos, pws_cnt);
                     }
 
+                    hc_thread_mutex_unlock (status_ctx->mux_counter);
+
                     continue;
                   }
 
@@ -4727,12 +4764,14 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
           {
             for (u32 association_salt_pos = 0; association_salt_pos < pws_cnt; association_salt_pos++)
             {
-              status_ctx->words_progress_done[pws_pos + association_salt_pos] += innerloop_left;
+              status_progress_add_done (hashcat_ctx, pws_pos + association_salt_pos, innerloop_left);
             }
           }
           else
           {
-            status_ctx->words_progress_done[salt_pos] += perf_sum_all;
+            // --loopback-live plains are not part of the keyspace
+
+            status_progress_add_done (hashcat_ctx, salt_pos, (pws_cnt - device_param->pws_loopback_cnt) * innerloop_left);
           }
 
           hc_thread_mutex_unlock (status_ctx->mux_counter);
@@ -9442,9 +9481,9 @@ static int get_opencl_kernel_dynamic_local_mem_size (hashcat_ctx_t *hashcat_ctx,
 }
 
 #if defined (__APPLE__)
-static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library)
+static bool load_kernel_from_cache_or_source (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library)
 #else
-static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library)
+static bool load_kernel_from_cache_or_source (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library)
 #endif
 {
   const backend_ctx_t   *backend_ctx   = hashcat_ctx->backend_ctx;
@@ -10138,6 +10177,59 @@ static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_p
   return true;
 }
 
+// the binary is cached under a content-addressed name (see kernel_cache.c), if a --kernel-cache-pack is given a missing entry is taken from it
+// devices sharing the same key end up with the same cached file, serializing on it means only the first setup thread compiles, the others pick up its cache entry
+
+#if defined (__APPLE__)
+static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, mtl_library *metal_library)
+#else
+static bool load_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *kernel_name, char *source_file, char *cached_file, const char *build_options_buf, const bool cache_disable, cl_program *opencl_program, CUmodule *cuda_module, hipModule_t *hip_module, MAYBE_UNUSED void *metal_library)
+#endif
+{
+  backend_ctx_t   *backend_ctx   = hashcat_ctx->backend_ctx;
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  if (cache_disable == true)
+  {
+    return load_kernel_from_cache_or_source (hashcat_ctx, device_param, kernel_name, source_file, cached_file, build_options_buf, cache_disable, opencl_program, cuda_module, hip_module, metal_library);
+  }
+
+  // if the kernel sources can't be hashed, stay with the legacy cache file name
+
+  u32 key[4] = { 0 };
+
+  char key_file[256] = { 0 };
+
+  const bool have_key = kernel_cache_key (hashcat_ctx, device_param, kernel_name, source_file, build_options_buf, key);
+
+  if (have_key == true)
+  {
+    kernel_cache_filename (folder_config, key, device_param->is_metal, key_file, sizeof (key_file));
+
+    cached_file = key_file;
+  }
+
+  const u32 lock_idx = cpu_crc32_buffer ((const u8 *) cached_file, strlen (cached_file)) % KERNEL_BUILD_LOCKS;
+
+  hc_thread_mutex_lock (backend_ctx->mux_kernel_build[lock_idx]);
+
+  if ((have_key == true) && (hc_path_read (cached_file) == false))
+  {
+    kernel_cache_pack_extract (hashcat_ctx, key, cached_file);
+  }
+
+  const bool rc = load_kernel_from_cache_or_source (hashcat_ctx, device_param, kernel_name, source_file, cached_file, build_options_buf, cache_disable, opencl_program, cuda_module, hip_module, metal_library);
+
+  hc_thread_mutex_unlock (backend_ctx->mux_kernel_build[lock_idx]);
+
+  if ((rc == true) && (have_key == true))
+  {
+    kernel_cache_remember (hashcat_ctx, key, cached_file);
+  }
+
+  return rc;
+}
+
 static int backend_session_setup_cuda_kernel_shared (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   // GPU memset
@@ -13399,8 +13491,27 @@ void backend_session_context_reset (hashcat_ctx_t *hashcat_ctx)
   }
 }
 
-int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
+// the tuning db can grow while other devices search it, so hand out a copy of the entry instead of a pointer into entry_buf
+
+static tuning_db_entry_t *backend_tuning_db_search (hashcat_ctx_t *hashcat_ctx, const char *device_name, const cl_device_type device_type, int attack_mode, const int hash_mode, tuning_db_entry_t *entry_copy)
+{
+  backend_ctx_t *backend_ctx = hashcat_ctx->backend_ctx;
+
+  hc_thread_mutex_lock (backend_ctx->mux_tuning_db);
+
+  const tuning_db_entry_t *entry = tuning_db_search (hashcat_ctx, device_name, device_type, attack_mode, hash_mode);
+
+  if (entry != NULL) memcpy (entry_copy, entry, sizeof (tuning_db_entry_t));
+
+  hc_thread_mutex_unlock (backend_ctx->mux_tuning_db);
+
+  return (entry != NULL) ? entry_copy : NULL;
+}
+
+static int backend_session_begin_device (backend_session_param_t *session_param)
 {
+  hashcat_ctx_t *hashcat_ctx = session_param->hashcat_ctx;
+
   const bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
   const bridge_ctx_t         *bridge_ctx          = hashcat_ctx->bridge_ctx;
   const folder_config_t      *folder_config       = hashcat_ctx->folder_config;
@@ -13409,1010 +13520,1207 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
   const module_ctx_t         *module_ctx          = hashcat_ctx->module_ctx;
         backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
   const straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+        status_ctx_t         *status_ctx          = hashcat_ctx->status_ctx;
   const user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
   const user_options_t       *user_options        = hashcat_ctx->user_options;
 
-  if (backend_ctx->enabled == false) return 0;
+  const int backend_devices_idx = session_param->backend_devices_idx;
 
-  u64 size_total_host_all = 0;
+  /**
+   * host buffer
+   */
 
-  u32 hardware_power_all = 0;
+  hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
 
-  int backend_memory_hit_warnings    = 0;
-  int backend_runtime_skip_warnings  = 0;
-  int backend_kernel_build_warnings  = 0;
-  int backend_kernel_create_warnings = 0;
-  int backend_kernel_accel_warnings  = 0;
-  int backend_extra_size_warning     = 0;
+  if (device_param->skipped == true) return 0;
 
-  backend_ctx->memory_hit_warning    = false;
-  backend_ctx->runtime_skip_warning  = false;
-  backend_ctx->kernel_build_warning  = false;
-  backend_ctx->kernel_create_warning = false;
-  backend_ctx->kernel_accel_warnings = false;
-  backend_ctx->extra_size_warning    = false;
-  backend_ctx->mixed_warnings        = false;
+  EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_PRE, &backend_devices_idx, sizeof (int));
 
-  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
-  {
-    /**
-     * host buffer
-     */
+  const int device_id = device_param->device_id;
 
-    hc_device_param_t *device_param = &backend_ctx->devices_param[backend_devices_idx];
+  /**
+   * Query used memory from the device using low-level API and update device_available_mem
+   * If there's no low-level API available we will silently ignore
+   */
 
-    if (device_param->skipped == true) continue;
+  // the other setup threads may query the hardware monitor at the same time
 
-    EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_PRE, &backend_devices_idx, sizeof (int));
+  hc_thread_mutex_lock (status_ctx->mux_hwmon);
 
-    const int device_id = device_param->device_id;
+  const u64 used_bytes = hm_get_memoryused_with_devices_idx (hashcat_ctx, device_id);
 
-    /**
-     * Query used memory from the device using low-level API and update device_available_mem
-     * If there's no low-level API available we will silently ignore
-     */
+  hc_thread_mutex_unlock (status_ctx->mux_hwmon);
 
-    const u64 used_bytes = hm_get_memoryused_with_devices_idx (hashcat_ctx, device_id);
+  if (used_bytes)
+  {
+    device_param->device_available_mem = MIN (device_param->device_available_mem, device_param->device_global_mem - used_bytes);
+  }
 
-    if (used_bytes)
-    {
-      device_param->device_available_mem = MIN (device_param->device_available_mem, device_param->device_global_mem - used_bytes);
-    }
+  /**
+   * module depending checks
+   */
 
-    /**
-     * module depending checks
-     */
+  device_param->skipped_warning = false;
 
-    device_param->skipped_warning = false;
+  if (module_ctx->module_unstable_warning != MODULE_DEFAULT)
+  {
+    const bool unstable_warning = module_ctx->module_unstable_warning (hashconfig, user_options, user_options_extra, device_param);
 
-    if (module_ctx->module_unstable_warning != MODULE_DEFAULT)
+    if ((unstable_warning == true) && (user_options->force == false))
     {
-      const bool unstable_warning = module_ctx->module_unstable_warning (hashconfig, user_options, user_options_extra, device_param);
+      char runtime_name[7];
 
-      if ((unstable_warning == true) && (user_options->force == false))
-      {
-        char runtime_name[7];
-
-        memset (runtime_name, 0, sizeof (runtime_name));
+      memset (runtime_name, 0, sizeof (runtime_name));
 
-        if (device_param->is_cuda   == true) memcpy (runtime_name, "CUDA", 4);
-        if (device_param->is_hip    == true) memcpy (runtime_name, "HIP", 3);
-        #if defined (__APPLE__)
-        if (device_param->is_metal  == true) memcpy (runtime_name, "Metal", 5);
-        #endif
-        if (device_param->is_opencl == true) memcpy (runtime_name, "OpenCL", 6);
+      if (device_param->is_cuda   == true) memcpy (runtime_name, "CUDA", 4);
+      if (device_param->is_hip    == true) memcpy (runtime_name, "HIP", 3);
+      #if defined (__APPLE__)
+      if (device_param->is_metal  == true) memcpy (runtime_name, "Metal", 5);
+      #endif
+      if (device_param->is_opencl == true) memcpy (runtime_name, "OpenCL", 6);
 
-        event_log_warning (hashcat_ctx, "* Device #%u: Skipping (hash-mode %u)", device_id + 1, hashconfig->hash_mode);
-        event_log_warning (hashcat_ctx, "             This is due to a known %s runtime and/or device driver issue (not a hashcat issue)", runtime_name);
-        event_log_warning (hashcat_ctx, "             You can use --force to override, but do not report related errors.");
-        event_log_warning (hashcat_ctx, NULL);
+      event_log_warning (hashcat_ctx, "* Device #%u: Skipping (hash-mode %u)", device_id + 1, hashconfig->hash_mode);
+      event_log_warning (hashcat_ctx, "             This is due to a known %s runtime and/or device driver issue (not a hashcat issue)", runtime_name);
+      event_log_warning (hashcat_ctx, "             You can use --force to override, but do not report related errors.");
+      event_log_warning (hashcat_ctx, NULL);
 
-        backend_runtime_skip_warnings++;
+      session_param->runtime_skip_warnings++;
 
-        device_param->skipped_warning = true;
-        continue;
-      }
+      device_param->skipped_warning = true;
+      return 0;
     }
+  }
 
-    /**
-     * tuning db
-     */
+  /**
+   * tuning db
+   */
 
-    if (module_ctx->module_extra_tuningdb_block != MODULE_DEFAULT)
-    {
-      // We need this because we can't trust CUDA/HIP to give us the real free device memory
-      // The only way to do so is through low level APIs
+  if (module_ctx->module_extra_tuningdb_block != MODULE_DEFAULT)
+  {
+    // We need this because we can't trust CUDA/HIP to give us the real free device memory
+    // The only way to do so is through low level APIs
+
+    hc_thread_mutex_lock (status_ctx->mux_hwmon);
 
-      const u64 used_bytes = hm_get_memoryused_with_devices_idx (hashcat_ctx, device_id);
+    const u64 used_bytes = hm_get_memoryused_with_devices_idx (hashcat_ctx, device_id);
+
+    hc_thread_mutex_unlock (status_ctx->mux_hwmon);
+
+    if (used_bytes)
+    {
+      const u64 new_left = device_param->device_global_mem - used_bytes;
 
-      if (used_bytes)
+      if (used_bytes > (device_param->device_global_mem * 0.15))
       {
-        const u64 new_left = device_param->device_global_mem - used_bytes;
+        event_log_warning (hashcat_ctx, "* Device #%u: High memory usage by desktop or other apps detected: %" PRIu64 "/%" PRIu64, device_id + 1, used_bytes, device_param->device_global_mem);
+        event_log_warning (hashcat_ctx, "             Performance is capped at %.2f%%", ((double) new_left / device_param->device_global_mem) * 100);
+      }
 
-        if (used_bytes > (device_param->device_global_mem * 0.15))
+      device_param->device_available_mem = MIN (device_param->device_available_mem, new_left);
+    }
+    else
+    {
+      if (user_options->hwmon == false)
+      {
+        if (user_options->machine_readable == false)
         {
-          event_log_warning (hashcat_ctx, "* Device #%u: High memory usage by desktop or other apps detected: %" PRIu64 "/%" PRIu64, device_id + 1, used_bytes, device_param->device_global_mem);
-          event_log_warning (hashcat_ctx, "             Performance is capped at %.2f%%", ((double) new_left / device_param->device_global_mem) * 100);
+          event_log_warning (hashcat_ctx, "* Device #%u: The hardware monitor was disabled, but it is the only reliable method to query actual free memory.", device_id + 1);
+          event_log_warning (hashcat_ctx, "             Falling back to --backend-devices-keepfree method.");
+          event_log_warning (hashcat_ctx, NULL);
         }
-
-        device_param->device_available_mem = MIN (device_param->device_available_mem, new_left);
       }
-      else
+
+      if (user_options->backend_devices_keepfree == 0)
       {
-        if (user_options->hwmon == false)
+        const u64 device_available_mem_sav = device_param->device_available_mem;
+
+        const u64 device_available_mem_new = device_available_mem_sav - (device_available_mem_sav * 0.34);
+
+        if (user_options->machine_readable == false)
         {
-          if (user_options->machine_readable == false)
-          {
-            event_log_warning (hashcat_ctx, "* Device #%u: The hardware monitor was disabled, but it is the only reliable method to query actual free memory.", device_id + 1);
-            event_log_warning (hashcat_ctx, "             Falling back to --backend-devices-keepfree method.");
-            event_log_warning (hashcat_ctx, NULL);
-          }
+          event_log_warning (hashcat_ctx, "* Device #%u: This system does not offer any reliable method to query actual free memory. Estimated base: %" PRIu64, device_id + 1, device_available_mem_sav);
+          event_log_warning (hashcat_ctx, "             Assuming normal desktop activity, reducing estimate by 34%%: %" PRIu64, device_available_mem_new);
+          event_log_warning (hashcat_ctx, "             This can hurt performance drastically, especially on memory-heavy algorithms.");
+          event_log_warning (hashcat_ctx, "             You can adjust this percentage using --backend-devices-keepfree");
+          event_log_warning (hashcat_ctx, NULL);
         }
 
-        if (user_options->backend_devices_keepfree == 0)
-        {
-          const u64 device_available_mem_sav = device_param->device_available_mem;
+        device_param->device_available_mem = device_available_mem_new;
+      }
+    }
 
-          const u64 device_available_mem_new = device_available_mem_sav - (device_available_mem_sav * 0.34);
+    u32 _kernel_accel = 0;
 
-          if (user_options->machine_readable == false)
-          {
-            event_log_warning (hashcat_ctx, "* Device #%u: This system does not offer any reliable method to query actual free memory. Estimated base: %" PRIu64, device_id + 1, device_available_mem_sav);
-            event_log_warning (hashcat_ctx, "             Assuming normal desktop activity, reducing estimate by 34%%: %" PRIu64, device_available_mem_new);
-            event_log_warning (hashcat_ctx, "             This can hurt performance drastically, especially on memory-heavy algorithms.");
-            event_log_warning (hashcat_ctx, "             You can adjust this percentage using --backend-devices-keepfree");
-            event_log_warning (hashcat_ctx, NULL);
-          }
+    if (user_options->kernel_accel_chgd == true)
+    {
+      _kernel_accel = user_options->kernel_accel;
+    }
+    else
+    {
+      tuning_db_entry_t tuningdb_copy;
 
-          device_param->device_available_mem = device_available_mem_new;
-        }
-      }
+      tuning_db_entry_t *tuningdb_entry = backend_tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode, &tuningdb_copy);
+
+      if (tuningdb_entry != NULL) _kernel_accel = tuningdb_entry->kernel_accel;
+    }
 
-      u32 _kernel_accel = 0;
+    const char *extra_tuningdb_block = module_ctx->module_extra_tuningdb_block (hashconfig, user_options, user_options_extra, backend_ctx, hashes, device_id, _kernel_accel);
 
-      if (user_options->kernel_accel_chgd == true)
-      {
-        _kernel_accel = user_options->kernel_accel;
-      }
-      else
-      {
-        tuning_db_entry_t *tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode);
+    char *lines_buf = hcstrdup (extra_tuningdb_block);
 
-        if (tuningdb_entry != NULL) _kernel_accel = tuningdb_entry->kernel_accel;
-      }
+    hc_thread_mutex_lock (backend_ctx->mux_tuning_db);
 
-      const char *extra_tuningdb_block = module_ctx->module_extra_tuningdb_block (hashconfig, user_options, user_options_extra, backend_ctx, hashes, device_id, _kernel_accel);
+    char *saveptr = NULL;
 
-      char *lines_buf = hcstrdup (extra_tuningdb_block);
+    char *next = strtok_r (lines_buf, "\n", &saveptr);
 
-      char *saveptr = NULL;
+    int line_num = 0;
 
-      char *next = strtok_r (lines_buf, "\n", &saveptr);
+    do
+    {
+      line_num++;
 
-      int line_num = 0;
+      const size_t line_len = strlen (next);
 
-      do
-      {
-        line_num++;
+      if (line_len == 0) continue;
 
-        const size_t line_len = strlen (next);
+      if (next[0] == '#') continue;
 
-        if (line_len == 0) continue;
+      char *search_name = NULL;
 
-        if (next[0] == '#') continue;
+      hc_asprintf (&search_name, "MODULE_%02d_%s", device_param->device_id, next);
 
-        char *search_name = NULL;
+      tuning_db_process_line (hashcat_ctx, search_name, line_num);
 
-        hc_asprintf (&search_name, "MODULE_%02d_%s", device_param->device_id, next);
+      hcfree (search_name);
 
-        tuning_db_process_line (hashcat_ctx, search_name, line_num);
+    } while ((next = strtok_r ((char *) NULL, "\n", &saveptr)) != NULL);
 
-        hcfree (search_name);
+    hcfree (lines_buf);
 
-      } while ((next = strtok_r ((char *) NULL, "\n", &saveptr)) != NULL);
+    // todo: print loaded 'cnt' message
 
-      hcfree (lines_buf);
+    // sort the database
 
-      // todo: print loaded 'cnt' message
+    tuning_db_t *tuning_db = hashcat_ctx->tuning_db;
 
-      // sort the database
+    qsort (tuning_db->alias_buf, tuning_db->alias_cnt, sizeof (tuning_db_alias_t), sort_by_tuning_db_alias);
+    qsort (tuning_db->entry_buf, tuning_db->entry_cnt, sizeof (tuning_db_entry_t), sort_by_tuning_db_entry);
 
-      tuning_db_t *tuning_db = hashcat_ctx->tuning_db;
+    hc_thread_mutex_unlock (backend_ctx->mux_tuning_db);
+  }
 
-      qsort (tuning_db->alias_buf, tuning_db->alias_cnt, sizeof (tuning_db_alias_t), sort_by_tuning_db_alias);
-      qsort (tuning_db->entry_buf, tuning_db->entry_cnt, sizeof (tuning_db_entry_t), sort_by_tuning_db_entry);
-    }
+  // vector_width
 
-    // vector_width
+  int vector_width = 0;
 
-    int vector_width = 0;
+  if (user_options->backend_vector_width_chgd == false)
+  {
+    // tuning db
 
-    if (user_options->backend_vector_width_chgd == false)
-    {
-      // tuning db
+    tuning_db_entry_t tuningdb_copy;
 
-      tuning_db_entry_t *tuningdb_entry;
+    tuning_db_entry_t *tuningdb_entry;
 
-      if (user_options->slow_candidates == true)
-      {
-        tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, 0, hashconfig->hash_mode);
-      }
-      else
-      {
-        tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode);
-      }
+    if (user_options->slow_candidates == true)
+    {
+      tuningdb_entry = backend_tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, 0, hashconfig->hash_mode, &tuningdb_copy);
+    }
+    else
+    {
+      tuningdb_entry = backend_tuning_db_search (hashcat_ctx, device_param->device_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode, &tuningdb_copy);
+    }
 
-      if (tuningdb_entry == NULL || tuningdb_entry->vector_width == -1)
+    if (tuningdb_entry == NULL || tuningdb_entry->vector_width == -1)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_USES_BITS_64)
       {
-        if (hashconfig->opti_type & OPTI_TYPE_USES_BITS_64)
+        if (device_param->is_cuda == true)
         {
-          if (device_param->is_cuda == true)
-          {
-            // cuda does not support this query
+          // cuda does not support this query
 
-            vector_width = 1;
-          }
+          vector_width = 1;
+        }
 
-          if (device_param->is_hip == true)
-          {
-            // hip does not support this query
+        if (device_param->is_hip == true)
+        {
+          // hip does not support this query
 
-            vector_width = 1;
-          }
+          vector_width = 1;
+        }
 
-          #if defined (__APPLE__)
-          if (device_param->is_metal == true)
-          {
-            // Metal does not support this query
+        #if defined (__APPLE__)
+        if (device_param->is_metal == true)
+        {
+          // Metal does not support this query
 
-            vector_width = 1;
-          }
-          #endif
+          vector_width = 1;
+        }
+        #endif
 
-          if (device_param->is_opencl == true)
-          {
-            // For CPU we can ask the runtime
-            // For GPUs we want to be more selective and we will use the tuning db
+        if (device_param->is_opencl == true)
+        {
+          // For CPU we can ask the runtime
+          // For GPUs we want to be more selective and we will use the tuning db
 
-            vector_width = 1;
+          vector_width = 1;
 
-            if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+          if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+          {
+            if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG, sizeof (vector_width), &vector_width, NULL) == -1)
             {
-              if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG, sizeof (vector_width), &vector_width, NULL) == -1)
-              {
-                device_param->skipped = true;
+              device_param->skipped = true;
 
-                continue;
-              }
+              return 0;
             }
           }
         }
-        else
+      }
+      else
+      {
+        if (device_param->is_cuda == true)
         {
-          if (device_param->is_cuda == true)
-          {
-            // cuda does not support this query
+          // cuda does not support this query
 
-            vector_width = 1;
-          }
+          vector_width = 1;
+        }
 
-          if (device_param->is_hip == true)
-          {
-            // hip does not support this query
+        if (device_param->is_hip == true)
+        {
+          // hip does not support this query
 
-            vector_width = 1;
-          }
+          vector_width = 1;
+        }
 
-          #if defined (__APPLE__)
-          if (device_param->is_metal == true)
-          {
-            // Metal does not support this query
+        #if defined (__APPLE__)
+        if (device_param->is_metal == true)
+        {
+          // Metal does not support this query
 
-            vector_width = 1;
-          }
-          #endif
+          vector_width = 1;
+        }
+        #endif
 
-          if (device_param->is_opencl == true)
-          {
-            // For CPU we can ask the runtime
-            // For GPUs we want to be more selective and we will use the tuning db
+        if (device_param->is_opencl == true)
+        {
+          // For CPU we can ask the runtime
+          // For GPUs we want to be more selective and we will use the tuning db
 
-            vector_width = 1;
+          vector_width = 1;
 
-            if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+          if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+          {
+            if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_INT,  sizeof (vector_width), &vector_width, NULL) == -1)
             {
-              if (hc_clGetDeviceInfo (hashcat_ctx, device_param->opencl_device, CL_DEVICE_NATIVE_VECTOR_WIDTH_INT,  sizeof (vector_width), &vector_width, NULL) == -1)
-              {
-                device_param->skipped = true;
+              device_param->skipped = true;
 
-                continue;
-              }
+              return 0;
             }
           }
         }
       }
-      else
-      {
-        vector_width = (cl_uint) tuningdb_entry->vector_width;
-      }
     }
     else
     {
-      vector_width = user_options->backend_vector_width;
+      vector_width = (cl_uint) tuningdb_entry->vector_width;
     }
+  }
+  else
+  {
+    vector_width = user_options->backend_vector_width;
+  }
+
+  // Metal supports vectors up to 4
+
+  if (device_param->is_metal == true && vector_width > 4)
+  {
+    vector_width = 4;
+  }
 
-    // Metal supports vectors up to 4
+  // We can't have SIMD in kernels where we have an unknown final password length
+  // It also turns out that pure kernels (that have a higher register pressure)
+  // actually run faster on scalar GPU (like 1080) without SIMD
 
-    if (device_param->is_metal == true && vector_width > 4)
+  if ((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0)
+  {
+    if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
     {
-      vector_width = 4;
+      vector_width = 1;
     }
+  }
+
+  if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+  {
+    // not working in this mode because the GID does not align with password candidate count
+    // and if it cracks, it will crack the same hash twice, running into segfaults
+
+    vector_width = 1;
+  }
+
+  if (vector_width > 16) vector_width = 16;
+
+  device_param->vector_width = vector_width;
+
+  /**
+   * kernel accel and loops tuning db adjustment
+   */
+
+  device_param->kernel_accel_min   = hashconfig->kernel_accel_min;
+  device_param->kernel_accel_max   = hashconfig->kernel_accel_max;
+  device_param->kernel_loops_min   = hashconfig->kernel_loops_min;
+  device_param->kernel_loops_max   = hashconfig->kernel_loops_max;
+  device_param->kernel_threads_min = hashconfig->kernel_threads_min;
+  device_param->kernel_threads_max = hashconfig->kernel_threads_max;
+
+  tuning_db_entry_t tuningdb_copy;
 
-    // We can't have SIMD in kernels where we have an unknown final password length
-    // It also turns out that pure kernels (that have a higher register pressure)
-    // actually run faster on scalar GPU (like 1080) without SIMD
+  tuning_db_entry_t *tuningdb_entry = NULL;
 
-    if ((hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL) == 0)
+  for (int i = 0; i < 2; i++)
+  {
+    char *search_name = NULL;
+
+    if (i == 0)
     {
-      if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
-      {
-        vector_width = 1;
-      }
+      hc_asprintf (&search_name, "MODULE_%02d_%s", device_param->device_id, device_param->device_name);
     }
-
-    if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+    else
     {
-      // not working in this mode because the GID does not align with password candidate count
-      // and if it cracks, it will crack the same hash twice, running into segfaults
-
-      vector_width = 1;
+      search_name = device_param->device_name;
     }
 
-    if (vector_width > 16) vector_width = 16;
+    if (user_options->slow_candidates == true)
+    {
+      tuningdb_entry = backend_tuning_db_search (hashcat_ctx, search_name, device_param->opencl_device_type, 0, hashconfig->hash_mode, &tuningdb_copy);
+    }
+    else
+    {
+      tuningdb_entry = backend_tuning_db_search (hashcat_ctx, search_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode, &tuningdb_copy);
+    }
 
-    device_param->vector_width = vector_width;
+    if (i == 0) hcfree (search_name);
 
-    /**
-     * kernel accel and loops tuning db adjustment
-     */
+    if (tuningdb_entry != NULL) break;
+  }
 
-    device_param->kernel_accel_min   = hashconfig->kernel_accel_min;
-    device_param->kernel_accel_max   = hashconfig->kernel_accel_max;
-    device_param->kernel_loops_min   = hashconfig->kernel_loops_min;
-    device_param->kernel_loops_max   = hashconfig->kernel_loops_max;
-    device_param->kernel_threads_min = hashconfig->kernel_threads_min;
-    device_param->kernel_threads_max = hashconfig->kernel_threads_max;
+  // user commandline option override tuning db
+  // but both have to stay inside the boundaries of the module
 
-    tuning_db_entry_t *tuningdb_entry = NULL;
+  if (user_options->kernel_accel_chgd == true)
+  {
+    const u32 _kernel_accel = user_options->kernel_accel;
 
-    for (int i = 0; i < 2; i++)
+    if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
     {
-      char *search_name = NULL;
+      device_param->kernel_accel_min = _kernel_accel;
+      device_param->kernel_accel_max = _kernel_accel;
+    }
+  }
+  else
+  {
+    if (tuningdb_entry != NULL)
+    {
+      const u32 _kernel_accel = tuningdb_entry->kernel_accel;
 
-      if (i == 0)
+      if (_kernel_accel == (u32) -1) // native, makes sense if OPTS_TYPE_MP_MULTI_DISABLE is used
       {
-        hc_asprintf (&search_name, "MODULE_%02d_%s", device_param->device_id, device_param->device_name);
+        if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
+        {
+          if (module_ctx->module_extra_tuningdb_block != MODULE_DEFAULT)
+          {
+            event_log_warning (hashcat_ctx, "ATTENTION! This hash-mode requires manual tuning to achieve full performance.");
+            event_log_warning (hashcat_ctx, "The loss of performance can be greater than 100%% without manual tuning.");
+            event_log_warning (hashcat_ctx, NULL);
+            event_log_warning (hashcat_ctx, "This warning message disappears after a definition for the installed");
+            event_log_warning (hashcat_ctx, "compute-device in this computer has been added to either list:");
+            event_log_warning (hashcat_ctx, "- src/modules/module_%05d.c", hashconfig->hash_mode);
+            event_log_warning (hashcat_ctx, "- hashcat.hctune");
+            event_log_warning (hashcat_ctx, NULL);
+            event_log_warning (hashcat_ctx, "For instructions on tuning, see src/modules/module_%05d.c", hashconfig->hash_mode);
+            event_log_warning (hashcat_ctx, "Also, consider sending a PR to Hashcat Master so that other users can benefit from your work.");
+            event_log_warning (hashcat_ctx, NULL);
+          }
+        }
+
+        device_param->kernel_accel_min = device_param->device_processors;
+        device_param->kernel_accel_max = device_param->device_processors;
       }
       else
       {
-        search_name = device_param->device_name;
+        if (_kernel_accel)
+        {
+          if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
+          {
+            device_param->kernel_accel_min = _kernel_accel;
+            device_param->kernel_accel_max = _kernel_accel;
+          }
+        }
       }
+    }
 
-      if (user_options->slow_candidates == true)
+    if (hashconfig->bridge_type & BRIDGE_TYPE_MATCH_TUNINGS)
+    {
+      u32 workitem_count = bridge_ctx->get_workitem_count (bridge_ctx->platform_context, device_param->bridge_link_device);
+
+           if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_001) workitem_count = 1;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_002) workitem_count = 2;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_004) workitem_count = 4;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_008) workitem_count = 8;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_016) workitem_count = 16;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_032) workitem_count = 32;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_064) workitem_count = 64;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_128) workitem_count = 128;
+      else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_256) workitem_count = 256;
+
+      u32 native_threads = 0;
+
+      if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
       {
-        tuningdb_entry = tuning_db_search (hashcat_ctx, search_name, device_param->opencl_device_type, 0, hashconfig->hash_mode);
+        native_threads = 1;
       }
-      else
+      else if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
       {
-        tuningdb_entry = tuning_db_search (hashcat_ctx, search_name, device_param->opencl_device_type, user_options->attack_mode, hashconfig->hash_mode);
+        native_threads = device_param->kernel_preferred_wgs_multiple;
       }
 
-      if (i == 0) hcfree (search_name);
+      const u32 _kernel_accel = ((workitem_count + native_threads - 1) / native_threads) * native_threads;
 
-      if (tuningdb_entry != NULL) break;
+      device_param->kernel_accel_min = _kernel_accel;
+      device_param->kernel_accel_max = _kernel_accel;
     }
+  }
 
-    // user commandline option override tuning db
-    // but both have to stay inside the boundaries of the module
+  if (user_options->kernel_loops_chgd == true)
+  {
+    const u32 _kernel_loops = user_options->kernel_loops;
 
-    if (user_options->kernel_accel_chgd == true)
+    if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
     {
-      const u32 _kernel_accel = user_options->kernel_accel;
-
-      if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
-      {
-        device_param->kernel_accel_min = _kernel_accel;
-        device_param->kernel_accel_max = _kernel_accel;
-      }
+      device_param->kernel_loops_min = _kernel_loops;
+      device_param->kernel_loops_max = _kernel_loops;
     }
-    else
+  }
+  else
+  {
+    if (tuningdb_entry != NULL)
     {
-      if (tuningdb_entry != NULL)
+      u32 _kernel_loops = tuningdb_entry->kernel_loops;
+
+      if (_kernel_loops)
       {
-        const u32 _kernel_accel = tuningdb_entry->kernel_accel;
+        if (user_options->workload_profile == 1)
+        {
+          _kernel_loops = (_kernel_loops > 8) ? _kernel_loops / 8 : 1;
+        }
+        else if (user_options->workload_profile == 2)
+        {
+          _kernel_loops = (_kernel_loops > 4) ? _kernel_loops / 4 : 1;
+        }
 
-        if (_kernel_accel == (u32) -1) // native, makes sense if OPTS_TYPE_MP_MULTI_DISABLE is used
+        if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
         {
-          if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
-          {
-            if (module_ctx->module_extra_tuningdb_block != MODULE_DEFAULT)
-            {
-              event_log_warning (hashcat_ctx, "ATTENTION! This hash-mode requires manual tuning to achieve full performance.");
-              event_log_warning (hashcat_ctx, "The loss of performance can be greater than 100%% without manual tuning.");
-              event_log_warning (hashcat_ctx, NULL);
-              event_log_warning (hashcat_ctx, "This warning message disappears after a definition for the installed");
-              event_log_warning (hashcat_ctx, "compute-device in this computer has been added to either list:");
-              event_log_warning (hashcat_ctx, "- src/modules/module_%05d.c", hashconfig->hash_mode);
-              event_log_warning (hashcat_ctx, "- hashcat.hctune");
-              event_log_warning (hashcat_ctx, NULL);
-              event_log_warning (hashcat_ctx, "For instructions on tuning, see src/modules/module_%05d.c", hashconfig->hash_mode);
-              event_log_warning (hashcat_ctx, "Also, consider sending a PR to Hashcat Master so that other users can benefit from your work.");
-              event_log_warning (hashcat_ctx, NULL);
-            }
-          }
-
-          device_param->kernel_accel_min = device_param->device_processors;
-          device_param->kernel_accel_max = device_param->device_processors;
-        }
-        else
-        {
-          if (_kernel_accel)
-          {
-            if ((_kernel_accel >= device_param->kernel_accel_min) && (_kernel_accel <= device_param->kernel_accel_max))
-            {
-              device_param->kernel_accel_min = _kernel_accel;
-              device_param->kernel_accel_max = _kernel_accel;
-            }
-          }
+          device_param->kernel_loops_min = _kernel_loops;
+          device_param->kernel_loops_max = _kernel_loops;
         }
       }
+    }
+  }
 
-      if (hashconfig->bridge_type & BRIDGE_TYPE_MATCH_TUNINGS)
-      {
-        u32 workitem_count = bridge_ctx->get_workitem_count (bridge_ctx->platform_context, device_param->bridge_link_device);
-
-             if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_001) workitem_count = 1;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_002) workitem_count = 2;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_004) workitem_count = 4;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_008) workitem_count = 8;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_016) workitem_count = 16;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_032) workitem_count = 32;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_064) workitem_count = 64;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_128) workitem_count = 128;
-        else if (hashconfig->bridge_type & BRIDGE_TYPE_FORCE_WORKITEMS_256) workitem_count = 256;
-
-        u32 native_threads = 0;
-
-        if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
-        {
-          native_threads = 1;
-        }
-        else if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
-        {
-          native_threads = device_param->kernel_preferred_wgs_multiple;
-        }
+  // there's no thread column in tuning db, stick to commandline if defined
 
-        const u32 _kernel_accel = ((workitem_count + native_threads - 1) / native_threads) * native_threads;
+  if (user_options->kernel_threads_chgd == true)
+  {
+    const u32 _kernel_threads = user_options->kernel_threads;
 
-        device_param->kernel_accel_min = _kernel_accel;
-        device_param->kernel_accel_max = _kernel_accel;
-      }
+    if ((_kernel_threads >= device_param->kernel_threads_min) && (_kernel_threads <= device_param->kernel_threads_max))
+    {
+      device_param->kernel_threads_min = _kernel_threads;
+      device_param->kernel_threads_max = _kernel_threads;
     }
+  }
 
-    if (user_options->kernel_loops_chgd == true)
-    {
-      const u32 _kernel_loops = user_options->kernel_loops;
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    // we have some absolute limits for fast hashes (because of limit constant memory), make sure not to overstep
 
-      if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
-        device_param->kernel_loops_min = _kernel_loops;
-        device_param->kernel_loops_max = _kernel_loops;
+        device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_RULES);
+        device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_RULES);
       }
-    }
-    else
-    {
-      if (tuningdb_entry != NULL)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        u32 _kernel_loops = tuningdb_entry->kernel_loops;
-
-        if (_kernel_loops)
-        {
-          if (user_options->workload_profile == 1)
-          {
-            _kernel_loops = (_kernel_loops > 8) ? _kernel_loops / 8 : 1;
-          }
-          else if (user_options->workload_profile == 2)
-          {
-            _kernel_loops = (_kernel_loops > 4) ? _kernel_loops / 4 : 1;
-          }
-
-          if ((_kernel_loops >= device_param->kernel_loops_min) && (_kernel_loops <= device_param->kernel_loops_max))
-          {
-            device_param->kernel_loops_min = _kernel_loops;
-            device_param->kernel_loops_max = _kernel_loops;
-          }
-        }
+        device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_COMBS);
+        device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_COMBS);
       }
-    }
-
-    // there's no thread column in tuning db, stick to commandline if defined
-
-    if (user_options->kernel_threads_chgd == true)
-    {
-      const u32 _kernel_threads = user_options->kernel_threads;
-
-      if ((_kernel_threads >= device_param->kernel_threads_min) && (_kernel_threads <= device_param->kernel_threads_max))
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
-        device_param->kernel_threads_min = _kernel_threads;
-        device_param->kernel_threads_max = _kernel_threads;
+        device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_BFS);
+        device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_BFS);
       }
     }
+  }
 
-    if (user_options->slow_candidates == true)
-    {
-    }
-    else
-    {
-      // we have some absolute limits for fast hashes (because of limit constant memory), make sure not to overstep
+  device_param->kernel_loops_min_sav = device_param->kernel_loops_min;
+  device_param->kernel_loops_max_sav = device_param->kernel_loops_max;
 
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_RULES);
-          device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_RULES);
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_COMBS);
-          device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_COMBS);
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, KERNEL_BFS);
-          device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, KERNEL_BFS);
-        }
-      }
-    }
+  device_param->at_cache_valid = false;
 
-    device_param->kernel_loops_min_sav = device_param->kernel_loops_min;
-    device_param->kernel_loops_max_sav = device_param->kernel_loops_max;
+  /**
+   * device properties
+   */
 
-    /**
-     * device properties
-     */
+  //const u32 device_processors = device_param->device_processors;
 
-    //const u32 device_processors = device_param->device_processors;
+  /**
+   * device threads
+   */
 
-    /**
-     * device threads
-     */
+  if (hashconfig->opts_type & OPTS_TYPE_MAXIMUM_THREADS)
+  {
+    // default for all, because the else branch is doing the same (nothing), but is actually used as a way to
+    // disable the default native thread configuration for HIP
+    // this can have negative performance if not tested on multiple different gpu architectures
+  }
+  else if (hashconfig->opts_type & OPTS_TYPE_NATIVE_THREADS)
+  {
+    u32 native_threads = 0;
 
-    if (hashconfig->opts_type & OPTS_TYPE_MAXIMUM_THREADS)
+    if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
     {
-      // default for all, because the else branch is doing the same (nothing), but is actually used as a way to
-      // disable the default native thread configuration for HIP
-      // this can have negative performance if not tested on multiple different gpu architectures
+      native_threads = 1;
     }
-    else if (hashconfig->opts_type & OPTS_TYPE_NATIVE_THREADS)
+    else if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
     {
-      u32 native_threads = 0;
-
-      if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
-      {
-        native_threads = 1;
-      }
-      else if (device_param->opencl_device_type & CL_DEVICE_TYPE_GPU)
-      {
-        native_threads = device_param->kernel_preferred_wgs_multiple;
-      }
-      else
-      {
-        // abort?
-      }
+      native_threads = device_param->kernel_preferred_wgs_multiple;
+    }
+    else
+    {
+      // abort?
+    }
 
-      if ((native_threads >= device_param->kernel_threads_min) && (native_threads <= device_param->kernel_threads_max))
-      {
-        device_param->kernel_threads_min = native_threads;
-        device_param->kernel_threads_max = native_threads;
-      }
-      else
-      {
-        // abort?
-      }
+    if ((native_threads >= device_param->kernel_threads_min) && (native_threads <= device_param->kernel_threads_max))
+    {
+      device_param->kernel_threads_min = native_threads;
+      device_param->kernel_threads_max = native_threads;
     }
     else
     {
-      // v7 test, needs some larger test, but I think we will need to stick to this
+      // abort?
+    }
+  }
+  else
+  {
+    // v7 test, needs some larger test, but I think we will need to stick to this
 
-      if (device_param->is_cuda == true)
-      {
-        // we will find this after loading the kernel with suppport of runtime api
-      }
-      else if (device_param->is_hip == true)
-      {
-        // we will find this after loading the kernel with suppport of runtime api
-      }
-      else if (device_param->is_opencl == true)
-      {
-        // we will find this after loading the kernel with suppport of runtime api
-      }
-      else if (device_param->is_metal == true)
-      {
-        // we will find this after loading the kernel with suppport of runtime api
-      }
+    if (device_param->is_cuda == true)
+    {
+      // we will find this after loading the kernel with suppport of runtime api
+    }
+    else if (device_param->is_hip == true)
+    {
+      // we will find this after loading the kernel with suppport of runtime api
     }
+    else if (device_param->is_opencl == true)
+    {
+      // we will find this after loading the kernel with suppport of runtime api
+    }
+    else if (device_param->is_metal == true)
+    {
+      // we will find this after loading the kernel with suppport of runtime api
+    }
+  }
 
-    // this seems to work always
+  // this seems to work always
 
-    if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
-    {
-      u32 native_threads = 1;
+  if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+  {
+    u32 native_threads = 1;
 
-      if ((native_threads >= device_param->kernel_threads_min) && (native_threads <= device_param->kernel_threads_max))
-      {
-        device_param->kernel_threads_min = native_threads;
-        device_param->kernel_threads_max = native_threads;
-      }
+    if ((native_threads >= device_param->kernel_threads_min) && (native_threads <= device_param->kernel_threads_max))
+    {
+      device_param->kernel_threads_min = native_threads;
+      device_param->kernel_threads_max = native_threads;
     }
+  }
 
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
-    {
-      // set some limits with Metal
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    // set some limits with Metal
 
-      device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
-      device_param->kernel_threads_min = MIN (device_param->kernel_threads_min, device_param->kernel_threads_max);
+    device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
+    device_param->kernel_threads_min = MIN (device_param->kernel_threads_min, device_param->kernel_threads_max);
 
-      device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, 1024);  // autotune go over ...
-      device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, device_param->kernel_loops_max);
+    device_param->kernel_loops_max = MIN (device_param->kernel_loops_max, 1024);  // autotune go over ...
+    device_param->kernel_loops_min = MIN (device_param->kernel_loops_min, device_param->kernel_loops_max);
 
-      device_param->overtune_unfriendly = true;
-    }
-    #endif
+    device_param->overtune_unfriendly = true;
+  }
+  #endif
 
-    // re-using context/command-queue, there is no need to re-initialize them
+  // re-using context/command-queue, there is no need to re-initialize them
 
-    /**
-     * create stream for CUDA devices
-     */
+  /**
+   * create stream for CUDA devices
+   */
 
-    if (device_param->is_cuda == true)
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuCtxPushCurrent (hashcat_ctx, device_param->cuda_context) == -1)
     {
-      if (hc_cuCtxPushCurrent (hashcat_ctx, device_param->cuda_context) == -1)
-      {
-        device_param->skipped = true;
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
+    }
 
-      if (hc_cuStreamCreate (hashcat_ctx, &device_param->cuda_stream, CU_STREAM_DEFAULT) == -1)
-      {
-        device_param->skipped = true;
+    if (hc_cuStreamCreate (hashcat_ctx, &device_param->cuda_stream, CU_STREAM_DEFAULT) == -1)
+    {
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
     }
+  }
 
-    /**
-     * create stream for HIP devices
-     */
+  /**
+   * create stream for HIP devices
+   */
 
-    if (device_param->is_hip == true)
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipSetDevice (hashcat_ctx, device_param->hip_device) == -1)
     {
-      if (hc_hipSetDevice (hashcat_ctx, device_param->hip_device) == -1)
-      {
-        device_param->skipped = true;
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
+    }
 
-      if (hc_hipStreamCreateWithFlags (hashcat_ctx, &device_param->hip_stream, hipStreamDefault) == -1)
-      {
-        device_param->skipped = true;
+    if (hc_hipStreamCreateWithFlags (hashcat_ctx, &device_param->hip_stream, hipStreamDefault) == -1)
+    {
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
     }
+  }
 
-    /**
-     * create events for CUDA devices
-     */
+  /**
+   * create events for CUDA devices
+   */
 
-    if (device_param->is_cuda == true)
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event1, CU_EVENT_BLOCKING_SYNC) == -1)
     {
-      if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event1, CU_EVENT_BLOCKING_SYNC) == -1)
-      {
-        device_param->skipped = true;
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
+    }
 
-      if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event2, CU_EVENT_BLOCKING_SYNC) == -1)
-      {
-        device_param->skipped = true;
+    if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event2, CU_EVENT_BLOCKING_SYNC) == -1)
+    {
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
+    }
 
-      if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event3, CU_EVENT_DISABLE_TIMING) == -1)
-      {
-        device_param->skipped = true;
+    if (hc_cuEventCreate (hashcat_ctx, &device_param->cuda_event3, CU_EVENT_DISABLE_TIMING) == -1)
+    {
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
     }
+  }
 
-    /**
-     * create events for HIP devices
-     */
+  /**
+   * create events for HIP devices
+   */
 
-    if (device_param->is_hip == true)
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event1, hipEventBlockingSync) == -1)
     {
-      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event1, hipEventBlockingSync) == -1)
-      {
-        device_param->skipped = true;
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
+    }
 
-      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event2, hipEventBlockingSync) == -1)
-      {
-        device_param->skipped = true;
+    if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event2, hipEventBlockingSync) == -1)
+    {
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
+    }
 
-      if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event3, hipEventDisableTiming) == -1)
-      {
-        device_param->skipped = true;
+    if (hc_hipEventCreateWithFlags (hashcat_ctx, &device_param->hip_event3, hipEventDisableTiming) == -1)
+    {
+      device_param->skipped = true;
 
-        continue;
-      }
+      return 0;
     }
+  }
 
-    /**
-     * create input buffers on device : calculate size of fixed memory buffers
-     */
+  /**
+   * create input buffers on device : calculate size of fixed memory buffers
+   */
 
-    u64 size_root_css   = SP_PW_MAX *           sizeof (cs_t);
-    u64 size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
+  u64 size_root_css   = SP_PW_MAX *           sizeof (cs_t);
+  u64 size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
 
-    device_param->size_root_css   = size_root_css;
-    device_param->size_markov_css = size_markov_css;
+  device_param->size_root_css   = size_root_css;
+  device_param->size_markov_css = size_markov_css;
 
-    u64 size_results = sizeof (u32);
+  u64 size_results = sizeof (u32);
 
-    device_param->size_results = size_results;
+  device_param->size_results = size_results;
 
-    u32 aligned_rules_cnt = MAX (MAX (straight_ctx->kernel_rules_cnt, device_param->kernel_loops_min), KERNEL_RULES);
+  u32 aligned_rules_cnt = MAX (MAX (straight_ctx->kernel_rules_cnt, device_param->kernel_loops_min), KERNEL_RULES);
 
-    u64 size_rules     = (u64) aligned_rules_cnt * sizeof (kernel_rule_t);
-    u64 size_rules_src = (u64) straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);  // size of source rules buffer can be less than aligned_rules_cnt
-    u64 size_rules_c   = (u64) KERNEL_RULES      * sizeof (kernel_rule_t);
+  u64 size_rules     = (u64) aligned_rules_cnt * sizeof (kernel_rule_t);
+  u64 size_rules_src = (u64) straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);  // size of source rules buffer can be less than aligned_rules_cnt
+  u64 size_rules_c   = (u64) KERNEL_RULES      * sizeof (kernel_rule_t);
 
-    device_param->size_rules    = size_rules;
-    device_param->size_rules_c  = size_rules_c;
+  device_param->size_rules    = size_rules;
+  device_param->size_rules_c  = size_rules_c;
 
-    u64 size_plains  = (u64) hashes->digests_cnt * sizeof (plain_t);
-    u64 size_salts   = (u64) hashes->salts_cnt   * sizeof (salt_t);
-    u64 size_esalts  = (u64) hashes->digests_cnt * hashconfig->esalt_size;
-    u64 size_shown   = (u64) hashes->digests_cnt * sizeof (u32);
-    u64 size_digests = (u64) hashes->digests_cnt * (u64) hashconfig->dgst_size;
+  u64 size_plains  = (u64) hashes->digests_cnt * sizeof (plain_t);
+  u64 size_salts   = (u64) hashes->salts_cnt   * sizeof (salt_t);
+  u64 size_esalts  = (u64) hashes->digests_cnt * hashconfig->esalt_size;
+  u64 size_shown   = (u64) hashes->digests_cnt * sizeof (u32);
+  u64 size_digests = (u64) hashes->digests_cnt * (u64) hashconfig->dgst_size;
 
-    device_param->size_plains   = size_plains;
-    device_param->size_digests  = size_digests;
-    device_param->size_shown    = size_shown;
-    device_param->size_salts    = size_salts;
-    device_param->size_esalts   = size_esalts;
+  device_param->size_plains   = size_plains;
+  device_param->size_digests  = size_digests;
+  device_param->size_shown    = size_shown;
+  device_param->size_salts    = size_salts;
+  device_param->size_esalts   = size_esalts;
 
-    u64 size_combs          = KERNEL_COMBS * sizeof (pw_t);
-    u64 size_bfs            = KERNEL_BFS   * sizeof (bf_t);
-    u64 size_tm             = 32           * sizeof (bs_word_t);
-    u64 size_kernel_params  = 1            * sizeof (kernel_param_t);
+  u64 size_combs          = KERNEL_COMBS * sizeof (pw_t);
+  u64 size_bfs            = KERNEL_BFS   * sizeof (bf_t);
+  u64 size_tm             = 32           * sizeof (bs_word_t);
+  u64 size_kernel_params  = 1            * sizeof (kernel_param_t);
 
-    device_param->size_bfs           = size_bfs;
-    device_param->size_combs         = size_combs;
-    device_param->size_tm            = size_tm;
-    device_param->size_kernel_params = size_kernel_params;
+  device_param->size_bfs           = size_bfs;
+  device_param->size_combs         = size_combs;
+  device_param->size_tm            = size_tm;
+  device_param->size_kernel_params = size_kernel_params;
 
-    u64 size_st_digests = 1 * hashconfig->dgst_size;
-    u64 size_st_salts   = 1 * sizeof (salt_t);
-    u64 size_st_esalts  = 1 * hashconfig->esalt_size;
+  u64 size_st_digests = 1 * hashconfig->dgst_size;
+  u64 size_st_salts   = 1 * sizeof (salt_t);
+  u64 size_st_esalts  = 1 * hashconfig->esalt_size;
 
-    device_param->size_st_digests = size_st_digests;
-    device_param->size_st_salts   = size_st_salts;
-    device_param->size_st_esalts  = size_st_esalts;
+  device_param->size_st_digests = size_st_digests;
+  device_param->size_st_salts   = size_st_salts;
+  device_param->size_st_esalts  = size_st_esalts;
 
-    // extra buffer
+  // extra buffer
 
-    u64 size_extra_buffer1 = 4096;
-    u64 size_extra_buffer2 = 4096;
-    u64 size_extra_buffer3 = 4096;
-    u64 size_extra_buffer4 = 4096;
+  u64 size_extra_buffer1 = 4096;
+  u64 size_extra_buffer2 = 4096;
+  u64 size_extra_buffer3 = 4096;
+  u64 size_extra_buffer4 = 4096;
 
-    if (module_ctx->module_extra_buffer_size != MODULE_DEFAULT)
-    {
-      const u64 extra_buffer_size = module_ctx->module_extra_buffer_size (hashconfig, user_options, user_options_extra, hashes, device_param);
+  if (module_ctx->module_extra_buffer_size != MODULE_DEFAULT)
+  {
+    const u64 extra_buffer_size = module_ctx->module_extra_buffer_size (hashconfig, user_options, user_options_extra, hashes, device_param);
 
-      if (extra_buffer_size == (u64) -1)
-      {
-        event_log_error (hashcat_ctx, "Invalid extra buffer size.");
+    if (extra_buffer_size == (u64) -1)
+    {
+      event_log_error (hashcat_ctx, "Invalid extra buffer size.");
 
-        backend_extra_size_warning++;
+      session_param->extra_size_warning++;
 
-        device_param->skipped_warning = true;
-        continue;
-      }
+      device_param->skipped_warning = true;
+      return 0;
+    }
 
-      device_param->extra_buffer_size = extra_buffer_size;
+    device_param->extra_buffer_size = extra_buffer_size;
 
-      /**
-       * We use a "4-buffer" strategy for certain hash types (like scrypt)
-       * that require large scratch buffers per work-item.
-       *
-       * The kernel assigns each work-item to one of 4 sub-buffers using:
-       *   buffer index = workitem_id % 4
-       *
-       * This means that each of the 4 sub-buffers must be large enough to hold
-       * all work-items that map to it. However, the total number of work-items
-       * is not always a multiple of 4. If we naively split the total buffer size
-       * evenly into 4 parts, the last chunk may be too small and cause buffer
-       * overflows for configurations where work-items spill into a partially sized chunk.
-       *
-       * Previous versions worked around this by over-allocating a full extra buffer,
-       * but this wasted gpu memory for large hashes like scrypt with high N.
-       *
-       * This improved logic computes the exact number of work-items assigned to
-       * each of the 4 chunks and sizes each chunk precisely:
-       *
-       * - The first 'leftover' chunks get one extra work-item to cover any remainder.
-       * - This guarantees each chunk is large enough for its assigned work-items.
-       */
+    /**
+     * We use a "4-buffer" strategy for certain hash types (like scrypt)
+     * that require large scratch buffers per work-item.
+     *
+     * The kernel assigns each work-item to one of 4 sub-buffers using:
+     *   buffer index = workitem_id % 4
+     *
+     * This means that each of the 4 sub-buffers must be large enough to hold
+     * all work-items that map to it. However, the total number of work-items
+     * is not always a multiple of 4. If we naively split the total buffer size
+     * evenly into 4 parts, the last chunk may be too small and cause buffer
+     * overflows for configurations where work-items spill into a partially sized chunk.
+     *
+     * Previous versions worked around this by over-allocating a full extra buffer,
+     * but this wasted gpu memory for large hashes like scrypt with high N.
+     *
+     * This improved logic computes the exact number of work-items assigned to
+     * each of the 4 chunks and sizes each chunk precisely:
+     *
+     * - The first 'leftover' chunks get one extra work-item to cover any remainder.
+     * - This guarantees each chunk is large enough for its assigned work-items.
+     */
 
-      const u64 kernel_power_max = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE) ? 1 : device_param->device_processors) * device_param->kernel_accel_max;
+    const u64 kernel_power_max = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE) ? 1 : device_param->device_processors) * device_param->kernel_accel_max;
 
-      const u64 extra_buffer_size_threads = extra_buffer_size / kernel_power_max;
+    const u64 extra_buffer_size_threads = extra_buffer_size / kernel_power_max;
 
-      const u64 workitems_per_chunk = kernel_power_max / 4;
+    const u64 workitems_per_chunk = kernel_power_max / 4;
 
-      const u64 base_chunk_size = workitems_per_chunk * extra_buffer_size_threads;
+    const u64 base_chunk_size = workitems_per_chunk * extra_buffer_size_threads;
 
-      size_extra_buffer1 += base_chunk_size;
-      size_extra_buffer2 += base_chunk_size;
-      size_extra_buffer3 += base_chunk_size;
-      size_extra_buffer4 += base_chunk_size;
+    size_extra_buffer1 += base_chunk_size;
+    size_extra_buffer2 += base_chunk_size;
+    size_extra_buffer3 += base_chunk_size;
+    size_extra_buffer4 += base_chunk_size;
 
-      const u64 leftover = kernel_power_max % 4;
+    const u64 leftover = kernel_power_max % 4;
 
-      switch (leftover)
-      {
-        case 3: size_extra_buffer3 += extra_buffer_size_threads; // fall-through
-        case 2: size_extra_buffer2 += extra_buffer_size_threads; // fall-through
-        case 1: size_extra_buffer1 += extra_buffer_size_threads; // fall-through
-        case 0: break;
-      }
+    switch (leftover)
+    {
+      case 3: size_extra_buffer3 += extra_buffer_size_threads; // fall-through
+      case 2: size_extra_buffer2 += extra_buffer_size_threads; // fall-through
+      case 1: size_extra_buffer1 += extra_buffer_size_threads; // fall-through
+      case 0: break;
     }
+  }
 
-    // kern type
+  // kern type
 
-    u32 kern_type = hashconfig->kern_type;
+  u32 kern_type = hashconfig->kern_type;
 
-    if (module_ctx->module_kern_type_dynamic != MODULE_DEFAULT)
+  if (module_ctx->module_kern_type_dynamic != MODULE_DEFAULT)
+  {
+    if (user_options->benchmark == true)
     {
-      if (user_options->benchmark == true)
-      {
-      }
-      else
-      {
-        void        *digests_buf    = hashes->digests_buf;
-        salt_t      *salts_buf      = hashes->salts_buf;
-        void        *esalts_buf     = hashes->esalts_buf;
-        void        *hook_salts_buf = hashes->hook_salts_buf;
-        hashinfo_t **hash_info      = hashes->hash_info;
+    }
+    else
+    {
+      void        *digests_buf    = hashes->digests_buf;
+      salt_t      *salts_buf      = hashes->salts_buf;
+      void        *esalts_buf     = hashes->esalts_buf;
+      void        *hook_salts_buf = hashes->hook_salts_buf;
+      hashinfo_t **hash_info      = hashes->hash_info;
 
-        hashinfo_t *hash_info_ptr = NULL;
+      hashinfo_t *hash_info_ptr = NULL;
 
-        if (hash_info) hash_info_ptr = hash_info[0];
+      if (hash_info) hash_info_ptr = hash_info[0];
 
-        kern_type = (u32) module_ctx->module_kern_type_dynamic (hashconfig, digests_buf, salts_buf, esalts_buf, hook_salts_buf, hash_info_ptr);
-      }
+      kern_type = (u32) module_ctx->module_kern_type_dynamic (hashconfig, digests_buf, salts_buf, esalts_buf, hook_salts_buf, hash_info_ptr);
     }
+  }
 
-    if ((int) kern_type == -1)
-    {
-      event_log_error (hashcat_ctx, "Invalid hash-mode selected: -1");
+  if ((int) kern_type == -1)
+  {
+    event_log_error (hashcat_ctx, "Invalid hash-mode selected: -1");
 
-      return -1;
-    }
+    return -1;
+  }
+
+  // built options
+
+  const size_t build_options_sz = 4096;
+
+  char *build_options_buf = (char *) hcmalloc (build_options_sz);
+
+  int build_options_len = snprintf(build_options_buf, build_options_sz, "-D KERNEL_STATIC ");
 
-    // built options
+  #if defined (DEBUG) && (DEBUG >= 1)
+  // only HIP and OpenCL have '-g'
+  if (device_param->is_hip == true || device_param->is_opencl == true)
+  {
+    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-g ");
+  }
+  #endif
+
+  if ((device_param->is_cuda == true) || (device_param->is_hip == true))
+  {
+    // using a path with a space will break nvrtc_make_options_array_from_string()
+    // we add it to options array in a clean way later
+  }
+  else
+  {
+    #if defined (_WIN) || defined (__CYGWIN__) || defined (__MSYS__)
+    // workaround for AMD
+    if (device_param->opencl_platform_vendor_id == VENDOR_ID_AMD && device_param->opencl_device_vendor_id == VENDOR_ID_AMD)
+    {
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-I . ");
+    }
 
-    const size_t build_options_sz = 4096;
+    // when built with cygwin or msys, cpath_real doesn't work
+    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D INCLUDE_PATH=%s ", "OpenCL");
+    #else
+    const char *build_options_include_fmt = (strchr (folder_config->cpath_real, ' ') != NULL) ? "-D INCLUDE_PATH=\"%s\" " : "-D INCLUDE_PATH=%s ";
 
-    char *build_options_buf = (char *) hcmalloc (build_options_sz);
+    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, build_options_include_fmt, folder_config->cpath_real);
+    #endif
 
-    int build_options_len = snprintf(build_options_buf, build_options_sz, "-D KERNEL_STATIC ");
+    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D XM2S(x)=#x ");
+    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D M2S(x)=XM2S(x) ");
+    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D MAX_THREADS_PER_BLOCK=%d ", (user_options->kernel_threads_chgd == true) ? user_options->kernel_threads : device_param->kernel_threads_max);
 
-    #if defined (DEBUG) && (DEBUG >= 1)
-    // only HIP and OpenCL have '-g'
-    if (device_param->is_hip == true || device_param->is_opencl == true)
+    #if defined (__APPLE__)
+    if (is_apple_silicon () == true)
     {
-      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-g ");
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D IS_APPLE_SILICON ");
     }
     #endif
+  }
+
+  /* currently disabled, hangs NEO drivers since 20.09.
+     was required for NEO driver 20.08 to workaround the same issue!
+     we go with the latest version
+     v7 re-enabled
+    */
 
-    if ((device_param->is_cuda == true) || (device_param->is_hip == true))
+  if (device_param->is_opencl == true)
+  {
+    if (device_param->use_opencl11 == true)
     {
-      // using a path with a space will break nvrtc_make_options_array_from_string()
-      // we add it to options array in a clean way later
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL1.1 ");
     }
-    else
+    else if (device_param->use_opencl12 == true)
     {
-      #if defined (_WIN) || defined (__CYGWIN__) || defined (__MSYS__)
-      // workaround for AMD
-      if (device_param->opencl_platform_vendor_id == VENDOR_ID_AMD && device_param->opencl_device_vendor_id == VENDOR_ID_AMD)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-I . ");
-      }
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL1.2 ");
+    }
+    else if (device_param->use_opencl20 == true)
+    {
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL2.0 ");
+    }
+    else if (device_param->use_opencl30 == true)
+    {
+      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL3.0 ");
+    }
+  }
 
-      // when built with cygwin or msys, cpath_real doesn't work
-      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D INCLUDE_PATH=%s ", "OpenCL");
-      #else
-      const char *build_options_include_fmt = (strchr (folder_config->cpath_real, ' ') != NULL) ? "-D INCLUDE_PATH=\"%s\" " : "-D INCLUDE_PATH=%s ";
+  // we don't have sm_* on vendors not NV but it doesn't matter
 
-      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, build_options_include_fmt, folder_config->cpath_real);
-      #endif
+  #if defined (DEBUG)
+  build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D HAS_SHFW=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u -D ATTACK_MODE=%u ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->has_shfw, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern, user_options->attack_mode);
+  #else
+  build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D HAS_SHFW=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u -D ATTACK_MODE=%u -w ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->has_shfw, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern, user_options->attack_mode);
+  #endif
 
-      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D XM2S(x)=#x ");
-      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D M2S(x)=XM2S(x) ");
-      build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D MAX_THREADS_PER_BLOCK=%d ", (user_options->kernel_threads_chgd == true) ? user_options->kernel_threads : device_param->kernel_threads_max);
+  build_options_buf[build_options_len] = 0;
 
-      #if defined (__APPLE__)
-      if (is_apple_silicon () == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D IS_APPLE_SILICON ");
-      }
-      #endif
+  /*
+  if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+  {
+    if (device_param->opencl_platform_vendor_id == VENDOR_ID_INTEL_SDK)
+    {
+      strncat (build_options_buf, " -cl-opt-disable", 16);
     }
+  }
+  */
 
-    /* currently disabled, hangs NEO drivers since 20.09.
-       was required for NEO driver 20.08 to workaround the same issue!
-       we go with the latest version
-       v7 re-enabled
-      */
+  #if defined (DEBUG)
+  if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options '%s'", device_id + 1, build_options_buf);
+  #endif
 
-    if (device_param->is_opencl == true)
+  /**
+   * device_name_chksum_amp_mp
+   */
+
+  char device_name_chksum_amp_mp[HCBUFSIZ_TINY] = { 0 };
+
+  const size_t dnclen_amp_mp = snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%d-%d-%d-%u-%u-%u-%s-%d-%u-%s-%s-%s-%u-%u",
+    backend_ctx->comptime,
+    backend_ctx->cuda_driver_version,
+    backend_ctx->hip_runtimeVersion,
+    backend_ctx->metal_runtimeVersion,
+    device_param->sm_major,
+    device_param->sm_minor,
+    (device_param->is_hip == true) ? device_param->gcnArchName : "",
+    device_param->is_opencl,
+    device_param->opencl_platform_vendor_id,
+    device_param->device_name,
+    device_param->opencl_device_version,
+    device_param->opencl_driver_version,
+    (user_options->kernel_threads_chgd == true) ? user_options->kernel_threads : device_param->kernel_threads_max,
+    get_current_arch());
+
+  md5_ctx_t md5_ctx;
+
+  md5_init   (&md5_ctx);
+  md5_update (&md5_ctx, (u32 *) device_name_chksum_amp_mp, dnclen_amp_mp);
+  md5_final  (&md5_ctx);
+
+  snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
+
+  /**
+   * kernel cache
+   */
+
+  bool cache_disable = false;
+
+  // Seems to be completely broken on Apple + (Intel?) CPU
+  // To reproduce set cache_disable to false and run benchmark -b
+
+  if (device_param->opencl_platform_vendor_id == VENDOR_ID_APPLE)
+  {
+    if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
     {
-      if (device_param->use_opencl11 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL1.1 ");
-      }
-      else if (device_param->use_opencl12 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL1.2 ");
-      }
-      else if (device_param->use_opencl20 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL2.0 ");
-      }
-      else if (device_param->use_opencl30 == true)
-      {
-        build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-cl-std=CL3.0 ");
-      }
+      cache_disable = true;
     }
+  }
 
-    // we don't have sm_* on vendors not NV but it doesn't matter
+  if (module_ctx->module_jit_cache_disable != MODULE_DEFAULT)
+  {
+    cache_disable = module_ctx->module_jit_cache_disable (hashconfig, user_options, user_options_extra, hashes, device_param);
+  }
 
-    #if defined (DEBUG)
-    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D HAS_SHFW=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u -D ATTACK_MODE=%u ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->has_shfw, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern, user_options->attack_mode);
+  #if defined (DEBUG)
+  // https://github.com/hashcat/hashcat/issues/2750
+  cache_disable = true;
+  #endif
+
+  /**
+   * shared kernel with no hashconfig dependencies
+   */
+
+  {
+    /**
+     * kernel shared source filename
+     */
+
+    char source_file[256] = { 0 };
+
+    generate_source_kernel_shared_filename (folder_config->shared_dir, source_file);
+
+    if (hc_path_read (source_file) == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+
+      return -1;
+    }
+
+    /**
+     * kernel shared cached filename
+     */
+
+    char cached_file[256] = { 0 };
+
+    generate_cached_kernel_shared_filename (folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
+
+    #if defined (__APPLE__)
+    const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, &device_param->metal_library_shared);
     #else
-    build_options_len += snprintf (build_options_buf + build_options_len, build_options_sz - build_options_len, "-D LOCAL_MEM_TYPE=%d -D VENDOR_ID=%u -D CUDA_ARCH=%u -D HAS_ADD=%u -D HAS_ADDC=%u -D HAS_SUB=%u -D HAS_SUBC=%u -D HAS_VADD=%u -D HAS_VADDC=%u -D HAS_VADD_CO=%u -D HAS_VADDC_CO=%u -D HAS_VSUB=%u -D HAS_VSUBB=%u -D HAS_VSUB_CO=%u -D HAS_VSUBB_CO=%u -D HAS_VPERM=%u -D HAS_VADD3=%u -D HAS_VBFE=%u -D HAS_BFE=%u -D HAS_LOP3=%u -D HAS_MOV64=%u -D HAS_PRMT=%u -D HAS_SHFW=%u -D VECT_SIZE=%d -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D ATTACK_EXEC=%u -D ATTACK_KERN=%u -D ATTACK_MODE=%u -w ", device_param->device_local_mem_type, device_param->opencl_platform_vendor_id, (device_param->sm_major * 100) + (device_param->sm_minor * 10), device_param->has_add, device_param->has_addc, device_param->has_sub, device_param->has_subc, device_param->has_vadd, device_param->has_vaddc, device_param->has_vadd_co, device_param->has_vaddc_co, device_param->has_vsub, device_param->has_vsubb, device_param->has_vsub_co, device_param->has_vsubb_co, device_param->has_vperm, device_param->has_vadd3, device_param->has_vbfe, device_param->has_bfe, device_param->has_lop3, device_param->has_mov64, device_param->has_prmt, device_param->has_shfw, device_param->vector_width, (u32) device_param->opencl_device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, kern_type, hashconfig->attack_exec, user_options_extra->attack_kern, user_options->attack_mode);
+    const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, NULL);
     #endif
 
-    build_options_buf[build_options_len] = 0;
+    if (rc_load_kernel == false)
+    {
+      event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
 
-    /*
-    if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
+      return -1;
+    }
+
+    int rc = -1;
+
+    if (device_param->is_cuda == true)
+    {
+      rc = backend_session_setup_cuda_kernel_shared (hashcat_ctx, device_param);
+    }
+
+    if (device_param->is_hip == true)
+    {
+      rc = backend_session_setup_hip_kernel_shared (hashcat_ctx, device_param);
+    }
+
+    #if defined (__APPLE__)
+    if (device_param->is_metal == true)
+    {
+      rc = backend_session_setup_metal_kernel_shared (hashcat_ctx, device_param);
+    }
+    #endif
+
+    if (device_param->is_opencl == true)
+    {
+      rc = backend_session_setup_opencl_kernel_shared (hashcat_ctx, device_param);
+    }
+
+    if (rc == -2)
     {
-      if (device_param->opencl_platform_vendor_id == VENDOR_ID_INTEL_SDK)
+      session_param->kernel_create_warnings++;
+
+      return 0;
+    }
+
+    if (rc == -1) return -1;
+
+  }
+
+  /**
+   * main kernel
+   */
+
+  {
+    char *build_options_module_buf = (char *) hcmalloc (build_options_sz);
+
+    int build_options_module_len = 0;
+
+    build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s ", build_options_buf);
+
+    if (module_ctx->module_jit_build_options != MODULE_DEFAULT)
+    {
+      char *jit_build_options = module_ctx->module_jit_build_options (hashconfig, user_options, user_options_extra, hashes, device_param);
+
+      if (jit_build_options != NULL)
       {
-        strncat (build_options_buf, " -cl-opt-disable", 16);
+        build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s", jit_build_options);
+
+        // this is a bit ugly
+        // would be better to have the module return the value as value
+
+        u32 fixed_local_size = 0;
+
+        if (sscanf (jit_build_options, "-D FIXED_LOCAL_SIZE=%u", &fixed_local_size) == 1)
+        {
+          device_param->kernel_threads_min = fixed_local_size;
+          device_param->kernel_threads_max = fixed_local_size;
+        }
+        else if (sscanf (jit_build_options, "-D FORCED_THREAD_COUNT=%u", &fixed_local_size) == 1)
+        {
+          // FORCED_THREAD_COUNT is the same as FIXED_LOCAL_SIZE, but has no impact on the kernel jit
+
+          device_param->kernel_threads_min = fixed_local_size;
+          device_param->kernel_threads_max = fixed_local_size;
+        }
+        else
+        {
+          // kernels specific minimum needs to be set so that self-test wont fail
+
+          if (sscanf (jit_build_options, "-D FIXED_LOCAL_SIZE_COMP=%u", &fixed_local_size) == 1)
+          {
+            device_param->kernel_threads_min = fixed_local_size;
+            // device_param->kernel_threads_max = fixed_local_size;
+
+            device_param->overtune_unfriendly = true;
+          }
+        }
       }
     }
-    */
+
+    build_options_module_buf[build_options_module_len] = 0;
 
     #if defined (DEBUG)
-    if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options '%s'", device_id + 1, build_options_buf);
+    if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options_module '%s'", device_id + 1, build_options_module_buf);
     #endif
 
     /**
-     * device_name_chksum_amp_mp
+     * device_name_chksum
      */
 
-    char device_name_chksum_amp_mp[HCBUFSIZ_TINY] = { 0 };
+    char device_name_chksum[HCBUFSIZ_TINY] = { 0 };
+
+    // The kernel source can depend on some JiT compiler macros which themself depend on the attack_modes.
+    // ATM this is relevant only for ATTACK_MODE_ASSOCIATION which slightly modifies ATTACK_MODE_STRAIGHT kernels.
+
+    const u32 extra_value = (user_options->attack_mode == ATTACK_MODE_ASSOCIATION) ? ATTACK_MODE_ASSOCIATION : ATTACK_MODE_NONE;
 
-    const size_t dnclen_amp_mp = snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%d-%d-%d-%u-%u-%u-%s-%d-%u-%s-%s-%s-%u-%u",
+    const size_t dnclen = snprintf (device_name_chksum, HCBUFSIZ_TINY, "%d-%d-%d-%u-%u-%u-%s-%d-%u-%s-%s-%s-%d-%u-%u-%u-%u-%s",
       backend_ctx->comptime,
       backend_ctx->cuda_driver_version,
       backend_ctx->hip_runtimeVersion,
@@ -14425,56 +14733,84 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       device_param->device_name,
       device_param->opencl_device_version,
       device_param->opencl_driver_version,
+      device_param->vector_width,
+      hashconfig->kern_type,
+      extra_value,
       (user_options->kernel_threads_chgd == true) ? user_options->kernel_threads : device_param->kernel_threads_max,
-      get_current_arch());
-
-    md5_ctx_t md5_ctx;
+      get_current_arch(),
+      build_options_module_buf);
 
+    memset     (&md5_ctx, 0, sizeof (md5_ctx_t));
     md5_init   (&md5_ctx);
-    md5_update (&md5_ctx, (u32 *) device_name_chksum_amp_mp, dnclen_amp_mp);
+    md5_update (&md5_ctx, (u32 *) device_name_chksum, dnclen);
     md5_final  (&md5_ctx);
 
-    snprintf (device_name_chksum_amp_mp, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
+    snprintf (device_name_chksum, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
 
     /**
-     * kernel cache
+     * kernel source filename
      */
 
-    bool cache_disable = false;
+    char source_file[256] = { 0 };
 
-    // Seems to be completely broken on Apple + (Intel?) CPU
-    // To reproduce set cache_disable to false and run benchmark -b
+    generate_source_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->shared_dir, source_file);
 
-    if (device_param->opencl_platform_vendor_id == VENDOR_ID_APPLE)
+    if (hc_path_read (source_file) == false)
     {
-      if (device_param->opencl_device_type & CL_DEVICE_TYPE_CPU)
-      {
-        cache_disable = true;
-      }
-    }
+      event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
 
-    if (module_ctx->module_jit_cache_disable != MODULE_DEFAULT)
-    {
-      cache_disable = module_ctx->module_jit_cache_disable (hashconfig, user_options, user_options_extra, hashes, device_param);
+      return -1;
     }
 
-    #if defined (DEBUG)
-    // https://github.com/hashcat/hashcat/issues/2750
-    cache_disable = true;
-    #endif
+    /**
+     * kernel cached filename
+     */
+
+    char cached_file[256] = { 0 };
+
+    generate_cached_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->cache_dir, device_name_chksum, cached_file, device_param->is_metal);
 
     /**
-     * shared kernel with no hashconfig dependencies
+     * load kernel
      */
 
+    #if defined (__APPLE__)
+    const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, &device_param->metal_library);
+    #else
+    const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, NULL);
+    #endif
+
+    if (rc_load_kernel == false)
+    {
+      event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+
+      session_param->kernel_build_warnings++;
+
+      device_param->skipped_warning = true;
+      return 0;
+    }
+
+    hcfree (build_options_module_buf);
+  }
+
+  /**
+   * word generator kernel
+   */
+
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_GENERIC) && (user_options->attack_mode != ATTACK_MODE_ASSOCIATION))
     {
       /**
-       * kernel shared source filename
+       * kernel mp source filename
        */
 
       char source_file[256] = { 0 };
 
-      generate_source_kernel_shared_filename (folder_config->shared_dir, source_file);
+      generate_source_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->shared_dir, source_file);
 
       if (hc_path_read (source_file) == false)
       {
@@ -14484,17 +14820,17 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       }
 
       /**
-       * kernel shared cached filename
+       * kernel mp cached filename
        */
 
       char cached_file[256] = { 0 };
 
-      generate_cached_kernel_shared_filename (folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
+      generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
 
       #if defined (__APPLE__)
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, &device_param->metal_library_shared);
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, &device_param->metal_library_mp);
       #else
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "shared_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_shared, &device_param->cuda_module_shared, &device_param->hip_module_shared, NULL);
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, NULL);
       #endif
 
       if (rc_load_kernel == false)
@@ -14503,910 +14839,713 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
 
         return -1;
       }
+    }
+  }
 
-      int rc = -1;
+  /**
+   * amplifier kernel
+   */
 
-      if (device_param->is_cuda == true)
-      {
-        rc = backend_session_setup_cuda_kernel_shared (hashcat_ctx, device_param);
-      }
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    {
 
-      if (device_param->is_hip == true)
-      {
-        rc = backend_session_setup_hip_kernel_shared (hashcat_ctx, device_param);
-      }
+    }
+    else
+    {
+      /**
+       * kernel amp source filename
+       */
 
-      #if defined (__APPLE__)
-      if (device_param->is_metal == true)
-      {
-        rc = backend_session_setup_metal_kernel_shared (hashcat_ctx, device_param);
-      }
-      #endif
+      char source_file[256] = { 0 };
 
-      if (device_param->is_opencl == true)
-      {
-        rc = backend_session_setup_opencl_kernel_shared (hashcat_ctx, device_param);
-      }
+      generate_source_kernel_amp_filename (user_options_extra->attack_kern, folder_config->shared_dir, source_file);
 
-      if (rc == -2)
+      if (hc_path_read (source_file) == false)
       {
-        backend_kernel_create_warnings++;
+        event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
 
-        continue;
+        return -1;
       }
 
-      if (rc == -1) return -1;
-
-    }
+      /**
+       * kernel amp cached filename
+       */
 
-    /**
-     * main kernel
-     */
+      char cached_file[256] = { 0 };
 
-    {
-      char *build_options_module_buf = (char *) hcmalloc (build_options_sz);
+      generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
 
-      int build_options_module_len = 0;
-
-      build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s ", build_options_buf);
-
-      if (module_ctx->module_jit_build_options != MODULE_DEFAULT)
-      {
-        char *jit_build_options = module_ctx->module_jit_build_options (hashconfig, user_options, user_options_extra, hashes, device_param);
-
-        if (jit_build_options != NULL)
-        {
-          build_options_module_len += snprintf (build_options_module_buf + build_options_module_len, build_options_sz - build_options_module_len, "%s", jit_build_options);
-
-          // this is a bit ugly
-          // would be better to have the module return the value as value
-
-          u32 fixed_local_size = 0;
-
-          if (sscanf (jit_build_options, "-D FIXED_LOCAL_SIZE=%u", &fixed_local_size) == 1)
-          {
-            device_param->kernel_threads_min = fixed_local_size;
-            device_param->kernel_threads_max = fixed_local_size;
-          }
-          else if (sscanf (jit_build_options, "-D FORCED_THREAD_COUNT=%u", &fixed_local_size) == 1)
-          {
-            // FORCED_THREAD_COUNT is the same as FIXED_LOCAL_SIZE, but has no impact on the kernel jit
-
-            device_param->kernel_threads_min = fixed_local_size;
-            device_param->kernel_threads_max = fixed_local_size;
-          }
-          else
-          {
-            // kernels specific minimum needs to be set so that self-test wont fail
-
-            if (sscanf (jit_build_options, "-D FIXED_LOCAL_SIZE_COMP=%u", &fixed_local_size) == 1)
-            {
-              device_param->kernel_threads_min = fixed_local_size;
-              // device_param->kernel_threads_max = fixed_local_size;
-
-              device_param->overtune_unfriendly = true;
-            }
-          }
-        }
-      }
-
-      build_options_module_buf[build_options_module_len] = 0;
-
-      #if defined (DEBUG)
-      if (user_options->quiet == false) event_log_warning (hashcat_ctx, "* Device #%u: build_options_module '%s'", device_id + 1, build_options_module_buf);
+      #if defined (__APPLE__)
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, &device_param->metal_library_amp);
+      #else
+      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, NULL);
       #endif
 
-      /**
-       * device_name_chksum
-       */
-
-      char device_name_chksum[HCBUFSIZ_TINY] = { 0 };
-
-      // The kernel source can depend on some JiT compiler macros which themself depend on the attack_modes.
-      // ATM this is relevant only for ATTACK_MODE_ASSOCIATION which slightly modifies ATTACK_MODE_STRAIGHT kernels.
-
-      const u32 extra_value = (user_options->attack_mode == ATTACK_MODE_ASSOCIATION) ? ATTACK_MODE_ASSOCIATION : ATTACK_MODE_NONE;
-
-      const size_t dnclen = snprintf (device_name_chksum, HCBUFSIZ_TINY, "%d-%d-%d-%u-%u-%u-%s-%d-%u-%s-%s-%s-%d-%u-%u-%u-%u-%s",
-        backend_ctx->comptime,
-        backend_ctx->cuda_driver_version,
-        backend_ctx->hip_runtimeVersion,
-        backend_ctx->metal_runtimeVersion,
-        device_param->sm_major,
-        device_param->sm_minor,
-        (device_param->is_hip == true) ? device_param->gcnArchName : "",
-        device_param->is_opencl,
-        device_param->opencl_platform_vendor_id,
-        device_param->device_name,
-        device_param->opencl_device_version,
-        device_param->opencl_driver_version,
-        device_param->vector_width,
-        hashconfig->kern_type,
-        extra_value,
-        (user_options->kernel_threads_chgd == true) ? user_options->kernel_threads : device_param->kernel_threads_max,
-        get_current_arch(),
-        build_options_module_buf);
-
-      memset     (&md5_ctx, 0, sizeof (md5_ctx_t));
-      md5_init   (&md5_ctx);
-      md5_update (&md5_ctx, (u32 *) device_name_chksum, dnclen);
-      md5_final  (&md5_ctx);
-
-      snprintf (device_name_chksum, HCBUFSIZ_TINY, "%08x", md5_ctx.h[0]);
-
-      /**
-       * kernel source filename
-       */
-
-      char source_file[256] = { 0 };
-
-      generate_source_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->shared_dir, source_file);
-
-      if (hc_path_read (source_file) == false)
+      if (rc_load_kernel == false)
       {
-        event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+        event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
 
         return -1;
       }
 
-      /**
-       * kernel cached filename
-       */
+      hcfree (build_options_buf);
+    }
+  }
 
-      char cached_file[256] = { 0 };
+  /**
+   * no more need for the compiler. cuda doesn't offer this function.
+   * from opencl specs:
+   * Calls to clBuildProgram, clCompileProgram or clLinkProgram after clUnloadPlatformCompiler will reload the compiler, if necessary, to build the appropriate program executable.
+   */
+  // Disabled after user reporting weird errors like CL_OUT_OF_HOST_MEMORY after calling
+  /*
+  if (device_param->is_opencl == true)
+  {
+    cl_platform_id platform_id = backend_ctx->opencl_platforms[device_param->opencl_platform_id];
 
-      generate_cached_kernel_filename (user_options->slow_candidates, hashconfig->attack_exec, user_options_extra->attack_kern, kern_type, hashconfig->opti_type, folder_config->cache_dir, device_name_chksum, cached_file, device_param->is_metal);
+    if (hc_clUnloadPlatformCompiler (hashcat_ctx, platform_id) == -1) return -1;
+  }
+  */
 
-      /**
-       * load kernel
-       */
+  // some algorithm collide too fast, make that impossible
 
-      #if defined (__APPLE__)
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, &device_param->metal_library);
-      #else
-      const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "main_kernel", source_file, cached_file, build_options_module_buf, cache_disable, &device_param->opencl_program, &device_param->cuda_module, &device_param->hip_module, NULL);
-      #endif
+  if (user_options->benchmark == true)
+  {
+    ((u32 *) hashes->digests_buf)[0] = -1U;
+    ((u32 *) hashes->digests_buf)[1] = -1U;
+    ((u32 *) hashes->digests_buf)[2] = -1U;
+    ((u32 *) hashes->digests_buf)[3] = -1U;
+  }
 
-      if (rc_load_kernel == false)
-      {
-        event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+  /**
+   * global buffers
+   */
 
-        backend_kernel_build_warnings++;
+  const u64 size_total_fixed
+    = bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + bitmap_ctx->bitmap_size
+    + size_plains
+    + size_digests
+    + size_shown
+    + size_salts
+    + size_results
+    + size_extra_buffer1
+    + size_extra_buffer2
+    + size_extra_buffer3
+    + size_extra_buffer4
+    + size_st_digests
+    + size_st_salts
+    + size_st_esalts
+    + size_esalts
+    + size_markov_css
+    + size_root_css
+    + size_rules
+    + size_rules_c
+    + size_tm
+    + size_kernel_params;
+
+  if (size_total_fixed > device_param->device_available_mem)
+  {
+    event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory for this hashlist/ruleset.", device_id + 1);
 
-        device_param->skipped_warning = true;
-        continue;
-      }
+    session_param->memory_hit_warnings++;
 
-      hcfree (build_options_module_buf);
-    }
+    device_param->skipped_warning = true;
+    return 0;
+  }
+
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_plain_bufs,     size_plains)             == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_buf,    size_digests)            == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_shown,  size_shown)              == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_salt_bufs,      size_salts)              == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_result,         size_results)            == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra0_buf,     size_extra_buffer1)      == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra1_buf,     size_extra_buffer2)      == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra2_buf,     size_extra_buffer3)      == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra3_buf,     size_extra_buffer4)      == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_digests_buf, size_st_digests)         == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_salts_buf,   size_st_salts)           == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_kernel_param,   size_kernel_params)      == -1) return -1;
+
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
+    if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
 
     /**
-     * word generator kernel
+     * special buffers
      */
 
     if (user_options->slow_candidates == true)
     {
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
     }
     else
     {
-      if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_GENERIC) && (user_options->attack_mode != ATTACK_MODE_ASSOCIATION))
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
-        /**
-         * kernel mp source filename
-         */
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules,   size_rules) == -1) return -1;
+
+        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+        {
+          size_t dummy = 0;
 
-        char source_file[256] = { 0 };
+          if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_rules_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
+        }
+        else
+        {
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
+        }
 
-        generate_source_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->shared_dir, source_file);
+        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_rules, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+      {
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs,          size_combs)      == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs_c,        size_combs)      == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+      {
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs,            size_bfs)        == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
 
-        if (hc_path_read (source_file) == false)
+        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
         {
-          event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+          size_t dummy = 0;
 
-          return -1;
-        }
+          if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_bfs_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
 
-        /**
-         * kernel mp cached filename
-         */
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
+        }
+        else
+        {
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs_c,          size_bfs)      == -1) return -1;
+          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
+        }
+      }
+    }
 
-        char cached_file[256] = { 0 };
+    if (size_esalts)
+    {
+      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_esalt_bufs, size_esalts) == -1) return -1;
 
-        generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
+    }
 
-        #if defined (__APPLE__)
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, &device_param->metal_library_mp);
-        #else
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "mp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_mp, &device_param->cuda_module_mp, &device_param->hip_module_mp, NULL);
-        #endif
+    if (hashconfig->st_hash != NULL)
+    {
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
+      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts)   == -1) return -1;
 
-        if (rc_load_kernel == false)
-        {
-          event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
+      if (size_esalts)
+      {
+        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_esalts_buf, size_st_esalts) == -1) return -1;
 
-          return -1;
-        }
+        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
       }
     }
+  }
+
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_plain_bufs,     size_plains)             == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_digests_buf,    size_digests)            == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_digests_shown,  size_shown)              == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_salt_bufs,      size_salts)              == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_result,         size_results)            == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra0_buf,     size_extra_buffer1)      == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra1_buf,     size_extra_buffer2)      == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra2_buf,     size_extra_buffer3)      == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra3_buf,     size_extra_buffer4)      == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_digests_buf, size_st_digests)         == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_salts_buf,   size_st_salts)           == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_kernel_param,   size_kernel_params)      == -1) return -1;
+
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
+    if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
 
     /**
-     * amplifier kernel
+     * special buffers
      */
 
     if (user_options->slow_candidates == true)
     {
+      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
     }
     else
     {
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
-
-      }
-      else
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
-        /**
-         * kernel amp source filename
-         */
-
-        char source_file[256] = { 0 };
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_rules,   size_rules) == -1) return -1;
 
-        generate_source_kernel_amp_filename (user_options_extra->attack_kern, folder_config->shared_dir, source_file);
-
-        if (hc_path_read (source_file) == false)
+        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
         {
-          event_log_error (hashcat_ctx, "%s: %s", source_file, strerror (errno));
+          size_t dummy = 0;
 
-          return -1;
+          if (hc_hipModuleGetGlobal (hashcat_ctx, &device_param->hip_d_rules_c, &dummy, device_param->hip_module, "generic_constant") == -1) return -1;
+        }
+        else
+        {
+          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
         }
 
-        /**
-         * kernel amp cached filename
-         */
-
-        char cached_file[256] = { 0 };
+        if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_rules, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+      {
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_combs,          size_combs)      == -1) return -1;
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_combs_c,        size_combs)      == -1) return -1;
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_markov_css_buf, size_markov_css) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+      {
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bfs,            size_bfs)        == -1) return -1;
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_markov_css_buf, size_markov_css) == -1) return -1;
 
-        generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->cache_dir, device_name_chksum_amp_mp, cached_file, device_param->is_metal);
+        if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+        {
+          size_t dummy = 0;
 
-        #if defined (__APPLE__)
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, &device_param->metal_library_amp);
-        #else
-        const bool rc_load_kernel = load_kernel (hashcat_ctx, device_param, "amp_kernel", source_file, cached_file, build_options_buf, cache_disable, &device_param->opencl_program_amp, &device_param->cuda_module_amp, &device_param->hip_module_amp, NULL);
-        #endif
+          if (hc_hipModuleGetGlobal (hashcat_ctx, &device_param->hip_d_bfs_c, &dummy, device_param->hip_module, "generic_constant") == -1) return -1;
 
-        if (rc_load_kernel == false)
+          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_tm_c,           size_tm)       == -1) return -1;
+        }
+        else
         {
-          event_log_error (hashcat_ctx, "* Device #%u: Kernel %s build failed.", device_param->device_id + 1, source_file);
-
-          return -1;
+          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bfs_c,          size_bfs)      == -1) return -1;
+          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_tm_c,           size_tm)       == -1) return -1;
         }
-
-        hcfree (build_options_buf);
       }
     }
 
-    /**
-     * no more need for the compiler. cuda doesn't offer this function.
-     * from opencl specs:
-     * Calls to clBuildProgram, clCompileProgram or clLinkProgram after clUnloadPlatformCompiler will reload the compiler, if necessary, to build the appropriate program executable.
-     */
-    // Disabled after user reporting weird errors like CL_OUT_OF_HOST_MEMORY after calling
-    /*
-    if (device_param->is_opencl == true)
+    if (size_esalts)
     {
-      cl_platform_id platform_id = backend_ctx->opencl_platforms[device_param->opencl_platform_id];
+      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_esalt_bufs, size_esalts) == -1) return -1;
 
-      if (hc_clUnloadPlatformCompiler (hashcat_ctx, platform_id) == -1) return -1;
+      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
     }
-    */
 
-    // some algorithm collide too fast, make that impossible
-
-    if (user_options->benchmark == true)
+    if (hashconfig->st_hash != NULL)
     {
-      ((u32 *) hashes->digests_buf)[0] = -1U;
-      ((u32 *) hashes->digests_buf)[1] = -1U;
-      ((u32 *) hashes->digests_buf)[2] = -1U;
-      ((u32 *) hashes->digests_buf)[3] = -1U;
+      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
+      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts) == -1) return -1;
+
+      if (size_esalts)
+      {
+        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_esalts_buf, size_st_esalts) == -1) return -1;
+
+        if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
+      }
     }
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_a);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_b);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_c);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_d);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_a);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_b);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_c);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_d);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_plains,             NULL, plain_bufs);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_digests,            NULL, digests_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_shown,              NULL, digests_shown);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_salts,              NULL, salt_bufs);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_results,            NULL, result);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer1,      NULL, extra0_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer2,      NULL, extra1_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer3,      NULL, extra2_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer4,      NULL, extra3_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_digests,         NULL, st_digests_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_salts,           NULL, st_salts_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_kernel_params,      NULL, kernel_param);
+
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_a, 0, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_b, 0, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_c, 0, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_d, 0, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_a, 0, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_b, 0, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_c, 0, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_d, 0, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_digests_buf, 0, hashes->digests_buf,     size_digests)            == -1) return -1;
+    if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_salt_bufs,   0, hashes->salts_buf,       size_salts)              == -1) return -1;
 
     /**
-     * global buffers
+     * special buffers
      */
 
-    const u64 size_total_fixed
-      = bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + bitmap_ctx->bitmap_size
-      + size_plains
-      + size_digests
-      + size_shown
-      + size_salts
-      + size_results
-      + size_extra_buffer1
-      + size_extra_buffer2
-      + size_extra_buffer3
-      + size_extra_buffer4
-      + size_st_digests
-      + size_st_salts
-      + size_st_esalts
-      + size_esalts
-      + size_markov_css
-      + size_root_css
-      + size_rules
-      + size_rules_c
-      + size_tm
-      + size_kernel_params;
-
-    if (size_total_fixed > device_param->device_available_mem)
+    if (user_options->slow_candidates == true)
     {
-      event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory for this hashlist/ruleset.", device_id + 1);
-
-      backend_memory_hit_warnings++;
-
-      device_param->skipped_warning = true;
-      continue;
+      HC_MTL_CREATEBUFFER(hashcat_ctx, size_rules_c,          NULL, rules_c);
     }
-
-    if (device_param->is_cuda == true)
+    else
     {
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_plain_bufs,     size_plains)             == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_buf,    size_digests)            == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_digests_shown,  size_shown)              == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_salt_bufs,      size_salts)              == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_result,         size_results)            == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra0_buf,     size_extra_buffer1)      == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra1_buf,     size_extra_buffer2)      == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra2_buf,     size_extra_buffer3)      == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_extra3_buf,     size_extra_buffer4)      == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_digests_buf, size_st_digests)         == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_salts_buf,   size_st_salts)           == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_kernel_param,   size_kernel_params)      == -1) return -1;
-
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
-      if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
-
-      /**
-       * special buffers
-       */
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+      {
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_rules,          NULL, rules);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_rules_c,        NULL, rules_c);
 
-      if (user_options->slow_candidates == true)
+        if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_rules, 0, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs_c);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules,   size_rules) == -1) return -1;
-
-          if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-          {
-            size_t dummy = 0;
-
-            if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_rules_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
-          }
-          else
-          {
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
-          }
-
-          if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_rules, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs,          size_combs)      == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_combs_c,        size_combs)      == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs,            size_bfs)        == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_markov_css_buf, size_markov_css) == -1) return -1;
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs_c);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_tm,             NULL, tm_c);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
+      }
+    }
 
-          if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-          {
-            size_t dummy = 0;
+    if (size_esalts)
+    {
+      HC_MTL_CREATEBUFFER(hashcat_ctx, size_esalts,           NULL, esalt_bufs);
 
-            if (hc_cuModuleGetGlobal (hashcat_ctx, &device_param->cuda_d_bfs_c, &dummy, device_param->cuda_module, "generic_constant") == -1) return -1;
+      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_esalt_bufs, 0, hashes->esalts_buf, size_esalts) == -1) return -1;
+    }
 
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
-          }
-          else
-          {
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_bfs_c,          size_bfs)      == -1) return -1;
-            if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tm_c,           size_tm)       == -1) return -1;
-          }
-        }
-      }
+    if (hashconfig->st_hash != NULL)
+    {
+      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_st_digests_buf, 0, hashes->st_digests_buf, size_st_digests) == -1) return -1;
+      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_st_salts_buf, 0, hashes->st_salts_buf, size_st_salts) == -1) return -1;
 
       if (size_esalts)
       {
-        if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_esalt_bufs, size_esalts) == -1) return -1;
+        HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_esalts,      NULL, st_esalts_buf);
 
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
+        if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_st_esalts_buf, 0, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
       }
+    }
+  }
+  #endif // __APPLE__
 
-      if (hashconfig->st_hash != NULL)
-      {
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
-        if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts)   == -1) return -1;
+  if (device_param->is_opencl == true)
+  {
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_a);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_b);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_c);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_d);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_a);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_b);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_c);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_d);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_plains,             NULL, plain_bufs);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_digests,            NULL, digests_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_shown,              NULL, digests_shown);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_salts,              NULL, salt_bufs);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_results,            NULL, result);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer1,      NULL, extra0_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer2,      NULL, extra1_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer3,      NULL, extra2_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer4,      NULL, extra3_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_digests,         NULL, st_digests_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_salts,           NULL, st_salts_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_kernel_params,      NULL, kernel_param);
+
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_a, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_b, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_c, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_d, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_a, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_b, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_c, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_d, 0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_digests_buf, CL_TRUE, 0, size_digests,            hashes->digests_buf,     0, NULL, NULL) == -1) return -1;
+    if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_salt_bufs,   CL_TRUE, 0, size_salts,              hashes->salts_buf,       0, NULL, NULL) == -1) return -1;
 
-        if (size_esalts)
-        {
-          if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_st_esalts_buf, size_st_esalts) == -1) return -1;
+    /**
+     * special buffers
+     */
 
-          if (hc_cuMemcpyHtoD (hashcat_ctx, device_param->cuda_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
-        }
-      }
+    if (user_options->slow_candidates == true)
+    {
+      HC_OCL_CREATEBUFFER(hashcat_ctx, size_rules_c,          NULL, rules_c);
     }
-
-    if (device_param->is_hip == true)
+    else
     {
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_a,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_b,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_c,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s1_d,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_a,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_b,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_c,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bitmap_s2_d,    bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_plain_bufs,     size_plains)             == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_digests_buf,    size_digests)            == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_digests_shown,  size_shown)              == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_salt_bufs,      size_salts)              == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_result,         size_results)            == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra0_buf,     size_extra_buffer1)      == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra1_buf,     size_extra_buffer2)      == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra2_buf,     size_extra_buffer3)      == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_extra3_buf,     size_extra_buffer4)      == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_digests_buf, size_st_digests)         == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_salts_buf,   size_st_salts)           == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_kernel_param,   size_kernel_params)      == -1) return -1;
-
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_a, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_b, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_c, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s1_d, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_a, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_b, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_c, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_bitmap_s2_d, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_digests_buf, hashes->digests_buf,     size_digests)            == -1) return -1;
-      if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_salt_bufs,   hashes->salts_buf,       size_salts)              == -1) return -1;
-
-      /**
-       * special buffers
-       */
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+      {
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_rules,          NULL, rules);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_rules_c,        NULL, rules_c);
 
-      if (user_options->slow_candidates == true)
+        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules,   CL_TRUE, 0, size_rules_src, straight_ctx->kernel_rules_buf, 0, NULL, NULL) == -1) return -1;
+      }
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs_c);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_rules,   size_rules) == -1) return -1;
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs_c);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_tm,             NULL, tm_c);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
+      }
+    }
 
-          if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-          {
-            size_t dummy = 0;
+    if (size_esalts)
+    {
+      HC_OCL_CREATEBUFFER(hashcat_ctx, size_esalts,           NULL, esalt_bufs);
 
-            if (hc_hipModuleGetGlobal (hashcat_ctx, &device_param->hip_d_rules_c, &dummy, device_param->hip_module, "generic_constant") == -1) return -1;
-          }
-          else
-          {
-            if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
-          }
-
-          if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_rules, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_combs,          size_combs)      == -1) return -1;
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_combs_c,        size_combs)      == -1) return -1;
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_markov_css_buf, size_markov_css) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bfs,            size_bfs)        == -1) return -1;
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_markov_css_buf, size_markov_css) == -1) return -1;
-
-          if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-          {
-            size_t dummy = 0;
-
-            if (hc_hipModuleGetGlobal (hashcat_ctx, &device_param->hip_d_bfs_c, &dummy, device_param->hip_module, "generic_constant") == -1) return -1;
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_esalt_bufs,      CL_TRUE, 0, size_esalts,     hashes->esalts_buf,      0, NULL, NULL) == -1) return -1;
+    }
 
-            if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_tm_c,           size_tm)       == -1) return -1;
-          }
-          else
-          {
-            if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_bfs_c,          size_bfs)      == -1) return -1;
-            if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_tm_c,           size_tm)       == -1) return -1;
-          }
-        }
-      }
+    if (hashconfig->st_hash != NULL)
+    {
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_digests_buf,  CL_TRUE, 0, size_st_digests, hashes->st_digests_buf,  0, NULL, NULL) == -1) return -1;
+      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_salts_buf,    CL_TRUE, 0, size_st_salts,   hashes->st_salts_buf,    0, NULL, NULL) == -1) return -1;
 
       if (size_esalts)
       {
-        if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_esalt_bufs, size_esalts) == -1) return -1;
+        HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_esalts,      NULL, st_esalts_buf);
 
-        if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_esalt_bufs, hashes->esalts_buf, size_esalts) == -1) return -1;
-      }
-
-      if (hashconfig->st_hash != NULL)
-      {
-        if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_st_digests_buf, hashes->st_digests_buf, size_st_digests) == -1) return -1;
-        if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_st_salts_buf,   hashes->st_salts_buf,   size_st_salts) == -1) return -1;
-
-        if (size_esalts)
-        {
-          if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_st_esalts_buf, size_st_esalts) == -1) return -1;
-
-          if (hc_hipMemcpyHtoD (hashcat_ctx, device_param->hip_d_st_esalts_buf, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
-        }
+        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_esalts_buf, CL_TRUE, 0, size_st_esalts,  hashes->st_esalts_buf,   0, NULL, NULL) == -1) return -1;
       }
     }
 
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
-    {
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_a);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_b);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_c);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_d);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_a);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_b);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_c);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_d);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_plains,             NULL, plain_bufs);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_digests,            NULL, digests_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_shown,              NULL, digests_shown);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_salts,              NULL, salt_bufs);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_results,            NULL, result);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer1,      NULL, extra0_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer2,      NULL, extra1_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer3,      NULL, extra2_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_extra_buffer4,      NULL, extra3_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_digests,         NULL, st_digests_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_salts,           NULL, st_salts_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_kernel_params,      NULL, kernel_param);
-
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_a, 0, bitmap_ctx->bitmap_s1_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_b, 0, bitmap_ctx->bitmap_s1_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_c, 0, bitmap_ctx->bitmap_s1_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s1_d, 0, bitmap_ctx->bitmap_s1_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_a, 0, bitmap_ctx->bitmap_s2_a, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_b, 0, bitmap_ctx->bitmap_s2_b, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_c, 0, bitmap_ctx->bitmap_s2_c, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_bitmap_s2_d, 0, bitmap_ctx->bitmap_s2_d, bitmap_ctx->bitmap_size) == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_digests_buf, 0, hashes->digests_buf,     size_digests)            == -1) return -1;
-      if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_salt_bufs,   0, hashes->salts_buf,       size_salts)              == -1) return -1;
-
-      /**
-       * special buffers
-       */
+    if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
+  }
 
-      if (user_options->slow_candidates == true)
-      {
-        HC_MTL_CREATEBUFFER(hashcat_ctx, size_rules_c,          NULL, rules_c);
-      }
-      else
-      {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_rules,          NULL, rules);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_rules_c,        NULL, rules_c);
+  /**
+   * kernel args
+   */
 
-          if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_rules, 0, straight_ctx->kernel_rules_buf, size_rules_src) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs_c);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs_c);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_tm,             NULL, tm_c);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
-        }
-      }
+  device_param->kernel_param.bitmap_mask         = bitmap_ctx->bitmap_mask;
+  device_param->kernel_param.bitmap_shift1       = bitmap_ctx->bitmap_shift1;
+  device_param->kernel_param.bitmap_shift2       = bitmap_ctx->bitmap_shift2;
+  device_param->kernel_param.salt_pos_host       = 0;
+  device_param->kernel_param.loop_pos            = 0;
+  device_param->kernel_param.loop_cnt            = 0;
+  device_param->kernel_param.il_cnt              = 0;
+  device_param->kernel_param.digests_cnt         = 0;
+  device_param->kernel_param.digests_offset_host = 0;
+  device_param->kernel_param.combs_mode          = 0;
+  device_param->kernel_param.salt_repeat         = 0;
+  device_param->kernel_param.combs_mode          = 0;
+  device_param->kernel_param.salt_repeat         = 0;
+  device_param->kernel_param.pws_pos             = 0;
+  device_param->kernel_param.gid_max             = 0;
 
-      if (size_esalts)
-      {
-        HC_MTL_CREATEBUFFER(hashcat_ctx, size_esalts,           NULL, esalt_bufs);
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params[ 0] = NULL; // &device_param->cuda_d_pws_buf;
+    device_param->kernel_params[ 1] = &device_param->cuda_d_rules_c;
+    device_param->kernel_params[ 2] = &device_param->cuda_d_combs_c;
+    device_param->kernel_params[ 3] = &device_param->cuda_d_bfs_c;
+    device_param->kernel_params[ 4] = NULL; // &device_param->cuda_d_tmps;
+    device_param->kernel_params[ 5] = NULL; // &device_param->cuda_d_hooks;
+    device_param->kernel_params[ 6] = &device_param->cuda_d_bitmap_s1_a;
+    device_param->kernel_params[ 7] = &device_param->cuda_d_bitmap_s1_b;
+    device_param->kernel_params[ 8] = &device_param->cuda_d_bitmap_s1_c;
+    device_param->kernel_params[ 9] = &device_param->cuda_d_bitmap_s1_d;
+    device_param->kernel_params[10] = &device_param->cuda_d_bitmap_s2_a;
+    device_param->kernel_params[11] = &device_param->cuda_d_bitmap_s2_b;
+    device_param->kernel_params[12] = &device_param->cuda_d_bitmap_s2_c;
+    device_param->kernel_params[13] = &device_param->cuda_d_bitmap_s2_d;
+    device_param->kernel_params[14] = &device_param->cuda_d_plain_bufs;
+    device_param->kernel_params[15] = &device_param->cuda_d_digests_buf;
+    device_param->kernel_params[16] = &device_param->cuda_d_digests_shown;
+    device_param->kernel_params[17] = &device_param->cuda_d_salt_bufs;
+    device_param->kernel_params[18] = &device_param->cuda_d_esalt_bufs;
+    device_param->kernel_params[19] = &device_param->cuda_d_result;
+    device_param->kernel_params[20] = &device_param->cuda_d_extra0_buf;
+    device_param->kernel_params[21] = &device_param->cuda_d_extra1_buf;
+    device_param->kernel_params[22] = &device_param->cuda_d_extra2_buf;
+    device_param->kernel_params[23] = &device_param->cuda_d_extra3_buf;
+    device_param->kernel_params[24] = &device_param->cuda_d_kernel_param;
+  }
 
-        if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_esalt_bufs, 0, hashes->esalts_buf, size_esalts) == -1) return -1;
-      }
+  if (device_param->is_hip == true)
+  {
+    device_param->kernel_params[ 0] = NULL; // &device_param->hip_d_pws_buf;
+    device_param->kernel_params[ 1] = &device_param->hip_d_rules_c;
+    device_param->kernel_params[ 2] = &device_param->hip_d_combs_c;
+    device_param->kernel_params[ 3] = &device_param->hip_d_bfs_c;
+    device_param->kernel_params[ 4] = NULL; // &device_param->hip_d_tmps;
+    device_param->kernel_params[ 5] = NULL; // &device_param->hip_d_hooks;
+    device_param->kernel_params[ 6] = &device_param->hip_d_bitmap_s1_a;
+    device_param->kernel_params[ 7] = &device_param->hip_d_bitmap_s1_b;
+    device_param->kernel_params[ 8] = &device_param->hip_d_bitmap_s1_c;
+    device_param->kernel_params[ 9] = &device_param->hip_d_bitmap_s1_d;
+    device_param->kernel_params[10] = &device_param->hip_d_bitmap_s2_a;
+    device_param->kernel_params[11] = &device_param->hip_d_bitmap_s2_b;
+    device_param->kernel_params[12] = &device_param->hip_d_bitmap_s2_c;
+    device_param->kernel_params[13] = &device_param->hip_d_bitmap_s2_d;
+    device_param->kernel_params[14] = &device_param->hip_d_plain_bufs;
+    device_param->kernel_params[15] = &device_param->hip_d_digests_buf;
+    device_param->kernel_params[16] = &device_param->hip_d_digests_shown;
+    device_param->kernel_params[17] = &device_param->hip_d_salt_bufs;
+    device_param->kernel_params[18] = &device_param->hip_d_esalt_bufs;
+    device_param->kernel_params[19] = &device_param->hip_d_result;
+    device_param->kernel_params[20] = &device_param->hip_d_extra0_buf;
+    device_param->kernel_params[21] = &device_param->hip_d_extra1_buf;
+    device_param->kernel_params[22] = &device_param->hip_d_extra2_buf;
+    device_param->kernel_params[23] = &device_param->hip_d_extra3_buf;
+    device_param->kernel_params[24] = &device_param->hip_d_kernel_param;
+  }
 
-      if (hashconfig->st_hash != NULL)
-      {
-        if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_st_digests_buf, 0, hashes->st_digests_buf, size_st_digests) == -1) return -1;
-        if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_st_salts_buf, 0, hashes->st_salts_buf, size_st_salts) == -1) return -1;
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    device_param->kernel_params[ 0] = NULL; // device_param->metal_d_pws_buf;
+    device_param->kernel_params[ 1] = device_param->metal_d_rules_c.buf_ptr;
+    device_param->kernel_params[ 2] = device_param->metal_d_combs_c.buf_ptr;
+    device_param->kernel_params[ 3] = device_param->metal_d_bfs_c.buf_ptr;
+    device_param->kernel_params[ 4] = NULL; // device_param->metal_d_tmps;
+    device_param->kernel_params[ 5] = NULL; // device_param->metal_d_hooks;
+    device_param->kernel_params[ 6] = device_param->metal_d_bitmap_s1_a.buf_ptr;
+    device_param->kernel_params[ 7] = device_param->metal_d_bitmap_s1_b.buf_ptr;
+    device_param->kernel_params[ 8] = device_param->metal_d_bitmap_s1_c.buf_ptr;
+    device_param->kernel_params[ 9] = device_param->metal_d_bitmap_s1_d.buf_ptr;
+    device_param->kernel_params[10] = device_param->metal_d_bitmap_s2_a.buf_ptr;
+    device_param->kernel_params[11] = device_param->metal_d_bitmap_s2_b.buf_ptr;
+    device_param->kernel_params[12] = device_param->metal_d_bitmap_s2_c.buf_ptr;
+    device_param->kernel_params[13] = device_param->metal_d_bitmap_s2_d.buf_ptr;
+    device_param->kernel_params[14] = device_param->metal_d_plain_bufs.buf_ptr;
+    device_param->kernel_params[15] = device_param->metal_d_digests_buf.buf_ptr;
+    device_param->kernel_params[16] = device_param->metal_d_digests_shown.buf_ptr;
+    device_param->kernel_params[17] = device_param->metal_d_salt_bufs.buf_ptr;
+    device_param->kernel_params[18] = device_param->metal_d_esalt_bufs.buf_ptr;
+    device_param->kernel_params[19] = device_param->metal_d_result.buf_ptr;
+    device_param->kernel_params[20] = device_param->metal_d_extra0_buf.buf_ptr;
+    device_param->kernel_params[21] = device_param->metal_d_extra1_buf.buf_ptr;
+    device_param->kernel_params[22] = device_param->metal_d_extra2_buf.buf_ptr;
+    device_param->kernel_params[23] = device_param->metal_d_extra3_buf.buf_ptr;
+    device_param->kernel_params[24] = device_param->metal_d_kernel_param.buf_ptr;
+  }
+  #endif // __APPLE__
 
-        if (size_esalts)
-        {
-          HC_MTL_CREATEBUFFER(hashcat_ctx, size_st_esalts,      NULL, st_esalts_buf);
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params[ 0] = NULL; // &device_param->opencl_d_pws_buf;
+    device_param->kernel_params[ 1] = &device_param->opencl_d_rules_c;
+    device_param->kernel_params[ 2] = &device_param->opencl_d_combs_c;
+    device_param->kernel_params[ 3] = &device_param->opencl_d_bfs_c;
+    device_param->kernel_params[ 4] = NULL; // &device_param->opencl_d_tmps;
+    device_param->kernel_params[ 5] = NULL; // &device_param->opencl_d_hooks;
+    device_param->kernel_params[ 6] = &device_param->opencl_d_bitmap_s1_a;
+    device_param->kernel_params[ 7] = &device_param->opencl_d_bitmap_s1_b;
+    device_param->kernel_params[ 8] = &device_param->opencl_d_bitmap_s1_c;
+    device_param->kernel_params[ 9] = &device_param->opencl_d_bitmap_s1_d;
+    device_param->kernel_params[10] = &device_param->opencl_d_bitmap_s2_a;
+    device_param->kernel_params[11] = &device_param->opencl_d_bitmap_s2_b;
+    device_param->kernel_params[12] = &device_param->opencl_d_bitmap_s2_c;
+    device_param->kernel_params[13] = &device_param->opencl_d_bitmap_s2_d;
+    device_param->kernel_params[14] = &device_param->opencl_d_plain_bufs;
+    device_param->kernel_params[15] = &device_param->opencl_d_digests_buf;
+    device_param->kernel_params[16] = &device_param->opencl_d_digests_shown;
+    device_param->kernel_params[17] = &device_param->opencl_d_salt_bufs;
+    device_param->kernel_params[18] = &device_param->opencl_d_esalt_bufs;
+    device_param->kernel_params[19] = &device_param->opencl_d_result;
+    device_param->kernel_params[20] = &device_param->opencl_d_extra0_buf;
+    device_param->kernel_params[21] = &device_param->opencl_d_extra1_buf;
+    device_param->kernel_params[22] = &device_param->opencl_d_extra2_buf;
+    device_param->kernel_params[23] = &device_param->opencl_d_extra3_buf;
+    device_param->kernel_params[24] = &device_param->opencl_d_kernel_param;
+  }
 
-          if (hc_mtlMemcpyHtoD (hashcat_ctx, device_param->metal_device, device_param->metal_command_queue, device_param->metal_d_st_esalts_buf, 0, hashes->st_esalts_buf, size_st_esalts) == -1) return -1;
-        }
-      }
-    }
-    #endif // __APPLE__
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    device_param->kernel_params_mp_buf64[3] = 0;
+    device_param->kernel_params_mp_buf32[4] = 0;
+    device_param->kernel_params_mp_buf32[5] = 0;
+    device_param->kernel_params_mp_buf32[6] = 0;
+    device_param->kernel_params_mp_buf32[7] = 0;
+    device_param->kernel_params_mp_buf64[8] = 0;
 
-    if (device_param->is_opencl == true)
+    if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
     {
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_a);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_b);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_c);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s1_d);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_a);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_b);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_c);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, bitmap_ctx->bitmap_size, NULL, bitmap_s2_d);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_plains,             NULL, plain_bufs);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_digests,            NULL, digests_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_shown,              NULL, digests_shown);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_salts,              NULL, salt_bufs);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_results,            NULL, result);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer1,      NULL, extra0_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer2,      NULL, extra1_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer3,      NULL, extra2_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_extra_buffer4,      NULL, extra3_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_digests,         NULL, st_digests_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_salts,           NULL, st_salts_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_kernel_params,      NULL, kernel_param);
-
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_a, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_b, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_c, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s1_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_d, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_a, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_a, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_b, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_b, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_c, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_c, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_bitmap_s2_d, CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_d, 0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_digests_buf, CL_TRUE, 0, size_digests,            hashes->digests_buf,     0, NULL, NULL) == -1) return -1;
-      if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_salt_bufs,   CL_TRUE, 0, size_salts,              hashes->salts_buf,       0, NULL, NULL) == -1) return -1;
-
-      /**
-       * special buffers
-       */
-
-      if (user_options->slow_candidates == true)
+      if (device_param->is_cuda == true)
       {
-        HC_OCL_CREATEBUFFER(hashcat_ctx, size_rules_c,          NULL, rules_c);
+        device_param->kernel_params_mp[0] = &device_param->cuda_d_combs;
       }
-      else
-      {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_rules,          NULL, rules);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_rules_c,        NULL, rules_c);
 
-          if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_rules,   CL_TRUE, 0, size_rules_src, straight_ctx->kernel_rules_buf, 0, NULL, NULL) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_combs,          NULL, combs_c);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_bfs,            NULL, bfs_c);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_tm,             NULL, tm_c);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_root_css,       NULL, root_css_buf);
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_markov_css,     NULL, markov_css_buf);
-        }
+      if (device_param->is_hip == true)
+      {
+        device_param->kernel_params_mp[0] = &device_param->hip_d_combs;
       }
 
-      if (size_esalts)
+      #if defined (__APPLE__)
+      if (device_param->is_metal == true)
       {
-        HC_OCL_CREATEBUFFER(hashcat_ctx, size_esalts,           NULL, esalt_bufs);
-
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_esalt_bufs,      CL_TRUE, 0, size_esalts,     hashes->esalts_buf,      0, NULL, NULL) == -1) return -1;
+        device_param->kernel_params_mp[0] = device_param->metal_d_combs.buf_ptr;
       }
+      #endif
 
-      if (hashconfig->st_hash != NULL)
+      if (device_param->is_opencl == true)
       {
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_digests_buf,  CL_TRUE, 0, size_st_digests, hashes->st_digests_buf,  0, NULL, NULL) == -1) return -1;
-        if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_salts_buf,    CL_TRUE, 0, size_st_salts,   hashes->st_salts_buf,    0, NULL, NULL) == -1) return -1;
-
-        if (size_esalts)
-        {
-          HC_OCL_CREATEBUFFER(hashcat_ctx, size_st_esalts,      NULL, st_esalts_buf);
-
-          if (hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->opencl_command_queue, device_param->opencl_d_st_esalts_buf, CL_TRUE, 0, size_st_esalts,  hashes->st_esalts_buf,   0, NULL, NULL) == -1) return -1;
-        }
+        device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
       }
-
-      if (hc_clFlush (hashcat_ctx, device_param->opencl_command_queue) == -1) return -1;
-    }
-
-    /**
-     * kernel args
-     */
-
-    device_param->kernel_param.bitmap_mask         = bitmap_ctx->bitmap_mask;
-    device_param->kernel_param.bitmap_shift1       = bitmap_ctx->bitmap_shift1;
-    device_param->kernel_param.bitmap_shift2       = bitmap_ctx->bitmap_shift2;
-    device_param->kernel_param.salt_pos_host       = 0;
-    device_param->kernel_param.loop_pos            = 0;
-    device_param->kernel_param.loop_cnt            = 0;
-    device_param->kernel_param.il_cnt              = 0;
-    device_param->kernel_param.digests_cnt         = 0;
-    device_param->kernel_param.digests_offset_host = 0;
-    device_param->kernel_param.combs_mode          = 0;
-    device_param->kernel_param.salt_repeat         = 0;
-    device_param->kernel_param.combs_mode          = 0;
-    device_param->kernel_param.salt_repeat         = 0;
-    device_param->kernel_param.pws_pos             = 0;
-    device_param->kernel_param.gid_max             = 0;
-
-    if (device_param->is_cuda == true)
-    {
-      device_param->kernel_params[ 0] = NULL; // &device_param->cuda_d_pws_buf;
-      device_param->kernel_params[ 1] = &device_param->cuda_d_rules_c;
-      device_param->kernel_params[ 2] = &device_param->cuda_d_combs_c;
-      device_param->kernel_params[ 3] = &device_param->cuda_d_bfs_c;
-      device_param->kernel_params[ 4] = NULL; // &device_param->cuda_d_tmps;
-      device_param->kernel_params[ 5] = NULL; // &device_param->cuda_d_hooks;
-      device_param->kernel_params[ 6] = &device_param->cuda_d_bitmap_s1_a;
-      device_param->kernel_params[ 7] = &device_param->cuda_d_bitmap_s1_b;
-      device_param->kernel_params[ 8] = &device_param->cuda_d_bitmap_s1_c;
-      device_param->kernel_params[ 9] = &device_param->cuda_d_bitmap_s1_d;
-      device_param->kernel_params[10] = &device_param->cuda_d_bitmap_s2_a;
-      device_param->kernel_params[11] = &device_param->cuda_d_bitmap_s2_b;
-      device_param->kernel_params[12] = &device_param->cuda_d_bitmap_s2_c;
-      device_param->kernel_params[13] = &device_param->cuda_d_bitmap_s2_d;
-      device_param->kernel_params[14] = &device_param->cuda_d_plain_bufs;
-      device_param->kernel_params[15] = &device_param->cuda_d_digests_buf;
-      device_param->kernel_params[16] = &device_param->cuda_d_digests_shown;
-      device_param->kernel_params[17] = &device_param->cuda_d_salt_bufs;
-      device_param->kernel_params[18] = &device_param->cuda_d_esalt_bufs;
-      device_param->kernel_params[19] = &device_param->cuda_d_result;
-      device_param->kernel_params[20] = &device_param->cuda_d_extra0_buf;
-      device_param->kernel_params[21] = &device_param->cuda_d_extra1_buf;
-      device_param->kernel_params[22] = &device_param->cuda_d_extra2_buf;
-      device_param->kernel_params[23] = &device_param->cuda_d_extra3_buf;
-      device_param->kernel_params[24] = &device_param->cuda_d_kernel_param;
-    }
-
-    if (device_param->is_hip == true)
-    {
-      device_param->kernel_params[ 0] = NULL; // &device_param->hip_d_pws_buf;
-      device_param->kernel_params[ 1] = &device_param->hip_d_rules_c;
-      device_param->kernel_params[ 2] = &device_param->hip_d_combs_c;
-      device_param->kernel_params[ 3] = &device_param->hip_d_bfs_c;
-      device_param->kernel_params[ 4] = NULL; // &device_param->hip_d_tmps;
-      device_param->kernel_params[ 5] = NULL; // &device_param->hip_d_hooks;
-      device_param->kernel_params[ 6] = &device_param->hip_d_bitmap_s1_a;
-      device_param->kernel_params[ 7] = &device_param->hip_d_bitmap_s1_b;
-      device_param->kernel_params[ 8] = &device_param->hip_d_bitmap_s1_c;
-      device_param->kernel_params[ 9] = &device_param->hip_d_bitmap_s1_d;
-      device_param->kernel_params[10] = &device_param->hip_d_bitmap_s2_a;
-      device_param->kernel_params[11] = &device_param->hip_d_bitmap_s2_b;
-      device_param->kernel_params[12] = &device_param->hip_d_bitmap_s2_c;
-      device_param->kernel_params[13] = &device_param->hip_d_bitmap_s2_d;
-      device_param->kernel_params[14] = &device_param->hip_d_plain_bufs;
-      device_param->kernel_params[15] = &device_param->hip_d_digests_buf;
-      device_param->kernel_params[16] = &device_param->hip_d_digests_shown;
-      device_param->kernel_params[17] = &device_param->hip_d_salt_bufs;
-      device_param->kernel_params[18] = &device_param->hip_d_esalt_bufs;
-      device_param->kernel_params[19] = &device_param->hip_d_result;
-      device_param->kernel_params[20] = &device_param->hip_d_extra0_buf;
-      device_param->kernel_params[21] = &device_param->hip_d_extra1_buf;
-      device_param->kernel_params[22] = &device_param->hip_d_extra2_buf;
-      device_param->kernel_params[23] = &device_param->hip_d_extra3_buf;
-      device_param->kernel_params[24] = &device_param->hip_d_kernel_param;
-    }
-
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
-    {
-      device_param->kernel_params[ 0] = NULL; // device_param->metal_d_pws_buf;
-      device_param->kernel_params[ 1] = device_param->metal_d_rules_c.buf_ptr;
-      device_param->kernel_params[ 2] = device_param->metal_d_combs_c.buf_ptr;
-      device_param->kernel_params[ 3] = device_param->metal_d_bfs_c.buf_ptr;
-      device_param->kernel_params[ 4] = NULL; // device_param->metal_d_tmps;
-      device_param->kernel_params[ 5] = NULL; // device_param->metal_d_hooks;
-      device_param->kernel_params[ 6] = device_param->metal_d_bitmap_s1_a.buf_ptr;
-      device_param->kernel_params[ 7] = device_param->metal_d_bitmap_s1_b.buf_ptr;
-      device_param->kernel_params[ 8] = device_param->metal_d_bitmap_s1_c.buf_ptr;
-      device_param->kernel_params[ 9] = device_param->metal_d_bitmap_s1_d.buf_ptr;
-      device_param->kernel_params[10] = device_param->metal_d_bitmap_s2_a.buf_ptr;
-      device_param->kernel_params[11] = device_param->metal_d_bitmap_s2_b.buf_ptr;
-      device_param->kernel_params[12] = device_param->metal_d_bitmap_s2_c.buf_ptr;
-      device_param->kernel_params[13] = device_param->metal_d_bitmap_s2_d.buf_ptr;
-      device_param->kernel_params[14] = device_param->metal_d_plain_bufs.buf_ptr;
-      device_param->kernel_params[15] = device_param->metal_d_digests_buf.buf_ptr;
-      device_param->kernel_params[16] = device_param->metal_d_digests_shown.buf_ptr;
-      device_param->kernel_params[17] = device_param->metal_d_salt_bufs.buf_ptr;
-      device_param->kernel_params[18] = device_param->metal_d_esalt_bufs.buf_ptr;
-      device_param->kernel_params[19] = device_param->metal_d_result.buf_ptr;
-      device_param->kernel_params[20] = device_param->metal_d_extra0_buf.buf_ptr;
-      device_param->kernel_params[21] = device_param->metal_d_extra1_buf.buf_ptr;
-      device_param->kernel_params[22] = device_param->metal_d_extra2_buf.buf_ptr;
-      device_param->kernel_params[23] = device_param->metal_d_extra3_buf.buf_ptr;
-      device_param->kernel_params[24] = device_param->metal_d_kernel_param.buf_ptr;
-    }
-    #endif // __APPLE__
-
-    if (device_param->is_opencl == true)
-    {
-      device_param->kernel_params[ 0] = NULL; // &device_param->opencl_d_pws_buf;
-      device_param->kernel_params[ 1] = &device_param->opencl_d_rules_c;
-      device_param->kernel_params[ 2] = &device_param->opencl_d_combs_c;
-      device_param->kernel_params[ 3] = &device_param->opencl_d_bfs_c;
-      device_param->kernel_params[ 4] = NULL; // &device_param->opencl_d_tmps;
-      device_param->kernel_params[ 5] = NULL; // &device_param->opencl_d_hooks;
-      device_param->kernel_params[ 6] = &device_param->opencl_d_bitmap_s1_a;
-      device_param->kernel_params[ 7] = &device_param->opencl_d_bitmap_s1_b;
-      device_param->kernel_params[ 8] = &device_param->opencl_d_bitmap_s1_c;
-      device_param->kernel_params[ 9] = &device_param->opencl_d_bitmap_s1_d;
-      device_param->kernel_params[10] = &device_param->opencl_d_bitmap_s2_a;
-      device_param->kernel_params[11] = &device_param->opencl_d_bitmap_s2_b;
-      device_param->kernel_params[12] = &device_param->opencl_d_bitmap_s2_c;
-      device_param->kernel_params[13] = &device_param->opencl_d_bitmap_s2_d;
-      device_param->kernel_params[14] = &device_param->opencl_d_plain_bufs;
-      device_param->kernel_params[15] = &device_param->opencl_d_digests_buf;
-      device_param->kernel_params[16] = &device_param->opencl_d_digests_shown;
-      device_param->kernel_params[17] = &device_param->opencl_d_salt_bufs;
-      device_param->kernel_params[18] = &device_param->opencl_d_esalt_bufs;
-      device_param->kernel_params[19] = &device_param->opencl_d_result;
-      device_param->kernel_params[20] = &device_param->opencl_d_extra0_buf;
-      device_param->kernel_params[21] = &device_param->opencl_d_extra1_buf;
-      device_param->kernel_params[22] = &device_param->opencl_d_extra2_buf;
-      device_param->kernel_params[23] = &device_param->opencl_d_extra3_buf;
-      device_param->kernel_params[24] = &device_param->opencl_d_kernel_param;
-    }
-
-    if (user_options->slow_candidates == true)
-    {
     }
     else
     {
-      device_param->kernel_params_mp_buf64[3] = 0;
-      device_param->kernel_params_mp_buf32[4] = 0;
-      device_param->kernel_params_mp_buf32[5] = 0;
-      device_param->kernel_params_mp_buf32[6] = 0;
-      device_param->kernel_params_mp_buf32[7] = 0;
-      device_param->kernel_params_mp_buf64[8] = 0;
-
-      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+      if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
       {
         if (device_param->is_cuda == true)
         {
@@ -15432,1488 +15571,1612 @@ int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
       }
       else
       {
-        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-        {
-          if (device_param->is_cuda == true)
-          {
-            device_param->kernel_params_mp[0] = &device_param->cuda_d_combs;
-          }
-
-          if (device_param->is_hip == true)
-          {
-            device_param->kernel_params_mp[0] = &device_param->hip_d_combs;
-          }
-
-          #if defined (__APPLE__)
-          if (device_param->is_metal == true)
-          {
-            device_param->kernel_params_mp[0] = device_param->metal_d_combs.buf_ptr;
-          }
-          #endif
-
-          if (device_param->is_opencl == true)
-          {
-            device_param->kernel_params_mp[0] = &device_param->opencl_d_combs;
-          }
-        }
-        else
-        {
-          device_param->kernel_params_mp[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                    // ? &device_param->opencl_d_pws_buf
-                                                    // : &device_param->opencl_d_pws_amp_buf;
-        }
-      }
-
-      if (device_param->is_cuda == true)
-      {
-        device_param->kernel_params_mp[1] = &device_param->cuda_d_root_css_buf;
-        device_param->kernel_params_mp[2] = &device_param->cuda_d_markov_css_buf;
-      }
-
-      if (device_param->is_hip == true)
-      {
-        device_param->kernel_params_mp[1] = &device_param->hip_d_root_css_buf;
-        device_param->kernel_params_mp[2] = &device_param->hip_d_markov_css_buf;
-      }
-
-      #if defined (__APPLE__)
-      if (device_param->is_metal == true)
-      {
-        device_param->kernel_params_mp[1] = device_param->metal_d_root_css_buf.buf_ptr;
-        device_param->kernel_params_mp[2] = device_param->metal_d_markov_css_buf.buf_ptr;
-      }
-      #endif
-
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_mp[1] = &device_param->opencl_d_root_css_buf;
-        device_param->kernel_params_mp[2] = &device_param->opencl_d_markov_css_buf;
-      }
-
-      device_param->kernel_params_mp[3] = &device_param->kernel_params_mp_buf64[3];
-      device_param->kernel_params_mp[4] = &device_param->kernel_params_mp_buf32[4];
-      device_param->kernel_params_mp[5] = &device_param->kernel_params_mp_buf32[5];
-      device_param->kernel_params_mp[6] = &device_param->kernel_params_mp_buf32[6];
-      device_param->kernel_params_mp[7] = &device_param->kernel_params_mp_buf32[7];
-      device_param->kernel_params_mp[8] = &device_param->kernel_params_mp_buf64[8];
-
-      device_param->kernel_params_mp_l_buf64[3] = 0;
-      device_param->kernel_params_mp_l_buf32[4] = 0;
-      device_param->kernel_params_mp_l_buf32[5] = 0;
-      device_param->kernel_params_mp_l_buf32[6] = 0;
-      device_param->kernel_params_mp_l_buf32[7] = 0;
-      device_param->kernel_params_mp_l_buf32[8] = 0;
-      device_param->kernel_params_mp_l_buf64[9] = 0;
-
-      device_param->kernel_params_mp_l[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+        device_param->kernel_params_mp[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
                                                   // ? &device_param->opencl_d_pws_buf
                                                   // : &device_param->opencl_d_pws_amp_buf;
-
-      if (device_param->is_cuda == true)
-      {
-        device_param->kernel_params_mp_l[1] = &device_param->cuda_d_root_css_buf;
-        device_param->kernel_params_mp_l[2] = &device_param->cuda_d_markov_css_buf;
-      }
-
-      if (device_param->is_hip == true)
-      {
-        device_param->kernel_params_mp_l[1] = &device_param->hip_d_root_css_buf;
-        device_param->kernel_params_mp_l[2] = &device_param->hip_d_markov_css_buf;
-      }
-
-      #if defined (__APPLE__)
-      if (device_param->is_metal == true)
-      {
-        device_param->kernel_params_mp_l[1] = device_param->metal_d_root_css_buf.buf_ptr;
-        device_param->kernel_params_mp_l[2] = device_param->metal_d_markov_css_buf.buf_ptr;
       }
-      #endif
-
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_mp_l[1] = &device_param->opencl_d_root_css_buf;
-        device_param->kernel_params_mp_l[2] = &device_param->opencl_d_markov_css_buf;
-      }
-
-      device_param->kernel_params_mp_l[3] = &device_param->kernel_params_mp_l_buf64[3];
-      device_param->kernel_params_mp_l[4] = &device_param->kernel_params_mp_l_buf32[4];
-      device_param->kernel_params_mp_l[5] = &device_param->kernel_params_mp_l_buf32[5];
-      device_param->kernel_params_mp_l[6] = &device_param->kernel_params_mp_l_buf32[6];
-      device_param->kernel_params_mp_l[7] = &device_param->kernel_params_mp_l_buf32[7];
-      device_param->kernel_params_mp_l[8] = &device_param->kernel_params_mp_l_buf32[8];
-      device_param->kernel_params_mp_l[9] = &device_param->kernel_params_mp_l_buf64[9];
-
-      device_param->kernel_params_mp_r_buf64[3] = 0;
-      device_param->kernel_params_mp_r_buf32[4] = 0;
-      device_param->kernel_params_mp_r_buf32[5] = 0;
-      device_param->kernel_params_mp_r_buf32[6] = 0;
-      device_param->kernel_params_mp_r_buf32[7] = 0;
-      device_param->kernel_params_mp_r_buf64[8] = 0;
-
-      if (device_param->is_cuda == true)
-      {
-        device_param->kernel_params_mp_r[0] = &device_param->cuda_d_bfs;
-        device_param->kernel_params_mp_r[1] = &device_param->cuda_d_root_css_buf;
-        device_param->kernel_params_mp_r[2] = &device_param->cuda_d_markov_css_buf;
-      }
-
-      if (device_param->is_hip == true)
-      {
-        device_param->kernel_params_mp_r[0] = &device_param->hip_d_bfs;
-        device_param->kernel_params_mp_r[1] = &device_param->hip_d_root_css_buf;
-        device_param->kernel_params_mp_r[2] = &device_param->hip_d_markov_css_buf;
-      }
-
-      #if defined (__APPLE__)
-      if (device_param->is_metal == true)
-      {
-        device_param->kernel_params_mp_r[0] = device_param->metal_d_bfs.buf_ptr;
-        device_param->kernel_params_mp_r[1] = device_param->metal_d_root_css_buf.buf_ptr;
-        device_param->kernel_params_mp_r[2] = device_param->metal_d_markov_css_buf.buf_ptr;
-      }
-      #endif
-
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_mp_r[0] = &device_param->opencl_d_bfs;
-        device_param->kernel_params_mp_r[1] = &device_param->opencl_d_root_css_buf;
-        device_param->kernel_params_mp_r[2] = &device_param->opencl_d_markov_css_buf;
-      }
-
-      device_param->kernel_params_mp_r[3] = &device_param->kernel_params_mp_r_buf64[3];
-      device_param->kernel_params_mp_r[4] = &device_param->kernel_params_mp_r_buf32[4];
-      device_param->kernel_params_mp_r[5] = &device_param->kernel_params_mp_r_buf32[5];
-      device_param->kernel_params_mp_r[6] = &device_param->kernel_params_mp_r_buf32[6];
-      device_param->kernel_params_mp_r[7] = &device_param->kernel_params_mp_r_buf32[7];
-      device_param->kernel_params_mp_r[8] = &device_param->kernel_params_mp_r_buf64[8];
-
-      device_param->kernel_params_amp_buf32[5] = 0; // combs_mode
-      device_param->kernel_params_amp_buf64[6] = 0; // gid_max
-
-      if (device_param->is_cuda == true)
-      {
-        device_param->kernel_params_amp[0] = NULL; // &device_param->cuda_d_pws_buf;
-        device_param->kernel_params_amp[1] = NULL; // &device_param->cuda_d_pws_amp_buf;
-        device_param->kernel_params_amp[2] = &device_param->cuda_d_rules_c;
-        device_param->kernel_params_amp[3] = &device_param->cuda_d_combs_c;
-        device_param->kernel_params_amp[4] = &device_param->cuda_d_bfs_c;
-      }
-
-      if (device_param->is_hip == true)
-      {
-        device_param->kernel_params_amp[0] = NULL; // &device_param->hip_d_pws_buf;
-        device_param->kernel_params_amp[1] = NULL; // &device_param->hip_d_pws_amp_buf;
-        device_param->kernel_params_amp[2] = &device_param->hip_d_rules_c;
-        device_param->kernel_params_amp[3] = &device_param->hip_d_combs_c;
-        device_param->kernel_params_amp[4] = &device_param->hip_d_bfs_c;
-      }
-
-      #if defined (__APPLE__)
-      if (device_param->is_metal == true)
-      {
-        device_param->kernel_params_amp[0] = NULL; // device_param->metal_d_pws_buf;
-        device_param->kernel_params_amp[1] = NULL; // device_param->metal_d_pws_amp_buf;
-        device_param->kernel_params_amp[2] = device_param->metal_d_rules_c.buf_ptr;
-        device_param->kernel_params_amp[3] = device_param->metal_d_combs_c.buf_ptr;
-        device_param->kernel_params_amp[4] = device_param->metal_d_bfs_c.buf_ptr;
-      }
-      #endif
-
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_amp[0] = NULL; // &device_param->opencl_d_pws_buf;
-        device_param->kernel_params_amp[1] = NULL; // &device_param->opencl_d_pws_amp_buf;
-        device_param->kernel_params_amp[2] = &device_param->opencl_d_rules_c;
-        device_param->kernel_params_amp[3] = &device_param->opencl_d_combs_c;
-        device_param->kernel_params_amp[4] = &device_param->opencl_d_bfs_c;
-      }
-
-      device_param->kernel_params_amp[5] = &device_param->kernel_params_amp_buf32[5];
-      device_param->kernel_params_amp[6] = &device_param->kernel_params_amp_buf64[6];
+    }
 
-      if (device_param->is_cuda == true)
-      {
-        device_param->kernel_params_tm[0] = &device_param->cuda_d_bfs_c;
-        device_param->kernel_params_tm[1] = &device_param->cuda_d_tm_c;
-      }
+    if (device_param->is_cuda == true)
+    {
+      device_param->kernel_params_mp[1] = &device_param->cuda_d_root_css_buf;
+      device_param->kernel_params_mp[2] = &device_param->cuda_d_markov_css_buf;
+    }
 
-      if (device_param->is_hip == true)
-      {
-        device_param->kernel_params_tm[0] = &device_param->hip_d_bfs_c;
-        device_param->kernel_params_tm[1] = &device_param->hip_d_tm_c;
-      }
+    if (device_param->is_hip == true)
+    {
+      device_param->kernel_params_mp[1] = &device_param->hip_d_root_css_buf;
+      device_param->kernel_params_mp[2] = &device_param->hip_d_markov_css_buf;
+    }
 
-      #if defined (__APPLE__)
-      if (device_param->is_metal == true)
-      {
-        device_param->kernel_params_tm[0] = device_param->metal_d_bfs_c.buf_ptr;
-        device_param->kernel_params_tm[1] = device_param->metal_d_tm_c.buf_ptr;
-      }
-      #endif
+    #if defined (__APPLE__)
+    if (device_param->is_metal == true)
+    {
+      device_param->kernel_params_mp[1] = device_param->metal_d_root_css_buf.buf_ptr;
+      device_param->kernel_params_mp[2] = device_param->metal_d_markov_css_buf.buf_ptr;
+    }
+    #endif
 
-      if (device_param->is_opencl == true)
-      {
-        device_param->kernel_params_tm[0] = &device_param->opencl_d_bfs_c;
-        device_param->kernel_params_tm[1] = &device_param->opencl_d_tm_c;
-      }
+    if (device_param->is_opencl == true)
+    {
+      device_param->kernel_params_mp[1] = &device_param->opencl_d_root_css_buf;
+      device_param->kernel_params_mp[2] = &device_param->opencl_d_markov_css_buf;
     }
 
-    device_param->kernel_params_memset_buf32[1] = 0; // value
-    device_param->kernel_params_memset_buf64[2] = 0; // gid_max
+    device_param->kernel_params_mp[3] = &device_param->kernel_params_mp_buf64[3];
+    device_param->kernel_params_mp[4] = &device_param->kernel_params_mp_buf32[4];
+    device_param->kernel_params_mp[5] = &device_param->kernel_params_mp_buf32[5];
+    device_param->kernel_params_mp[6] = &device_param->kernel_params_mp_buf32[6];
+    device_param->kernel_params_mp[7] = &device_param->kernel_params_mp_buf32[7];
+    device_param->kernel_params_mp[8] = &device_param->kernel_params_mp_buf64[8];
 
-    device_param->kernel_params_memset[0] = NULL;
-    device_param->kernel_params_memset[1] = &device_param->kernel_params_memset_buf32[1];
-    device_param->kernel_params_memset[2] = &device_param->kernel_params_memset_buf64[2];
+    device_param->kernel_params_mp_l_buf64[3] = 0;
+    device_param->kernel_params_mp_l_buf32[4] = 0;
+    device_param->kernel_params_mp_l_buf32[5] = 0;
+    device_param->kernel_params_mp_l_buf32[6] = 0;
+    device_param->kernel_params_mp_l_buf32[7] = 0;
+    device_param->kernel_params_mp_l_buf32[8] = 0;
+    device_param->kernel_params_mp_l_buf64[9] = 0;
 
-    device_param->kernel_params_bzero_buf64[1] = 0; // gid_max
+    device_param->kernel_params_mp_l[0] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                // ? &device_param->opencl_d_pws_buf
+                                                // : &device_param->opencl_d_pws_amp_buf;
 
-    device_param->kernel_params_bzero[0] = NULL;
-    device_param->kernel_params_bzero[1] = &device_param->kernel_params_bzero_buf64[1];
+    if (device_param->is_cuda == true)
+    {
+      device_param->kernel_params_mp_l[1] = &device_param->cuda_d_root_css_buf;
+      device_param->kernel_params_mp_l[2] = &device_param->cuda_d_markov_css_buf;
+    }
 
-    device_param->kernel_params_atinit_buf64[1] = 0; // gid_max
+    if (device_param->is_hip == true)
+    {
+      device_param->kernel_params_mp_l[1] = &device_param->hip_d_root_css_buf;
+      device_param->kernel_params_mp_l[2] = &device_param->hip_d_markov_css_buf;
+    }
 
-    device_param->kernel_params_atinit[0] = NULL;
-    device_param->kernel_params_atinit[1] = &device_param->kernel_params_atinit_buf64[1];
+    #if defined (__APPLE__)
+    if (device_param->is_metal == true)
+    {
+      device_param->kernel_params_mp_l[1] = device_param->metal_d_root_css_buf.buf_ptr;
+      device_param->kernel_params_mp_l[2] = device_param->metal_d_markov_css_buf.buf_ptr;
+    }
+    #endif
 
-    device_param->kernel_params_utf8toutf16le_buf64[1] = 0; // gid_max
+    if (device_param->is_opencl == true)
+    {
+      device_param->kernel_params_mp_l[1] = &device_param->opencl_d_root_css_buf;
+      device_param->kernel_params_mp_l[2] = &device_param->opencl_d_markov_css_buf;
+    }
 
-    device_param->kernel_params_utf8toutf16le[0] = NULL;
-    device_param->kernel_params_utf8toutf16le[1] = &device_param->kernel_params_utf8toutf16le_buf64[1];
+    device_param->kernel_params_mp_l[3] = &device_param->kernel_params_mp_l_buf64[3];
+    device_param->kernel_params_mp_l[4] = &device_param->kernel_params_mp_l_buf32[4];
+    device_param->kernel_params_mp_l[5] = &device_param->kernel_params_mp_l_buf32[5];
+    device_param->kernel_params_mp_l[6] = &device_param->kernel_params_mp_l_buf32[6];
+    device_param->kernel_params_mp_l[7] = &device_param->kernel_params_mp_l_buf32[7];
+    device_param->kernel_params_mp_l[8] = &device_param->kernel_params_mp_l_buf32[8];
+    device_param->kernel_params_mp_l[9] = &device_param->kernel_params_mp_l_buf64[9];
 
-    device_param->kernel_params_decompress_buf64[3] = 0; // gid_max
+    device_param->kernel_params_mp_r_buf64[3] = 0;
+    device_param->kernel_params_mp_r_buf32[4] = 0;
+    device_param->kernel_params_mp_r_buf32[5] = 0;
+    device_param->kernel_params_mp_r_buf32[6] = 0;
+    device_param->kernel_params_mp_r_buf32[7] = 0;
+    device_param->kernel_params_mp_r_buf64[8] = 0;
 
     if (device_param->is_cuda == true)
     {
-      device_param->kernel_params_decompress[0] = NULL; // &device_param->cuda_d_pws_idx;
-      device_param->kernel_params_decompress[1] = NULL; // &device_param->cuda_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                        // ? &device_param->cuda_d_pws_buf
-                                                        // : &device_param->cuda_d_pws_amp_buf;
+      device_param->kernel_params_mp_r[0] = &device_param->cuda_d_bfs;
+      device_param->kernel_params_mp_r[1] = &device_param->cuda_d_root_css_buf;
+      device_param->kernel_params_mp_r[2] = &device_param->cuda_d_markov_css_buf;
     }
 
     if (device_param->is_hip == true)
     {
-      device_param->kernel_params_decompress[0] = NULL; // &device_param->hip_d_pws_idx;
-      device_param->kernel_params_decompress[1] = NULL; // &device_param->hip_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                        // ? &device_param->hip_d_pws_buf
-                                                        // : &device_param->hip_d_pws_amp_buf;
+      device_param->kernel_params_mp_r[0] = &device_param->hip_d_bfs;
+      device_param->kernel_params_mp_r[1] = &device_param->hip_d_root_css_buf;
+      device_param->kernel_params_mp_r[2] = &device_param->hip_d_markov_css_buf;
     }
 
     #if defined (__APPLE__)
     if (device_param->is_metal == true)
     {
-      device_param->kernel_params_decompress[0] = NULL; // device_param->metal_d_pws_idx;
-      device_param->kernel_params_decompress[1] = NULL; // device_param->metal_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                        // ? device_param->metal_d_pws_buf
-                                                        // : device_param->metal_d_pws_amp_buf;
+      device_param->kernel_params_mp_r[0] = device_param->metal_d_bfs.buf_ptr;
+      device_param->kernel_params_mp_r[1] = device_param->metal_d_root_css_buf.buf_ptr;
+      device_param->kernel_params_mp_r[2] = device_param->metal_d_markov_css_buf.buf_ptr;
     }
     #endif
 
     if (device_param->is_opencl == true)
     {
-      device_param->kernel_params_decompress[0] = NULL; // &device_param->opencl_d_pws_idx;
-      device_param->kernel_params_decompress[1] = NULL; // &device_param->opencl_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                        // ? &device_param->opencl_d_pws_buf
-                                                        // : &device_param->opencl_d_pws_amp_buf;
+      device_param->kernel_params_mp_r[0] = &device_param->opencl_d_bfs;
+      device_param->kernel_params_mp_r[1] = &device_param->opencl_d_root_css_buf;
+      device_param->kernel_params_mp_r[2] = &device_param->opencl_d_markov_css_buf;
     }
 
-    device_param->kernel_params_decompress[3] = &device_param->kernel_params_decompress_buf64[3];
-
-    /**
-     * kernel name
-     */
+    device_param->kernel_params_mp_r[3] = &device_param->kernel_params_mp_r_buf64[3];
+    device_param->kernel_params_mp_r[4] = &device_param->kernel_params_mp_r_buf32[4];
+    device_param->kernel_params_mp_r[5] = &device_param->kernel_params_mp_r_buf32[5];
+    device_param->kernel_params_mp_r[6] = &device_param->kernel_params_mp_r_buf32[6];
+    device_param->kernel_params_mp_r[7] = &device_param->kernel_params_mp_r_buf32[7];
+    device_param->kernel_params_mp_r[8] = &device_param->kernel_params_mp_r_buf64[8];
 
-    int rc = -1;
+    device_param->kernel_params_amp_buf32[5] = 0; // combs_mode
+    device_param->kernel_params_amp_buf64[6] = 0; // gid_max
 
     if (device_param->is_cuda == true)
     {
-      rc = backend_session_setup_cuda_kernel_types (hashcat_ctx, device_param, kern_type);
+      device_param->kernel_params_amp[0] = NULL; // &device_param->cuda_d_pws_buf;
+      device_param->kernel_params_amp[1] = NULL; // &device_param->cuda_d_pws_amp_buf;
+      device_param->kernel_params_amp[2] = &device_param->cuda_d_rules_c;
+      device_param->kernel_params_amp[3] = &device_param->cuda_d_combs_c;
+      device_param->kernel_params_amp[4] = &device_param->cuda_d_bfs_c;
     }
 
     if (device_param->is_hip == true)
     {
-      rc = backend_session_setup_hip_kernel_types (hashcat_ctx, device_param, kern_type);
+      device_param->kernel_params_amp[0] = NULL; // &device_param->hip_d_pws_buf;
+      device_param->kernel_params_amp[1] = NULL; // &device_param->hip_d_pws_amp_buf;
+      device_param->kernel_params_amp[2] = &device_param->hip_d_rules_c;
+      device_param->kernel_params_amp[3] = &device_param->hip_d_combs_c;
+      device_param->kernel_params_amp[4] = &device_param->hip_d_bfs_c;
     }
 
     #if defined (__APPLE__)
     if (device_param->is_metal == true)
     {
-      rc = backend_session_setup_metal_kernel_types (hashcat_ctx, device_param, kern_type);
+      device_param->kernel_params_amp[0] = NULL; // device_param->metal_d_pws_buf;
+      device_param->kernel_params_amp[1] = NULL; // device_param->metal_d_pws_amp_buf;
+      device_param->kernel_params_amp[2] = device_param->metal_d_rules_c.buf_ptr;
+      device_param->kernel_params_amp[3] = device_param->metal_d_combs_c.buf_ptr;
+      device_param->kernel_params_amp[4] = device_param->metal_d_bfs_c.buf_ptr;
     }
     #endif
 
     if (device_param->is_opencl == true)
     {
-      rc = backend_session_setup_opencl_kernel_types (hashcat_ctx, device_param, kern_type);
+      device_param->kernel_params_amp[0] = NULL; // &device_param->opencl_d_pws_buf;
+      device_param->kernel_params_amp[1] = NULL; // &device_param->opencl_d_pws_amp_buf;
+      device_param->kernel_params_amp[2] = &device_param->opencl_d_rules_c;
+      device_param->kernel_params_amp[3] = &device_param->opencl_d_combs_c;
+      device_param->kernel_params_amp[4] = &device_param->opencl_d_bfs_c;
     }
 
-    if (rc == -2)
+    device_param->kernel_params_amp[5] = &device_param->kernel_params_amp_buf32[5];
+    device_param->kernel_params_amp[6] = &device_param->kernel_params_amp_buf64[6];
+
+    if (device_param->is_cuda == true)
     {
-      backend_kernel_create_warnings++;
+      device_param->kernel_params_tm[0] = &device_param->cuda_d_bfs_c;
+      device_param->kernel_params_tm[1] = &device_param->cuda_d_tm_c;
+    }
 
-      continue;
+    if (device_param->is_hip == true)
+    {
+      device_param->kernel_params_tm[0] = &device_param->hip_d_bfs_c;
+      device_param->kernel_params_tm[1] = &device_param->hip_d_tm_c;
     }
 
-    if (rc == -1) return -1;
+    #if defined (__APPLE__)
+    if (device_param->is_metal == true)
+    {
+      device_param->kernel_params_tm[0] = device_param->metal_d_bfs_c.buf_ptr;
+      device_param->kernel_params_tm[1] = device_param->metal_d_tm_c.buf_ptr;
+    }
+    #endif
 
-    if (device_param->is_cuda == true)
+    if (device_param->is_opencl == true)
     {
-      // zero some data buffers
+      device_param->kernel_params_tm[0] = &device_param->opencl_d_bfs_c;
+      device_param->kernel_params_tm[1] = &device_param->opencl_d_tm_c;
+    }
+  }
 
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_digests_shown, device_param->size_shown)   == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_result,        device_param->size_results) == -1) return -1;
+  device_param->kernel_params_memset_buf32[1] = 0; // value
+  device_param->kernel_params_memset_buf64[2] = 0; // gid_max
 
-      // special buffers
+  device_param->kernel_params_memset[0] = NULL;
+  device_param->kernel_params_memset[1] = &device_param->kernel_params_memset_buf32[1];
+  device_param->kernel_params_memset[2] = &device_param->kernel_params_memset_buf64[2];
 
-      if (user_options->slow_candidates == true)
+  device_param->kernel_params_bzero_buf64[1] = 0; // gid_max
+
+  device_param->kernel_params_bzero[0] = NULL;
+  device_param->kernel_params_bzero[1] = &device_param->kernel_params_bzero_buf64[1];
+
+  device_param->kernel_params_atinit_buf64[1] = 0; // gid_max
+
+  device_param->kernel_params_atinit[0] = NULL;
+  device_param->kernel_params_atinit[1] = &device_param->kernel_params_atinit_buf64[1];
+
+  device_param->kernel_params_utf8toutf16le_buf64[1] = 0; // gid_max
+
+  device_param->kernel_params_utf8toutf16le[0] = NULL;
+  device_param->kernel_params_utf8toutf16le[1] = &device_param->kernel_params_utf8toutf16le_buf64[1];
+
+  device_param->kernel_params_decompress_buf64[3] = 0; // gid_max
+
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params_decompress[0] = NULL; // &device_param->cuda_d_pws_idx;
+    device_param->kernel_params_decompress[1] = NULL; // &device_param->cuda_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                      // ? &device_param->cuda_d_pws_buf
+                                                      // : &device_param->cuda_d_pws_amp_buf;
+  }
+
+  if (device_param->is_hip == true)
+  {
+    device_param->kernel_params_decompress[0] = NULL; // &device_param->hip_d_pws_idx;
+    device_param->kernel_params_decompress[1] = NULL; // &device_param->hip_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                      // ? &device_param->hip_d_pws_buf
+                                                      // : &device_param->hip_d_pws_amp_buf;
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    device_param->kernel_params_decompress[0] = NULL; // device_param->metal_d_pws_idx;
+    device_param->kernel_params_decompress[1] = NULL; // device_param->metal_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                      // ? device_param->metal_d_pws_buf
+                                                      // : device_param->metal_d_pws_amp_buf;
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params_decompress[0] = NULL; // &device_param->opencl_d_pws_idx;
+    device_param->kernel_params_decompress[1] = NULL; // &device_param->opencl_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = NULL; // (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                                      // ? &device_param->opencl_d_pws_buf
+                                                      // : &device_param->opencl_d_pws_amp_buf;
+  }
+
+  device_param->kernel_params_decompress[3] = &device_param->kernel_params_decompress_buf64[3];
+
+  /**
+   * kernel name
+   */
+
+  int rc = -1;
+
+  if (device_param->is_cuda == true)
+  {
+    rc = backend_session_setup_cuda_kernel_types (hashcat_ctx, device_param, kern_type);
+  }
+
+  if (device_param->is_hip == true)
+  {
+    rc = backend_session_setup_hip_kernel_types (hashcat_ctx, device_param, kern_type);
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    rc = backend_session_setup_metal_kernel_types (hashcat_ctx, device_param, kern_type);
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    rc = backend_session_setup_opencl_kernel_types (hashcat_ctx, device_param, kern_type);
+  }
+
+  if (rc == -2)
+  {
+    session_param->kernel_create_warnings++;
+
+    return 0;
+  }
+
+  if (rc == -1) return -1;
+
+  if (device_param->is_cuda == true)
+  {
+    // zero some data buffers
+
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_digests_shown, device_param->size_shown)   == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_result,        device_param->size_results) == -1) return -1;
+
+    // special buffers
+
+    if (user_options->slow_candidates == true)
+    {
+      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
+    }
+    else
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
         if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_rules_c, size_rules_c) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs,          size_combs)       == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs_c,        size_combs)       == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs,            size_bfs)         == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs_c,          size_bfs)         == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tm_c,           size_tm)          == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
-        }
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs,          size_combs)       == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_combs_c,        size_combs)       == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
       }
-
-      if (user_options->slow_candidates == true)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs,            size_bfs)         == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_bfs_c,          size_bfs)         == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tm_c,           size_tm)          == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_markov_css_buf, size_markov_css)  == -1) return -1;
       }
-      else
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
       {
-        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          // prepare mp
+        // prepare mp
 
-          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
-          }
-          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-          }
+        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+        {
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
 
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
         }
-        else if (user_options->attack_mode == ATTACK_MODE_BF)
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
         {
-          // prepare mp_r and mp_l
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
+        }
 
-          device_param->kernel_params_mp_l_buf32[6] = 0;
-          device_param->kernel_params_mp_l_buf32[7] = 0;
-          device_param->kernel_params_mp_l_buf32[8] = 0;
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        // prepare mp_r and mp_l
 
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+        device_param->kernel_params_mp_l_buf32[6] = 0;
+        device_param->kernel_params_mp_l_buf32[7] = 0;
+        device_param->kernel_params_mp_l_buf32[8] = 0;
 
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
-        }
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
       }
     }
+  }
 
-    if (device_param->is_hip == true)
-    {
-      // zero some data buffers
+  if (device_param->is_hip == true)
+  {
+    // zero some data buffers
 
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_digests_shown, device_param->size_shown)   == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_result,        device_param->size_results) == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_digests_shown, device_param->size_shown)   == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_result,        device_param->size_results) == -1) return -1;
 
-      // special buffers
+    // special buffers
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
+    }
+    else
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
         if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_rules_c, size_rules_c) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_combs,          size_combs)       == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_combs_c,        size_combs)       == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_markov_css_buf, size_markov_css)  == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_bfs,            size_bfs)         == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_bfs_c,          size_bfs)         == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_tm_c,           size_tm)          == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_markov_css_buf, size_markov_css)  == -1) return -1;
-        }
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_combs,          size_combs)       == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_combs_c,        size_combs)       == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_markov_css_buf, size_markov_css)  == -1) return -1;
       }
-
-      if (user_options->slow_candidates == true)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_bfs,            size_bfs)         == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_bfs_c,          size_bfs)         == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_tm_c,           size_tm)          == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_markov_css_buf, size_markov_css)  == -1) return -1;
       }
-      else
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
       {
-        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          // prepare mp
+        // prepare mp
 
-          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
-          }
-          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-          }
+        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+        {
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
 
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
         }
-        else if (user_options->attack_mode == ATTACK_MODE_BF)
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
         {
-          // prepare mp_r and mp_l
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
+        }
+
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        // prepare mp_r and mp_l
 
-          device_param->kernel_params_mp_l_buf32[6] = 0;
-          device_param->kernel_params_mp_l_buf32[7] = 0;
-          device_param->kernel_params_mp_l_buf32[8] = 0;
+        device_param->kernel_params_mp_l_buf32[6] = 0;
+        device_param->kernel_params_mp_l_buf32[7] = 0;
+        device_param->kernel_params_mp_l_buf32[8] = 0;
 
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
 
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
-          //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
-        }
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
+        //for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]); if (CL_rc == -1) return -1; }
       }
     }
+  }
 
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
-    {
-      // zero some data buffers
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    // zero some data buffers
 
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_digests_shown, device_param->size_shown)   == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_result,        device_param->size_results) == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_plain_bufs,    device_param->size_plains)  == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_digests_shown, device_param->size_shown)   == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_result,        device_param->size_results) == -1) return -1;
 
-      // special buffers
+    // special buffers
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_rules_c, size_rules_c) == -1) return -1;
+    }
+    else
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
         if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_rules_c, size_rules_c) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_rules_c, size_rules_c) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_combs,          size_combs)       == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_combs_c,        size_combs)       == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_markov_css_buf, size_markov_css)  == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_bfs,            size_bfs)         == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_bfs_c,          size_bfs)         == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_tm_c,           size_tm)          == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_root_css_buf,   size_root_css)    == -1) return -1;
-          if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_markov_css_buf, size_markov_css)  == -1) return -1;
-        }
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_combs,          size_combs)       == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_combs_c,        size_combs)       == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_markov_css_buf, size_markov_css)  == -1) return -1;
       }
-
-      if (user_options->slow_candidates == true)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_bfs,            size_bfs)         == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_bfs_c,          size_bfs)         == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_tm_c,           size_tm)          == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_root_css_buf,   size_root_css)    == -1) return -1;
+        if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_markov_css_buf, size_markov_css)  == -1) return -1;
       }
-      else
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
       {
-        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+        // prepare mp
+
+        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
         {
-          // prepare mp
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
 
-          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
-          }
-          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-          }
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
         }
-        else if (user_options->attack_mode == ATTACK_MODE_BF)
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
         {
-          // prepare mp_r and mp_l
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
+        }
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        // prepare mp_r and mp_l
 
-          device_param->kernel_params_mp_l_buf32[6] = 0;
-          device_param->kernel_params_mp_l_buf32[7] = 0;
-          device_param->kernel_params_mp_l_buf32[8] = 0;
+        device_param->kernel_params_mp_l_buf32[6] = 0;
+        device_param->kernel_params_mp_l_buf32[7] = 0;
+        device_param->kernel_params_mp_l_buf32[8] = 0;
 
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
-        }
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
       }
     }
-    #endif
+  }
+  #endif
 
-    if (device_param->is_opencl == true)
-    {
-      // zero some data buffers
+  if (device_param->is_opencl == true)
+  {
+    // zero some data buffers
 
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_plain_bufs,    device_param->size_plains)   == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_digests_shown, device_param->size_shown)    == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result,        device_param->size_results)  == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_plain_bufs,    device_param->size_plains)   == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_digests_shown, device_param->size_shown)    == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_result,        device_param->size_results)  == -1) return -1;
 
-      // special buffers
+    // special buffers
 
-      if (user_options->slow_candidates == true)
+    if (user_options->slow_candidates == true)
+    {
+      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, size_rules_c) == -1) return -1;
+    }
+    else
+    {
+      if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
       {
         if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, size_rules_c) == -1) return -1;
       }
-      else
+      else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
       {
-        if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-        {
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_rules_c, size_rules_c) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-        {
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs,          size_combs)      == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs_c,        size_combs)      == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
-        }
-        else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-        {
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs,            size_bfs)        == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs_c,          size_bfs)        == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tm_c,           size_tm)         == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
-          if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
-        }
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs,          size_combs)      == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_combs_c,        size_combs)      == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
       }
-
-      if (user_options->slow_candidates == true)
+      else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
       {
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs,            size_bfs)        == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_bfs_c,          size_bfs)        == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tm_c,           size_tm)         == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_root_css_buf,   size_root_css)   == -1) return -1;
+        if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_markov_css_buf, size_markov_css) == -1) return -1;
       }
-      else
+    }
+
+    if (user_options->slow_candidates == true)
+    {
+    }
+    else
+    {
+      if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
       {
-        if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
-        {
-          // prepare mp
+        // prepare mp
 
-          if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
-            if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
-          }
-          else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-          {
-            device_param->kernel_params_mp_buf32[5] = 0;
-            device_param->kernel_params_mp_buf32[6] = 0;
-            device_param->kernel_params_mp_buf32[7] = 0;
-          }
+        if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+        {
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
 
-          for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]) == -1) return -1; }
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_buf32[5] = full01;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_buf32[5] = full06;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_buf32[5] = full80;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_buf32[6] = 1;
+          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_buf32[7] = 1;
         }
-        else if (user_options->attack_mode == ATTACK_MODE_BF)
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
         {
-          // prepare mp_r and mp_l
+          device_param->kernel_params_mp_buf32[5] = 0;
+          device_param->kernel_params_mp_buf32[6] = 0;
+          device_param->kernel_params_mp_buf32[7] = 0;
+        }
+
+        for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, i, sizeof (cl_mem), device_param->kernel_params_mp[i]) == -1) return -1; }
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_BF)
+      {
+        // prepare mp_r and mp_l
 
-          device_param->kernel_params_mp_l_buf32[6] = 0;
-          device_param->kernel_params_mp_l_buf32[7] = 0;
-          device_param->kernel_params_mp_l_buf32[8] = 0;
+        device_param->kernel_params_mp_l_buf32[6] = 0;
+        device_param->kernel_params_mp_l_buf32[7] = 0;
+        device_param->kernel_params_mp_l_buf32[8] = 0;
 
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
-          if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)     device_param->kernel_params_mp_l_buf32[6] = full01;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD06)     device_param->kernel_params_mp_l_buf32[6] = full06;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)     device_param->kernel_params_mp_l_buf32[6] = full80;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS14) device_param->kernel_params_mp_l_buf32[7] = 1;
+        if (hashconfig->opts_type & OPTS_TYPE_PT_ADDBITS15) device_param->kernel_params_mp_l_buf32[8] = 1;
 
-          for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]) == -1) return -1; }
-          for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]) == -1) return -1; }
-        }
+        for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, i, sizeof (cl_mem), device_param->kernel_params_mp_l[i]) == -1) return -1; }
+        for (u32 i = 0; i < 3; i++) { if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_r, i, sizeof (cl_mem), device_param->kernel_params_mp_r[i]) == -1) return -1; }
       }
     }
+  }
 
-    u32 threads_per_block = 32;
+  u32 threads_per_block = 32;
 
-    if (device_param->is_cuda == true)
-    {
-      const int kern_run = find_tuning_function (hashcat_ctx, device_param);
+  if (device_param->is_cuda == true)
+  {
+    const int kern_run = find_tuning_function (hashcat_ctx, device_param);
 
-      CUfunction func = cuda_function_with_id (device_param, kern_run);
+    CUfunction func = cuda_function_with_id (device_param, kern_run);
 
-      threads_per_block = cuda_query_threads_per_block (hashcat_ctx, func);
+    threads_per_block = cuda_query_threads_per_block (hashcat_ctx, func);
 
-      const u32 num_regs = cuda_query_num_regs (hashcat_ctx, func);
+    const u32 num_regs = cuda_query_num_regs (hashcat_ctx, func);
 
-      if (num_regs)
-      {
-        u32 threads_per_block_with_regs = (floor) ((float) device_param->regsPerBlock / num_regs);
+    if (num_regs)
+    {
+      u32 threads_per_block_with_regs = (floor) ((float) device_param->regsPerBlock / num_regs);
 
-        if (threads_per_block_with_regs == 0)
-        {
-          // prevent threads_per_block from resulting in 0 due to a bug on the runtime
-          threads_per_block_with_regs = threads_per_block;
-        }
+      if (threads_per_block_with_regs == 0)
+      {
+        // prevent threads_per_block from resulting in 0 due to a bug on the runtime
+        threads_per_block_with_regs = threads_per_block;
+      }
 
-        if (threads_per_block_with_regs > device_param->kernel_preferred_wgs_multiple) threads_per_block_with_regs -= threads_per_block_with_regs % device_param->kernel_preferred_wgs_multiple;
+      if (threads_per_block_with_regs > device_param->kernel_preferred_wgs_multiple) threads_per_block_with_regs -= threads_per_block_with_regs % device_param->kernel_preferred_wgs_multiple;
 
-        threads_per_block = MIN (threads_per_block, threads_per_block_with_regs);
-      }
+      threads_per_block = MIN (threads_per_block, threads_per_block_with_regs);
     }
-    else if (device_param->is_hip == true)
-    {
-      const int kern_run = find_tuning_function (hashcat_ctx, device_param);
+  }
+  else if (device_param->is_hip == true)
+  {
+    const int kern_run = find_tuning_function (hashcat_ctx, device_param);
 
-      hipFunction_t func = hip_function_with_id (device_param, kern_run);
+    hipFunction_t func = hip_function_with_id (device_param, kern_run);
 
-      threads_per_block = hip_query_threads_per_block (hashcat_ctx, func);
+    threads_per_block = hip_query_threads_per_block (hashcat_ctx, func);
 
-      const u32 num_regs = hip_query_num_regs (hashcat_ctx, func);
+    const u32 num_regs = hip_query_num_regs (hashcat_ctx, func);
 
-      if (num_regs)
-      {
-        u32 threads_per_block_with_regs = (floor) ((float) device_param->regsPerBlock / num_regs);
+    if (num_regs)
+    {
+      u32 threads_per_block_with_regs = (floor) ((float) device_param->regsPerBlock / num_regs);
 
-        if (threads_per_block_with_regs == 0)
-        {
-          // https://rocm.docs.amd.com/projects/HIP/en/docs-develop/doxygen/html/bug.html
-          // HIP-Clang always returns 0 for regsPerBlock due to a known bug
-          // prevent threads_per_block from resulting in 0, otherwise hashcat crashes
-          threads_per_block_with_regs = threads_per_block;
-        }
+      if (threads_per_block_with_regs == 0)
+      {
+        // https://rocm.docs.amd.com/projects/HIP/en/docs-develop/doxygen/html/bug.html
+        // HIP-Clang always returns 0 for regsPerBlock due to a known bug
+        // prevent threads_per_block from resulting in 0, otherwise hashcat crashes
+        threads_per_block_with_regs = threads_per_block;
+      }
 
-        if (threads_per_block_with_regs > device_param->kernel_preferred_wgs_multiple) threads_per_block_with_regs -= threads_per_block_with_regs % device_param->kernel_preferred_wgs_multiple;
+      if (threads_per_block_with_regs > device_param->kernel_preferred_wgs_multiple) threads_per_block_with_regs -= threads_per_block_with_regs % device_param->kernel_preferred_wgs_multiple;
 
-        threads_per_block = MIN (threads_per_block, threads_per_block_with_regs);
-      }
+      threads_per_block = MIN (threads_per_block, threads_per_block_with_regs);
     }
-    else if (device_param->is_opencl == true)
-    {
-      const int kern_run = find_tuning_function (hashcat_ctx, device_param);
+  }
+  else if (device_param->is_opencl == true)
+  {
+    const int kern_run = find_tuning_function (hashcat_ctx, device_param);
 
-      cl_kernel kernel = opencl_kernel_with_id (device_param, kern_run);
+    cl_kernel kernel = opencl_kernel_with_id (device_param, kern_run);
 
-      threads_per_block = opencl_query_threads_per_block (hashcat_ctx, device_param, kernel);
+    threads_per_block = opencl_query_threads_per_block (hashcat_ctx, device_param, kernel);
 
-      // num_regs check should be included in opencl's CL_KERNEL_WORK_GROUP_SIZE
-    }
-    else if (device_param->is_metal == true)
-    {
-      threads_per_block = device_param->kernel_preferred_wgs_multiple;
-    }
+    // num_regs check should be included in opencl's CL_KERNEL_WORK_GROUP_SIZE
+  }
+  else if (device_param->is_metal == true)
+  {
+    threads_per_block = device_param->kernel_preferred_wgs_multiple;
+  }
 
-    if (user_options->kernel_threads_chgd == true)
+  if (user_options->kernel_threads_chgd == true)
+  {
+    if (threads_per_block < user_options->kernel_threads)
     {
-      if (threads_per_block < user_options->kernel_threads)
-      {
-        event_log_warning (hashcat_ctx, "* Device #%u: The requested thread size '%d' exceeds the recommended limit of the backend runtime '%d'.", device_id + 1, user_options->kernel_threads, threads_per_block);
-      }
+      event_log_warning (hashcat_ctx, "* Device #%u: The requested thread size '%d' exceeds the recommended limit of the backend runtime '%d'.", device_id + 1, user_options->kernel_threads, threads_per_block);
     }
+  }
 
-    if ((threads_per_block >= device_param->kernel_threads_min) && (threads_per_block <= device_param->kernel_threads_max))
-    {
-      //printf ("auto thread max: %d\n", threads_per_block);
-      device_param->kernel_threads_max = threads_per_block;
-    }
+  if ((threads_per_block >= device_param->kernel_threads_min) && (threads_per_block <= device_param->kernel_threads_max))
+  {
+    //printf ("auto thread max: %d\n", threads_per_block);
+    device_param->kernel_threads_max = threads_per_block;
+  }
 
-    const u32 threads_per_block_p2f = threads_per_block / (threads_per_block & -threads_per_block);
+  const u32 threads_per_block_p2f = threads_per_block / (threads_per_block & -threads_per_block);
 
-    if ((threads_per_block_p2f >= device_param->kernel_threads_min) && (threads_per_block_p2f <= device_param->kernel_threads_max))
-    {
-      //printf ("auto thread min: %d\n", threads_per_block_p2f);
-      device_param->kernel_threads_min = threads_per_block_p2f;
-    }
+  if ((threads_per_block_p2f >= device_param->kernel_threads_min) && (threads_per_block_p2f <= device_param->kernel_threads_max))
+  {
+    //printf ("auto thread min: %d\n", threads_per_block_p2f);
+    device_param->kernel_threads_min = threads_per_block_p2f;
+  }
 
-    // this is required because inside the kernels there is this:
-    // __local pw_t s_pws[64];
+  // this is required because inside the kernels there is this:
+  // __local pw_t s_pws[64];
 
-    if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT)
-     || (user_options->attack_mode == ATTACK_MODE_GENERIC)
-     || (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
-     || (user_options->slow_candidates == true))
+  if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT)
+   || (user_options->attack_mode == ATTACK_MODE_GENERIC)
+   || (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+   || (user_options->slow_candidates == true))
+  {
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
     {
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
       {
-        if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-        {
-          // not required
-        }
-        else
-        {
-          device_param->kernel_threads_min = MIN (device_param->kernel_threads_min, 64);
-          device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
+        // not required
+      }
+      else
+      {
+        device_param->kernel_threads_min = MIN (device_param->kernel_threads_min, 64);
+        device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
 
-          device_param->overtune_unfriendly = true;
-        }
+        device_param->overtune_unfriendly = true;
       }
     }
+  }
 
-    /**
-     * now everything that depends on threads and accel, basically dynamic workload
-     */
+  /**
+   * now everything that depends on threads and accel, basically dynamic workload
+   */
 
-    //    u32 kernel_threads = get_kernel_threads (device_param);
+  //    u32 kernel_threads = get_kernel_threads (device_param);
 
-    if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
-    {
-      // the smaller the kernel_threads the more accurate we can set kernel_accel
-      // in autotune. in this attack mode kernel_power is limited by salts_cnt so we
-      // do not have a lot of options left.
+  if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+  {
+    // the smaller the kernel_threads the more accurate we can set kernel_accel
+    // in autotune. in this attack mode kernel_power is limited by salts_cnt so we
+    // do not have a lot of options left.
 
-      device_param->kernel_threads_min = MIN (device_param->kernel_threads_min, 64);
-      device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
+    device_param->kernel_threads_min = MIN (device_param->kernel_threads_min, 64);
+    device_param->kernel_threads_max = MIN (device_param->kernel_threads_max, 64);
 
-      device_param->overtune_unfriendly = true;
-    }
+    device_param->overtune_unfriendly = true;
+  }
 
-    device_param->kernel_threads = 0;
-    device_param->kernel_accel = 0;
+  device_param->kernel_threads = 0;
+  device_param->kernel_accel = 0;
 
-    u32 kernel_threads_min = device_param->kernel_threads_min;
-    u32 kernel_threads_max = device_param->kernel_threads_max;
+  u32 kernel_threads_min = device_param->kernel_threads_min;
+  u32 kernel_threads_max = device_param->kernel_threads_max;
 
-    u32 kernel_accel_min = device_param->kernel_accel_min;
-    u32 kernel_accel_max = device_param->kernel_accel_max;
+  u32 kernel_accel_min = device_param->kernel_accel_min;
+  u32 kernel_accel_max = device_param->kernel_accel_max;
 
-    // check if there's enough host memory left for upcoming allocations, otherwise reduce skip device and present user an option to deal with
+  // check if there's enough host memory left for upcoming allocations, otherwise reduce skip device and present user an option to deal with
 
-    u64 accel_limit_host = 0;
+  u64 accel_limit_host = 0;
 
-    if (get_free_memory (&accel_limit_host) == false)
-    {
-      const u64 GiB4 = 4ULL * 1024 * 1024 * 1024;
+  if (get_free_memory (&accel_limit_host) == false)
+  {
+    const u64 GiB4 = 4ULL * 1024 * 1024 * 1024;
 
-      event_log_warning (hashcat_ctx, "Couldn't query the OS for free memory, assuming 4GiB is available per compute device");
+    event_log_warning (hashcat_ctx, "Couldn't query the OS for free memory, assuming 4GiB is available per compute device");
 
-      accel_limit_host = GiB4;
+    accel_limit_host = GiB4;
+  }
+  else
+  {
+    if (user_options->backend_devices_keepfree)
+    {
+      accel_limit_host = ((u64) accel_limit_host * (100 - user_options->backend_devices_keepfree)) / 100;
     }
     else
     {
-      if (user_options->backend_devices_keepfree)
-      {
-        accel_limit_host = ((u64) accel_limit_host * (100 - user_options->backend_devices_keepfree)) / 100;
-      }
-      else
-      {
-        accel_limit_host = accel_limit_host - (accel_limit_host * 0.34);
-      }
+      accel_limit_host = accel_limit_host - (accel_limit_host * 0.34);
+    }
 
-      accel_limit_host /= backend_ctx->backend_devices_active;
+    accel_limit_host /= backend_ctx->backend_devices_active;
 
-      // even tho let's not be greedy
+    // even tho let's not be greedy
 
-      const u64 GiB8 = 8ULL * 1024 * 1024 * 1024;
+    const u64 GiB8 = 8ULL * 1024 * 1024 * 1024;
 
-      accel_limit_host = MIN (accel_limit_host, GiB8);
-    }
+    accel_limit_host = MIN (accel_limit_host, GiB8);
+  }
 
-    // Opposite direction check: find out if we would request too much memory on memory blocks which are based on kernel_accel
+  // Opposite direction check: find out if we would request too much memory on memory blocks which are based on kernel_accel
+
+  u64 size_pws      = 4;
+  u64 size_pws_amp  = 4;
+  u64 size_pws_comp = 4;
+  u64 size_pws_idx  = 4;
+  u64 size_pws_pre  = 4;
+  u64 size_pws_base = 4;
+  u64 size_tmps     = 4;
+  u64 size_hooks    = 4;
+  #ifdef WITH_BRAIN
+  u64 size_brain_link_in  = 4;
+  u64 size_brain_link_out = 4;
+  #endif
 
-    u64 size_pws      = 4;
-    u64 size_pws_amp  = 4;
-    u64 size_pws_comp = 4;
-    u64 size_pws_idx  = 4;
-    u64 size_pws_pre  = 4;
-    u64 size_pws_base = 4;
-    u64 size_tmps     = 4;
-    u64 size_hooks    = 4;
-    #ifdef WITH_BRAIN
-    u64 size_brain_link_in  = 4;
-    u64 size_brain_link_out = 4;
+  u32 local_size_bytes = 0;
+
+  if ((device_param->is_cuda == true) || (device_param->is_hip == true) || (device_param->is_opencl == true))
+  {
+    if (device_param->is_cuda   == true) local_size_bytes = cuda_query_max_local_size_bytes   (hashcat_ctx, device_param);
+    if (device_param->is_hip    == true) local_size_bytes = hip_query_max_local_size_bytes    (hashcat_ctx, device_param);
+    if (device_param->is_opencl == true) local_size_bytes = opencl_query_max_local_size_bytes (hashcat_ctx, device_param);
+    #if defined (__APPLE__)
+    if (device_param->is_metal  == true) local_size_bytes = metal_query_max_local_size_bytes  (hashcat_ctx, device_param);
     #endif
+  }
 
-    u32 local_size_bytes = 0;
+  const u64 size_device_extra1234 = size_extra_buffer1 + size_extra_buffer2 + size_extra_buffer3 + size_extra_buffer4;
 
-    if ((device_param->is_cuda == true) || (device_param->is_hip == true) || (device_param->is_opencl == true))
-    {
-      if (device_param->is_cuda   == true) local_size_bytes = cuda_query_max_local_size_bytes   (hashcat_ctx, device_param);
-      if (device_param->is_hip    == true) local_size_bytes = hip_query_max_local_size_bytes    (hashcat_ctx, device_param);
-      if (device_param->is_opencl == true) local_size_bytes = opencl_query_max_local_size_bytes (hashcat_ctx, device_param);
-      #if defined (__APPLE__)
-      if (device_param->is_metal  == true) local_size_bytes = metal_query_max_local_size_bytes  (hashcat_ctx, device_param);
-      #endif
-    }
+  // Still not 100% sure about the 64MiB here
 
-    const u64 size_device_extra1234 = size_extra_buffer1 + size_extra_buffer2 + size_extra_buffer3 + size_extra_buffer4;
+  const u64 size_device_extra = MAX ((64ULL * 1024 * 1024), size_device_extra1234);
 
-    // Still not 100% sure about the 64MiB here
+  // we will first decrease accel and when reached that limit, we will decrease threads
+  // when we decrease limit this will restore accel_max
 
-    const u64 size_device_extra = MAX ((64ULL * 1024 * 1024), size_device_extra1234);
+  int memory_limit_hit = 0;
 
-    // we will first decrease accel and when reached that limit, we will decrease threads
-    // when we decrease limit this will restore accel_max
+  const u32 kernel_accel_max_sav = kernel_accel_max;
 
-    int memory_limit_hit = 0;
+  while ((kernel_accel_max >= kernel_accel_min) || (kernel_threads_max >= kernel_threads_min))
+  {
+    const u64 device_processors = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors);
+    const u64 kernel_threads    = ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : kernel_threads_max);
 
-    const u32 kernel_accel_max_sav = kernel_accel_max;
+    const u64 kernel_power_max = device_processors * kernel_threads * kernel_accel_max;
 
-    while ((kernel_accel_max >= kernel_accel_min) || (kernel_threads_max >= kernel_threads_min))
-    {
-      const u64 device_processors = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors);
-      const u64 kernel_threads    = ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : kernel_threads_max);
+    // size_spilling
 
-      const u64 kernel_power_max = device_processors * kernel_threads * kernel_accel_max;
+    const u64 size_spilling = kernel_power_max * local_size_bytes;
 
-      // size_spilling
+    // size_pws
 
-      const u64 size_spilling = kernel_power_max * local_size_bytes;
+    size_pws = kernel_power_max * sizeof (pw_t);
 
-      // size_pws
+    size_pws_amp = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL) ? 1 : size_pws;
 
-      size_pws = kernel_power_max * sizeof (pw_t);
+    // size_pws_comp
 
-      size_pws_amp = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL) ? 1 : size_pws;
+    size_pws_comp = kernel_power_max * (sizeof (u32) * 64);
 
-      // size_pws_comp
+    // size_pws_idx
 
-      size_pws_comp = kernel_power_max * (sizeof (u32) * 64);
+    size_pws_idx = (kernel_power_max + 1) * sizeof (pw_idx_t);
 
-      // size_pws_idx
+    // size_tmps
 
-      size_pws_idx = (kernel_power_max + 1) * sizeof (pw_idx_t);
+    size_tmps = kernel_power_max * hashconfig->tmp_size;
 
-      // size_tmps
+    // size_hooks
 
-      size_tmps = kernel_power_max * hashconfig->tmp_size;
+    size_hooks = kernel_power_max * hashconfig->hook_size;
 
-      // size_hooks
+    #ifdef WITH_BRAIN
+    // size_brains
 
-      size_hooks = kernel_power_max * hashconfig->hook_size;
+    size_brain_link_in  = kernel_power_max * 1;
+    size_brain_link_out = kernel_power_max * 8;
+    #endif
 
-      #ifdef WITH_BRAIN
-      // size_brains
+    if (user_options->slow_candidates == true)
+    {
+      // size_pws_pre
+
+      size_pws_pre = kernel_power_max * sizeof (pw_pre_t);
+
+      // size_pws_base
+
+      size_pws_base = kernel_power_max * sizeof (pw_pre_t);
+    }
+
+    // now check if all device-memory sizes which depend on the kernel_accel_max amplifier are within its boundaries
+    // if not, decrease amplifier and try again
+
+    memory_limit_hit = 0;
+
+    // sometimes device_available_mem and device_maxmem_alloc reported back from the opencl runtime are a bit inaccurate.
+    // let's add some extra space just to be sure.
+    // now depends on the kernel-accel value (where scrypt and similar benefits), but also hard minimum 64mb and maximum 1024mb limit
+    // let's see if we still need this now that we have low-level API to report free memory
+    // we don't want these get too big. if a plugin requires really a lot of memory, the extra buffer should be used instead.
+
+    if (size_pws   > device_param->device_maxmem_alloc / 4) memory_limit_hit = 1;
+    if (size_tmps  > device_param->device_maxmem_alloc / 4) memory_limit_hit = 1;
+    if (size_hooks > device_param->device_maxmem_alloc / 4) memory_limit_hit = 1;
+
+    // work around, for some reason apple opencl can't have buffers larger 2^31
+    // typically runs into trap 6
+    // maybe 32/64 bit problem affecting size_t?
+    // this is really ugly, and still in place 2025/06/09
+    //  Version.: OpenCL 1.2 (Apr 18 2025 21:45:30)
+    //  Driver.Version.: 1.2 (Apr 22 2025 20:11:41)
+
+    if ((device_param->opencl_platform_vendor_id == VENDOR_ID_APPLE) && (device_param->is_metal == false))
+    {
+      const size_t undocumented_single_allocation_apple = 0x7fffffff;
+
+      if (bitmap_ctx->bitmap_size > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_bfs                > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_combs              > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_digests            > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_esalts             > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_hooks              > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_markov_css         > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_plains             > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_pws                > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_pws_amp            > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_pws_comp           > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_pws_idx            > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_results            > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_root_css           > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_rules              > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_rules_c            > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_salts              > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_extra_buffer1      > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_extra_buffer2      > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_extra_buffer3      > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_extra_buffer4      > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_shown              > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_tm                 > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_tmps               > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_st_digests         > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_st_salts           > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_st_esalts          > undocumented_single_allocation_apple) memory_limit_hit = 1;
+      if (size_kernel_params      > undocumented_single_allocation_apple) memory_limit_hit = 1;
+    }
+
+    const u64 size_total
+      = bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + bitmap_ctx->bitmap_size
+      + size_bfs
+      + size_combs
+      + size_digests
+      + size_esalts
+      + size_hooks
+      + size_markov_css
+      + size_plains
+      + size_pws
+      + size_pws_amp
+      + size_pws_comp
+      + size_pws_idx
+      + size_results
+      + size_root_css
+      + size_rules
+      + size_rules_c
+      + size_salts
+      + size_device_extra
+      + size_shown
+      + size_tm
+      + size_tmps
+      + size_st_digests
+      + size_st_salts
+      + size_st_esalts
+      + size_kernel_params
+      + size_spilling;
 
-      size_brain_link_in  = kernel_power_max * 1;
-      size_brain_link_out = kernel_power_max * 8;
-      #endif
+    if (size_total > device_param->device_available_mem) memory_limit_hit = 1;
 
-      if (user_options->slow_candidates == true)
-      {
-        // size_pws_pre
-
-        size_pws_pre = kernel_power_max * sizeof (pw_pre_t);
-
-        // size_pws_base
-
-        size_pws_base = kernel_power_max * sizeof (pw_pre_t);
-      }
-
-      // now check if all device-memory sizes which depend on the kernel_accel_max amplifier are within its boundaries
-      // if not, decrease amplifier and try again
-
-      memory_limit_hit = 0;
-
-      // sometimes device_available_mem and device_maxmem_alloc reported back from the opencl runtime are a bit inaccurate.
-      // let's add some extra space just to be sure.
-      // now depends on the kernel-accel value (where scrypt and similar benefits), but also hard minimum 64mb and maximum 1024mb limit
-      // let's see if we still need this now that we have low-level API to report free memory
-      // we don't want these get too big. if a plugin requires really a lot of memory, the extra buffer should be used instead.
-
-      if (size_pws   > device_param->device_maxmem_alloc / 4) memory_limit_hit = 1;
-      if (size_tmps  > device_param->device_maxmem_alloc / 4) memory_limit_hit = 1;
-      if (size_hooks > device_param->device_maxmem_alloc / 4) memory_limit_hit = 1;
-
-      // work around, for some reason apple opencl can't have buffers larger 2^31
-      // typically runs into trap 6
-      // maybe 32/64 bit problem affecting size_t?
-      // this is really ugly, and still in place 2025/06/09
-      //  Version.: OpenCL 1.2 (Apr 18 2025 21:45:30)
-      //  Driver.Version.: 1.2 (Apr 22 2025 20:11:41)
-
-      if ((device_param->opencl_platform_vendor_id == VENDOR_ID_APPLE) && (device_param->is_metal == false))
-      {
-        const size_t undocumented_single_allocation_apple = 0x7fffffff;
-
-        if (bitmap_ctx->bitmap_size > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_bfs                > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_combs              > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_digests            > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_esalts             > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_hooks              > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_markov_css         > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_plains             > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_pws                > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_pws_amp            > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_pws_comp           > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_pws_idx            > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_results            > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_root_css           > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_rules              > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_rules_c            > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_salts              > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_extra_buffer1      > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_extra_buffer2      > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_extra_buffer3      > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_extra_buffer4      > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_shown              > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_tm                 > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_tmps               > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_st_digests         > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_st_salts           > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_st_esalts          > undocumented_single_allocation_apple) memory_limit_hit = 1;
-        if (size_kernel_params      > undocumented_single_allocation_apple) memory_limit_hit = 1;
-      }
-
-      const u64 size_total
-        = bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + bitmap_ctx->bitmap_size
-        + size_bfs
-        + size_combs
-        + size_digests
-        + size_esalts
-        + size_hooks
-        + size_markov_css
-        + size_plains
-        + size_pws
-        + size_pws_amp
-        + size_pws_comp
-        + size_pws_idx
-        + size_results
-        + size_root_css
-        + size_rules
-        + size_rules_c
-        + size_salts
-        + size_device_extra
-        + size_shown
-        + size_tm
-        + size_tmps
-        + size_st_digests
-        + size_st_salts
-        + size_st_esalts
-        + size_kernel_params
-        + size_spilling;
-
-      if (size_total > device_param->device_available_mem) memory_limit_hit = 1;
-
-      const u64 size_host_extra = (512 * 1024 * 1024) / backend_ctx->backend_devices_active;
-
-      const u64 size_total_host
-        = size_pws_comp
-        + size_pws_idx
-        + size_hooks
-        #ifdef WITH_BRAIN
-        + size_brain_link_in
-        + size_brain_link_out
-        #endif
-        + size_pws_pre
-        + size_pws_base
-        + size_host_extra;
+    const u64 size_host_extra = (512 * 1024 * 1024) / backend_ctx->backend_devices_active;
+
+    const u64 size_total_host
+      = size_pws_comp
+      + size_pws_idx
+      + size_hooks
+      #ifdef WITH_BRAIN
+      + size_brain_link_in
+      + size_brain_link_out
+      #endif
+      + size_pws_pre
+      + size_pws_base
+      + size_host_extra;
 
-      if (size_total_host > accel_limit_host) memory_limit_hit = 1;
+    if (size_total_host > accel_limit_host) memory_limit_hit = 1;
 
-      //printf ("%zu %zu %d %d\n", size_total, device_param->device_available_mem, kernel_accel_max, kernel_threads_max);
+    //printf ("%zu %zu %d %d\n", size_total, device_param->device_available_mem, kernel_accel_max, kernel_threads_max);
 
-      if (memory_limit_hit == 1)
+    if (memory_limit_hit == 1)
+    {
+      if (kernel_accel_max == kernel_accel_min)
       {
-        if (kernel_accel_max == kernel_accel_min)
+        if ((kernel_threads_max > kernel_threads_min) && (kernel_threads_max >= (device_param->kernel_preferred_wgs_multiple * 2)))
         {
-          if ((kernel_threads_max > kernel_threads_min) && (kernel_threads_max >= (device_param->kernel_preferred_wgs_multiple * 2)))
-          {
-            kernel_threads_max -= device_param->kernel_preferred_wgs_multiple;
+          kernel_threads_max -= device_param->kernel_preferred_wgs_multiple;
 
-            kernel_accel_max = kernel_accel_max_sav;
-          }
-          else
-          {
-            break;
-          }
+          kernel_accel_max = kernel_accel_max_sav;
         }
         else
         {
-          kernel_accel_max--;
+          break;
         }
+      }
+      else
+      {
+        kernel_accel_max--;
+      }
+
+      continue;
+    }
+
+    session_param->size_total_host += size_total_host;
+
+    break;
+  }
+
+  if (memory_limit_hit == 1)
+  {
+    event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory or free host memory for mapping.", device_id + 1);
+
+    session_param->memory_hit_warnings++;
+
+    device_param->skipped_warning = true;
+
+    return 0;
+  }
+
+  // similar process for association attack
+  // there's no need to have a device_power > salts_cnt since salt_pos is set to GID in kernel
+
+  if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+  {
+    while (kernel_accel_max > kernel_accel_min)
+    {
+      const u64 kernel_power_max = device_param->device_processors * kernel_accel_max;
+
+      if (kernel_power_max > hashes->salts_cnt)
+      {
+        kernel_accel_max--;
 
         continue;
       }
 
-      size_total_host_all += size_total_host;
-
       break;
     }
+  }
 
-    if (memory_limit_hit == 1)
-    {
-      event_log_error (hashcat_ctx, "* Device #%u: Not enough allocatable device memory or free host memory for mapping.", device_id + 1);
+  device_param->kernel_threads_min = kernel_threads_min;
+  device_param->kernel_threads_max = kernel_threads_max;
+
+  const u32 hardware_power_max = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors)
+                               * ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : device_param->kernel_threads_max);
+
+  device_param->kernel_accel_min = kernel_accel_min;
+  device_param->kernel_accel_max = kernel_accel_max;
+
+  device_param->size_pws      = size_pws;
+  device_param->size_pws_amp  = size_pws_amp;
+  device_param->size_pws_comp = size_pws_comp;
+  device_param->size_pws_idx  = size_pws_idx;
+  device_param->size_pws_pre  = size_pws_pre;
+  device_param->size_pws_base = size_pws_base;
+  device_param->size_tmps     = size_tmps;
+  device_param->size_hooks    = size_hooks;
+  #ifdef WITH_BRAIN
+  device_param->size_brain_link_in  = size_brain_link_in;
+  device_param->size_brain_link_out = size_brain_link_out;
+  #endif
 
-      backend_memory_hit_warnings++;
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_buf,      size_pws)      == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_comp_buf, size_pws_comp) == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_idx,      size_pws_idx)  == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tmps,         size_tmps)     == -1) return -1;
+    if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_hooks,        size_hooks)    == -1) return -1;
+
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tmps,          device_param->size_tmps)     == -1) return -1;
+    if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_hooks,         device_param->size_hooks)    == -1) return -1;
+  }
 
-      device_param->skipped_warning = true;
+  if (device_param->is_hip == true)
+  {
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_buf,      size_pws)      == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_comp_buf, size_pws_comp) == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_idx,      size_pws_idx)  == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_tmps,         size_tmps)     == -1) return -1;
+    if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_hooks,        size_hooks)    == -1) return -1;
+
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_tmps,          device_param->size_tmps)     == -1) return -1;
+    if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_hooks,         device_param->size_hooks)    == -1) return -1;
+  }
 
-      continue;
-    }
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws,      NULL, pws_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws_amp,  NULL, pws_amp_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws_comp, NULL, pws_comp_buf);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws_idx,  NULL, pws_idx);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_tmps,     NULL, tmps);
+    HC_MTL_CREATEBUFFER(hashcat_ctx, size_hooks,    NULL, hooks);
+
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_tmps,          device_param->size_tmps)     == -1) return -1;
+    if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_hooks,         device_param->size_hooks)    == -1) return -1;
+  }
+  #endif
+
+  if (device_param->is_opencl == true)
+  {
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws,      NULL, pws_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws_amp,  NULL, pws_amp_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws_comp, NULL, pws_comp_buf);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws_idx,  NULL, pws_idx);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_tmps,     NULL, tmps);
+    HC_OCL_CREATEBUFFER(hashcat_ctx, size_hooks,    NULL, hooks);
+
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_buf,       device_param->size_pws)      == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tmps,          device_param->size_tmps)     == -1) return -1;
+    if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_hooks,         device_param->size_hooks)    == -1) return -1;
+  }
+
+  /**
+   * main host data
+   */
+
+  if (hashconfig->bridge_type)
+  {
+    void *h_tmps = hcmalloc_bridge_aligned (device_param->size_tmps, 64);
+
+    device_param->h_tmps = h_tmps;
+  }
+
+  u32 *pws_comp = (u32 *) hcmalloc (size_pws_comp);
+
+  device_param->pws_comp = pws_comp;
+
+  pw_idx_t *pws_idx = (pw_idx_t *) hcmalloc (size_pws_idx);
+
+  device_param->pws_idx = pws_idx;
+
+  pw_t *combs_buf = (pw_t *) hccalloc (KERNEL_COMBS, sizeof (pw_t));
+
+  device_param->combs_buf = combs_buf;
+
+  u32 *salts_active_buf = (u32 *) hccalloc (hashes->salts_cnt, sizeof (u32));
+
+  device_param->salts_active_buf  = salts_active_buf;
+  device_param->salts_active_cnt  = 0;
+  device_param->salts_active_done = (u32) -1;
+
+  void *hooks_buf = hcmalloc (size_hooks);
+
+  device_param->hooks_buf = hooks_buf;
+
+  char *scratch_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  device_param->scratch_buf = scratch_buf;
+
+  #ifdef WITH_BRAIN
+  u8 *brain_link_in_buf = (u8 *) hcmalloc (size_brain_link_in);
+
+  device_param->brain_link_in_buf = brain_link_in_buf;
+
+  u32 *brain_link_out_buf = (u32 *) hcmalloc (size_brain_link_out);
+
+  device_param->brain_link_out_buf = brain_link_out_buf;
+  #endif
+
+  pw_pre_t *pws_pre_buf = (pw_pre_t *) hcmalloc (size_pws_pre);
+
+  device_param->pws_pre_buf = pws_pre_buf;
+
+  pw_pre_t *pws_base_buf = (pw_pre_t *) hcmalloc (size_pws_base);
+
+  device_param->pws_base_buf = pws_base_buf;
+
+  /**
+   * kernel args
+   */
+
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params[ 0] = &device_param->cuda_d_pws_buf;
+    device_param->kernel_params[ 4] = &device_param->cuda_d_tmps;
+    device_param->kernel_params[ 5] = &device_param->cuda_d_hooks;
+  }
+
+  if (device_param->is_hip == true)
+  {
+    device_param->kernel_params[ 0] = &device_param->hip_d_pws_buf;
+    device_param->kernel_params[ 4] = &device_param->hip_d_tmps;
+    device_param->kernel_params[ 5] = &device_param->hip_d_hooks;
+  }
+
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    device_param->kernel_params[ 0] = device_param->metal_d_pws_buf.buf_ptr;
+    device_param->kernel_params[ 4] = device_param->metal_d_tmps.buf_ptr;
+    device_param->kernel_params[ 5] = device_param->metal_d_hooks.buf_ptr;
+  }
+  #endif
 
-    // similar process for association attack
-    // there's no need to have a device_power > salts_cnt since salt_pos is set to GID in kernel
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params[ 0] = &device_param->opencl_d_pws_buf;
+    device_param->kernel_params[ 4] = &device_param->opencl_d_tmps;
+    device_param->kernel_params[ 5] = &device_param->opencl_d_hooks;
+  }
 
-    if (user_options->attack_mode == ATTACK_MODE_ASSOCIATION)
+  if (user_options->slow_candidates == true)
+  {
+  }
+  else
+  {
+    if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
+    {
+      // nothing to do
+    }
+    else
     {
-      while (kernel_accel_max > kernel_accel_min)
+      if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
       {
-        const u64 kernel_power_max = device_param->device_processors * kernel_accel_max;
+        if (device_param->is_cuda == true)
+        {
+          device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->cuda_d_pws_buf
+                                            : &device_param->cuda_d_pws_amp_buf;
+
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
+        }
+
+        if (device_param->is_hip == true)
+        {
+          device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->hip_d_pws_buf
+                                            : &device_param->hip_d_pws_amp_buf;
+
+          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
+        }
+
+        #if defined (__APPLE__)
+        if (device_param->is_metal == true)
+        {
+          device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? device_param->metal_d_pws_buf.buf_ptr
+                                            : device_param->metal_d_pws_amp_buf.buf_ptr;
+        }
+        #endif
 
-        if (kernel_power_max > hashes->salts_cnt)
+        if (device_param->is_opencl == true)
         {
-          kernel_accel_max--;
+          device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->opencl_d_pws_buf
+                                            : &device_param->opencl_d_pws_amp_buf;
 
-          continue;
+          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]) == -1) return -1;
         }
-
-        break;
       }
     }
 
-    device_param->kernel_threads_min = kernel_threads_min;
-    device_param->kernel_threads_max = kernel_threads_max;
+    if (user_options->attack_mode == ATTACK_MODE_BF)
+    {
+      if (device_param->is_cuda == true)
+      {
+        device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->cuda_d_pws_buf
+                                            : &device_param->cuda_d_pws_amp_buf;
 
-    const u32 hardware_power_max = ((hashconfig->opts_type & OPTS_TYPE_MP_MULTI_DISABLE)     ? 1 : device_param->device_processors)
-                                 * ((hashconfig->opts_type & OPTS_TYPE_THREAD_MULTI_DISABLE) ? 1 : device_param->kernel_threads_max);
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
+      }
 
-    device_param->kernel_accel_min = kernel_accel_min;
-    device_param->kernel_accel_max = kernel_accel_max;
+      if (device_param->is_hip == true)
+      {
+        device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->hip_d_pws_buf
+                                            : &device_param->hip_d_pws_amp_buf;
 
-    device_param->size_pws      = size_pws;
-    device_param->size_pws_amp  = size_pws_amp;
-    device_param->size_pws_comp = size_pws_comp;
-    device_param->size_pws_idx  = size_pws_idx;
-    device_param->size_pws_pre  = size_pws_pre;
-    device_param->size_pws_base = size_pws_base;
-    device_param->size_tmps     = size_tmps;
-    device_param->size_hooks    = size_hooks;
-    #ifdef WITH_BRAIN
-    device_param->size_brain_link_in  = size_brain_link_in;
-    device_param->size_brain_link_out = size_brain_link_out;
-    #endif
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
+      }
 
-    if (device_param->is_cuda == true)
-    {
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_buf,      size_pws)      == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_comp_buf, size_pws_comp) == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_pws_idx,      size_pws_idx)  == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_tmps,         size_tmps)     == -1) return -1;
-      if (hc_cuMemAlloc (hashcat_ctx, &device_param->cuda_d_hooks,        size_hooks)    == -1) return -1;
+      #if defined (__APPLE__)
+      if (device_param->is_metal == true)
+      {
+        device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? device_param->metal_d_pws_buf.buf_ptr
+                                            : device_param->metal_d_pws_amp_buf.buf_ptr;
+      }
+      #endif
+
+      if (device_param->is_opencl == true)
+      {
+        device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                            ? &device_param->opencl_d_pws_buf
+                                            : &device_param->opencl_d_pws_amp_buf;
 
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_buf,       device_param->size_pws)      == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_tmps,          device_param->size_tmps)     == -1) return -1;
-      if (run_cuda_kernel_bzero (hashcat_ctx, device_param, device_param->cuda_d_hooks,         device_param->size_hooks)    == -1) return -1;
+        if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]) == -1) return -1;
+      }
     }
 
-    if (device_param->is_hip == true)
+    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
     {
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_buf,      size_pws)      == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_amp_buf,  size_pws_amp)  == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_comp_buf, size_pws_comp) == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_pws_idx,      size_pws_idx)  == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_tmps,         size_tmps)     == -1) return -1;
-      if (hc_hipMemAlloc (hashcat_ctx, &device_param->hip_d_hooks,        size_hooks)    == -1) return -1;
-
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_buf,       device_param->size_pws)      == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_tmps,          device_param->size_tmps)     == -1) return -1;
-      if (run_hip_kernel_bzero (hashcat_ctx, device_param, device_param->hip_d_hooks,         device_param->size_hooks)    == -1) return -1;
+      // nothing to do
     }
-
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
+    else
     {
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws,      NULL, pws_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws_amp,  NULL, pws_amp_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws_comp, NULL, pws_comp_buf);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_pws_idx,  NULL, pws_idx);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_tmps,     NULL, tmps);
-      HC_MTL_CREATEBUFFER(hashcat_ctx, size_hooks,    NULL, hooks);
+      if (device_param->is_cuda == true)
+      {
+        device_param->kernel_params_amp[0] = &device_param->cuda_d_pws_buf;
+        device_param->kernel_params_amp[1] = &device_param->cuda_d_pws_amp_buf;
 
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_buf,       device_param->size_pws)      == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_tmps,          device_param->size_tmps)     == -1) return -1;
-      if (run_metal_kernel_bzero (hashcat_ctx, device_param, device_param->metal_d_hooks,         device_param->size_hooks)    == -1) return -1;
-    }
-    #endif
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
+      }
 
-    if (device_param->is_opencl == true)
-    {
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws,      NULL, pws_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws_amp,  NULL, pws_amp_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws_comp, NULL, pws_comp_buf);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_pws_idx,  NULL, pws_idx);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_tmps,     NULL, tmps);
-      HC_OCL_CREATEBUFFER(hashcat_ctx, size_hooks,    NULL, hooks);
+      if (device_param->is_hip == true)
+      {
+        device_param->kernel_params_amp[0] = &device_param->hip_d_pws_buf;
+        device_param->kernel_params_amp[1] = &device_param->hip_d_pws_amp_buf;
 
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_buf,       device_param->size_pws)      == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_amp_buf,   device_param->size_pws_amp)  == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_comp_buf,  device_param->size_pws_comp) == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_pws_idx,       device_param->size_pws_idx)  == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_tmps,          device_param->size_tmps)     == -1) return -1;
-      if (run_opencl_kernel_bzero (hashcat_ctx, device_param, device_param->opencl_d_hooks,         device_param->size_hooks)    == -1) return -1;
-    }
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
+        //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
+      }
 
-    /**
-     * main host data
-     */
+      #if defined (__APPLE__)
+      if (device_param->is_metal == true)
+      {
+        device_param->kernel_params_amp[0] = device_param->metal_d_pws_buf.buf_ptr;
+        device_param->kernel_params_amp[1] = device_param->metal_d_pws_amp_buf.buf_ptr;
+      }
+      #endif
 
-    if (hashconfig->bridge_type)
-    {
-      void *h_tmps = hcmalloc_bridge_aligned (device_param->size_tmps, 64);
+      if (device_param->is_opencl == true)
+      {
+        device_param->kernel_params_amp[0] = &device_param->opencl_d_pws_buf;
+        device_param->kernel_params_amp[1] = &device_param->opencl_d_pws_amp_buf;
 
-      device_param->h_tmps = h_tmps;
+        if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]) == -1) return -1;
+        if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]) == -1) return -1;
+      }
     }
+  }
 
-    u32 *pws_comp = (u32 *) hcmalloc (size_pws_comp);
+  if (device_param->is_cuda == true)
+  {
+    device_param->kernel_params_decompress[0] = &device_param->cuda_d_pws_idx;
+    device_param->kernel_params_decompress[1] = &device_param->cuda_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                              ? &device_param->cuda_d_pws_buf
+                                              : &device_param->cuda_d_pws_amp_buf;
 
-    device_param->pws_comp = pws_comp;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
+  }
 
-    pw_idx_t *pws_idx = (pw_idx_t *) hcmalloc (size_pws_idx);
+  if (device_param->is_hip == true)
+  {
+    device_param->kernel_params_decompress[0] = &device_param->hip_d_pws_idx;
+    device_param->kernel_params_decompress[1] = &device_param->hip_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                              ? &device_param->hip_d_pws_buf
+                                              : &device_param->hip_d_pws_amp_buf;
 
-    device_param->pws_idx = pws_idx;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
+    //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
+  }
 
-    pw_t *combs_buf = (pw_t *) hccalloc (KERNEL_COMBS, sizeof (pw_t));
+  #if defined (__APPLE__)
+  if (device_param->is_metal == true)
+  {
+    device_param->kernel_params_decompress[0] = device_param->metal_d_pws_idx.buf_ptr;
+    device_param->kernel_params_decompress[1] = device_param->metal_d_pws_comp_buf.buf_ptr;
+    device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                              ? device_param->metal_d_pws_buf.buf_ptr
+                                              : device_param->metal_d_pws_amp_buf.buf_ptr;
+  }
+  #endif
 
-    device_param->combs_buf = combs_buf;
+  if (device_param->is_opencl == true)
+  {
+    device_param->kernel_params_decompress[0] = &device_param->opencl_d_pws_idx;
+    device_param->kernel_params_decompress[1] = &device_param->opencl_d_pws_comp_buf;
+    device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+                                              ? &device_param->opencl_d_pws_buf
+                                              : &device_param->opencl_d_pws_amp_buf;
 
-    void *hooks_buf = hcmalloc (size_hooks);
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]) == -1) return -1;
+    if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]) == -1) return -1;
+  }
 
-    device_param->hooks_buf = hooks_buf;
+  // context
 
-    char *scratch_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+  if (device_param->is_cuda == true)
+  {
+    if (hc_cuCtxPopCurrent (hashcat_ctx, &device_param->cuda_context) == -1)
+    {
+      device_param->skipped = true;
 
-    device_param->scratch_buf = scratch_buf;
+      return 0;
+    }
+  }
 
-    #ifdef WITH_BRAIN
-    u8 *brain_link_in_buf = (u8 *) hcmalloc (size_brain_link_in);
+  session_param->hardware_power = hardware_power_max;
 
-    device_param->brain_link_in_buf = brain_link_in_buf;
+  EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_POST, &backend_devices_idx, sizeof (int));
 
-    u32 *brain_link_out_buf = (u32 *) hcmalloc (size_brain_link_out);
+  return 0;
+}
 
-    device_param->brain_link_out_buf = brain_link_out_buf;
-    #endif
+#if defined (_WIN32) || defined (__WIN32__)
+static HC_API_CALL DWORD thread_backend_session_begin (void *p)
+#else
+static HC_API_CALL void *thread_backend_session_begin (void *p)
+#endif
+{
+  backend_session_param_t *session_param = (backend_session_param_t *) p;
 
-    pw_pre_t *pws_pre_buf = (pw_pre_t *) hcmalloc (size_pws_pre);
+  hashcat_ctx_t *hashcat_ctx = session_param->hashcat_ctx;
 
-    device_param->pws_pre_buf = pws_pre_buf;
+  backend_ctx_t        *backend_ctx  = hashcat_ctx->backend_ctx;
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  status_ctx_t         *status_ctx   = hashcat_ctx->status_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
 
-    pw_pre_t *pws_base_buf = (pw_pre_t *) hcmalloc (size_pws_base);
+  session_param->rc = backend_session_begin_device (session_param);
 
-    device_param->pws_base_buf = pws_base_buf;
+  if (session_param->rc == -1) return 0;
 
-    /**
-     * kernel args
-     */
+  // --kernel-cache-prewarm stops after the kernels are built
 
-    if (device_param->is_cuda == true)
-    {
-      device_param->kernel_params[ 0] = &device_param->cuda_d_pws_buf;
-      device_param->kernel_params[ 4] = &device_param->cuda_d_tmps;
-      device_param->kernel_params[ 5] = &device_param->cuda_d_hooks;
-    }
+  if (user_options->kernel_cache_prewarm == true) return 0;
 
-    if (device_param->is_hip == true)
-    {
-      device_param->kernel_params[ 0] = &device_param->hip_d_pws_buf;
-      device_param->kernel_params[ 4] = &device_param->hip_d_tmps;
-      device_param->kernel_params[ 5] = &device_param->hip_d_hooks;
-    }
+  if (hashconfig->opts_type & OPTS_TYPE_SELF_TEST_DISABLE) return 0;
 
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
-    {
-      device_param->kernel_params[ 0] = device_param->metal_d_pws_buf.buf_ptr;
-      device_param->kernel_params[ 4] = device_param->metal_d_tmps.buf_ptr;
-      device_param->kernel_params[ 5] = device_param->metal_d_hooks.buf_ptr;
-    }
-    #endif
+  // no need to wait for the other devices, but only the first one ready announces the self-test
 
-    if (device_param->is_opencl == true)
-    {
-      device_param->kernel_params[ 0] = &device_param->opencl_d_pws_buf;
-      device_param->kernel_params[ 4] = &device_param->opencl_d_tmps;
-      device_param->kernel_params[ 5] = &device_param->opencl_d_hooks;
-    }
+  hc_thread_mutex_lock (backend_ctx->mux_selftest_start);
 
-    if (user_options->slow_candidates == true)
-    {
-    }
-    else
-    {
-      if (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL)
-      {
-        // nothing to do
-      }
-      else
-      {
-        if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-        {
-          if (device_param->is_cuda == true)
-          {
-            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->cuda_d_pws_buf
-                                              : &device_param->cuda_d_pws_amp_buf;
+  if (backend_ctx->selftest_started == false)
+  {
+    status_ctx->devices_status = STATUS_SELFTEST;
 
-            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
-          }
+    EVENT (EVENT_SELFTEST_STARTING);
 
-          if (device_param->is_hip == true)
-          {
-            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->hip_d_pws_buf
-                                              : &device_param->hip_d_pws_amp_buf;
+    backend_ctx->selftest_started = true;
+  }
 
-            //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]); if (CL_rc == -1) return -1;
-          }
+  hc_thread_mutex_unlock (backend_ctx->mux_selftest_start);
 
-          #if defined (__APPLE__)
-          if (device_param->is_metal == true)
-          {
-            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? device_param->metal_d_pws_buf.buf_ptr
-                                              : device_param->metal_d_pws_amp_buf.buf_ptr;
-          }
-          #endif
+  thread_param_t thread_param;
 
-          if (device_param->is_opencl == true)
-          {
-            device_param->kernel_params_mp[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->opencl_d_pws_buf
-                                              : &device_param->opencl_d_pws_amp_buf;
+  thread_param.hashcat_ctx = hashcat_ctx;
+  thread_param.tid         = session_param->backend_devices_idx;
 
-            if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp, 0, sizeof (cl_mem), device_param->kernel_params_mp[0]) == -1) return -1;
-          }
-        }
-      }
+  thread_selftest (&thread_param);
 
-      if (user_options->attack_mode == ATTACK_MODE_BF)
-      {
-        if (device_param->is_cuda == true)
-        {
-          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->cuda_d_pws_buf
-                                              : &device_param->cuda_d_pws_amp_buf;
+  return 0;
+}
 
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
-        }
+int backend_session_begin (hashcat_ctx_t *hashcat_ctx)
+{
+        backend_ctx_t        *backend_ctx         = hashcat_ctx->backend_ctx;
+  const user_options_t       *user_options        = hashcat_ctx->user_options;
 
-        if (device_param->is_hip == true)
-        {
-          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->hip_d_pws_buf
-                                              : &device_param->hip_d_pws_amp_buf;
+  if (backend_ctx->enabled == false) return 0;
 
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]); if (CL_rc == -1) return -1;
-        }
+  u64 size_total_host_all = 0;
 
-        #if defined (__APPLE__)
-        if (device_param->is_metal == true)
-        {
-          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? device_param->metal_d_pws_buf.buf_ptr
-                                              : device_param->metal_d_pws_amp_buf.buf_ptr;
-        }
-        #endif
+  u32 hardware_power_all = 0;
 
-        if (device_param->is_opencl == true)
-        {
-          device_param->kernel_params_mp_l[0] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                              ? &device_param->opencl_d_pws_buf
-                                              : &device_param->opencl_d_pws_amp_buf;
+  int backend_memory_hit_warnings    = 0;
+  int backend_runtime_skip_warnings  = 0;
+  int backend_kernel_build_warnings  = 0;
+  int backend_kernel_create_warnings = 0;
+  int backend_kernel_accel_warnings  = 0;
+  int backend_extra_size_warning     = 0;
 
-          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_mp_l, 0, sizeof (cl_mem), device_param->kernel_params_mp_l[0]) == -1) return -1;
-        }
-      }
+  backend_ctx->memory_hit_warning    = false;
+  backend_ctx->runtime_skip_warning  = false;
+  backend_ctx->kernel_build_warning  = false;
+  backend_ctx->kernel_create_warning = false;
+  backend_ctx->kernel_accel_warnings = false;
+  backend_ctx->extra_size_warning    = false;
+  backend_ctx->mixed_warnings        = false;
 
-      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-      {
-        // nothing to do
-      }
-      else
-      {
-        if (device_param->is_cuda == true)
-        {
-          device_param->kernel_params_amp[0] = &device_param->cuda_d_pws_buf;
-          device_param->kernel_params_amp[1] = &device_param->cuda_d_pws_amp_buf;
+  /**
+   * one setup thread per device, kernel builds for identical devices are deduplicated in load_kernel()
+   */
 
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
-        }
+  for (int lock_idx = 0; lock_idx < KERNEL_BUILD_LOCKS; lock_idx++)
+  {
+    hc_thread_mutex_init (backend_ctx->mux_kernel_build[lock_idx]);
+  }
 
-        if (device_param->is_hip == true)
-        {
-          device_param->kernel_params_amp[0] = &device_param->hip_d_pws_buf;
-          device_param->kernel_params_amp[1] = &device_param->hip_d_pws_amp_buf;
+  hc_thread_mutex_init (backend_ctx->mux_tuning_db);
 
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]); if (CL_rc == -1) return -1;
-          //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]); if (CL_rc == -1) return -1;
-        }
+  hc_thread_mutex_init (backend_ctx->mux_selftest_start);
 
-        #if defined (__APPLE__)
-        if (device_param->is_metal == true)
-        {
-          device_param->kernel_params_amp[0] = device_param->metal_d_pws_buf.buf_ptr;
-          device_param->kernel_params_amp[1] = device_param->metal_d_pws_amp_buf.buf_ptr;
-        }
-        #endif
+  backend_ctx->selftest_started = false;
 
-        if (device_param->is_opencl == true)
-        {
-          device_param->kernel_params_amp[0] = &device_param->opencl_d_pws_buf;
-          device_param->kernel_params_amp[1] = &device_param->opencl_d_pws_amp_buf;
+  backend_session_param_t *session_params = (backend_session_param_t *) hccalloc (backend_ctx->backend_devices_cnt, sizeof (backend_session_param_t));
 
-          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 0, sizeof (cl_mem), device_param->kernel_params_amp[0]) == -1) return -1;
-          if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_amp, 1, sizeof (cl_mem), device_param->kernel_params_amp[1]) == -1) return -1;
-        }
-      }
-    }
+  hc_thread_t *session_threads = (hc_thread_t *) hccalloc (backend_ctx->backend_devices_cnt, sizeof (hc_thread_t));
 
-    if (device_param->is_cuda == true)
-    {
-      device_param->kernel_params_decompress[0] = &device_param->cuda_d_pws_idx;
-      device_param->kernel_params_decompress[1] = &device_param->cuda_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                ? &device_param->cuda_d_pws_buf
-                                                : &device_param->cuda_d_pws_amp_buf;
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    backend_session_param_t *session_param = session_params + backend_devices_idx;
 
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
-    }
+    session_param->hashcat_ctx         = hashcat_ctx;
+    session_param->backend_devices_idx = backend_devices_idx;
 
-    if (device_param->is_hip == true)
-    {
-      device_param->kernel_params_decompress[0] = &device_param->hip_d_pws_idx;
-      device_param->kernel_params_decompress[1] = &device_param->hip_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                ? &device_param->hip_d_pws_buf
-                                                : &device_param->hip_d_pws_amp_buf;
+    hc_thread_create (session_threads[backend_devices_idx], thread_backend_session_begin, session_param);
+  }
 
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]); if (CL_rc == -1) return -1;
-      //CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]); if (CL_rc == -1) return -1;
-    }
+  hc_thread_wait (backend_ctx->backend_devices_cnt, session_threads);
 
-    #if defined (__APPLE__)
-    if (device_param->is_metal == true)
-    {
-      device_param->kernel_params_decompress[0] = device_param->metal_d_pws_idx.buf_ptr;
-      device_param->kernel_params_decompress[1] = device_param->metal_d_pws_comp_buf.buf_ptr;
-      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                ? device_param->metal_d_pws_buf.buf_ptr
-                                                : device_param->metal_d_pws_amp_buf.buf_ptr;
-    }
-    #endif
+  hcfree (session_threads);
 
-    if (device_param->is_opencl == true)
-    {
-      device_param->kernel_params_decompress[0] = &device_param->opencl_d_pws_idx;
-      device_param->kernel_params_decompress[1] = &device_param->opencl_d_pws_comp_buf;
-      device_param->kernel_params_decompress[2] = (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
-                                                ? &device_param->opencl_d_pws_buf
-                                                : &device_param->opencl_d_pws_amp_buf;
+  for (int lock_idx = 0; lock_idx < KERNEL_BUILD_LOCKS; lock_idx++)
+  {
+    hc_thread_mutex_delete (backend_ctx->mux_kernel_build[lock_idx]);
+  }
 
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 0, sizeof (cl_mem), device_param->kernel_params_decompress[0]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 1, sizeof (cl_mem), device_param->kernel_params_decompress[1]) == -1) return -1;
-      if (hc_clSetKernelArg (hashcat_ctx, device_param->opencl_kernel_decompress, 2, sizeof (cl_mem), device_param->kernel_params_decompress[2]) == -1) return -1;
-    }
+  hc_thread_mutex_delete (backend_ctx->mux_tuning_db);
 
-    // context
+  hc_thread_mutex_delete (backend_ctx->mux_selftest_start);
 
-    if (device_param->is_cuda == true)
-    {
-      if (hc_cuCtxPopCurrent (hashcat_ctx, &device_param->cuda_context) == -1)
-      {
-        device_param->skipped = true;
+  int rc_devices = 0;
 
-        continue;
-      }
-    }
+  for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
+  {
+    const backend_session_param_t *session_param = session_params + backend_devices_idx;
+
+    if (session_param->rc == -1) rc_devices = -1;
 
-    hardware_power_all += hardware_power_max;
+    backend_memory_hit_warnings    += session_param->memory_hit_warnings;
+    backend_runtime_skip_warnings  += session_param->runtime_skip_warnings;
+    backend_kernel_build_warnings  += session_param->kernel_build_warnings;
+    backend_kernel_create_warnings += session_param->kernel_create_warnings;
+    backend_extra_size_warning     += session_param->extra_size_warning;
 
-    EVENT_DATA (EVENT_BACKEND_DEVICE_INIT_POST, &backend_devices_idx, sizeof (int));
+    size_total_host_all += session_param->size_total_host;
+
+    hardware_power_all += session_param->hardware_power;
   }
 
+  hcfree (session_params);
+
+  if (rc_devices == -1) return -1;
+
+
   int rc = 0;
 
   backend_ctx->memory_hit_warning    = (backend_memory_hit_warnings    == backend_ctx->backend_devices_active);
@@ -16972,6 +17235,7 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
     hcfree (device_param->pws_pre_buf);
     hcfree (device_param->pws_base_buf);
     hcfree (device_param->combs_buf);
+    hcfree (device_param->salts_active_buf);
     hcfree (device_param->hooks_buf);
     hcfree (device_param->scratch_buf);
     #ifdef WITH_BRAIN
@@ -17308,6 +17572,7 @@ void backend_session_destroy (hashcat_ctx_t *hashcat_ctx)
     device_param->pws_pre_buf         = NULL;
     device_param->pws_base_buf        = NULL;
     device_param->combs_buf           = NULL;
+    device_param->salts_active_buf    = NULL;
     device_param->hooks_buf           = NULL;
     device_param->scratch_buf         = NULL;
     #ifdef WITH_BRAIN
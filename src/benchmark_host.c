@@ -0,0 +1,895 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "folder.h"
+#include "status.h"
+#include "timer.h"
+#include "shared.h"
+#include "filehandling.h"
+#include "convert.h"
+#include "interface.h"
+#include "hashes.h"
+#include "potfile.h"
+#include "wordlist.h"
+#include "rp.h"
+#include "rp_cpu.h"
+#include "mpsp.h"
+#include "user_options.h"
+#ifdef WITH_BRAIN
+#include "brain.h"
+#endif
+#include "benchmark_host.h"
+
+// host-side pipeline micro-benchmark (--benchmark-host)
+//
+// -b only measures kernel speed, but with fast hashes the host often is the limit: wordlist parsing,
+// the cpu rule engine, mask expansion, hash and potfile parsing, and the brain hashing.
+// each of these stages runs here on synthetic data, without any backend device, and the result is
+// printed as json so it can be saved and later passed to --benchmark-host-baseline.
+
+static const char *BENCHMARK_HOST_RULES[] =
+{
+  ":",
+  "l",
+  "u",
+  "c",
+  "C",
+  "t",
+  "r",
+  "d",
+  "f",
+  "{",
+  "}",
+  "[",
+  "]",
+  "$1",
+  "^1",
+  "$1 $2 $3",
+  "sa@",
+  "se3 so0",
+  "T0",
+  "'6",
+  "D2",
+  "i3!",
+  "o0X",
+  "c $1",
+  "u $!",
+  "l r",
+  "c so0 $1",
+  NULL
+};
+
+static volatile u64 benchmark_host_sink = 0;
+
+static u64 benchmark_host_rand (u64 *state)
+{
+  // xorshift64*, the data only needs to look like passwords and be the same on every run
+
+  u64 x = *state;
+
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+
+  *state = x;
+
+  return x * 0x2545f4914f6cdd1dULL;
+}
+
+static void benchmark_host_words_init (char *words_buf, u8 *words_len, const u64 words_cnt)
+{
+  static const char charset[] = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$";
+
+  const u64 charset_len = sizeof (charset) - 1;
+
+  u64 state = 0x6863737461740002ULL;
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    char *word = words_buf + (i * BENCHMARK_HOST_WORD_SIZE);
+
+    const u32 len = 6 + (u32) (benchmark_host_rand (&state) % (BENCHMARK_HOST_WORD_SIZE - 6));
+
+    for (u32 j = 0; j < len; j++)
+    {
+      word[j] = charset[benchmark_host_rand (&state) % charset_len];
+    }
+
+    words_len[i] = (u8) len;
+  }
+}
+
+static bool benchmark_host_write (hashcat_ctx_t *hashcat_ctx, const char *path, const char *buf, const size_t len)
+{
+  HCFILE fp;
+
+  if (hc_fopen (&fp, path, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+    return false;
+  }
+
+  const size_t nwrite = hc_fwrite (buf, 1, len, &fp);
+
+  hc_fclose (&fp);
+
+  if (nwrite != len)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+    return false;
+  }
+
+  return true;
+}
+
+static int benchmark_host_wordlist (hashcat_ctx_t *hashcat_ctx, const char *dictfile, const u64 words_cnt, const u64 dict_size, benchmark_host_stage_t *stages, int stages_cnt)
+{
+  straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+  wl_data_t      *wl_data      = hashcat_ctx->wl_data;
+
+  HCFILE fp;
+
+  hc_timer_t timer;
+
+  // get_next_word () and load_segment (), the same loop as in the straight attack of the dispatcher
+
+  if (hc_fopen (&fp, dictfile, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
+
+    return -1;
+  }
+
+  wl_data->cnt = 0;
+  wl_data->pos = 0;
+
+  benchmark_host_stage_t *stage = stages + stages_cnt++;
+
+  stage->stage = "wordlist_get_next_word";
+  stage->items = words_cnt;
+  stage->bytes = dict_size;
+
+  u64 sink = 0;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  for (u64 words_cur = 0; words_cur < words_cnt; words_cur++)
+  {
+    char *line_buf;
+    u32   line_len;
+
+    get_next_word (hashcat_ctx, &fp, &line_buf, &line_len);
+
+    sink += line_len;
+  }
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  hc_fclose (&fp);
+
+  benchmark_host_sink += sink;
+
+  // count_words (), this is the dictstat cache-miss path as the dictstat is not loaded
+
+  if (hc_fopen (&fp, dictfile, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", dictfile, strerror (errno));
+
+    return -1;
+  }
+
+  stage = stages + stages_cnt++;
+
+  stage->stage = "wordlist_count_words";
+  stage->items = words_cnt;
+  stage->bytes = dict_size;
+
+  straight_ctx->kernel_rules_cnt = 1;
+
+  u64 words_counted = 0;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  const int rc_count = count_words (hashcat_ctx, &fp, dictfile, &words_counted);
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  straight_ctx->kernel_rules_cnt = 0;
+
+  hc_fclose (&fp);
+
+  if ((rc_count != 0) || (words_counted != words_cnt))
+  {
+    event_log_error (hashcat_ctx, "%s: counted %" PRIu64 " words, expected %" PRIu64 ".", dictfile, words_counted, words_cnt);
+
+    return -1;
+  }
+
+  return stages_cnt;
+}
+
+static int benchmark_host_rules (const char *words_buf, const u8 *words_len, const u64 words_cnt, benchmark_host_stage_t *stages, int stages_cnt)
+{
+  int rules_cnt = 0;
+
+  while (BENCHMARK_HOST_RULES[rules_cnt] != NULL) rules_cnt++;
+
+  int rules_len[64];
+
+  for (int i = 0; i < rules_cnt; i++) rules_len[i] = (int) strlen (BENCHMARK_HOST_RULES[i]);
+
+  benchmark_host_stage_t *stage = stages + stages_cnt++;
+
+  stage->stage = "rule_apply";
+  stage->items = words_cnt;
+  stage->bytes = 0;
+
+  char in[RP_PASSWORD_SIZE];
+  char out[RP_PASSWORD_SIZE];
+
+  memset (in,  0, sizeof (in));
+  memset (out, 0, sizeof (out));
+
+  u64 sink = 0;
+
+  hc_timer_t timer;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    const int rule_idx = (int) (i % rules_cnt);
+
+    const int in_len = words_len[i];
+
+    memcpy (in, words_buf + (i * BENCHMARK_HOST_WORD_SIZE), in_len);
+
+    const int out_len = _old_apply_rule (BENCHMARK_HOST_RULES[rule_idx], rules_len[rule_idx], in, in_len, out);
+
+    if (out_len > 0) sink += out_len + (u8) out[0];
+
+    stage->bytes += in_len;
+  }
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  benchmark_host_sink += sink;
+
+  return stages_cnt;
+}
+
+static int benchmark_host_mask (const u64 words_cnt, benchmark_host_stage_t *stages, int stages_cnt)
+{
+  // ?l?l?l?l?l?d?d?d, without markov statistics every markov row of a position is a copy of the root charset
+
+  static const char *mask_css[] =
+  {
+    "abcdefghijklmnopqrstuvwxyz",
+    "abcdefghijklmnopqrstuvwxyz",
+    "abcdefghijklmnopqrstuvwxyz",
+    "abcdefghijklmnopqrstuvwxyz",
+    "abcdefghijklmnopqrstuvwxyz",
+    "0123456789",
+    "0123456789",
+    "0123456789",
+  };
+
+  const u32 mask_len = sizeof (mask_css) / sizeof (mask_css[0]);
+
+  cs_t *root_css_buf   = (cs_t *) hccalloc (SP_PW_MAX,           sizeof (cs_t));
+  cs_t *markov_css_buf = (cs_t *) hccalloc (SP_PW_MAX * CHARSIZ, sizeof (cs_t));
+
+  for (u32 i = 0; i < mask_len; i++)
+  {
+    cs_t *cs = root_css_buf + i;
+
+    cs->cs_len = (u32) strlen (mask_css[i]);
+
+    for (u32 j = 0; j < cs->cs_len; j++) cs->cs_buf[j] = (u8) mask_css[i][j];
+
+    for (u32 k = 0; k < CHARSIZ; k++) memcpy (markov_css_buf + (i * CHARSIZ) + k, cs, sizeof (cs_t));
+  }
+
+  char pw_buf[SP_PW_MAX];
+
+  memset (pw_buf, 0, sizeof (pw_buf));
+
+  hc_timer_t timer;
+
+  // sp_exec (), one full decode per candidate as done for the base words in hybrid and -S mode
+
+  benchmark_host_stage_t *stage = stages + stages_cnt++;
+
+  stage->stage = "mask_sp_exec";
+  stage->items = words_cnt;
+  stage->bytes = words_cnt * mask_len;
+
+  u64 sink = 0;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    sp_exec (i, pw_buf, root_css_buf, markov_css_buf, 0, mask_len);
+
+    sink += (u8) pw_buf[0];
+  }
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  // sp_iter_next (), the odometer walk over the same range
+
+  stage = stages + stages_cnt++;
+
+  stage->stage = "mask_sp_iter";
+  stage->items = words_cnt;
+  stage->bytes = words_cnt * mask_len;
+
+  sp_iter_t sp_iter;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  sp_iter_init (&sp_iter, 0, pw_buf, root_css_buf, markov_css_buf, 0, mask_len);
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    sink += (u8) pw_buf[0];
+
+    sp_iter_next (&sp_iter);
+  }
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  benchmark_host_sink += sink;
+
+  hcfree (root_css_buf);
+  hcfree (markov_css_buf);
+
+  return stages_cnt;
+}
+
+static int benchmark_host_hashes (hashcat_ctx_t *hashcat_ctx, const char *hashfile, const char *potfile, const u64 hashes_cnt, benchmark_host_stage_t *stages, int stages_cnt)
+{
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+        hashes_t       *hashes       = hashcat_ctx->hashes;
+        potfile_ctx_t  *potfile_ctx  = hashcat_ctx->potfile_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  // modes which require a binary hashfile can't be fed with copies of the self-test hash
+
+  if ((hashconfig->opts_type & OPTS_TYPE_BINARY_HASHFILE) && ((hashconfig->opts_type & OPTS_TYPE_BINARY_HASHFILE_OPTIONAL) == 0))
+  {
+    event_log_warning (hashcat_ctx, "Hash-mode %u uses a binary hashfile, skipping hash parsing stages.", user_options->hash_mode);
+
+    return stages_cnt;
+  }
+
+  const char *st_hash = hashconfig->st_hash;
+  const char *st_pass = hashconfig->st_pass;
+
+  const size_t st_hash_len = strlen (st_hash);
+  const size_t st_pass_len = strlen (st_pass);
+
+  // hashfile: the self-test hash, once per line
+
+  const size_t hash_line_len = st_hash_len + 1;
+
+  char *buf = (char *) hcmalloc (hashes_cnt * (st_hash_len + 1 + st_pass_len + 1));
+
+  for (u64 i = 0; i < hashes_cnt; i++)
+  {
+    char *line = buf + (i * hash_line_len);
+
+    memcpy (line, st_hash, st_hash_len);
+
+    line[st_hash_len] = '\n';
+  }
+
+  if (benchmark_host_write (hashcat_ctx, hashfile, buf, hashes_cnt * hash_line_len) == false)
+  {
+    hcfree (buf);
+
+    return -1;
+  }
+
+  // potfile: most entries of a real potfile don't belong to the loaded hashes,
+  // so all lines but the last one get a different digit in the hash and will miss the lookup
+
+  size_t last_hex = st_hash_len;
+
+  for (size_t i = 0; i < st_hash_len; i++)
+  {
+    if (is_valid_hex_char ((const u8) st_hash[i]) == true) last_hex = i;
+  }
+
+  const size_t pot_line_len = st_hash_len + 1 + st_pass_len + 1;
+
+  for (u64 i = 0; i < hashes_cnt; i++)
+  {
+    char *line = buf + (i * pot_line_len);
+
+    memcpy (line, st_hash, st_hash_len);
+
+    line[st_hash_len] = hashconfig->separator;
+
+    memcpy (line + st_hash_len + 1, st_pass, st_pass_len);
+
+    line[pot_line_len - 1] = '\n';
+
+    if ((last_hex < st_hash_len) && (i < (hashes_cnt - 1)))
+    {
+      line[last_hex] = (line[last_hex] == '0') ? '1' : '0';
+    }
+  }
+
+  if (benchmark_host_write (hashcat_ctx, potfile, buf, hashes_cnt * pot_line_len) == false)
+  {
+    hcfree (buf);
+
+    return -1;
+  }
+
+  hcfree (buf);
+
+  // hashes_init_stage1 (), the module hash_decode () for every line of the hashfile
+
+  hashes->hashfile                = hashfile;
+  hashes->hashlist_mode           = HL_MODE_FILE_PLAIN;
+  hashes->parser_token_length_cnt = 0;
+
+  benchmark_host_stage_t *stage = stages + stages_cnt++;
+
+  stage->stage = "hashes_parse";
+  stage->items = hashes_cnt;
+  stage->bytes = hashes_cnt * hash_line_len;
+
+  hc_timer_t timer;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  const int rc_stage1 = hashes_init_stage1 (hashcat_ctx);
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  if (rc_stage1 == -1) return -1;
+
+  if (hashes->hashes_cnt != hashes_cnt)
+  {
+    event_log_error (hashcat_ctx, "%s: parsed %u hashes, expected %" PRIu64 ".", hashfile, hashes->hashes_cnt, hashes_cnt);
+
+    return -1;
+  }
+
+  hashes->hashes_cnt_orig = hashes->hashes_cnt;
+
+  if (hashes_init_stage2 (hashcat_ctx) == -1) return -1;
+
+  // potfile_remove_parse (), parse every potfile line and look it up in the loaded hashes
+
+  if ((hashconfig->potfile_disable == false) && ((hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK) == 0))
+  {
+    potfile_ctx->enabled  = true;
+    potfile_ctx->filename = hcstrdup (potfile);
+
+    stage = stages + stages_cnt++;
+
+    stage->stage = "potfile_remove_parse";
+    stage->items = hashes_cnt;
+    stage->bytes = hashes_cnt * pot_line_len;
+
+    hc_alloc_count_start ();
+
+    hc_timer_set (&timer);
+
+    const int rc_pot = potfile_remove_parse (hashcat_ctx);
+
+    stage->msec   = hc_timer_get (timer);
+    stage->allocs = hc_alloc_count_stop ();
+
+    if (rc_pot == -1) return -1;
+  }
+
+  if (hashes_init_stage3 (hashcat_ctx) == -1) return -1;
+
+  return stages_cnt;
+}
+
+#ifdef WITH_BRAIN
+static int benchmark_host_brain (const char *words_buf, const u8 *words_len, const u64 words_cnt, benchmark_host_stage_t *stages, int stages_cnt)
+{
+  brain_server_hash_short_t *hashes_buf = (brain_server_hash_short_t *) hccalloc (words_cnt, sizeof (brain_server_hash_short_t));
+
+  hc_timer_t timer;
+
+  // brain_client_generate_hash (), done for every candidate before it's sent to the server
+
+  benchmark_host_stage_t *stage = stages + stages_cnt++;
+
+  stage->stage = "brain_client_hash";
+  stage->items = words_cnt;
+  stage->bytes = 0;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    brain_client_generate_hash ((u64 *) hashes_buf[i].hash, words_buf + (i * BENCHMARK_HOST_WORD_SIZE), words_len[i]);
+
+    stage->bytes += words_len[i];
+  }
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  // the server sorts every incoming batch before it merges it into the session database
+
+  brain_server_hash_short_t *sorted_buf = (brain_server_hash_short_t *) hcmalloc (words_cnt * sizeof (brain_server_hash_short_t));
+
+  memcpy (sorted_buf, hashes_buf, words_cnt * sizeof (brain_server_hash_short_t));
+
+  stage = stages + stages_cnt++;
+
+  stage->stage = "brain_server_sort";
+  stage->items = words_cnt;
+  stage->bytes = words_cnt * sizeof (brain_server_hash_short_t);
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  qsort (sorted_buf, words_cnt, sizeof (brain_server_hash_short_t), brain_server_sort_hash_short);
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  // and looks up every hash of a request in it
+
+  stage = stages + stages_cnt++;
+
+  stage->stage = "brain_server_find";
+  stage->items = words_cnt;
+  stage->bytes = words_cnt * sizeof (brain_server_hash_short_t);
+
+  u64 found = 0;
+
+  hc_alloc_count_start ();
+
+  hc_timer_set (&timer);
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    if (brain_server_find_hash_short (hashes_buf[i].hash, sorted_buf, (i64) words_cnt) != -1) found++;
+  }
+
+  stage->msec   = hc_timer_get (timer);
+  stage->allocs = hc_alloc_count_stop ();
+
+  benchmark_host_sink += found;
+
+  hcfree (sorted_buf);
+  hcfree (hashes_buf);
+
+  return stages_cnt;
+}
+#endif
+
+static int benchmark_host_baseline_load (hashcat_ctx_t *hashcat_ctx, const char *path, benchmark_host_baseline_t *baseline)
+{
+  HCFILE fp;
+
+  if (hc_fopen (&fp, path, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", path, strerror (errno));
+
+    return -1;
+  }
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  int baseline_cnt = 0;
+
+  while (!hc_feof (&fp))
+  {
+    const size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE);
+
+    if (line_len == 0) continue;
+
+    // our own output has exactly one stage per line
+
+    const char *stage_pos = strstr (line_buf, "\"stage\": \"");
+    const char *speed_pos = strstr (line_buf, "\"items_per_sec\": ");
+
+    if ((stage_pos == NULL) || (speed_pos == NULL)) continue;
+
+    if (baseline_cnt == BENCHMARK_HOST_STAGES_MAX) break;
+
+    benchmark_host_baseline_t *entry = baseline + baseline_cnt;
+
+    stage_pos += strlen ("\"stage\": \"");
+
+    const char *stage_end = strchr (stage_pos, '"');
+
+    if (stage_end == NULL) continue;
+
+    const size_t stage_len = MIN ((size_t) (stage_end - stage_pos), sizeof (entry->stage) - 1);
+
+    memcpy (entry->stage, stage_pos, stage_len);
+
+    entry->stage[stage_len] = 0;
+
+    entry->items_per_sec = strtod (speed_pos + strlen ("\"items_per_sec\": "), NULL);
+
+    baseline_cnt++;
+  }
+
+  hcfree (line_buf);
+
+  hc_fclose (&fp);
+
+  if (baseline_cnt == 0)
+  {
+    event_log_error (hashcat_ctx, "%s: No host benchmark stages found.", path);
+
+    return -1;
+  }
+
+  return baseline_cnt;
+}
+
+static int benchmark_host_print (hashcat_ctx_t *hashcat_ctx, const benchmark_host_stage_t *stages, const int stages_cnt, const benchmark_host_baseline_t *baseline, const int baseline_cnt)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  int regressions = 0;
+
+  printf ("{\n");
+  printf ("  \"hash_mode\": %u,\n", user_options->hash_mode);
+  printf ("  \"size\": %u,\n",      user_options->benchmark_host_size);
+  printf ("  \"stages\": [\n");
+
+  for (int i = 0; i < stages_cnt; i++)
+  {
+    const benchmark_host_stage_t *stage = stages + i;
+
+    const double sec = MAX (stage->msec, 0.001) / 1000;
+
+    const double items_per_sec = (double) stage->items / sec;
+    const double bytes_per_sec = (double) stage->bytes / sec;
+
+    printf ("    { \"stage\": \"%s\", \"items\": %" PRIu64 ", \"bytes\": %" PRIu64 ", \"seconds\": %.6f, \"items_per_sec\": %.0f, \"bytes_per_sec\": %.0f, \"allocs\": %" PRIu64,
+      stage->stage,
+      stage->items,
+      stage->bytes,
+      sec,
+      items_per_sec,
+      bytes_per_sec,
+      stage->allocs);
+
+    for (int j = 0; j < baseline_cnt; j++)
+    {
+      if (strcmp (baseline[j].stage, stage->stage) != 0) continue;
+
+      if (baseline[j].items_per_sec <= 0) break;
+
+      const double delta_pct = ((items_per_sec - baseline[j].items_per_sec) / baseline[j].items_per_sec) * 100;
+
+      const bool regression = (delta_pct < -BENCHMARK_HOST_TOLERANCE);
+
+      if (regression == true) regressions++;
+
+      printf (", \"baseline_items_per_sec\": %.0f, \"delta_pct\": %.2f, \"regression\": %s", baseline[j].items_per_sec, delta_pct, (regression == true) ? "true" : "false");
+
+      break;
+    }
+
+    printf (" }%s\n", (i < (stages_cnt - 1)) ? "," : "");
+  }
+
+  printf ("  ]");
+
+  if (baseline_cnt > 0)
+  {
+    printf (",\n  \"regressions\": %d", regressions);
+  }
+
+  printf ("\n}\n");
+
+  fflush (stdout);
+
+  return regressions;
+}
+
+int benchmark_host (hashcat_ctx_t *hashcat_ctx, const char *install_folder, const char *shared_folder)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+  const user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  /**
+   * a subset of hashcat_session_init (), no backend, no bridges, no potfile or dictstat of the user
+   */
+
+  user_options_session_auto (hashcat_ctx);
+
+  if (event_ctx_init (hashcat_ctx) == -1) return -1;
+
+  if (status_ctx_init (hashcat_ctx) == -1) return -1;
+
+  if (folder_config_init (hashcat_ctx, install_folder, shared_folder) == -1) return -1;
+
+  user_options_preprocess (hashcat_ctx);
+
+  user_options_extra_init (hashcat_ctx);
+
+  user_options_postprocess (hashcat_ctx);
+
+  if (hashconfig_init (hashcat_ctx) == -1)
+  {
+    event_log_error (hashcat_ctx, "Invalid hash-mode '%u' selected.", user_options->hash_mode);
+
+    return -1;
+  }
+
+  if (wl_data_init (hashcat_ctx) == -1) return -1;
+
+  /**
+   * synthetic data
+   */
+
+  const u64 words_cnt  = user_options->benchmark_host_size;
+  const u64 hashes_cnt = MAX (words_cnt / BENCHMARK_HOST_HASHES_DIV, 1);
+
+  char *words_buf = (char *) hcmalloc (words_cnt * BENCHMARK_HOST_WORD_SIZE);
+  u8   *words_len = (u8 *)   hcmalloc (words_cnt);
+
+  benchmark_host_words_init (words_buf, words_len, words_cnt);
+
+  char *dictfile = NULL;
+  char *hashfile = NULL;
+  char *potfile  = NULL;
+
+  hc_asprintf (&dictfile, "%s/%s.dict",    folder_config->session_dir, user_options->session);
+  hc_asprintf (&hashfile, "%s/%s.hash",    folder_config->session_dir, user_options->session);
+  hc_asprintf (&potfile,  "%s/%s.potfile", folder_config->session_dir, user_options->session);
+
+  char *dict_buf = (char *) hcmalloc (words_cnt * (BENCHMARK_HOST_WORD_SIZE + 1));
+
+  u64 dict_size = 0;
+
+  for (u64 i = 0; i < words_cnt; i++)
+  {
+    memcpy (dict_buf + dict_size, words_buf + (i * BENCHMARK_HOST_WORD_SIZE), words_len[i]);
+
+    dict_size += words_len[i];
+
+    dict_buf[dict_size++] = '\n';
+  }
+
+  const bool rc_dict = benchmark_host_write (hashcat_ctx, dictfile, dict_buf, dict_size);
+
+  hcfree (dict_buf);
+
+  /**
+   * run the stages
+   */
+
+  // the fastest of a few passes is reported, otherwise the noise of a single run easily exceeds the baseline tolerance
+
+  benchmark_host_stage_t stages[BENCHMARK_HOST_STAGES_MAX];
+  benchmark_host_stage_t stages_pass[BENCHMARK_HOST_STAGES_MAX];
+
+  memset (stages, 0, sizeof (stages));
+
+  int stages_cnt = (rc_dict == true) ? 0 : -1;
+
+  for (int pass = 0; pass < BENCHMARK_HOST_PASSES; pass++)
+  {
+    if (stages_cnt == -1) break;
+
+    memset (stages_pass, 0, sizeof (stages_pass));
+
+    int pass_cnt = 0;
+
+    if (pass_cnt != -1) pass_cnt = benchmark_host_wordlist (hashcat_ctx, dictfile, words_cnt, dict_size, stages_pass, pass_cnt);
+    if (pass_cnt != -1) pass_cnt = benchmark_host_rules    (words_buf, words_len, words_cnt, stages_pass, pass_cnt);
+    if (pass_cnt != -1) pass_cnt = benchmark_host_mask     (words_cnt, stages_pass, pass_cnt);
+    if (pass_cnt != -1) pass_cnt = benchmark_host_hashes   (hashcat_ctx, hashfile, potfile, hashes_cnt, stages_pass, pass_cnt);
+    #ifdef WITH_BRAIN
+    if (pass_cnt != -1) pass_cnt = benchmark_host_brain    (words_buf, words_len, words_cnt, stages_pass, pass_cnt);
+    #endif
+
+    potfile_destroy (hashcat_ctx);
+    hashes_destroy  (hashcat_ctx);
+
+    if (pass_cnt == -1)
+    {
+      stages_cnt = -1;
+
+      break;
+    }
+
+    for (int i = 0; i < pass_cnt; i++)
+    {
+      if ((pass == 0) || (stages_pass[i].msec < stages[i].msec)) stages[i] = stages_pass[i];
+    }
+
+    stages_cnt = pass_cnt;
+  }
+
+  unlink (dictfile);
+  unlink (hashfile);
+  unlink (potfile);
+
+  hcfree (dictfile);
+  hcfree (hashfile);
+  hcfree (potfile);
+
+  hcfree (words_buf);
+  hcfree (words_len);
+
+  /**
+   * report, optionally compared to an earlier run
+   */
+
+  int rc = -1;
+
+  if (stages_cnt != -1)
+  {
+    benchmark_host_baseline_t baseline[BENCHMARK_HOST_STAGES_MAX];
+
+    int baseline_cnt = 0;
+
+    if (user_options->benchmark_host_baseline != NULL)
+    {
+      baseline_cnt = benchmark_host_baseline_load (hashcat_ctx, user_options->benchmark_host_baseline, baseline);
+    }
+
+    if (baseline_cnt != -1)
+    {
+      const int regressions = benchmark_host_print (hashcat_ctx, stages, stages_cnt, baseline, baseline_cnt);
+
+      rc = (regressions > 0) ? 1 : 0;
+    }
+  }
+
+  /**
+   * a subset of hashcat_session_destroy ()
+   */
+
+  wl_data_destroy            (hashcat_ctx);
+  hashconfig_destroy         (hashcat_ctx);
+  folder_config_destroy      (hashcat_ctx);
+  user_options_destroy       (hashcat_ctx);
+  user_options_extra_destroy (hashcat_ctx);
+  status_ctx_destroy         (hashcat_ctx);
+  event_ctx_destroy          (hashcat_ctx);
+
+  return rc;
+}
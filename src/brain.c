@@ -12,6 +12,7 @@
 #include "convert.h"
 #include "shared.h"
 #include "hashes.h"
+#include "folder.h"
 #include "brain.h"
 
 static bool keep_running = true;
@@ -200,7 +201,7 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
   {
     if (straight_ctx->dict)
     {
-      const u64 wordlist_hash = brain_compute_attack_wordlist (straight_ctx->dict);
+      const u64 wordlist_hash = brain_compute_attack_wordlist (hashcat_ctx, straight_ctx->dict);
 
       XXH64_update (state, &wordlist_hash, sizeof (wordlist_hash));
     }
@@ -249,8 +250,8 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
   }
   else if (user_options->attack_mode == ATTACK_MODE_COMBI)
   {
-    const u64 wordlist1_hash = brain_compute_attack_wordlist (combinator_ctx->dict1);
-    const u64 wordlist2_hash = brain_compute_attack_wordlist (combinator_ctx->dict2);
+    const u64 wordlist1_hash = brain_compute_attack_wordlist (hashcat_ctx, combinator_ctx->dict1);
+    const u64 wordlist2_hash = brain_compute_attack_wordlist (hashcat_ctx, combinator_ctx->dict2);
 
     XXH64_update (state, &wordlist1_hash, sizeof (wordlist1_hash));
     XXH64_update (state, &wordlist2_hash, sizeof (wordlist2_hash));
@@ -376,7 +377,7 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
   }
   else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
   {
-    const u64 wordlist_hash = brain_compute_attack_wordlist (straight_ctx->dict);
+    const u64 wordlist_hash = brain_compute_attack_wordlist (hashcat_ctx, straight_ctx->dict);
 
     XXH64_update (state, &wordlist_hash, sizeof (wordlist_hash));
 
@@ -503,7 +504,7 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
 
     XXH64_update (state, mask, strlen (mask));
 
-    const u64 wordlist_hash = brain_compute_attack_wordlist (straight_ctx->dict);
+    const u64 wordlist_hash = brain_compute_attack_wordlist (hashcat_ctx, straight_ctx->dict);
 
     XXH64_update (state, &wordlist_hash, sizeof (wordlist_hash));
 
@@ -600,7 +601,7 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
   {
     if (straight_ctx->dict)
     {
-      const u64 wordlist_hash = brain_compute_attack_wordlist (straight_ctx->dict);
+      const u64 wordlist_hash = brain_compute_attack_wordlist (hashcat_ctx, straight_ctx->dict);
 
       XXH64_update (state, &wordlist_hash, sizeof (wordlist_hash));
     }
@@ -644,19 +645,203 @@ u32 brain_compute_attack (hashcat_ctx_t *hashcat_ctx)
   return brain_attack;
 }
 
-u64 brain_compute_attack_wordlist (const char *filename)
+/**
+ * The full hash of a wordlist is cached per file version in <cache_dir>/brainstats,
+ * keyed like the seekdb of the wordlist feed: size, mtime and the first and last 64 KiB.
+ * Attacks on the same wordlist, -a 1 with the same file twice, a mask file with -a 6/-a 7
+ * and a directory of wordlists which is walked again then only need the key.
+ * A plain file of several chunks is hashed by multiple threads, each chunk on its own and
+ * the final hash over the chunk hashes. Smaller and compressed files are hashed as before.
+ */
+
+typedef struct brain_wordlist_chunk_param
+{
+  const char *filename;
+
+  u64 *chunk_hashes;
+  u64  chunk_cnt;
+  u64  file_size;
+
+  int  tid;
+  int  threads_cnt;
+
+  bool failed;
+
+} brain_wordlist_chunk_param_t;
+
+#if defined (_WIN32) || defined (__WIN32__)
+static HC_API_CALL DWORD brain_compute_attack_wordlist_chunks (void *p)
+#else
+static HC_API_CALL void *brain_compute_attack_wordlist_chunks (void *p)
+#endif
+{
+  brain_wordlist_chunk_param_t *param = (brain_wordlist_chunk_param_t *) p;
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, param->filename, "rb") == false)
+  {
+    param->failed = true;
+
+    return 0;
+  }
+
+  u8 *buf = (u8 *) hcmalloc (BRAIN_ATTACK_WORDLIST_SAMPLE);
+
+  XXH64_state_t *state = XXH64_createState ();
+
+  for (u64 chunk_idx = param->tid; chunk_idx < param->chunk_cnt; chunk_idx += param->threads_cnt)
+  {
+    const u64 chunk_off = chunk_idx * BRAIN_ATTACK_WORDLIST_CHUNK;
+    const u64 chunk_len = MIN ((u64) BRAIN_ATTACK_WORDLIST_CHUNK, param->file_size - chunk_off);
+
+    XXH64_reset (state, 0);
+
+    hc_fseek (&fp, (off_t) chunk_off, SEEK_SET);
+
+    u64 left = chunk_len;
+
+    while (left > 0)
+    {
+      const size_t nread = hc_fread (buf, 1, (size_t) MIN (left, (u64) BRAIN_ATTACK_WORDLIST_SAMPLE), &fp);
+
+      if (nread == 0)
+      {
+        param->failed = true;
+
+        break;
+      }
+
+      XXH64_update (state, buf, nread);
+
+      left -= nread;
+    }
+
+    param->chunk_hashes[chunk_idx] = XXH64_digest (state);
+  }
+
+  XXH64_freeState (state);
+
+  hcfree (buf);
+
+  hc_fclose (&fp);
+
+  return 0;
+}
+
+static bool brain_compute_attack_wordlist_key (const char *filename, u64 *key, u64 *file_size)
 {
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, filename, "rb") == false) return false;
+
+  struct stat st;
+
+  if (hc_fstat (&fp, &st) == -1)
+  {
+    hc_fclose (&fp);
+
+    return false;
+  }
+
   XXH64_state_t *state = XXH64_createState ();
 
   XXH64_reset (state, 0);
 
-  #define FBUFSZ 8192
+  XXH64_update (state, &st.st_size,  sizeof (st.st_size));
+  XXH64_update (state, &st.st_mtime, sizeof (st.st_mtime));
 
-  char buf[FBUFSZ];
+  u8 *buf = (u8 *) hcmalloc (BRAIN_ATTACK_WORDLIST_SAMPLE);
+
+  const size_t nread1 = hc_fread (buf, 1, BRAIN_ATTACK_WORDLIST_SAMPLE, &fp);
+
+  XXH64_update (state, buf, nread1);
+
+  if ((u64) st.st_size > (u64) BRAIN_ATTACK_WORDLIST_SAMPLE)
+  {
+    hc_fseek (&fp, st.st_size - BRAIN_ATTACK_WORDLIST_SAMPLE, SEEK_SET);
+
+    const size_t nread2 = hc_fread (buf, 1, BRAIN_ATTACK_WORDLIST_SAMPLE, &fp);
+
+    XXH64_update (state, buf, nread2);
+  }
+
+  hcfree (buf);
+
+  hc_fclose (&fp);
+
+  *key       = XXH64_digest (state);
+  *file_size = (u64) st.st_size;
+
+  XXH64_freeState (state);
+
+  return true;
+}
+
+static bool brain_compute_attack_wordlist_full (const char *filename, const u64 file_size, u64 *hash)
+{
+  const u64 chunk_cnt = (u64) mydivc64 (file_size, (u64) BRAIN_ATTACK_WORDLIST_CHUNK);
 
   HCFILE fp;
 
-  hc_fopen (&fp, filename, "rb");
+  if (hc_fopen (&fp, filename, "rb") == false) return false;
+
+  // the choice depends on the file only, all clients of a session have to end up with the same hash
+  // compressed files can only be read in order
+
+  const bool chunked = (fp.pfp != NULL) && (chunk_cnt >= (u64) BRAIN_ATTACK_WORDLIST_CHUNKS_MIN);
+
+  if (chunked == true)
+  {
+    hc_fclose (&fp);
+
+    const int threads_cnt = (int) MIN ((u64) MAX (hc_get_processor_count (), 1), chunk_cnt);
+
+    u64 *chunk_hashes = (u64 *) hccalloc (chunk_cnt, sizeof (u64));
+
+    brain_wordlist_chunk_param_t *params    = (brain_wordlist_chunk_param_t *) hccalloc (threads_cnt, sizeof (brain_wordlist_chunk_param_t));
+    hc_thread_t                  *c_threads = (hc_thread_t *)                  hccalloc (threads_cnt, sizeof (hc_thread_t));
+
+    for (int tid = 0; tid < threads_cnt; tid++)
+    {
+      brain_wordlist_chunk_param_t *param = params + tid;
+
+      param->filename     = filename;
+      param->chunk_hashes = chunk_hashes;
+      param->chunk_cnt    = chunk_cnt;
+      param->file_size    = file_size;
+      param->tid          = tid;
+      param->threads_cnt  = threads_cnt;
+      param->failed       = false;
+
+      hc_thread_create (c_threads[tid], brain_compute_attack_wordlist_chunks, param);
+    }
+
+    hc_thread_wait (threads_cnt, c_threads);
+
+    bool failed = false;
+
+    for (int tid = 0; tid < threads_cnt; tid++)
+    {
+      if (params[tid].failed == true) failed = true;
+    }
+
+    if (failed == false) *hash = XXH64 (chunk_hashes, chunk_cnt * sizeof (u64), file_size);
+
+    hcfree (c_threads);
+    hcfree (params);
+    hcfree (chunk_hashes);
+
+    return (failed == false);
+  }
+
+  XXH64_state_t *state = XXH64_createState ();
+
+  XXH64_reset (state, 0);
+
+  #define FBUFSZ 8192
+
+  char buf[FBUFSZ];
 
   while (!hc_feof (&fp))
   {
@@ -669,10 +854,89 @@ u64 brain_compute_attack_wordlist (const char *filename)
 
   hc_fclose (&fp);
 
-  const u64 hash = XXH64_digest (state);
+  *hash = XXH64_digest (state);
 
   XXH64_freeState (state);
 
+  return true;
+}
+
+u64 brain_compute_attack_wordlist (hashcat_ctx_t *hashcat_ctx, const char *filename)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  u64 key       = 0;
+  u64 file_size = 0;
+
+  u64 hash = 0;
+
+  if (brain_compute_attack_wordlist_key (filename, &key, &file_size) == false)
+  {
+    brain_compute_attack_wordlist_full (filename, 0, &hash);
+
+    return hash;
+  }
+
+  char *cache_dir  = NULL;
+  char *cache_file = NULL;
+  char *cache_tmp  = NULL;
+
+  hc_asprintf (&cache_dir,  "%s/brainstats", folder_config->cache_dir);
+  hc_asprintf (&cache_file, "%s/%016" PRIx64 ".brainstat", cache_dir, key);
+  hc_asprintf (&cache_tmp,  "%s/%016" PRIx64 ".brainstat.%d", cache_dir, key, (int) getpid ());
+
+  // version, file size and hash
+
+  u64 cache[3] = { 0 };
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, cache_file, "rb") == true)
+  {
+    const size_t nread = hc_fread (cache, sizeof (cache), 1, &fp);
+
+    hc_fclose (&fp);
+
+    if ((nread == 1) && (cache[0] == BRAIN_ATTACK_WORDLIST_VERSION) && (cache[1] == file_size))
+    {
+      hcfree (cache_tmp);
+      hcfree (cache_file);
+      hcfree (cache_dir);
+
+      return cache[2];
+    }
+  }
+
+  if (brain_compute_attack_wordlist_full (filename, file_size, &hash) == false)
+  {
+    hcfree (cache_tmp);
+    hcfree (cache_file);
+    hcfree (cache_dir);
+
+    return hash;
+  }
+
+  cache[0] = BRAIN_ATTACK_WORDLIST_VERSION;
+  cache[1] = file_size;
+  cache[2] = hash;
+
+  // it's only a cache, concurrent instances write the same value and a failure is not an error
+
+  hc_mkdir (cache_dir, 0700);
+
+  if (hc_fopen_raw (&fp, cache_tmp, "wb") == true)
+  {
+    const size_t nwrite = hc_fwrite (cache, sizeof (cache), 1, &fp);
+
+    hc_fclose (&fp);
+
+    if ((nwrite != 1) || (rename (cache_tmp, cache_file) == -1)) unlink (cache_tmp);
+  }
+
+  hcfree (cache_tmp);
+  hcfree (cache_file);
+  hcfree (cache_dir);
+
   return hash;
 }
 
@@ -1008,6 +1272,7 @@ bool brain_client_connect (hc_device_param_t *device_param, const status_ctx_t *
   device_param->brain_link_send_bytes  = 0;
   device_param->brain_link_recv_active = false;
   device_param->brain_link_send_active = false;
+  device_param->brain_link_batch       = 0;
 
   memset (&device_param->brain_link_recv_speed, 0, sizeof (link_speed_t));
   memset (&device_param->brain_link_send_speed, 0, sizeof (link_speed_t));
@@ -1245,7 +1510,10 @@ bool brain_client_commit (hc_device_param_t *device_param, const status_ctx_t *s
   return true;
 }
 
-bool brain_client_lookup (hc_device_param_t *device_param, const status_ctx_t *status_ctx)
+// the pipelined mode splits the lookup in two halves: the hashes of the next batch are sent first,
+// the device then runs the previous batch while the server works on them, and only then the answer is read.
+
+bool brain_client_lookup_send (hc_device_param_t *device_param, const status_ctx_t *status_ctx)
 {
   if (device_param->pws_pre_cnt == 0) return true;
 
@@ -1253,10 +1521,8 @@ bool brain_client_lookup (hc_device_param_t *device_param, const status_ctx_t *s
 
   if (brain_link_client_fd == -1) return false;
 
-  char *recvbuf = (char *) device_param->brain_link_in_buf;
   char *sendbuf = (char *) device_param->brain_link_out_buf;
 
-  int in_size  = 0;
   int out_size = device_param->pws_pre_cnt * BRAIN_HASH_SIZE;
 
   u8 operation = BRAIN_OPERATION_HASH_LOOKUP;
@@ -1265,6 +1531,21 @@ bool brain_client_lookup (hc_device_param_t *device_param, const status_ctx_t *s
   if (brain_send (brain_link_client_fd, &out_size,   sizeof (out_size), SEND_FLAGS, device_param, status_ctx) == false) return false;
   if (brain_send (brain_link_client_fd, sendbuf,              out_size, SEND_FLAGS, device_param, status_ctx) == false) return false;
 
+  return true;
+}
+
+bool brain_client_lookup_recv (hc_device_param_t *device_param, const status_ctx_t *status_ctx)
+{
+  if (device_param->pws_pre_cnt == 0) return true;
+
+  const int brain_link_client_fd = device_param->brain_link_client_fd;
+
+  if (brain_link_client_fd == -1) return false;
+
+  char *recvbuf = (char *) device_param->brain_link_in_buf;
+
+  int in_size = 0;
+
   if (brain_recv (brain_link_client_fd, &in_size,     sizeof (in_size),          0, device_param, status_ctx) == false) return false;
 
   if (in_size > (int) device_param->size_brain_link_in) return false;
@@ -1274,6 +1555,49 @@ bool brain_client_lookup (hc_device_param_t *device_param, const status_ctx_t *s
   return true;
 }
 
+bool brain_client_lookup (hc_device_param_t *device_param, const status_ctx_t *status_ctx)
+{
+  if (brain_client_lookup_send (device_param, status_ctx) == false) return false;
+  if (brain_client_lookup_recv (device_param, status_ctx) == false) return false;
+
+  return true;
+}
+
+// in pipelined mode the short-term memory on the server holds two batches, the one running on the device
+// and the one being looked up. reservations and lookups are tagged with the current batch number and a
+// commit only moves the batches up to the given one into the long-term memory.
+
+bool brain_client_batch (hc_device_param_t *device_param, const status_ctx_t *status_ctx)
+{
+  const int brain_link_client_fd = device_param->brain_link_client_fd;
+
+  if (brain_link_client_fd == -1) return false;
+
+  u8 operation = BRAIN_OPERATION_BATCH;
+
+  if (brain_send (brain_link_client_fd, &operation, sizeof (operation), SEND_FLAGS, device_param, status_ctx) == false) return false;
+
+  device_param->brain_link_batch++;
+
+  return true;
+}
+
+bool brain_client_commit_batch (hc_device_param_t *device_param, const status_ctx_t *status_ctx, u32 batch)
+{
+  if (device_param->pws_cnt == 0) return true;
+
+  const int brain_link_client_fd = device_param->brain_link_client_fd;
+
+  if (brain_link_client_fd == -1) return false;
+
+  u8 operation = BRAIN_OPERATION_COMMIT_BATCH;
+
+  if (brain_send (brain_link_client_fd, &operation, sizeof (operation), SEND_FLAGS, device_param, status_ctx) == false) return false;
+  if (brain_send (brain_link_client_fd, &batch,         sizeof (batch), SEND_FLAGS, device_param, status_ctx) == false) return false;
+
+  return true;
+}
+
 void brain_client_generate_hash (u64 *hash, const char *line_buf, const size_t line_len)
 {
   const u64 seed = 0;
@@ -1290,6 +1614,11 @@ void brain_server_db_hash_init (brain_server_db_hash_t *brain_server_db_hash, co
   brain_server_db_hash->long_buf     = NULL;
   brain_server_db_hash->long_alloc   = 0;
   brain_server_db_hash->write_hashes = false;
+  brain_server_db_hash->wal_open     = false;
+  brain_server_db_hash->wal_cnt      = 0;
+  brain_server_db_hash->filter_buf   = NULL;
+  brain_server_db_hash->filter_cnt   = 0;
+  brain_server_db_hash->filter_bits  = 0;
 
   hc_thread_mutex_init (brain_server_db_hash->mux_hr);
   hc_thread_mutex_init (brain_server_db_hash->mux_hg);
@@ -1319,11 +1648,25 @@ void brain_server_db_hash_free (brain_server_db_hash_t *brain_server_db_hash)
 
   hcfree (brain_server_db_hash->long_buf);
 
+  for (int idx = 0; idx < brain_server_db_hash->filter_cnt; idx++)
+  {
+    hcfree (brain_server_db_hash->filter_buf[idx].slots);
+  }
+
+  hcfree (brain_server_db_hash->filter_buf);
+
+  if (brain_server_db_hash->wal_open == true) hc_fclose (&brain_server_db_hash->wal_fp);
+
   brain_server_db_hash->hb            = 0;
   brain_server_db_hash->long_cnt      = 0;
   brain_server_db_hash->long_buf      = NULL;
   brain_server_db_hash->long_alloc    = 0;
   brain_server_db_hash->write_hashes  = false;
+  brain_server_db_hash->wal_open      = false;
+  brain_server_db_hash->wal_cnt       = 0;
+  brain_server_db_hash->filter_buf    = NULL;
+  brain_server_db_hash->filter_cnt    = 0;
+  brain_server_db_hash->filter_bits   = 0;
   brain_server_db_hash->brain_session = 0;
 }
 
@@ -1339,6 +1682,8 @@ void brain_server_db_attack_init (brain_server_db_attack_t *brain_server_db_atta
   brain_server_db_attack->long_buf      = NULL;
   brain_server_db_attack->long_alloc    = 0;
   brain_server_db_attack->write_attacks = false;
+  brain_server_db_attack->wal_open      = false;
+  brain_server_db_attack->wal_cnt       = 0;
 
   hc_thread_mutex_init (brain_server_db_attack->mux_ar);
   hc_thread_mutex_init (brain_server_db_attack->mux_ag);
@@ -1381,6 +1726,8 @@ void brain_server_db_attack_free (brain_server_db_attack_t *brain_server_db_atta
   hcfree (brain_server_db_attack->long_buf);
   hcfree (brain_server_db_attack->short_buf);
 
+  if (brain_server_db_attack->wal_open == true) hc_fclose (&brain_server_db_attack->wal_fp);
+
   brain_server_db_attack->ab            = 0;
   brain_server_db_attack->long_cnt      = 0;
   brain_server_db_attack->long_buf      = NULL;
@@ -1390,6 +1737,8 @@ void brain_server_db_attack_free (brain_server_db_attack_t *brain_server_db_atta
   brain_server_db_attack->short_alloc   = 0;
   brain_server_db_attack->brain_attack  = 0;
   brain_server_db_attack->write_attacks = false;
+  brain_server_db_attack->wal_open      = false;
+  brain_server_db_attack->wal_cnt       = 0;
 }
 
 u64 brain_server_highest_attack (const brain_server_db_attack_t *buf)
@@ -1652,28 +2001,75 @@ bool brain_server_read_hash_dumps (brain_server_dbs_t *brain_server_dbs, const c
     brain_server_dbs->hash_cnt++;
   }
 
+  // replay the logs on top of the snapshots, a session which was never compacted has a log only
+  // filter images are read here too, the log replay inserts into the filter or into the sorted hashes,
+  // whatever was read first, the conversion below handles both
+
+  rewinddir (dirp);
+
+  while ((entry = readdir (dirp)) != NULL)
+  {
+    char *file = entry->d_name;
+
+    const size_t len = strlen (file);
+
+    if ((len != 19) && (len != 23)) continue;
+
+    if (memcmp (file, "brain.", 6) != 0) continue;
+
+    const bool is_filter = (len == 19) && (memcmp (file + 14, ".lflt", 5) == 0);
+
+    if ((is_filter == false) && (memcmp (file + 14, ".lwal", 5) != 0)) continue;
+
+    if ((len == 23) && (memcmp (file + 19, ".old", 4) != 0)) continue;
+
+    const u32 brain_session = byte_swap_32 (hex_to_u32 ((const u8 *) file + 6));
+
+    brain_server_db_hash_t *brain_server_db_hash = NULL;
+
+    for (int idx = 0; idx < brain_server_dbs->hash_cnt; idx++)
+    {
+      if (brain_server_dbs->hash_buf[idx].brain_session == brain_session) brain_server_db_hash = &brain_server_dbs->hash_buf[idx];
+    }
+
+    if (brain_server_db_hash == NULL)
+    {
+      if (brain_server_dbs->hash_cnt == BRAIN_SERVER_SESSIONS_MAX) continue;
+
+      brain_server_db_hash = &brain_server_dbs->hash_buf[brain_server_dbs->hash_cnt];
+
+      brain_server_db_hash_init (brain_server_db_hash, brain_session);
+
+      brain_server_dbs->hash_cnt++;
+    }
+
+    if (is_filter == true)
+    {
+      brain_server_read_hash_filter (brain_server_db_hash, file);
+    }
+    else
+    {
+      brain_server_read_hash_wal (brain_server_db_hash, file, (len == 19));
+    }
+  }
+
   closedir (dirp);
 
+  for (int idx = 0; idx < brain_server_dbs->hash_cnt; idx++)
+  {
+    brain_server_filter_select (brain_server_dbs, &brain_server_dbs->hash_buf[idx]);
+  }
+
   return true;
 }
 
-bool brain_server_write_hash_dumps (brain_server_dbs_t *brain_server_dbs, const char *path)
+bool brain_server_write_hash_dumps (brain_server_dbs_t *brain_server_dbs, const char *path, const bool force)
 {
   for (i64 idx = 0; idx < brain_server_dbs->hash_cnt; idx++)
   {
     brain_server_db_hash_t *brain_server_db_hash = &brain_server_dbs->hash_buf[idx];
 
-    hc_thread_mutex_lock (brain_server_db_hash->mux_hg);
-
-    char file[100];
-
-    memset (file, 0, sizeof (file));
-
-    snprintf (file, sizeof (file), "%s/brain.%08x.ldmp", path, brain_server_db_hash->brain_session);
-
-    brain_server_write_hash_dump (brain_server_db_hash, file);
-
-    hc_thread_mutex_unlock (brain_server_db_hash->mux_hg);
+    brain_server_write_hash_dump (brain_server_db_hash, path, force);
   }
 
   return true;
@@ -1700,7 +2096,7 @@ bool brain_server_read_hash_dump (brain_server_db_hash_t *brain_server_db_hash,
 
   HCFILE fp;
 
-  if (hc_fopen (&fp, file, "rb") == false)
+  if (hc_fopen_raw (&fp, file, "rb") == false)
   {
     brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
 
@@ -1741,318 +2137,1382 @@ bool brain_server_read_hash_dump (brain_server_db_hash_t *brain_server_db_hash,
   return true;
 }
 
-bool brain_server_write_hash_dump (brain_server_db_hash_t *brain_server_db_hash, const char *file)
-{
-  if (brain_server_db_hash->write_hashes == false) return true;
-
-  hc_timer_t timer_dump;
+/**
+ * The long-term memory is no longer written in full on every timer tick.
+ * Each commit appends its new hashes to brain.<session>.lwal (the write-ahead log),
+ * and the timer folds the log into the snapshot brain.<session>.ldmp only once it
+ * has grown to a fraction of the snapshot size (BRAIN_SERVER_WAL_COMPACT_DIV).
+ * For that, the log is renamed to .lwal.old while holding the lock and a new log is
+ * started with the next commit. The merge itself runs from the files on disk, the
+ * old snapshot is streamed in chunks and the sorted old log is merged into it, so the
+ * lock is never held while gigabytes are written.
+ * After a crash, the snapshot is read first and .lwal.old and .lwal are replayed on top.
+ */
 
-  hc_timer_set (&timer_dump);
+static i64 brain_server_unique_hash_long (brain_server_hash_long_t *buf, const i64 cnt)
+{
+  if (cnt == 0) return 0;
 
-  // write to file
+  qsort (buf, cnt, sizeof (brain_server_hash_long_t), brain_server_sort_hash_long);
 
-  HCFILE fp;
+  i64 unique_cnt = 1;
 
-  if (hc_fopen (&fp, file, "wb") == false)
+  for (i64 idx = 1; idx < cnt; idx++)
   {
-    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+    if (brain_server_sort_hash_long (buf + unique_cnt - 1, buf + idx) == 0) continue;
 
-    return false;
+    buf[unique_cnt] = buf[idx];
+
+    unique_cnt++;
   }
 
-  const size_t nwrite = hc_fwrite (brain_server_db_hash->long_buf, sizeof (brain_server_hash_long_t), brain_server_db_hash->long_cnt, &fp);
+  return unique_cnt;
+}
+
+bool brain_server_write_hash_dump (brain_server_db_hash_t *brain_server_db_hash, const char *path, const bool force)
+{
+  char dump_file[256];
+  char wal_file[256];
+  char old_file[256];
+  char tmp_file[256];
+
+  snprintf (dump_file, sizeof (dump_file), "%s/brain.%08x.ldmp",     path, brain_server_db_hash->brain_session);
+  snprintf (wal_file,  sizeof (wal_file),  "%s/brain.%08x.lwal",     path, brain_server_db_hash->brain_session);
+  snprintf (old_file,  sizeof (old_file),  "%s/brain.%08x.lwal.old", path, brain_server_db_hash->brain_session);
+  snprintf (tmp_file,  sizeof (tmp_file),  "%s/brain.%08x.ldmp.tmp", path, brain_server_db_hash->brain_session);
+
+  struct stat sb;
+
+  // rotate the log, a left-over old log from a failed merge is merged first
+
+  hc_thread_mutex_lock (brain_server_db_hash->mux_hg);
+
+  if (brain_server_db_hash->wal_open == true)
+  {
+    hc_fflush (&brain_server_db_hash->wal_fp);
+    hc_fsync  (&brain_server_db_hash->wal_fp);
+  }
+
+  bool compact = (stat (old_file, &sb) == 0);
+
+  if (compact == false)
+  {
+    const i64 dump_cnt = brain_server_db_hash->long_cnt - brain_server_db_hash->wal_cnt;
+
+    bool rotate = (brain_server_db_hash->write_hashes == true) && ((force == true) || ((brain_server_db_hash->wal_cnt * BRAIN_SERVER_WAL_COMPACT_DIV) >= dump_cnt));
+
+    // a converted session still has its sorted snapshot
+
+    const bool filter = (brain_server_db_hash->filter_bits > 0);
+
+    if ((filter == true) && (stat (dump_file, &sb) == 0)) rotate = true;
+
+    if (rotate == true)
+    {
+      if (brain_server_db_hash->wal_open == true)
+      {
+        hc_fclose (&brain_server_db_hash->wal_fp);
+
+        brain_server_db_hash->wal_open = false;
+      }
+
+      if (rename (wal_file, old_file) == 0)
+      {
+        compact = true;
+      }
+      else if ((filter == false) || (errno != ENOENT))
+      {
+        brain_logging (stderr, 0, "%s: %s\n", wal_file, strerror (errno));
+      }
+
+      if (filter == true) compact = true;
+
+      brain_server_db_hash->wal_cnt      = 0;
+      brain_server_db_hash->write_hashes = false;
+    }
+  }
+
+  hc_thread_mutex_unlock (brain_server_db_hash->mux_hg);
+
+  if (compact == false) return true;
+
+  // the filter is in memory in full, it's written as a whole and both logs become obsolete
+
+  if (brain_server_db_hash->filter_bits > 0)
+  {
+    if (brain_server_write_hash_filter (brain_server_db_hash, path) == false) return false;
+
+    unlink (old_file);
+    unlink (dump_file);
+
+    return true;
+  }
+
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  // the old log, it's unsorted and can have duplicates across commits
+
+  if (stat (old_file, &sb) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", old_file, strerror (errno));
+
+    return false;
+  }
+
+  HCFILE wal_fp;
+
+  if (hc_fopen_raw (&wal_fp, old_file, "rb") == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", old_file, strerror (errno));
+
+    return false;
+  }
+
+  i64 wal_cnt = (u64) sb.st_size / sizeof (brain_server_hash_long_t);
+
+  brain_server_hash_long_t *wal_buf = (brain_server_hash_long_t *) hcmalloc ((wal_cnt + 1) * sizeof (brain_server_hash_long_t));
+
+  wal_cnt = (i64) hc_fread (wal_buf, sizeof (brain_server_hash_long_t), wal_cnt, &wal_fp);
+
+  hc_fclose (&wal_fp);
+
+  wal_cnt = brain_server_unique_hash_long (wal_buf, wal_cnt);
+
+  // stream the old snapshot and merge the log into it
+
+  HCFILE dump_fp;
+
+  bool dump_open = hc_fopen_raw (&dump_fp, dump_file, "rb");
+
+  HCFILE tmp_fp;
+
+  if (hc_fopen_raw (&tmp_fp, tmp_file, "wb") == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", tmp_file, strerror (errno));
+
+    if (dump_open == true) hc_fclose (&dump_fp);
+
+    hcfree (wal_buf);
+
+    return false;
+  }
+
+  brain_server_hash_long_t *dump_buf = (brain_server_hash_long_t *) hcmalloc (BRAIN_SERVER_COMPACT_CHUNK_SIZE * sizeof (brain_server_hash_long_t));
+  brain_server_hash_long_t *out_buf  = (brain_server_hash_long_t *) hcmalloc (BRAIN_SERVER_COMPACT_CHUNK_SIZE * sizeof (brain_server_hash_long_t));
+
+  i64 dump_pos  = 0;
+  i64 dump_cnt  = 0;
+  i64 wal_pos   = 0;
+  i64 out_cnt   = 0;
+  i64 out_total = 0;
+
+  bool rc = true;
+
+  while (rc == true)
+  {
+    if ((dump_pos == dump_cnt) && (dump_open == true))
+    {
+      dump_cnt = (i64) hc_fread (dump_buf, sizeof (brain_server_hash_long_t), BRAIN_SERVER_COMPACT_CHUNK_SIZE, &dump_fp);
+      dump_pos = 0;
+
+      if (dump_cnt == 0)
+      {
+        hc_fclose (&dump_fp);
+
+        dump_open = false;
+      }
+    }
+
+    const bool dump_left = (dump_pos < dump_cnt);
+    const bool wal_left  = (wal_pos  < wal_cnt);
+
+    if ((dump_left == false) && (wal_left == false)) break;
+
+    int cmp = 0;
+
+    if ((dump_left == true) && (wal_left == true))
+    {
+      cmp = brain_server_sort_hash_long (dump_buf + dump_pos, wal_buf + wal_pos);
+    }
+    else
+    {
+      cmp = (dump_left == true) ? -1 : 1;
+    }
+
+    if (cmp <= 0)
+    {
+      out_buf[out_cnt] = dump_buf[dump_pos];
+
+      dump_pos++;
+
+      if (cmp == 0) wal_pos++;
+    }
+    else
+    {
+      out_buf[out_cnt] = wal_buf[wal_pos];
+
+      wal_pos++;
+    }
+
+    out_cnt++;
+
+    if (out_cnt < BRAIN_SERVER_COMPACT_CHUNK_SIZE) continue;
+
+    if (hc_fwrite (out_buf, sizeof (brain_server_hash_long_t), out_cnt, &tmp_fp) != (size_t) out_cnt) rc = false;
+
+    out_total += out_cnt;
+
+    out_cnt = 0;
+  }
+
+  if ((rc == true) && (out_cnt > 0))
+  {
+    if (hc_fwrite (out_buf, sizeof (brain_server_hash_long_t), out_cnt, &tmp_fp) != (size_t) out_cnt) rc = false;
+
+    out_total += out_cnt;
+  }
+
+  if (dump_open == true) hc_fclose (&dump_fp);
+
+  hcfree (out_buf);
+  hcfree (dump_buf);
+  hcfree (wal_buf);
+
+  hc_fflush (&tmp_fp);
+  hc_fsync  (&tmp_fp);
+  hc_fclose (&tmp_fp);
+
+  if (rc == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", tmp_file, strerror (errno));
+
+    unlink (tmp_file);
+
+    return false;
+  }
+
+  if (rename (tmp_file, dump_file) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", dump_file, strerror (errno));
+
+    return false;
+  }
+
+  unlink (old_file);
+
+  const double ms = hc_timer_get (timer_dump);
+
+  brain_logging (stdout, 0, "Wrote %" PRIu64 " bytes from session 0x%08x in %.2f ms (%" PRIi64 " logged hashes)\n", (u64) out_total * sizeof (brain_server_hash_long_t), brain_server_db_hash->brain_session, ms, wal_cnt);
+
+  return true;
+}
+
+bool brain_server_read_hash_wal (brain_server_db_hash_t *brain_server_db_hash, const char *file, const bool live)
+{
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  struct stat sb;
+
+  memset (&sb, 0, sizeof (struct stat));
+
+  if (stat (file, &sb) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+    return false;
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, file, "rb") == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+    return false;
+  }
+
+  // a torn record at the end of the log is from a crash during the append, it's ignored
+
+  i64 temp_cnt = (u64) sb.st_size / sizeof (brain_server_hash_long_t);
+
+  brain_server_hash_long_t *temp_buf = (brain_server_hash_long_t *) hcmalloc ((temp_cnt + 1) * sizeof (brain_server_hash_long_t));
+
+  temp_cnt = (i64) hc_fread (temp_buf, sizeof (brain_server_hash_long_t), temp_cnt, &fp);
+
+  hc_fclose (&fp);
+
+  if (live == true) brain_server_db_hash->wal_cnt += temp_cnt;
+
+  if (brain_server_db_hash->filter_bits > 0)
+  {
+    for (i64 idx = 0; idx < temp_cnt; idx++)
+    {
+      if (brain_server_filter_insert (brain_server_db_hash, temp_buf[idx].hash) == true) continue;
+
+      brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+      break;
+    }
+
+    brain_server_db_hash->write_hashes = true;
+
+    hcfree (temp_buf);
+
+    const double ms = hc_timer_get (timer_dump);
+
+    brain_logging (stdout, 0, "Replayed %" PRIu64 " bytes to session 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_hash->brain_session, ms);
+
+    return true;
+  }
+
+  temp_cnt = brain_server_unique_hash_long (temp_buf, temp_cnt);
+
+  if (brain_server_db_hash_realloc (brain_server_db_hash, temp_cnt) == false)
+  {
+    brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+    hcfree (temp_buf);
+
+    return false;
+  }
+
+  // merge in reverse order, like the commit does
+
+  const i64 cnt_total = brain_server_db_hash->long_cnt + temp_cnt;
+
+  i64 long_left  = brain_server_db_hash->long_cnt - 1;
+  i64 temp_left  = temp_cnt - 1;
+  i64 long_dupes = 0;
+
+  for (i64 idx = cnt_total - 1; idx >= long_dupes; idx--)
+  {
+    int rc = 0;
+
+    if ((long_left >= 0) && (temp_left >= 0))
+    {
+      rc = brain_server_sort_hash_long (brain_server_db_hash->long_buf + long_left, temp_buf + temp_left);
+    }
+    else
+    {
+      rc = (long_left >= 0) ? 1 : -1;
+    }
+
+    if (rc == -1)
+    {
+      brain_server_db_hash->long_buf[idx] = temp_buf[temp_left];
+
+      temp_left--;
+    }
+    else
+    {
+      brain_server_db_hash->long_buf[idx] = brain_server_db_hash->long_buf[long_left];
+
+      if (rc == 0)
+      {
+        temp_left--;
+
+        long_dupes++;
+      }
+
+      long_left--;
+    }
+  }
+
+  brain_server_db_hash->long_cnt = cnt_total - long_dupes;
+
+  if (long_dupes)
+  {
+    memmove (brain_server_db_hash->long_buf, brain_server_db_hash->long_buf + long_dupes, brain_server_db_hash->long_cnt * sizeof (brain_server_hash_long_t));
+  }
+
+  brain_server_db_hash->write_hashes = true;
+
+  hcfree (temp_buf);
+
+  const double ms = hc_timer_get (timer_dump);
+
+  brain_logging (stdout, 0, "Replayed %" PRIu64 " bytes to session 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_hash->brain_session, ms);
+
+  return true;
+}
+
+bool brain_server_write_hash_wal (brain_server_db_hash_t *brain_server_db_hash, const char *path, const brain_server_hash_short_t *buf, const i64 cnt)
+{
+  if (brain_server_db_hash->wal_open == false)
+  {
+    char file[256];
+
+    snprintf (file, sizeof (file), "%s/brain.%08x.lwal", path, brain_server_db_hash->brain_session);
+
+    if (hc_fopen_raw (&brain_server_db_hash->wal_fp, file, "ab") == false)
+    {
+      brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+      return false;
+    }
+
+    brain_server_db_hash->wal_open = true;
+  }
+
+  for (i64 idx = 0; idx < cnt; idx++)
+  {
+    if (hc_fwrite (buf[idx].hash, sizeof (brain_server_hash_long_t), 1, &brain_server_db_hash->wal_fp) != 1) return false;
+  }
+
+  hc_fflush (&brain_server_db_hash->wal_fp);
+
+  brain_server_db_hash->wal_cnt += cnt;
+
+  return true;
+}
+
+bool brain_server_read_hash_filter (brain_server_db_hash_t *brain_server_db_hash, const char *file)
+{
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  struct stat sb;
+
+  memset (&sb, 0, sizeof (struct stat));
+
+  if (stat (file, &sb) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+    return false;
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, file, "rb") == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+    return false;
+  }
+
+  u32 header[2] = { 0 };
+
+  if (hc_fread (header, sizeof (header), 1, &fp) != 1)
+  {
+    brain_logging (stderr, 0, "%s: truncated filter header\n", file);
+
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  const u32 filter_bits = header[0];
+  const int filter_cnt  = (int) MIN (header[1], (u32) BRAIN_SERVER_FILTERS_MAX);
+
+  if (((filter_bits != 8) && (filter_bits != 16) && (filter_bits != 32)) || (header[1] > (u32) BRAIN_SERVER_FILTERS_MAX))
+  {
+    brain_logging (stderr, 0, "%s: invalid filter header\n", file);
+
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  brain_server_filter_t *filter_buf = (brain_server_filter_t *) hccalloc (MAX (filter_cnt, 1), sizeof (brain_server_filter_t));
+
+  if (filter_buf == NULL)
+  {
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  bool rc = true;
+
+  for (int idx = 0; (rc == true) && (idx < filter_cnt); idx++)
+  {
+    brain_server_filter_t *filter = &filter_buf[idx];
+
+    u64 filter_header[4] = { 0 };
+
+    if (hc_fread (filter_header, sizeof (filter_header), 1, &fp) != 1)
+    {
+      rc = false;
+
+      break;
+    }
+
+    filter->buckets_cnt   = filter_header[0];
+    filter->items_cnt     = filter_header[1];
+    filter->victim_bucket = filter_header[2];
+    filter->victim_fp     = filter_header[3];
+
+    if ((filter->buckets_cnt == 0) || (filter->buckets_cnt & (filter->buckets_cnt - 1)))
+    {
+      rc = false;
+
+      break;
+    }
+
+    const u64 slots_cnt = filter->buckets_cnt * BRAIN_SERVER_FILTER_BUCKET_SIZE;
+
+    filter->slots = (u8 *) hcmalloc (slots_cnt * (filter_bits / 8));
+
+    if (filter->slots == NULL)
+    {
+      rc = false;
+
+      break;
+    }
+
+    if (hc_fread (filter->slots, filter_bits / 8, slots_cnt, &fp) != slots_cnt) rc = false;
+  }
+
+  hc_fclose (&fp);
+
+  if (rc == false)
+  {
+    brain_logging (stderr, 0, "%s: invalid or truncated filter\n", file);
+
+    for (int idx = 0; idx < filter_cnt; idx++) hcfree (filter_buf[idx].slots);
+
+    hcfree (filter_buf);
+
+    return false;
+  }
+
+  brain_server_db_hash->filter_buf  = filter_buf;
+  brain_server_db_hash->filter_cnt  = filter_cnt;
+  brain_server_db_hash->filter_bits = filter_bits;
+
+  const double ms = hc_timer_get (timer_dump);
+
+  brain_logging (stdout, 0, "Read %" PRIu64 " bytes from session 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_hash->brain_session, ms);
+
+  return true;
+}
+
+bool brain_server_write_hash_filter (brain_server_db_hash_t *brain_server_db_hash, const char *path)
+{
+  char filter_file[256];
+  char tmp_file[256];
+
+  snprintf (filter_file, sizeof (filter_file), "%s/brain.%08x.lflt",     path, brain_server_db_hash->brain_session);
+  snprintf (tmp_file,    sizeof (tmp_file),    "%s/brain.%08x.lflt.tmp", path, brain_server_db_hash->brain_session);
+
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, tmp_file, "wb") == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", tmp_file, strerror (errno));
+
+    return false;
+  }
+
+  // as a reader, lookups can go on while it's written
+
+  hc_thread_mutex_lock (brain_server_db_hash->mux_hr);
+
+  brain_server_db_hash->hb++;
+
+  if (brain_server_db_hash->hb == 1)
+  {
+    hc_thread_mutex_lock (brain_server_db_hash->mux_hg);
+  }
+
+  hc_thread_mutex_unlock (brain_server_db_hash->mux_hr);
+
+  const u32 header[2] = { brain_server_db_hash->filter_bits, (u32) brain_server_db_hash->filter_cnt };
+
+  bool rc = (hc_fwrite (header, sizeof (header), 1, &fp) == 1);
+
+  for (int idx = 0; (rc == true) && (idx < brain_server_db_hash->filter_cnt); idx++)
+  {
+    const brain_server_filter_t *filter = &brain_server_db_hash->filter_buf[idx];
+
+    const u64 filter_header[4] = { filter->buckets_cnt, filter->items_cnt, filter->victim_bucket, filter->victim_fp };
+
+    if (hc_fwrite (filter_header, sizeof (filter_header), 1, &fp) != 1) rc = false;
+
+    const u64 slots_cnt = filter->buckets_cnt * BRAIN_SERVER_FILTER_BUCKET_SIZE;
+
+    if ((rc == true) && (hc_fwrite (filter->slots, brain_server_db_hash->filter_bits / 8, slots_cnt, &fp) != slots_cnt)) rc = false;
+  }
+
+  const i64    hashes_cnt = brain_server_db_hash->long_cnt;
+  const u64    size       = brain_server_filter_size (brain_server_db_hash);
+  const double fpr        = brain_server_filter_fpr  (brain_server_db_hash);
+
+  hc_thread_mutex_lock (brain_server_db_hash->mux_hr);
+
+  brain_server_db_hash->hb--;
+
+  if (brain_server_db_hash->hb == 0)
+  {
+    hc_thread_mutex_unlock (brain_server_db_hash->mux_hg);
+  }
+
+  hc_thread_mutex_unlock (brain_server_db_hash->mux_hr);
+
+  hc_fflush (&fp);
+  hc_fsync  (&fp);
+  hc_fclose (&fp);
+
+  if (rc == false)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", tmp_file, strerror (errno));
+
+    unlink (tmp_file);
+
+    return false;
+  }
+
+  if (rename (tmp_file, filter_file) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", filter_file, strerror (errno));
+
+    return false;
+  }
+
+  const double ms = hc_timer_get (timer_dump);
+
+  brain_logging (stdout, 0, "Wrote %" PRIu64 " bytes from session 0x%08x in %.2f ms (%" PRIi64 " hashes, %u bit filter, FPR: %.4f%%)\n", size, brain_server_db_hash->brain_session, ms, hashes_cnt, brain_server_db_hash->filter_bits, fpr * 100);
+
+  return true;
+}
+
+bool brain_server_read_attack_dumps (brain_server_dbs_t *brain_server_dbs, const char *path)
+{
+  brain_server_dbs->attack_cnt = 0;
+
+  /* temporary disabled due to https://github.com/hashcat/hashcat/issues/2379
+  if (chdir (path) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", path, strerror (errno));
+
+    return false;
+  }
+  */
+
+  DIR *dirp = opendir (path);
+
+  if (dirp == NULL)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", path, strerror (errno));
+
+    return false;
+  }
+
+  struct dirent *entry = NULL;
+
+  while ((entry = readdir (dirp)) != NULL)
+  {
+    char *file = entry->d_name;
+
+    const size_t len = strlen (file);
+
+    if (len != 19) continue;
+
+    if (file[ 0] != 'b') continue;
+    if (file[ 1] != 'r') continue;
+    if (file[ 2] != 'a') continue;
+    if (file[ 3] != 'i') continue;
+    if (file[ 4] != 'n') continue;
+    if (file[ 5] != '.') continue;
+
+    if (file[14] != '.') continue;
+    if (file[15] != 'a') continue;
+    if (file[16] != 'd') continue;
+    if (file[17] != 'm') continue;
+    if (file[18] != 'p') continue;
+
+    const u32 brain_attack = byte_swap_32 (hex_to_u32 ((const u8 *) file + 6));
+
+    brain_server_db_attack_t *brain_server_db_attack = &brain_server_dbs->attack_buf[brain_server_dbs->attack_cnt];
+
+    brain_server_db_attack_init (brain_server_db_attack, brain_attack);
+
+    if (brain_server_read_attack_dump (brain_server_db_attack, file) == false) continue;
+
+    brain_server_dbs->attack_cnt++;
+  }
+
+  // replay the logs on top of the snapshots, an attack which was never compacted has a log only
+
+  rewinddir (dirp);
+
+  while ((entry = readdir (dirp)) != NULL)
+  {
+    char *file = entry->d_name;
+
+    const size_t len = strlen (file);
+
+    if ((len != 19) && (len != 23)) continue;
+
+    if (memcmp (file,      "brain.", 6) != 0) continue;
+    if (memcmp (file + 14, ".awal",  5) != 0) continue;
+
+    if ((len == 23) && (memcmp (file + 19, ".old", 4) != 0)) continue;
+
+    const u32 brain_attack = byte_swap_32 (hex_to_u32 ((const u8 *) file + 6));
 
-  if (nwrite != (size_t) brain_server_db_hash->long_cnt)
+    brain_server_db_attack_t *brain_server_db_attack = NULL;
+
+    for (int idx = 0; idx < brain_server_dbs->attack_cnt; idx++)
+    {
+      if (brain_server_dbs->attack_buf[idx].brain_attack == brain_attack) brain_server_db_attack = &brain_server_dbs->attack_buf[idx];
+    }
+
+    if (brain_server_db_attack == NULL)
+    {
+      if (brain_server_dbs->attack_cnt == BRAIN_SERVER_ATTACKS_MAX) continue;
+
+      brain_server_db_attack = &brain_server_dbs->attack_buf[brain_server_dbs->attack_cnt];
+
+      brain_server_db_attack_init (brain_server_db_attack, brain_attack);
+
+      brain_server_dbs->attack_cnt++;
+    }
+
+    brain_server_read_attack_wal (brain_server_db_attack, file, (len == 19));
+  }
+
+  closedir (dirp);
+
+  return true;
+}
+
+bool brain_server_write_attack_dumps (brain_server_dbs_t *brain_server_dbs, const char *path, const bool force)
+{
+  for (i64 idx = 0; idx < brain_server_dbs->attack_cnt; idx++)
+  {
+    brain_server_db_attack_t *brain_server_db_attack = &brain_server_dbs->attack_buf[idx];
+
+    brain_server_write_attack_dump (brain_server_db_attack, path, force);
+  }
+
+  return true;
+}
+
+bool brain_server_read_attack_dump (brain_server_db_attack_t *brain_server_db_attack, const char *file)
+{
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  // read from file
+
+  struct stat sb;
+
+  memset (&sb, 0, sizeof (struct stat));
+
+  if (stat (file, &sb) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+    return false;
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, file, "rb") == false)
   {
-    brain_logging (stderr, 0, "%s: only %" PRIu64 " bytes written\n", file, (u64) nwrite * sizeof (brain_server_hash_long_t));
+    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+    return false;
+  }
+
+  i64 temp_cnt = (u64) sb.st_size / sizeof (brain_server_attack_long_t);
+
+  if (brain_server_db_attack_realloc (brain_server_db_attack, temp_cnt, 0) == false)
+  {
+    brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
 
     hc_fclose (&fp);
 
     return false;
   }
 
-  hc_fclose (&fp);
+  const size_t nread = hc_fread (brain_server_db_attack->long_buf, sizeof (brain_server_attack_long_t), temp_cnt, &fp);
 
-  brain_server_db_hash->write_hashes = false;
+  if (nread != (size_t) temp_cnt)
+  {
+    brain_logging (stderr, 0, "%s: only %" PRIu64 " bytes read\n", file, (u64) nread * sizeof (brain_server_attack_long_t));
 
-  // stats
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  brain_server_db_attack->long_cnt      = temp_cnt;
+  brain_server_db_attack->write_attacks = false;
+
+  hc_fclose (&fp);
 
   const double ms = hc_timer_get (timer_dump);
 
+  brain_logging (stdout, 0, "Read %" PRIu64 " bytes from attack 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_attack->brain_attack, ms);
+
+  return true;
+}
+
+// same scheme as the hashes, with brain.<attack>.awal as log. the ranges are small compared to the hashes
+// so the merge reads snapshot and old log in one go.
+
+static bool brain_server_append_attack_file (const char *file, brain_server_attack_long_t **buf, i64 *cnt)
+{
   struct stat sb;
 
   memset (&sb, 0, sizeof (struct stat));
 
-  if (stat (file, &sb) == -1)
+  if (stat (file, &sb) == -1) return (errno == ENOENT);
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, file, "rb") == false)
   {
     brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
 
     return false;
   }
 
-  brain_logging (stdout, 0, "Wrote %" PRIu64 " bytes from session 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_hash->brain_session, ms);
+  const i64 temp_cnt = (u64) sb.st_size / sizeof (brain_server_attack_long_t);
+
+  brain_server_attack_long_t *temp_buf = (brain_server_attack_long_t *) hcrealloc (*buf, *cnt * sizeof (brain_server_attack_long_t), (temp_cnt + 1) * sizeof (brain_server_attack_long_t));
+
+  *buf = temp_buf;
+  *cnt += (i64) hc_fread (temp_buf + *cnt, sizeof (brain_server_attack_long_t), temp_cnt, &fp);
+
+  hc_fclose (&fp);
 
   return true;
 }
 
-bool brain_server_read_attack_dumps (brain_server_dbs_t *brain_server_dbs, const char *path)
+bool brain_server_write_attack_dump (brain_server_db_attack_t *brain_server_db_attack, const char *path, const bool force)
 {
-  brain_server_dbs->attack_cnt = 0;
+  char dump_file[256];
+  char wal_file[256];
+  char old_file[256];
+  char tmp_file[256];
 
-  /* temporary disabled due to https://github.com/hashcat/hashcat/issues/2379
-  if (chdir (path) == -1)
+  snprintf (dump_file, sizeof (dump_file), "%s/brain.%08x.admp",     path, brain_server_db_attack->brain_attack);
+  snprintf (wal_file,  sizeof (wal_file),  "%s/brain.%08x.awal",     path, brain_server_db_attack->brain_attack);
+  snprintf (old_file,  sizeof (old_file),  "%s/brain.%08x.awal.old", path, brain_server_db_attack->brain_attack);
+  snprintf (tmp_file,  sizeof (tmp_file),  "%s/brain.%08x.admp.tmp", path, brain_server_db_attack->brain_attack);
+
+  struct stat sb;
+
+  hc_thread_mutex_lock (brain_server_db_attack->mux_ag);
+
+  if (brain_server_db_attack->wal_open == true)
   {
-    brain_logging (stderr, 0, "%s: %s\n", path, strerror (errno));
+    hc_fflush (&brain_server_db_attack->wal_fp);
+    hc_fsync  (&brain_server_db_attack->wal_fp);
+  }
+
+  bool compact = (stat (old_file, &sb) == 0);
+
+  if ((compact == false) && (brain_server_db_attack->write_attacks == true))
+  {
+    const i64 dump_cnt = brain_server_db_attack->long_cnt - brain_server_db_attack->wal_cnt;
+
+    if ((force == true) || ((brain_server_db_attack->wal_cnt * BRAIN_SERVER_WAL_COMPACT_DIV) >= dump_cnt))
+    {
+      if (brain_server_db_attack->wal_open == true)
+      {
+        hc_fclose (&brain_server_db_attack->wal_fp);
+
+        brain_server_db_attack->wal_open = false;
+      }
+
+      if (rename (wal_file, old_file) == 0)
+      {
+        compact = true;
+      }
+      else
+      {
+        brain_logging (stderr, 0, "%s: %s\n", wal_file, strerror (errno));
+      }
+
+      brain_server_db_attack->wal_cnt       = 0;
+      brain_server_db_attack->write_attacks = false;
+    }
+  }
+
+  hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
+
+  if (compact == false) return true;
+
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  brain_server_attack_long_t *temp_buf = NULL;
+
+  i64 temp_cnt = 0;
+
+  if (brain_server_append_attack_file (dump_file, &temp_buf, &temp_cnt) == false)
+  {
+    hcfree (temp_buf);
 
     return false;
   }
-  */
 
-  DIR *dirp = opendir (path);
+  if (brain_server_append_attack_file (old_file, &temp_buf, &temp_cnt) == false)
+  {
+    hcfree (temp_buf);
 
-  if (dirp == NULL)
+    return false;
+  }
+
+  qsort (temp_buf, temp_cnt, sizeof (brain_server_attack_long_t), brain_server_sort_attack_long);
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, tmp_file, "wb") == false)
   {
-    brain_logging (stderr, 0, "%s: %s\n", path, strerror (errno));
+    brain_logging (stderr, 0, "%s: %s\n", tmp_file, strerror (errno));
+
+    hcfree (temp_buf);
+
+    return false;
+  }
+
+  const size_t nwrite = hc_fwrite (temp_buf, sizeof (brain_server_attack_long_t), temp_cnt, &fp);
+
+  hcfree (temp_buf);
+
+  hc_fflush (&fp);
+  hc_fsync  (&fp);
+  hc_fclose (&fp);
+
+  if (nwrite != (size_t) temp_cnt)
+  {
+    brain_logging (stderr, 0, "%s: only %" PRIu64 " bytes written\n", tmp_file, (u64) nwrite * sizeof (brain_server_attack_long_t));
+
+    unlink (tmp_file);
+
+    return false;
+  }
+
+  if (rename (tmp_file, dump_file) == -1)
+  {
+    brain_logging (stderr, 0, "%s: %s\n", dump_file, strerror (errno));
+
+    return false;
+  }
+
+  unlink (old_file);
+
+  const double ms = hc_timer_get (timer_dump);
+
+  brain_logging (stdout, 0, "Wrote %" PRIu64 " bytes from attack 0x%08x in %.2f ms\n", (u64) temp_cnt * sizeof (brain_server_attack_long_t), brain_server_db_attack->brain_attack, ms);
+
+  return true;
+}
+
+bool brain_server_read_attack_wal (brain_server_db_attack_t *brain_server_db_attack, const char *file, const bool live)
+{
+  hc_timer_t timer_dump;
+
+  hc_timer_set (&timer_dump);
+
+  brain_server_attack_long_t *temp_buf = NULL;
+
+  i64 temp_cnt = 0;
+
+  if (brain_server_append_attack_file (file, &temp_buf, &temp_cnt) == false)
+  {
+    hcfree (temp_buf);
+
+    return false;
+  }
+
+  if (brain_server_db_attack_realloc (brain_server_db_attack, temp_cnt, 0) == false)
+  {
+    brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+    hcfree (temp_buf);
 
     return false;
   }
 
-  struct dirent *entry = NULL;
+  if (temp_cnt > 0)
+  {
+    memcpy (brain_server_db_attack->long_buf + brain_server_db_attack->long_cnt, temp_buf, temp_cnt * sizeof (brain_server_attack_long_t));
+  }
+
+  brain_server_db_attack->long_cnt += temp_cnt;
+
+  qsort (brain_server_db_attack->long_buf, brain_server_db_attack->long_cnt, sizeof (brain_server_attack_long_t), brain_server_sort_attack_long);
+
+  if (live == true) brain_server_db_attack->wal_cnt += temp_cnt;
+
+  brain_server_db_attack->write_attacks = true;
+
+  hcfree (temp_buf);
+
+  const double ms = hc_timer_get (timer_dump);
+
+  brain_logging (stdout, 0, "Replayed %" PRIu64 " bytes to attack 0x%08x in %.2f ms\n", (u64) temp_cnt * sizeof (brain_server_attack_long_t), brain_server_db_attack->brain_attack, ms);
+
+  return true;
+}
+
+bool brain_server_write_attack_wal (brain_server_db_attack_t *brain_server_db_attack, const char *path, const brain_server_attack_long_t *entry)
+{
+  if (brain_server_db_attack->wal_open == false)
+  {
+    char file[256];
+
+    snprintf (file, sizeof (file), "%s/brain.%08x.awal", path, brain_server_db_attack->brain_attack);
+
+    if (hc_fopen_raw (&brain_server_db_attack->wal_fp, file, "ab") == false)
+    {
+      brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+
+      return false;
+    }
+
+    brain_server_db_attack->wal_open = true;
+  }
+
+  if (hc_fwrite (entry, sizeof (brain_server_attack_long_t), 1, &brain_server_db_attack->wal_fp) != 1) return false;
+
+  hc_fflush (&brain_server_db_attack->wal_fp);
+
+  brain_server_db_attack->wal_cnt++;
+
+  return true;
+}
+
+int brain_server_get_client_idx (brain_server_dbs_t *brain_server_dbs)
+{
+  for (int i = 1; i < BRAIN_SERVER_CLIENTS_MAX; i++)
+  {
+    if (brain_server_dbs->client_slots[i] == 0)
+    {
+      brain_server_dbs->client_slots[i] = 1;
+
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+i64 brain_server_find_hash_long (const u32 *search, const brain_server_hash_long_t *buf, const i64 cnt)
+{
+  for (i64 l = 0, r = cnt; r; r >>= 1)
+  {
+    const i64 m = r >> 1;
+    const i64 c = l + m;
+
+    const int cmp = brain_server_sort_hash_long (search, buf + c);
+
+    if (cmp > 0)
+    {
+      l += m + 1;
+
+      r--;
+    }
+
+    if (cmp == 0) return c;
+  }
+
+  return -1;
+}
+
+i64 brain_server_find_hash_short (const u32 *search, const brain_server_hash_short_t *buf, const i64 cnt)
+{
+  for (i64 l = 0, r = cnt; r; r >>= 1)
+  {
+    const i64 m = r >> 1;
+    const i64 c = l + m;
+
+    const int cmp = brain_server_sort_hash_short (search, buf + c);
 
-  while ((entry = readdir (dirp)) != NULL)
-  {
-    char *file = entry->d_name;
+    if (cmp > 0)
+    {
+      l += m + 1;
 
-    const size_t len = strlen (file);
+      r--;
+    }
 
-    if (len != 19) continue;
+    if (cmp == 0) return c;
+  }
 
-    if (file[ 0] != 'b') continue;
-    if (file[ 1] != 'r') continue;
-    if (file[ 2] != 'a') continue;
-    if (file[ 3] != 'i') continue;
-    if (file[ 4] != 'n') continue;
-    if (file[ 5] != '.') continue;
+  return -1;
+}
 
-    if (file[14] != '.') continue;
-    if (file[15] != 'a') continue;
-    if (file[16] != 'd') continue;
-    if (file[17] != 'm') continue;
-    if (file[18] != 'p') continue;
+/**
+ * Sessions listed in --brain-server-filter keep their long-term memory in a blocked cuckoo
+ * filter instead of the sorted array of 8 byte hashes. A bucket has four slots, each holding
+ * a fingerprint of --brain-server-filter-bits bits, and the second bucket of an entry is derived
+ * from the first one and its fingerprint, so entries can be moved without knowing the hash.
+ * With 16 bit fingerprints an entry needs about 2 bytes instead of 8, in exchange a candidate
+ * which was never seen can be reported as known and is skipped (a false positive).
+ * A filter which reached its load limit is not resized, a new one of twice the size is added
+ * and all of them are checked, so the false-positive rate is the sum of the single rates.
+ */
 
-    const u32 brain_attack = byte_swap_32 (hex_to_u32 ((const u8 *) file + 6));
+static u64 brain_server_filter_index (const u32 *hash, const u64 buckets_cnt)
+{
+  const u64 h = ((u64) hash[1] << 32) | hash[0];
 
-    brain_server_db_attack_t *brain_server_db_attack = &brain_server_dbs->attack_buf[brain_server_dbs->attack_cnt];
+  return h & (buckets_cnt - 1);
+}
 
-    brain_server_db_attack_init (brain_server_db_attack, brain_attack);
+static u64 brain_server_filter_alt (const u64 bucket, const u64 fp, const u64 buckets_cnt)
+{
+  return (bucket ^ (fp * 0x5bd1e995)) & (buckets_cnt - 1);
+}
 
-    if (brain_server_read_attack_dump (brain_server_db_attack, file) == false) continue;
+static u64 brain_server_filter_fp (const u32 *hash, const u32 filter_bits)
+{
+  const u32 mask = (filter_bits == 32) ? 0xffffffff : ((1u << filter_bits) - 1);
 
-    brain_server_dbs->attack_cnt++;
-  }
+  const u32 fp = (hash[1] >> (32 - filter_bits)) & mask;
 
-  closedir (dirp);
+  // zero marks an empty slot
 
-  return true;
+  return (fp == 0) ? 1 : fp;
 }
 
-bool brain_server_write_attack_dumps (brain_server_dbs_t *brain_server_dbs, const char *path)
+static u64 brain_server_filter_get (const brain_server_filter_t *filter, const u32 filter_bits, const u64 pos)
 {
-  for (i64 idx = 0; idx < brain_server_dbs->attack_cnt; idx++)
-  {
-    brain_server_db_attack_t *brain_server_db_attack = &brain_server_dbs->attack_buf[idx];
+  if (filter_bits ==  8) return ((const u8  *) filter->slots)[pos];
+  if (filter_bits == 16) return ((const u16 *) filter->slots)[pos];
 
-    hc_thread_mutex_lock (brain_server_db_attack->mux_ag);
+  return ((const u32 *) filter->slots)[pos];
+}
 
-    char file[100];
+static void brain_server_filter_set (brain_server_filter_t *filter, const u32 filter_bits, const u64 pos, const u64 fp)
+{
+  if      (filter_bits ==  8) ((u8  *) filter->slots)[pos] = (u8)  fp;
+  else if (filter_bits == 16) ((u16 *) filter->slots)[pos] = (u16) fp;
+  else                        ((u32 *) filter->slots)[pos] = (u32) fp;
+}
 
-    memset (file, 0, sizeof (file));
+static bool brain_server_filter_bucket_add (brain_server_filter_t *filter, const u32 filter_bits, const u64 bucket, const u64 fp)
+{
+  for (int slot = 0; slot < BRAIN_SERVER_FILTER_BUCKET_SIZE; slot++)
+  {
+    const u64 pos = (bucket * BRAIN_SERVER_FILTER_BUCKET_SIZE) + slot;
 
-    snprintf (file, sizeof (file), "%s/brain.%08x.admp", path, brain_server_db_attack->brain_attack);
+    if (brain_server_filter_get (filter, filter_bits, pos) != 0) continue;
 
-    brain_server_write_attack_dump (brain_server_db_attack, file);
+    brain_server_filter_set (filter, filter_bits, pos, fp);
 
-    hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
+    return true;
   }
 
-  return true;
+  return false;
 }
 
-bool brain_server_read_attack_dump (brain_server_db_attack_t *brain_server_db_attack, const char *file)
+static bool brain_server_filter_lookup (const brain_server_filter_t *filter, const u32 filter_bits, const u32 *hash)
 {
-  hc_timer_t timer_dump;
-
-  hc_timer_set (&timer_dump);
-
-  // read from file
-
-  struct stat sb;
+  const u64 fp = brain_server_filter_fp (hash, filter_bits);
 
-  memset (&sb, 0, sizeof (struct stat));
+  const u64 bucket1 = brain_server_filter_index (hash, filter->buckets_cnt);
+  const u64 bucket2 = brain_server_filter_alt (bucket1, fp, filter->buckets_cnt);
 
-  if (stat (file, &sb) == -1)
+  for (int slot = 0; slot < BRAIN_SERVER_FILTER_BUCKET_SIZE; slot++)
   {
-    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
-
-    return false;
+    if (brain_server_filter_get (filter, filter_bits, (bucket1 * BRAIN_SERVER_FILTER_BUCKET_SIZE) + slot) == fp) return true;
+    if (brain_server_filter_get (filter, filter_bits, (bucket2 * BRAIN_SERVER_FILTER_BUCKET_SIZE) + slot) == fp) return true;
   }
 
-  HCFILE fp;
-
-  if (hc_fopen (&fp, file, "rb") == false)
+  if (filter->victim_fp == fp)
   {
-    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
-
-    return false;
+    if ((filter->victim_bucket == bucket1) || (filter->victim_bucket == bucket2)) return true;
   }
 
-  i64 temp_cnt = (u64) sb.st_size / sizeof (brain_server_attack_long_t);
+  return false;
+}
 
-  if (brain_server_db_attack_realloc (brain_server_db_attack, temp_cnt, 0) == false)
-  {
-    brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+static void brain_server_filter_add (brain_server_filter_t *filter, const u32 filter_bits, const u32 *hash)
+{
+  filter->items_cnt++;
 
-    hc_fclose (&fp);
+  u64 fp = brain_server_filter_fp (hash, filter_bits);
 
-    return false;
-  }
+  const u64 bucket1 = brain_server_filter_index (hash, filter->buckets_cnt);
+  const u64 bucket2 = brain_server_filter_alt (bucket1, fp, filter->buckets_cnt);
 
-  const size_t nread = hc_fread (brain_server_db_attack->long_buf, sizeof (brain_server_attack_long_t), temp_cnt, &fp);
+  if (brain_server_filter_bucket_add (filter, filter_bits, bucket1, fp) == true) return;
+  if (brain_server_filter_bucket_add (filter, filter_bits, bucket2, fp) == true) return;
 
-  if (nread != (size_t) temp_cnt)
+  // both buckets are full, move entries to their other bucket
+
+  u64 bucket = (fp & 1) ? bucket1 : bucket2;
+
+  for (int kick = 0; kick < BRAIN_SERVER_FILTER_KICKS_MAX; kick++)
   {
-    brain_logging (stderr, 0, "%s: only %" PRIu64 " bytes read\n", file, (u64) nread * sizeof (brain_server_attack_long_t));
+    const u64 pos = (bucket * BRAIN_SERVER_FILTER_BUCKET_SIZE) + ((fp ^ (u64) kick) % BRAIN_SERVER_FILTER_BUCKET_SIZE);
 
-    hc_fclose (&fp);
+    const u64 fp_old = brain_server_filter_get (filter, filter_bits, pos);
 
-    return false;
-  }
+    brain_server_filter_set (filter, filter_bits, pos, fp);
 
-  brain_server_db_attack->long_cnt      = temp_cnt;
-  brain_server_db_attack->write_attacks = false;
+    fp = fp_old;
 
-  hc_fclose (&fp);
+    bucket = brain_server_filter_alt (bucket, fp, filter->buckets_cnt);
 
-  const double ms = hc_timer_get (timer_dump);
+    if (brain_server_filter_bucket_add (filter, filter_bits, bucket, fp) == true) return;
+  }
 
-  brain_logging (stdout, 0, "Read %" PRIu64 " bytes from attack 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_attack->brain_attack, ms);
+  // the last one moved out is kept aside, the filter takes no more entries
 
-  return true;
+  filter->victim_bucket = bucket;
+  filter->victim_fp     = fp;
 }
 
-bool brain_server_write_attack_dump (brain_server_db_attack_t *brain_server_db_attack, const char *file)
+bool brain_server_filter_find (const brain_server_db_hash_t *brain_server_db_hash, const u32 *hash)
 {
-  if (brain_server_db_attack->write_attacks == false) return true;
+  for (int idx = brain_server_db_hash->filter_cnt - 1; idx >= 0; idx--)
+  {
+    if (brain_server_filter_lookup (&brain_server_db_hash->filter_buf[idx], brain_server_db_hash->filter_bits, hash) == true) return true;
+  }
 
-  hc_timer_t timer_dump;
+  return false;
+}
 
-  hc_timer_set (&timer_dump);
+bool brain_server_filter_insert (brain_server_db_hash_t *brain_server_db_hash, const u32 *hash)
+{
+  if (brain_server_filter_find (brain_server_db_hash, hash) == true) return true;
 
-  // write to file
+  brain_server_filter_t *filter = (brain_server_db_hash->filter_cnt > 0) ? &brain_server_db_hash->filter_buf[brain_server_db_hash->filter_cnt - 1] : NULL;
 
-  HCFILE fp;
+  bool full = true;
 
-  if (hc_fopen (&fp, file, "wb") == false)
+  if (filter != NULL)
   {
-    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
-
-    return false;
+    full = (filter->victim_fp != 0) || ((filter->items_cnt * 100) >= (filter->buckets_cnt * BRAIN_SERVER_FILTER_BUCKET_SIZE * BRAIN_SERVER_FILTER_LOAD_PCT));
   }
 
-  // storing should not include reserved attacks only finished
-
-  const size_t nwrite = hc_fwrite (brain_server_db_attack->long_buf, sizeof (brain_server_attack_long_t), brain_server_db_attack->long_cnt, &fp);
-
-  if (nwrite != (size_t) brain_server_db_attack->long_cnt)
+  if (full == true)
   {
-    brain_logging (stderr, 0, "%s: only %" PRIu64 " bytes written\n", file, (u64) nwrite * sizeof (brain_server_attack_long_t));
+    if (brain_server_db_hash->filter_cnt == BRAIN_SERVER_FILTERS_MAX) return false;
 
-    hc_fclose (&fp);
+    const u64 buckets_cnt = (filter == NULL) ? (u64) BRAIN_SERVER_FILTER_BUCKETS_MIN : filter->buckets_cnt * 2;
 
-    return false;
-  }
+    u8 *slots = (u8 *) hccalloc (buckets_cnt * BRAIN_SERVER_FILTER_BUCKET_SIZE, brain_server_db_hash->filter_bits / 8);
 
-  hc_fclose (&fp);
+    if (slots == NULL) return false;
 
-  brain_server_db_attack->write_attacks = false;
+    brain_server_filter_t *filter_buf = (brain_server_filter_t *) hcrealloc (brain_server_db_hash->filter_buf, brain_server_db_hash->filter_cnt * sizeof (brain_server_filter_t), sizeof (brain_server_filter_t));
 
-  // stats
+    if (filter_buf == NULL)
+    {
+      hcfree (slots);
 
-  const double ms = hc_timer_get (timer_dump);
+      return false;
+    }
 
-  struct stat sb;
+    brain_server_db_hash->filter_buf = filter_buf;
 
-  memset (&sb, 0, sizeof (struct stat));
+    filter = &filter_buf[brain_server_db_hash->filter_cnt];
 
-  if (stat (file, &sb) == -1)
-  {
-    brain_logging (stderr, 0, "%s: %s\n", file, strerror (errno));
+    filter->slots       = slots;
+    filter->buckets_cnt = buckets_cnt;
 
-    return false;
+    brain_server_db_hash->filter_cnt++;
   }
 
-  brain_logging (stdout, 0, "Wrote %" PRIu64 " bytes from attack 0x%08x in %.2f ms\n", (u64) sb.st_size, brain_server_db_attack->brain_attack, ms);
+  brain_server_filter_add (filter, brain_server_db_hash->filter_bits, hash);
+
+  brain_server_db_hash->long_cnt++;
 
   return true;
 }
 
-int brain_server_get_client_idx (brain_server_dbs_t *brain_server_dbs)
+void brain_server_filter_select (brain_server_dbs_t *brain_server_dbs, brain_server_db_hash_t *brain_server_db_hash)
 {
-  for (int i = 1; i < BRAIN_SERVER_CLIENTS_MAX; i++)
+  if (brain_server_db_hash->filter_bits == 0)
   {
-    if (brain_server_dbs->client_slots[i] == 0)
+    for (int idx = 0; idx < brain_server_dbs->filter_session_cnt; idx++)
     {
-      brain_server_dbs->client_slots[i] = 1;
+      if (brain_server_dbs->filter_session_buf[idx] != brain_server_db_hash->brain_session) continue;
 
-      return i;
+      brain_server_db_hash->filter_bits = brain_server_dbs->filter_bits;
     }
   }
 
-  return -1;
-}
+  if (brain_server_db_hash->filter_bits == 0) return;
 
-i64 brain_server_find_hash_long (const u32 *search, const brain_server_hash_long_t *buf, const i64 cnt)
-{
-  for (i64 l = 0, r = cnt; r; r >>= 1)
+  const i64 long_cnt = (brain_server_db_hash->long_buf == NULL) ? 0 : brain_server_db_hash->long_cnt;
+
+  brain_server_db_hash->long_cnt = 0;
+
+  for (int idx = 0; idx < brain_server_db_hash->filter_cnt; idx++)
   {
-    const i64 m = r >> 1;
-    const i64 c = l + m;
+    brain_server_db_hash->long_cnt += brain_server_db_hash->filter_buf[idx].items_cnt;
+  }
 
-    const int cmp = brain_server_sort_hash_long (search, buf + c);
+  if (brain_server_db_hash->long_buf == NULL) return;
 
-    if (cmp > 0)
+  // a sorted snapshot or replayed log, the snapshot is replaced with the filter image on the next dump
+
+  brain_server_hash_long_t *long_buf = brain_server_db_hash->long_buf;
+
+  i64 hashes_cnt = 0;
+
+  for (i64 idx = 0; idx < long_cnt; idx++)
+  {
+    if (brain_server_filter_insert (brain_server_db_hash, long_buf[idx].hash) == false)
     {
-      l += m + 1;
+      brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
 
-      r--;
+      break;
     }
 
-    if (cmp == 0) return c;
+    hashes_cnt++;
   }
 
-  return -1;
+  hcfree (long_buf);
+
+  brain_server_db_hash->long_buf   = NULL;
+  brain_server_db_hash->long_alloc = 0;
+
+  brain_logging (stdout, 0, "Converted %" PRIi64 " hashes of session 0x%08x to a %u bit filter of %" PRIu64 " bytes, FPR: %.4f%%\n", hashes_cnt, brain_server_db_hash->brain_session, brain_server_db_hash->filter_bits, brain_server_filter_size (brain_server_db_hash), brain_server_filter_fpr (brain_server_db_hash) * 100);
 }
 
-i64 brain_server_find_hash_short (const u32 *search, const brain_server_hash_short_t *buf, const i64 cnt)
+u64 brain_server_filter_size (const brain_server_db_hash_t *brain_server_db_hash)
 {
-  for (i64 l = 0, r = cnt; r; r >>= 1)
+  u64 size = 0;
+
+  for (int idx = 0; idx < brain_server_db_hash->filter_cnt; idx++)
   {
-    const i64 m = r >> 1;
-    const i64 c = l + m;
+    size += brain_server_db_hash->filter_buf[idx].buckets_cnt * BRAIN_SERVER_FILTER_BUCKET_SIZE * (brain_server_db_hash->filter_bits / 8);
+  }
 
-    const int cmp = brain_server_sort_hash_short (search, buf + c);
+  return size;
+}
 
-    if (cmp > 0)
-    {
-      l += m + 1;
+double brain_server_filter_fpr (const brain_server_db_hash_t *brain_server_db_hash)
+{
+  // a lookup compares the fingerprint against the slots of two buckets
 
-      r--;
-    }
+  const double fp_cnt = (brain_server_db_hash->filter_bits == 32) ? 4294967295.0 : (double) ((1u << brain_server_db_hash->filter_bits) - 1);
 
-    if (cmp == 0) return c;
+  double fpr = 0;
+
+  for (int idx = 0; idx < brain_server_db_hash->filter_cnt; idx++)
+  {
+    const brain_server_filter_t *filter = &brain_server_db_hash->filter_buf[idx];
+
+    const double load = (double) filter->items_cnt / (double) (filter->buckets_cnt * BRAIN_SERVER_FILTER_BUCKET_SIZE);
+
+    fpr += (2 * BRAIN_SERVER_FILTER_BUCKET_SIZE * load) / fp_cnt;
   }
 
-  return -1;
+  return MIN (fpr, 1.0);
 }
 
 void brain_server_handle_signal (int signo)
@@ -2083,8 +3543,8 @@ HC_API_CALL void *brain_server_handle_dumps (void *p)
   {
     if (i == brain_server_timer)
     {
-      brain_server_write_hash_dumps   (brain_server_dbs, ".");
-      brain_server_write_attack_dumps (brain_server_dbs, ".");
+      brain_server_write_hash_dumps   (brain_server_dbs, ".", false);
+      brain_server_write_attack_dumps (brain_server_dbs, ".", false);
 
       i = 0;
     }
@@ -2338,6 +3798,8 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
     brain_server_db_hash_init (brain_server_db_hash, brain_session);
 
+    brain_server_filter_select (brain_server_dbs, brain_server_db_hash);
+
     brain_server_dbs->hash_cnt++;
   }
 
@@ -2450,6 +3912,10 @@ HC_API_CALL void *brain_server_handle_client (void *p)
   brain_server_db_short->short_cnt = 0;
   brain_server_db_short->short_buf = (brain_server_hash_short_t *) hccalloc (passwords_max, sizeof (brain_server_hash_short_t));
 
+  // batch number for pipelined clients, non-pipelined clients stay in batch 0 and commit everything
+
+  u32 batch = 0;
+
   if (brain_server_db_short->short_buf == NULL)
   {
     brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
@@ -2569,6 +4035,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
           brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].offset     = offset + overlap;
           brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].length     = length - overlap;
           brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].client_idx = client_idx;
+          brain_server_db_attack->short_buf[brain_server_db_attack->short_cnt].batch      = batch;
 
           brain_server_db_attack->short_cnt++;
 
@@ -2584,8 +4051,21 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
       brain_logging (stdout, client_idx, "R | %8.2f ms | Offset: %" PRIu64 ", Length: %" PRIu64 ", Overlap: %" PRIu64 "\n", ms, offset, length, overlap);
     }
-    else if (operation == BRAIN_OPERATION_COMMIT)
+    else if (operation == BRAIN_OPERATION_BATCH)
     {
+      batch++;
+    }
+    else if ((operation == BRAIN_OPERATION_COMMIT) || (operation == BRAIN_OPERATION_COMMIT_BATCH))
+    {
+      // a plain commit moves everything, a batch commit only the batches up to the given one
+
+      u32 commit_batch = 0xffffffff;
+
+      if (operation == BRAIN_OPERATION_COMMIT_BATCH)
+      {
+        if (brain_recv (client_fd, &commit_batch, sizeof (commit_batch), 0, NULL, NULL) == false) break;
+      }
+
       // time the lookups for debugging
 
       hc_timer_t timer_commit;
@@ -2598,13 +4078,18 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
       for (i64 idx = 0; idx < brain_server_db_attack->short_cnt; idx++)
       {
-        if (brain_server_db_attack->short_buf[idx].client_idx == client_idx)
+        if ((brain_server_db_attack->short_buf[idx].client_idx == client_idx) && (brain_server_db_attack->short_buf[idx].batch <= commit_batch))
         {
           if (brain_server_db_attack_realloc (brain_server_db_attack, 1, 0) == true)
           {
             brain_server_db_attack->long_buf[brain_server_db_attack->long_cnt].offset = brain_server_db_attack->short_buf[idx].offset;
             brain_server_db_attack->long_buf[brain_server_db_attack->long_cnt].length = brain_server_db_attack->short_buf[idx].length;
 
+            if (brain_server_write_attack_wal (brain_server_db_attack, ".", &brain_server_db_attack->long_buf[brain_server_db_attack->long_cnt]) == false)
+            {
+              brain_logging (stderr, client_idx, "Failed to log attack 0x%08x\n", brain_server_db_attack->brain_attack);
+            }
+
             brain_server_db_attack->long_cnt++;
 
             qsort (brain_server_db_attack->long_buf, brain_server_db_attack->long_cnt, sizeof (brain_server_attack_long_t), brain_server_sort_attack_long);
@@ -2622,7 +4107,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
         }
       }
 
-      brain_server_db_attack->write_attacks = true;
+      if (new_attacks) brain_server_db_attack->write_attacks = true;
 
       hc_thread_mutex_unlock (brain_server_db_attack->mux_ag);
 
@@ -2637,13 +4122,55 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
       hc_timer_set (&timer_commit);
 
+      // park the hashes of younger batches in temp_buf, the remaining short-term memory stays sorted
+
+      i64 keep_cnt = 0;
+
+      if (operation == BRAIN_OPERATION_COMMIT_BATCH)
+      {
+        i64 commit_cnt = 0;
+
+        for (i64 idx = 0; idx < brain_server_db_short->short_cnt; idx++)
+        {
+          const brain_server_hash_short_t *short_entry = &brain_server_db_short->short_buf[idx];
+
+          if (short_entry->batch <= commit_batch)
+          {
+            brain_server_db_short->short_buf[commit_cnt] = *short_entry;
+
+            commit_cnt++;
+          }
+          else
+          {
+            temp_buf[keep_cnt].hash[0]  = short_entry->hash[0];
+            temp_buf[keep_cnt].hash[1]  = short_entry->hash[1];
+            temp_buf[keep_cnt].hash_idx = short_entry->batch;
+
+            keep_cnt++;
+          }
+        }
+
+        brain_server_db_short->short_cnt = commit_cnt;
+      }
+
       hc_thread_mutex_lock (brain_server_db_hash->mux_hg);
 
       // long-term memory merge
 
       if (brain_server_db_short->short_cnt)
       {
-        if (brain_server_db_hash_realloc (brain_server_db_hash, brain_server_db_short->short_cnt) == true)
+        if (brain_server_db_hash->filter_bits > 0)
+        {
+          for (i64 idx = 0; idx < brain_server_db_short->short_cnt; idx++)
+          {
+            if (brain_server_filter_insert (brain_server_db_hash, brain_server_db_short->short_buf[idx].hash) == true) continue;
+
+            brain_logging (stderr, client_idx, "%s\n", MSG_ENOMEM);
+
+            break;
+          }
+        }
+        else if (brain_server_db_hash_realloc (brain_server_db_hash, brain_server_db_short->short_cnt) == true)
         {
           if (brain_server_db_hash->long_cnt == 0)
           {
@@ -2737,6 +4264,11 @@ HC_API_CALL void *brain_server_handle_client (void *p)
           brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
         }
 
+        if (brain_server_write_hash_wal (brain_server_db_hash, ".", brain_server_db_short->short_buf, brain_server_db_short->short_cnt) == false)
+        {
+          brain_logging (stderr, client_idx, "Failed to log session 0x%08x\n", brain_server_db_hash->brain_session);
+        }
+
         brain_server_db_hash->write_hashes = true;
       }
 
@@ -2749,7 +4281,14 @@ HC_API_CALL void *brain_server_handle_client (void *p)
         brain_logging (stdout, client_idx, "C | %8.2f ms | Hashes: %" PRIi64 "\n", ms_hashes, brain_server_db_short->short_cnt);
       }
 
-      brain_server_db_short->short_cnt = 0;
+      for (i64 idx = 0; idx < keep_cnt; idx++)
+      {
+        brain_server_db_short->short_buf[idx].hash[0] = temp_buf[idx].hash[0];
+        brain_server_db_short->short_buf[idx].hash[1] = temp_buf[idx].hash[1];
+        brain_server_db_short->short_buf[idx].batch   = (u32) temp_buf[idx].hash_idx;
+      }
+
+      brain_server_db_short->short_cnt = keep_cnt;
     }
     else if (operation == BRAIN_OPERATION_HASH_LOOKUP)
     {
@@ -2854,9 +4393,18 @@ HC_API_CALL void *brain_server_handle_client (void *p)
         {
           brain_server_hash_unique_t *cur = &temp_buf[temp_idx];
 
-          const i64 r = brain_server_find_hash_long (cur->hash, brain_server_db_hash->long_buf, brain_server_db_hash->long_cnt);
+          bool found = false;
 
-          if (r != -1)
+          if (brain_server_db_hash->filter_bits > 0)
+          {
+            found = brain_server_filter_find (brain_server_db_hash, cur->hash);
+          }
+          else
+          {
+            found = (brain_server_find_hash_long (cur->hash, brain_server_db_hash->long_buf, brain_server_db_hash->long_cnt) != -1);
+          }
+
+          if (found == true)
           {
             send_buf[cur->hash_idx] = 1;
           }
@@ -2876,6 +4424,8 @@ HC_API_CALL void *brain_server_handle_client (void *p)
         temp_cnt = temp_idx_new;
       }
 
+      const double lookup_fpr = brain_server_filter_fpr (brain_server_db_hash);
+
       hc_thread_mutex_lock (brain_server_db_hash->mux_hr);
 
       brain_server_db_hash->hb--;
@@ -2929,6 +4479,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
           {
             brain_server_db_short->short_buf[idx].hash[0] = temp_buf[idx].hash[0];
             brain_server_db_short->short_buf[idx].hash[1] = temp_buf[idx].hash[1];
+            brain_server_db_short->short_buf[idx].batch   = batch;
           }
 
           brain_server_db_short->short_cnt = temp_cnt;
@@ -2970,6 +4521,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
             {
               next->hash[0] = unique_entry->hash[0];
               next->hash[1] = unique_entry->hash[1];
+              next->batch   = batch;
 
               unique_left--;
             }
@@ -2977,6 +4529,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
             {
               next->hash[0] = short_entry->hash[0];
               next->hash[1] = short_entry->hash[1];
+              next->batch   = short_entry->batch;
 
               short_left--;
             }
@@ -3011,7 +4564,14 @@ HC_API_CALL void *brain_server_handle_client (void *p)
 
       const double ms = hc_timer_get (timer_lookup);
 
-      brain_logging (stdout, client_idx, "L | %8.2f ms | Long: %" PRIi64 ", Inc: %d, New: %d\n", ms, brain_server_db_hash->long_cnt, hashes_cnt, local_lookup_new);
+      if (brain_server_db_hash->filter_bits > 0)
+      {
+        brain_logging (stdout, client_idx, "L | %8.2f ms | Long: %" PRIi64 ", Inc: %d, New: %d, FPR: %.4f%%\n", ms, brain_server_db_hash->long_cnt, hashes_cnt, local_lookup_new, lookup_fpr * 100);
+      }
+      else
+      {
+        brain_logging (stdout, client_idx, "L | %8.2f ms | Long: %" PRIi64 ", Inc: %d, New: %d\n", ms, brain_server_db_hash->long_cnt, hashes_cnt, local_lookup_new);
+      }
 
       // send
 
@@ -3062,7 +4622,7 @@ HC_API_CALL void *brain_server_handle_client (void *p)
   return 0;
 }
 
-int brain_server (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer)
+int brain_server (const char *listen_host, const int listen_port, const char *brain_password, const char *brain_session_whitelist, const u32 brain_server_timer, const char *brain_server_filter, const u32 brain_server_filter_bits)
 {
   #if defined (_WIN)
   WSADATA wsaData;
@@ -3231,6 +4791,50 @@ int brain_server (const char *listen_host, const int listen_port, const char *br
     return -1;
   }
 
+  // sessions to store in a filter, needed before the dumps are read for the conversion
+
+  brain_server_dbs->filter_session_buf = (u32 *) hccalloc (BRAIN_SERVER_SESSIONS_MAX, sizeof (u32));
+  brain_server_dbs->filter_session_cnt = 0;
+  brain_server_dbs->filter_bits        = brain_server_filter_bits;
+
+  if (brain_server_dbs->filter_session_buf == NULL)
+  {
+    brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+    if (brain_password == NULL) hcfree (auth_password);
+
+    return -1;
+  }
+
+  if (brain_server_filter != NULL)
+  {
+    char *sessions = hcstrdup (brain_server_filter);
+
+    if (sessions == NULL)
+    {
+      brain_logging (stderr, 0, "%s\n", MSG_ENOMEM);
+
+      if (brain_password == NULL) hcfree (auth_password);
+
+      return -1;
+    }
+
+    char *saveptr = NULL;
+
+    char *next = strtok_r (sessions, ",", &saveptr);
+
+    while ((next != NULL) && (brain_server_dbs->filter_session_cnt < BRAIN_SERVER_SESSIONS_MAX))
+    {
+      brain_server_dbs->filter_session_buf[brain_server_dbs->filter_session_cnt] = (u32) hc_strtoul (next, NULL, 16);
+
+      brain_server_dbs->filter_session_cnt++;
+
+      next = strtok_r ((char *) NULL, ",", &saveptr);
+    }
+
+    hcfree (sessions);
+  }
+
   if (brain_server_read_hash_dumps (brain_server_dbs, ".") == false)
   {
     if (brain_password == NULL) hcfree (auth_password);
@@ -3412,14 +5016,14 @@ int brain_server (const char *listen_host, const int listen_port, const char *br
 
   hc_thread_wait (1, &dump_thr);
 
-  if (brain_server_write_hash_dumps (brain_server_dbs, ".") == false)
+  if (brain_server_write_hash_dumps (brain_server_dbs, ".", true) == false)
   {
     if (brain_password == NULL) hcfree (auth_password);
 
     return -1;
   }
 
-  if (brain_server_write_attack_dumps (brain_server_dbs, ".") == false)
+  if (brain_server_write_attack_dumps (brain_server_dbs, ".", true) == false)
   {
     if (brain_password == NULL) hcfree (auth_password);
 
@@ -3442,6 +5046,7 @@ int brain_server (const char *listen_host, const int listen_port, const char *br
 
   hcfree (brain_server_dbs->hash_buf);
   hcfree (brain_server_dbs->attack_buf);
+  hcfree (brain_server_dbs->filter_session_buf);
   hcfree (brain_server_dbs);
   hcfree (brain_server_client_options);
 
@@ -0,0 +1,140 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "thread.h"
+#include "bridge_pool.h"
+
+// host thread pool for bridges using BRIDGE_TYPE_THREAD_POOL
+//
+// instead of one bridge unit per core, each with its own backend device thread, autotune and buffers,
+// such a bridge advertises a single unit and hands the whole pws_cnt batch of a launch to bridge_pool_run().
+// the pool threads take chunks from a shared cursor until the batch is drained, so a thread which got
+// a slow candidate simply takes fewer chunks and no thread idles while others still have work queued.
+
+bridge_pool_t *bridge_pool_init (const int threads_cnt)
+{
+  bridge_pool_t *bridge_pool = (bridge_pool_t *) hcmalloc (sizeof (bridge_pool_t));
+
+  bridge_pool->threads_cnt = MAX (threads_cnt, 1);
+
+  hc_thread_mutex_init (bridge_pool->mux_cursor);
+
+  return bridge_pool;
+}
+
+void bridge_pool_term (bridge_pool_t *bridge_pool)
+{
+  if (bridge_pool == NULL) return;
+
+  hc_thread_mutex_delete (bridge_pool->mux_cursor);
+
+  hcfree (bridge_pool);
+}
+
+int bridge_pool_threads (const bridge_pool_t *bridge_pool)
+{
+  return bridge_pool->threads_cnt;
+}
+
+static bool bridge_pool_next (bridge_pool_t *bridge_pool, u64 *work_pos, u64 *work_cnt)
+{
+  hc_thread_mutex_lock (bridge_pool->mux_cursor);
+
+  const u64 pos = bridge_pool->work_cursor;
+
+  const bool has_work = (bridge_pool->work_failed == false) && (pos < bridge_pool->work_cnt);
+
+  if (has_work == true)
+  {
+    *work_pos = pos;
+    *work_cnt = MIN (bridge_pool->work_chunk, bridge_pool->work_cnt - pos);
+
+    bridge_pool->work_cursor = pos + *work_cnt;
+  }
+
+  hc_thread_mutex_unlock (bridge_pool->mux_cursor);
+
+  return has_work;
+}
+
+static void bridge_pool_drain (bridge_pool_t *bridge_pool, const int tid)
+{
+  u64 work_pos = 0;
+  u64 work_cnt = 0;
+
+  while (bridge_pool_next (bridge_pool, &work_pos, &work_cnt) == true)
+  {
+    if (bridge_pool->work (bridge_pool->work_ctx, tid, work_pos, work_cnt) == true) continue;
+
+    hc_thread_mutex_lock (bridge_pool->mux_cursor);
+
+    bridge_pool->work_failed = true;
+
+    hc_thread_mutex_unlock (bridge_pool->mux_cursor);
+
+    break;
+  }
+}
+
+#if defined (_WIN32) || defined (__WIN32__)
+HC_API_CALL DWORD bridge_pool_thread (void *p)
+#else
+HC_API_CALL void *bridge_pool_thread (void *p)
+#endif
+{
+  bridge_pool_thread_param_t *bridge_pool_thread_param = (bridge_pool_thread_param_t *) p;
+
+  bridge_pool_drain (bridge_pool_thread_param->bridge_pool, bridge_pool_thread_param->tid);
+
+  return 0;
+}
+
+// the work callback gets the pool thread index, so the bridge can keep per-thread scratch memory,
+// and a range of work items. work_chunk should be small for expensive items with uneven cost (argon2)
+// and a multiple of the SIMD lane count for multi-buffer code.
+
+bool bridge_pool_run (bridge_pool_t *bridge_pool, const u64 work_cnt, const u64 work_chunk, BRIDGE_POOL_WORK work, void *work_ctx)
+{
+  bridge_pool->work        = work;
+  bridge_pool->work_ctx    = work_ctx;
+  bridge_pool->work_cnt    = work_cnt;
+  bridge_pool->work_chunk  = MAX (work_chunk, 1);
+  bridge_pool->work_cursor = 0;
+  bridge_pool->work_failed = false;
+
+  const u64 chunks_cnt = (work_cnt + bridge_pool->work_chunk - 1) / bridge_pool->work_chunk;
+
+  const int threads_cnt = (int) MIN ((u64) bridge_pool->threads_cnt, chunks_cnt);
+
+  if (threads_cnt <= 1)
+  {
+    bridge_pool_drain (bridge_pool, 0);
+
+    return (bridge_pool->work_failed == false);
+  }
+
+  bridge_pool_thread_param_t *bridge_pool_threads_param = (bridge_pool_thread_param_t *) hcmalloc (threads_cnt * sizeof (bridge_pool_thread_param_t));
+  hc_thread_t                *c_threads                 = (hc_thread_t *)                hcmalloc (threads_cnt * sizeof (hc_thread_t));
+
+  for (int i = 0; i < threads_cnt; i++)
+  {
+    bridge_pool_thread_param_t *bridge_pool_thread_param = bridge_pool_threads_param + i;
+
+    bridge_pool_thread_param->tid         = i;
+    bridge_pool_thread_param->bridge_pool = bridge_pool;
+
+    hc_thread_create (c_threads[i], bridge_pool_thread, bridge_pool_thread_param);
+  }
+
+  hc_thread_wait (threads_cnt, c_threads);
+
+  hcfree (c_threads);
+  hcfree (bridge_pool_threads_param);
+
+  return (bridge_pool->work_failed == false);
+}
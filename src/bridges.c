@@ -197,6 +197,20 @@ bool bridges_init (hashcat_ctx_t *hashcat_ctx)
     return false;
   }
 
+  // a pooled bridge does its own scheduling across host threads, there must not be a second layer of units
+
+  if (hashconfig->bridge_type & BRIDGE_TYPE_THREAD_POOL)
+  {
+    const int units_cnt = bridge_ctx->get_unit_count (bridge_ctx->platform_context);
+
+    if (units_cnt != 1)
+    {
+      event_log_error (hashcat_ctx, "BRIDGE_TYPE_THREAD_POOL requires exactly one bridge unit, bridge '%s' reports %d", hashconfig->bridge_name, units_cnt);
+
+      return false;
+    }
+  }
+
   // auto adjust workitem counts
 
   if (hashconfig->bridge_type & BRIDGE_TYPE_MATCH_TUNINGS)
@@ -0,0 +1,891 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "bridges.h"
+#include "memory.h"
+#include "shared.h"
+#include "cpu_features.h"
+
+#if defined (__linux__)
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+// argon2 reference
+
+#undef _DEFAULT_SOURCE
+
+#if defined (BRIDGE_ISA)
+
+// one ISA variant of the memory filling, see BRIDGE_ISA_DISPATCH in src/Makefile
+
+#define fill_segment CPU_ISA_FN (fill_segment)
+
+#include "opt.c"
+#define ARGON2_FILL_OPT
+
+#else
+
+#include "argon2.c"
+#include "core.c"
+#include "blake2/blake2b.c"
+
+#if !defined (BRIDGE_ISA_DISPATCH)
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86) || defined (__aarch64__) || defined (__arm64__)
+#include "opt.c"
+#define ARGON2_FILL_OPT
+#else
+#include "ref.c"
+#endif
+#endif
+
+#endif
+
+// several argon2 lanes are filled round-robin, one block at a time. a lane is either
+// one lane of a different password candidate or, with p > 1, a different lane of the same candidate.
+// as soon as a block is done, the reference block of the lane's next step is known and gets prefetched,
+// it has to be in cache only after the blocks of all other lanes are done. the compression of a single
+// block stays the SIMD implementation of opt.c, interleaving across SIMD lanes instead wastes most
+// of each cache line in the data-dependent phase, where every lane references a different block.
+
+#define STREAMS_MIN 4
+
+// good: we can use this multiplier do reduce copy overhead to increase the guessing speed,
+// bad: but we also increase the password candidate batch size.
+// slow hashes which make use of this bridge probably are used with smaller wordlists,
+// and therefore it's easier for hashcat to parallelize if this multiplier is low.
+// in the end, it's a trade-off. it should be a multiple of STREAMS_MIN.
+
+#define N_ACCEL 32
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// one argon2 lane in flight
+
+typedef struct
+{
+  // SIMD state of opt.c, the layout is the same for every ISA variant
+
+  block  state __attribute__ ((aligned (64)));
+
+  block  address_block;
+  block  input_block;
+  block  zero_block;
+
+  block *memory;
+  block *ref_block;
+
+  u32    lane;
+
+} stream_t;
+
+#if defined (BRIDGE_ISA) || !defined (BRIDGE_ISA_DISPATCH)
+
+#if defined (ARGON2_FILL_OPT)
+#if defined (__AVX512F__)
+typedef __m512i fill_state_t;
+#elif defined (__AVX2__)
+typedef __m256i fill_state_t;
+#else
+typedef __m128i fill_state_t;
+#endif
+#endif
+
+static void stream_next_addresses (stream_t *stream)
+{
+  #if defined (ARGON2_FILL_OPT)
+  next_addresses (&stream->address_block, &stream->input_block);
+  #else
+  next_addresses (&stream->address_block, &stream->input_block, &stream->zero_block);
+  #endif
+}
+
+static void stream_fill_block (stream_t *stream, block *prev_block, block *curr_block, const bool with_xor)
+{
+  #if defined (ARGON2_FILL_OPT)
+  (void) prev_block;
+
+  fill_block ((fill_state_t *) stream->state.v, stream->ref_block, curr_block, with_xor);
+  #else
+  fill_block (prev_block, stream->ref_block, curr_block, with_xor);
+  #endif
+}
+
+static inline u32 stream_prev_index (const argon2_instance_t *instance, const u32 curr_index)
+{
+  return (curr_index == 0) ? instance->lane_length - 1 : curr_index - 1;
+}
+
+static block *stream_ref_block (const argon2_instance_t *instance, stream_t *stream, const u32 pass, const u32 slice, const u32 index, const bool data_independent_addressing)
+{
+  const u32 lane_length = instance->lane_length;
+
+  u64 pseudo_rand;
+
+  if (data_independent_addressing)
+  {
+    if ((index % ARGON2_ADDRESSES_IN_BLOCK) == 0) stream_next_addresses (stream);
+
+    pseudo_rand = stream->address_block.v[index % ARGON2_ADDRESSES_IN_BLOCK];
+  }
+  else
+  {
+    const u32 prev_index = stream_prev_index (instance, (slice * instance->segment_length) + index);
+
+    pseudo_rand = stream->memory[(stream->lane * lane_length) + prev_index].v[0];
+  }
+
+  u32 ref_lane = (u32) ((pseudo_rand >> 32) % instance->lanes);
+
+  if ((pass == 0) && (slice == 0)) ref_lane = stream->lane;
+
+  argon2_position_t position;
+
+  position.pass  = pass;
+  position.lane  = stream->lane;
+  position.slice = (uint8_t) slice;
+  position.index = index;
+
+  const u32 ref_index = index_alpha (instance, &position, (u32) (pseudo_rand & 0xffffffff), ref_lane == stream->lane);
+
+  block *ref_block = stream->memory + ((size_t) ref_lane * lane_length) + ref_index;
+
+  for (int line = 0; line < ARGON2_BLOCK_SIZE; line += 64) __builtin_prefetch ((const u8 *) ref_block + line, 0, 3);
+
+  return ref_block;
+}
+
+void CPU_ISA_FN (fill_slice_interleaved) (const argon2_instance_t *instance, stream_t *streams_buf, const u32 streams_cnt, const u32 pass, const u32 slice)
+{
+  const u32 lane_length    = instance->lane_length;
+  const u32 segment_length = instance->segment_length;
+
+  const bool data_independent_addressing = (pass == 0) && (slice < ARGON2_SYNC_POINTS / 2);
+
+  const u32 starting_index = ((pass == 0) && (slice == 0)) ? 2 : 0; // first two blocks are done already
+
+  for (u32 stream_idx = 0; stream_idx < streams_cnt; stream_idx++)
+  {
+    stream_t *stream = streams_buf + stream_idx;
+
+    if (data_independent_addressing)
+    {
+      init_block_value (&stream->input_block, 0);
+
+      stream->input_block.v[0] = pass;
+      stream->input_block.v[1] = stream->lane;
+      stream->input_block.v[2] = slice;
+      stream->input_block.v[3] = instance->memory_blocks;
+      stream->input_block.v[4] = instance->passes;
+      stream->input_block.v[5] = instance->type;
+
+      if (starting_index == 2) stream_next_addresses (stream);
+    }
+
+    #if defined (ARGON2_FILL_OPT)
+    const u32 prev_index = stream_prev_index (instance, (slice * segment_length) + starting_index);
+
+    memcpy (stream->state.v, stream->memory[(stream->lane * lane_length) + prev_index].v, ARGON2_BLOCK_SIZE);
+    #endif
+
+    stream->ref_block = stream_ref_block (instance, stream, pass, slice, starting_index, data_independent_addressing);
+  }
+
+  for (u32 index = starting_index; index < segment_length; index++)
+  {
+    const u32 curr_index = (slice * segment_length) + index;
+    const u32 prev_index = stream_prev_index (instance, curr_index);
+
+    for (u32 stream_idx = 0; stream_idx < streams_cnt; stream_idx++)
+    {
+      stream_t *stream = streams_buf + stream_idx;
+
+      block *lane_memory = stream->memory + ((size_t) stream->lane * lane_length);
+
+      stream_fill_block (stream, lane_memory + prev_index, lane_memory + curr_index, pass > 0);
+
+      if ((index + 1) == segment_length) continue;
+
+      stream->ref_block = stream_ref_block (instance, stream, pass, slice, index + 1, data_independent_addressing);
+    }
+  }
+}
+
+#endif
+
+#if !defined (BRIDGE_ISA)
+
+typedef void fill_slice_interleaved_fn_t (const argon2_instance_t *instance, stream_t *streams_buf, const u32 streams_cnt, const u32 pass, const u32 slice);
+
+#if defined (BRIDGE_ISA_DISPATCH)
+
+typedef void fill_segment_fn_t (const argon2_instance_t *instance, argon2_position_t position);
+
+fill_segment_fn_t           fill_segment_sse2;
+fill_segment_fn_t           fill_segment_avx2;
+fill_segment_fn_t           fill_segment_avx512;
+
+fill_slice_interleaved_fn_t fill_slice_interleaved_sse2;
+fill_slice_interleaved_fn_t fill_slice_interleaved_avx2;
+fill_slice_interleaved_fn_t fill_slice_interleaved_avx512;
+
+static fill_segment_fn_t           *fill_segment_isa = fill_segment_sse2;
+static fill_slice_interleaved_fn_t *fill_slice_isa   = fill_slice_interleaved_sse2;
+static const char                  *fill_isa_name    = "SSE2";
+
+// core.c still references fill_segment (), the lanes are filled by fill_slice_interleaved () though
+
+void fill_segment (const argon2_instance_t *instance, argon2_position_t position)
+{
+  fill_segment_isa (instance, position);
+}
+
+static void fill_isa_select ()
+{
+  if (cpu_supports_avx512f () && cpu_supports_avx512vl ())
+  {
+    fill_segment_isa = fill_segment_avx512;
+    fill_slice_isa   = fill_slice_interleaved_avx512;
+    fill_isa_name    = "AVX512";
+  }
+  else if (cpu_supports_avx2 ())
+  {
+    fill_segment_isa = fill_segment_avx2;
+    fill_slice_isa   = fill_slice_interleaved_avx2;
+    fill_isa_name    = "AVX2";
+  }
+}
+
+#else
+
+static fill_slice_interleaved_fn_t *fill_slice_isa   = fill_slice_interleaved;
+static const char                  *fill_isa_name    = "native";
+
+static void fill_isa_select ()
+{
+}
+
+#endif
+
+typedef struct
+{
+  // input
+
+  u32 pw_buf[64];
+  u32 pw_len;
+
+  // output
+
+  u32 h[64];
+
+} argon2_optimized_tmp_t;
+
+typedef struct
+{
+  u32 salt_buf[64];
+  u32 salt_len;
+
+  u32 digest_buf[64];
+  u32 digest_len;
+
+  u32 m;
+  u32 t;
+  u32 p;
+
+} argon2_t;
+
+typedef struct
+{
+  // template
+
+  char    unit_info_buf[1024];
+  int     unit_info_len;
+
+  u64     workitem_count;
+  size_t  workitem_size;
+
+  // implementation specific
+
+  void     *memory;
+  size_t    memory_size;
+  bool      memory_mmap;
+
+  stream_t *streams_buf;
+
+  int       numa_node;
+
+  #if defined (__linux__)
+  cpu_set_t cpuset_saved;
+  bool      cpuset_pinned;
+  #endif
+
+} unit_t;
+
+typedef struct
+{
+  unit_t *units_buf;
+  int     units_cnt;
+
+  int     numa_nodes_cnt;
+
+  #if defined (__linux__)
+  cpu_set_t *numa_cpusets;
+  #endif
+
+} bridge_argon2id_t;
+
+// depends on the salt only
+
+typedef struct
+{
+  argon2_instance_t instance;
+
+  u32 cands_per_group;
+  u32 streams_cnt;
+
+} layout_t;
+
+static void argon2_layout (layout_t *layout, const argon2_t *argon2id)
+{
+  const u32 lanes = argon2id->p;
+
+  u32 memory_blocks = argon2id->m;
+
+  if (memory_blocks < 2 * ARGON2_SYNC_POINTS * lanes) memory_blocks = 2 * ARGON2_SYNC_POINTS * lanes;
+
+  const u32 segment_length = memory_blocks / (lanes * ARGON2_SYNC_POINTS);
+
+  argon2_instance_t *instance = &layout->instance;
+
+  memset (instance, 0, sizeof (argon2_instance_t));
+
+  instance->version        = ARGON2_VERSION_NUMBER;
+  instance->passes         = argon2id->t;
+  instance->memory_blocks  = segment_length * lanes * ARGON2_SYNC_POINTS;
+  instance->segment_length = segment_length;
+  instance->lane_length    = segment_length * ARGON2_SYNC_POINTS;
+  instance->lanes          = lanes;
+  instance->threads        = 1;
+  instance->type           = Argon2_id;
+
+  // lanes of the same candidate count as streams, too. with a high p this keeps the batch small
+  // and it is the only source of parallelism left if there are only a few candidates
+
+  layout->cands_per_group = (lanes >= STREAMS_MIN) ? 1 : STREAMS_MIN / lanes;
+  layout->streams_cnt     = layout->cands_per_group * lanes;
+}
+
+static size_t argon2_layout_size (const layout_t *layout)
+{
+  return (size_t) layout->cands_per_group * layout->instance.memory_blocks * ARGON2_BLOCK_SIZE;
+}
+
+static void *arena_alloc (unit_t *unit_buf, size_t size)
+{
+  #if defined (__linux__)
+
+  size = (size + HUGE_PAGE_SIZE - 1) & ~((size_t) HUGE_PAGE_SIZE - 1);
+
+  // the pages are touched first by the pinned unit thread, which places them on its NUMA node
+
+  void *memory = MAP_FAILED;
+
+  #if defined (MAP_HUGETLB)
+  memory = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  #endif
+
+  if (memory == MAP_FAILED)
+  {
+    memory = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (memory == MAP_FAILED) return NULL;
+
+    #if defined (MADV_HUGEPAGE)
+    madvise (memory, size, MADV_HUGEPAGE);
+    #endif
+  }
+
+  unit_buf->memory_size = size;
+  unit_buf->memory_mmap = true;
+
+  return memory;
+
+  #else
+
+  unit_buf->memory_size = size;
+  unit_buf->memory_mmap = false;
+
+  return hcmalloc_bridge_aligned (size, 64);
+
+  #endif
+}
+
+static void arena_free (unit_t *unit_buf)
+{
+  if (unit_buf->memory == NULL) return;
+
+  #if defined (__linux__)
+  if (unit_buf->memory_mmap == true)
+  {
+    munmap (unit_buf->memory, unit_buf->memory_size);
+  }
+  else
+  #endif
+  {
+    hcfree_bridge_aligned (unit_buf->memory);
+  }
+
+  unit_buf->memory      = NULL;
+  unit_buf->memory_size = 0;
+}
+
+#if defined (__linux__)
+static bool numa_cpulist_parse (const char *path, cpu_set_t *cpuset)
+{
+  CPU_ZERO (cpuset);
+
+  FILE *fp = fopen (path, "rb");
+
+  if (fp == NULL) return false;
+
+  char buf[4096];
+
+  const size_t len = fread (buf, 1, sizeof (buf) - 1, fp);
+
+  fclose (fp);
+
+  buf[len] = 0;
+
+  // format is "0-3,8-11"
+
+  char *saveptr = NULL;
+
+  for (char *range = strtok_r (buf, ",\n", &saveptr); range != NULL; range = strtok_r (NULL, ",\n", &saveptr))
+  {
+    char *end = NULL;
+
+    const long first = strtol (range, &end, 10);
+
+    long last = first;
+
+    if (*end == '-') last = strtol (end + 1, NULL, 10);
+
+    for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) CPU_SET (cpu, cpuset);
+  }
+
+  return true;
+}
+#endif
+
+static void numa_init (bridge_argon2id_t *bridge_argon2id)
+{
+  bridge_argon2id->numa_nodes_cnt = 0;
+
+  #if defined (__linux__)
+
+  cpu_set_t process_cpuset;
+
+  if (sched_getaffinity (0, sizeof (process_cpuset), &process_cpuset) == -1) return;
+
+  bridge_argon2id->numa_cpusets = (cpu_set_t *) hccalloc (CPU_SETSIZE, sizeof (cpu_set_t));
+
+  for (int node = 0; node < CPU_SETSIZE; node++)
+  {
+    char path[256];
+
+    snprintf (path, sizeof (path), "/sys/devices/system/node/node%d/cpulist", node);
+
+    cpu_set_t node_cpuset;
+
+    if (numa_cpulist_parse (path, &node_cpuset) == false) break;
+
+    // honor --cpu-affinity and taskset, nodes we may not run on are skipped
+
+    CPU_AND (&node_cpuset, &node_cpuset, &process_cpuset);
+
+    if (CPU_COUNT (&node_cpuset) == 0) continue;
+
+    bridge_argon2id->numa_cpusets[bridge_argon2id->numa_nodes_cnt++] = node_cpuset;
+  }
+
+  #endif
+}
+
+static void numa_term (bridge_argon2id_t *bridge_argon2id)
+{
+  #if defined (__linux__)
+  hcfree (bridge_argon2id->numa_cpusets);
+  #endif
+
+  bridge_argon2id->numa_nodes_cnt = 0;
+}
+
+static bool units_init (bridge_argon2id_t *bridge_argon2id)
+{
+  #if defined (_WIN)
+
+  SYSTEM_INFO sysinfo;
+
+  GetSystemInfo (&sysinfo);
+
+  int num_devices = sysinfo.dwNumberOfProcessors;
+
+  #else
+
+  int num_devices = sysconf (_SC_NPROCESSORS_ONLN);
+
+  #endif
+
+  // one unit per physical core, hyper-threads fight for the same SIMD units and memory bus
+  num_devices = MAX (num_devices / 2, 1);
+
+  unit_t *units_buf = (unit_t *) hccalloc (num_devices, sizeof (unit_t));
+
+  int units_cnt = 0;
+
+  for (int i = 0; i < num_devices; i++)
+  {
+    unit_t *unit_buf = &units_buf[i];
+
+    // spread the units evenly across the nodes
+
+    unit_buf->numa_node = (bridge_argon2id->numa_nodes_cnt > 1) ? i % bridge_argon2id->numa_nodes_cnt : -1;
+
+    if (unit_buf->numa_node == -1)
+    {
+      unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
+        "Argon2 optimized, %s, %d lanes interleaved",
+        fill_isa_name,
+        STREAMS_MIN);
+    }
+    else
+    {
+      unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
+        "Argon2 optimized, %s, %d lanes interleaved, NUMA node %d",
+        fill_isa_name,
+        STREAMS_MIN,
+        unit_buf->numa_node);
+    }
+
+    unit_buf->unit_info_buf[unit_buf->unit_info_len] = 0;
+
+    unit_buf->workitem_count = N_ACCEL;
+
+    units_cnt++;
+  }
+
+  bridge_argon2id->units_buf = units_buf;
+  bridge_argon2id->units_cnt = units_cnt;
+
+  return true;
+}
+
+static void units_term (bridge_argon2id_t *bridge_argon2id)
+{
+  if (bridge_argon2id->units_buf)
+  {
+    hcfree (bridge_argon2id->units_buf);
+  }
+}
+
+void *platform_init (MAYBE_UNUSED user_options_t *user_options)
+{
+  // Verify CPU features
+
+  if (cpu_chipset_test () == -1) return NULL;
+
+  fill_isa_select ();
+
+  // Allocate platform context
+
+  bridge_argon2id_t *bridge_argon2id = (bridge_argon2id_t *) hcmalloc (sizeof (bridge_argon2id_t));
+
+  numa_init (bridge_argon2id);
+
+  if (units_init (bridge_argon2id) == false)
+  {
+    numa_term (bridge_argon2id);
+
+    hcfree (bridge_argon2id);
+
+    return NULL;
+  }
+
+  return bridge_argon2id;
+}
+
+void platform_term (void *platform_context)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  if (bridge_argon2id)
+  {
+    units_term (bridge_argon2id);
+
+    numa_term (bridge_argon2id);
+
+    hcfree (bridge_argon2id);
+  }
+}
+
+int get_unit_count (void *platform_context)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  return bridge_argon2id->units_cnt;
+}
+
+// we support units of mixed speed, that's why the workitem count is unit specific
+
+int get_workitem_count (void *platform_context, const int unit_idx)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+  return unit_buf->workitem_count;
+}
+
+char *get_unit_info (void *platform_context, const int unit_idx)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+  return unit_buf->unit_info_buf;
+}
+
+bool thread_init (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_param_t *device_param, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  const int unit_idx = device_param->bridge_link_device;
+
+  unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+  #if defined (__linux__)
+
+  unit_buf->cpuset_pinned = false;
+
+  if (unit_buf->numa_node == -1) return true;
+
+  if (pthread_getaffinity_np (pthread_self (), sizeof (cpu_set_t), &unit_buf->cpuset_saved) != 0) return true;
+
+  if (pthread_setaffinity_np (pthread_self (), sizeof (cpu_set_t), &bridge_argon2id->numa_cpusets[unit_buf->numa_node]) != 0) return true;
+
+  unit_buf->cpuset_pinned = true;
+
+  #endif
+
+  return true;
+}
+
+void thread_term (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_param_t *device_param, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  const int unit_idx = device_param->bridge_link_device;
+
+  unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+  #if defined (__linux__)
+
+  if (unit_buf->cpuset_pinned == false) return;
+
+  pthread_setaffinity_np (pthread_self (), sizeof (cpu_set_t), &unit_buf->cpuset_saved);
+
+  unit_buf->cpuset_pinned = false;
+
+  #endif
+}
+
+bool salt_prepare (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes)
+{
+  // we can use self-test hash as base
+
+  layout_t layout;
+
+  argon2_layout (&layout, (argon2_t *) hashes->st_esalts_buf);
+
+  size_t largest_size    = argon2_layout_size (&layout);
+  u32    largest_streams = layout.streams_cnt;
+
+  // from here regular hashes
+
+  argon2_t *argon2 = (argon2_t *) hashes->esalts_buf;
+
+  for (u32 salt_idx = 0; salt_idx < hashes->salts_cnt; salt_idx++, argon2++)
+  {
+    argon2_layout (&layout, argon2);
+
+    const size_t size = argon2_layout_size (&layout);
+
+    if (size > largest_size) largest_size = size;
+
+    if (layout.streams_cnt > largest_streams) largest_streams = layout.streams_cnt;
+  }
+
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  for (int unit_idx = 0; unit_idx < bridge_argon2id->units_cnt; unit_idx++)
+  {
+    unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+    unit_buf->memory = arena_alloc (unit_buf, largest_size);
+
+    if (unit_buf->memory == NULL) return false;
+
+    unit_buf->streams_buf = (stream_t *) hcmalloc_bridge_aligned (largest_streams * sizeof (stream_t), 64);
+
+    if (unit_buf->streams_buf == NULL) return false;
+  }
+
+  return true;
+}
+
+void salt_destroy (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  for (int unit_idx = 0; unit_idx < bridge_argon2id->units_cnt; unit_idx++)
+  {
+    unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+    arena_free (unit_buf);
+
+    if (unit_buf->streams_buf)
+    {
+      hcfree_bridge_aligned (unit_buf->streams_buf);
+
+      unit_buf->streams_buf = NULL;
+    }
+  }
+}
+
+bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_param_t *device_param, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes, MAYBE_UNUSED const u32 salt_pos, MAYBE_UNUSED const u64 pws_cnt)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  const int unit_idx = device_param->bridge_link_device;
+
+  unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+
+  argon2_t *esalts_buf = (argon2_t *) hashes->esalts_buf;
+
+  argon2_t *argon2id = &esalts_buf[salt_pos];
+
+  argon2_optimized_tmp_t *argon2_optimized_tmp = (argon2_optimized_tmp_t *) device_param->h_tmps;
+
+  layout_t layout;
+
+  argon2_layout (&layout, argon2id);
+
+  argon2_instance_t *instance = &layout.instance;
+
+  argon2_context context;
+
+  context.out           = (uint8_t *) NULL;
+  context.outlen        = (uint32_t)  argon2id->digest_len;
+  context.pwd           = (uint8_t *) NULL;
+  context.pwdlen        = (uint32_t)  0;
+  context.salt          = (uint8_t *) argon2id->salt_buf;
+  context.saltlen       = (uint32_t)  argon2id->salt_len;
+  context.secret        = NULL;
+  context.secretlen     = 0;
+  context.ad            = NULL;
+  context.adlen         = 0;
+  context.t_cost        = argon2id->t;
+  context.m_cost        = argon2id->m;
+  context.lanes         = argon2id->p;
+  context.threads       = 1;
+  context.allocate_cbk  = NULL;
+  context.free_cbk      = NULL;
+  context.flags         = ARGON2_DEFAULT_FLAGS;
+  context.version       = ARGON2_VERSION_NUMBER;
+  context.memory        = NULL;
+
+  for (u64 group_pos = 0; group_pos < pws_cnt; group_pos += layout.cands_per_group)
+  {
+    const u32 group_cnt = (u32) MIN ((u64) layout.cands_per_group, pws_cnt - group_pos);
+
+    // H0 and the first two blocks of each lane
+
+    for (u32 cand = 0; cand < group_cnt; cand++)
+    {
+      argon2_optimized_tmp_t *tmp = argon2_optimized_tmp + group_pos + cand;
+
+      context.pwd    = (uint8_t *) tmp->pw_buf;
+      context.pwdlen = (uint32_t)  tmp->pw_len;
+      context.memory = (uint8_t *) unit_buf->memory + ((size_t) cand * instance->memory_blocks * ARGON2_BLOCK_SIZE);
+
+      initialize (instance, &context);
+    }
+
+    const u32 streams_cnt = group_cnt * instance->lanes;
+
+    for (u32 stream_idx = 0; stream_idx < streams_cnt; stream_idx++)
+    {
+      stream_t *stream = unit_buf->streams_buf + stream_idx;
+
+      const u32 cand = stream_idx / instance->lanes;
+
+      stream->memory = (block *) unit_buf->memory + ((size_t) cand * instance->memory_blocks);
+      stream->lane   = stream_idx % instance->lanes;
+
+      init_block_value (&stream->zero_block, 0);
+    }
+
+    // lanes only reference finished segments of other lanes, the order inside a slice does not matter
+
+    for (u32 pass = 0; pass < instance->passes; pass++)
+    {
+      for (u32 slice = 0; slice < ARGON2_SYNC_POINTS; slice++)
+      {
+        fill_slice_isa (instance, unit_buf->streams_buf, streams_cnt, pass, slice);
+      }
+    }
+
+    // xor of the last block of each lane, hashed
+
+    for (u32 cand = 0; cand < group_cnt; cand++)
+    {
+      argon2_optimized_tmp_t *tmp = argon2_optimized_tmp + group_pos + cand;
+
+      context.out    = (uint8_t *) tmp->h;
+      context.memory = (uint8_t *) unit_buf->memory + ((size_t) cand * instance->memory_blocks * ARGON2_BLOCK_SIZE);
+
+      instance->memory = (block *) context.memory;
+
+      finalize (&context, instance);
+    }
+  }
+
+  return true;
+}
+
+void bridge_init (bridge_ctx_t *bridge_ctx)
+{
+  bridge_ctx->bridge_context_size       = BRIDGE_CONTEXT_SIZE_CURRENT;
+  bridge_ctx->bridge_interface_version  = BRIDGE_INTERFACE_VERSION_CURRENT;
+
+  bridge_ctx->platform_init       = platform_init;
+  bridge_ctx->platform_term       = platform_term;
+  bridge_ctx->get_unit_count      = get_unit_count;
+  bridge_ctx->get_unit_info       = get_unit_info;
+  bridge_ctx->get_workitem_count  = get_workitem_count;
+  bridge_ctx->thread_init         = thread_init;
+  bridge_ctx->thread_term         = thread_term;
+  bridge_ctx->salt_prepare        = salt_prepare;
+  bridge_ctx->salt_destroy        = salt_destroy;
+  bridge_ctx->launch_loop         = launch_loop;
+  bridge_ctx->launch_loop2        = BRIDGE_DEFAULT;
+  bridge_ctx->st_update_hash      = BRIDGE_DEFAULT;
+  bridge_ctx->st_update_pass      = BRIDGE_DEFAULT;
+}
+
+#endif // BRIDGE_ISA
@@ -0,0 +1,47 @@
+
+ARGON2_OPTIMIZED := deps/phc-winner-argon2-20190702
+ARGON2_OPTIMIZED_CFLAGS := -I$(ARGON2_OPTIMIZED)/_hashcat/
+
+ARGON2_OPTIMIZED_ISA :=
+
+ifeq ($(BRIDGE_ISA_DISPATCH),1)
+ARGON2_OPTIMIZED_ISA := sse2 avx2 avx512
+ARGON2_OPTIMIZED_CFLAGS += -DBRIDGE_ISA_DISPATCH
+else
+ifeq ($(MAINTAINER_MODE),0)
+ifeq ($(BUILD_MODE),cross)
+ARGON2_OPTIMIZED_CFLAGS += -mavx2
+else
+ifeq ($(UNAME),Darwin)
+ifeq ($(IS_APPLE_SILICON),0)
+ARGON2_OPTIMIZED_CFLAGS += -mavx2
+endif
+else
+ifeq ($(IS_PPC),1)
+ARGON2_OPTIMIZED_CFLAGS += -mcpu=native
+ARGON2_OPTIMIZED_CFLAGS += -mtune=native
+else
+ARGON2_OPTIMIZED_CFLAGS += -march=native
+ARGON2_OPTIMIZED_CFLAGS += -mtune=native
+endif
+endif
+endif
+endif
+endif
+
+$(foreach isa,$(ARGON2_OPTIMIZED_ISA),$(eval $(call BRIDGE_ISA_VARIANT,argon2id_optimized,$(isa),ARGON2_OPTIMIZED_CFLAGS)))
+
+ifeq ($(BUILD_MODE),cross)
+bridges/bridge_argon2id_optimized.so:  src/bridges/bridge_argon2id_optimized.c src/cpu_features.c $(ARGON2_OPTIMIZED_ISA:%=obj/bridge_argon2id_optimized.%.LINUX.o) obj/combined.LINUX.a
+	$(CC_LINUX) $(CCFLAGS) $(CFLAGS_CROSS_LINUX)  $^ -o $@ $(LFLAGS_CROSS_LINUX) -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_OPTIMIZED_CFLAGS)
+bridges/bridge_argon2id_optimized.dll: src/bridges/bridge_argon2id_optimized.c src/cpu_features.c $(ARGON2_OPTIMIZED_ISA:%=obj/bridge_argon2id_optimized.%.WIN.o) obj/combined.WIN.a
+	$(CC_WIN)   $(CCFLAGS) $(CFLAGS_CROSS_WIN)    $^ -o $@ $(LFLAGS_CROSS_WIN)   -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_OPTIMIZED_CFLAGS)
+else
+ifeq ($(SHARED),1)
+bridges/bridge_argon2id_optimized.$(BRIDGE_SUFFIX): src/bridges/bridge_argon2id_optimized.c src/cpu_features.c $(ARGON2_OPTIMIZED_ISA:%=obj/bridge_argon2id_optimized.%.NATIVE.o) $(HASHCAT_LIBRARY)
+	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_OPTIMIZED_CFLAGS)
+else
+bridges/bridge_argon2id_optimized.$(BRIDGE_SUFFIX): src/bridges/bridge_argon2id_optimized.c src/cpu_features.c $(ARGON2_OPTIMIZED_ISA:%=obj/bridge_argon2id_optimized.%.NATIVE.o) obj/combined.NATIVE.a
+	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_OPTIMIZED_CFLAGS)
+endif
+endif
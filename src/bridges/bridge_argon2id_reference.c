@@ -9,21 +9,72 @@
 #include "memory.h"
 #include "shared.h"
 #include "cpu_features.h"
+#include "bridge_pool.h"
 
 // argon2 reference
 
 #undef _DEFAULT_SOURCE
 
+#if defined (BRIDGE_ISA)
+
+// one ISA variant of the memory filling, see BRIDGE_ISA_DISPATCH in src/Makefile
+
+#define fill_segment CPU_ISA_FN (fill_segment)
+
+#include "opt.c"
+
+#else
+
 #include "argon2.c"
 #include "core.c"
 #include "blake2/blake2b.c"
 
+#if defined (BRIDGE_ISA_DISPATCH)
+
+typedef void fill_segment_fn_t (const argon2_instance_t *instance, argon2_position_t position);
+
+fill_segment_fn_t fill_segment_sse2;
+fill_segment_fn_t fill_segment_avx2;
+fill_segment_fn_t fill_segment_avx512;
+
+static fill_segment_fn_t *fill_segment_isa      = fill_segment_sse2;
+static const char        *fill_segment_isa_name = "SSE2";
+
+void fill_segment (const argon2_instance_t *instance, argon2_position_t position)
+{
+  fill_segment_isa (instance, position);
+}
+
+static void fill_segment_select ()
+{
+  if (cpu_supports_avx512f () && cpu_supports_avx512vl ())
+  {
+    fill_segment_isa      = fill_segment_avx512;
+    fill_segment_isa_name = "AVX512";
+  }
+  else if (cpu_supports_avx2 ())
+  {
+    fill_segment_isa      = fill_segment_avx2;
+    fill_segment_isa_name = "AVX2";
+  }
+}
+
+#else
+
 #if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86) || defined (__aarch64__) || defined (__arm64__)
 #include "opt.c"
 #else
 #include "ref.c"
 #endif
 
+static const char *fill_segment_isa_name = "native";
+
+static void fill_segment_select ()
+{
+}
+
+#endif
+
 // good: we can use this multiplier do reduce copy overhead to increase the guessing speed,
 // bad: but we also increase the password candidate batch size.
 // slow hashes which make use of this bridge probably are used with smaller wordlists,
@@ -69,10 +120,6 @@ typedef struct
   u64     workitem_count;
   size_t  workitem_size;
 
-  // implementation specific
-
-  void   *memory;
-
 } unit_t;
 
 typedef struct
@@ -80,8 +127,23 @@ typedef struct
   unit_t *units_buf;
   int     units_cnt;
 
+  // all cores work on the batch of the single unit, see BRIDGE_TYPE_THREAD_POOL
+
+  bridge_pool_t *bridge_pool;
+
+  void  **memory; // one per pool thread
+
 } bridge_argon2id_t;
 
+typedef struct
+{
+  const argon2_t         *argon2id;
+  argon2_reference_tmp_t *argon2_reference_tmp;
+
+  void                  **memory;
+
+} argon2_work_t;
+
 static bool units_init (bridge_argon2id_t *bridge_argon2id)
 {
   #if defined (_WIN)
@@ -90,42 +152,42 @@ static bool units_init (bridge_argon2id_t *bridge_argon2id)
 
   GetSystemInfo (&sysinfo);
 
-  int num_devices = sysinfo.dwNumberOfProcessors;
+  int num_threads = sysinfo.dwNumberOfProcessors;
 
   #else
 
-  int num_devices = sysconf (_SC_NPROCESSORS_ONLN);
+  int num_threads = sysconf (_SC_NPROCESSORS_ONLN);
 
   #endif
 
   // this works really good for me, I think is because of register pressure on SIMD enabled code
-  num_devices /= 2;
+  num_threads /= 2;
 
   // this is just a wild guess, but memory bus will probably bottleneck if we
   // have too many cores using it. we set some upper limit which is not ideal, but good enough for now.
-  //num_devices = MIN (num_devices, 8);
+  //num_threads = MIN (num_threads, 8);
 
-  unit_t *units_buf = (unit_t *) hccalloc (num_devices, sizeof (unit_t));
+  bridge_argon2id->bridge_pool = bridge_pool_init (num_threads);
 
-  int units_cnt = 0;
+  num_threads = bridge_pool_threads (bridge_argon2id->bridge_pool);
 
-  for (int i = 0; i < num_devices; i++)
-  {
-    unit_t *unit_buf = &units_buf[i];
+  bridge_argon2id->memory = (void **) hccalloc (num_threads, sizeof (void *));
 
-    unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
-      "%s",
-      "Argon2 reference implementation + tunings");
+  unit_t *units_buf = (unit_t *) hccalloc (1, sizeof (unit_t));
 
-    unit_buf->unit_info_buf[unit_buf->unit_info_len] = 0;
+  unit_t *unit_buf = &units_buf[0];
 
-    unit_buf->workitem_count = N_ACCEL;
+  unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
+    "Argon2 reference implementation + tunings, %s, %d threads",
+    fill_segment_isa_name,
+    num_threads);
 
-    units_cnt++;
-  }
+  unit_buf->unit_info_buf[unit_buf->unit_info_len] = 0;
+
+  unit_buf->workitem_count = (u64) N_ACCEL * num_threads;
 
   bridge_argon2id->units_buf = units_buf;
-  bridge_argon2id->units_cnt = units_cnt;
+  bridge_argon2id->units_cnt = 1;
 
   return true;
 }
@@ -136,6 +198,10 @@ static void units_term (bridge_argon2id_t *bridge_argon2id)
   {
     hcfree (bridge_argon2id->units_buf);
   }
+
+  hcfree (bridge_argon2id->memory);
+
+  bridge_pool_term (bridge_argon2id->bridge_pool);
 }
 
 void *platform_init (MAYBE_UNUSED user_options_t *user_options)
@@ -144,6 +210,8 @@ void *platform_init (MAYBE_UNUSED user_options_t *user_options)
 
   if (cpu_chipset_test () == -1) return NULL;
 
+  fill_segment_select ();
+
   // Allocate platform context
 
   bridge_argon2id_t *bridge_argon2id = (bridge_argon2id_t *) hcmalloc (sizeof (bridge_argon2id_t));
@@ -216,11 +284,11 @@ bool salt_prepare (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
 
   bridge_argon2id_t *bridge_argon2id = platform_context;
 
-  for (int unit_idx = 0; unit_idx < bridge_argon2id->units_cnt; unit_idx++)
-  {
-    unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+  const int threads_cnt = bridge_pool_threads (bridge_argon2id->bridge_pool);
 
-    unit_buf->memory = hcmalloc_bridge_aligned ((largest_m * 1024), 32); // because AVX2
+  for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+  {
+    bridge_argon2id->memory[thread_idx] = hcmalloc_bridge_aligned ((largest_m * 1024), 32); // because AVX2
   }
 
   return true;
@@ -230,27 +298,21 @@ void salt_destroy (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig
 {
   bridge_argon2id_t *bridge_argon2id = platform_context;
 
-  for (int unit_idx = 0; unit_idx < bridge_argon2id->units_cnt; unit_idx++)
-  {
-    unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
+  const int threads_cnt = bridge_pool_threads (bridge_argon2id->bridge_pool);
 
-    hcfree_bridge_aligned (unit_buf->memory);
+  for (int thread_idx = 0; thread_idx < threads_cnt; thread_idx++)
+  {
+    hcfree_bridge_aligned (bridge_argon2id->memory[thread_idx]);
   }
 }
 
-bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_param_t *device_param, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes, MAYBE_UNUSED const u32 salt_pos, MAYBE_UNUSED const u64 pws_cnt)
+static bool argon2_work (void *work_ctx, const int thread_idx, const u64 pw_pos, const u64 pw_cnt)
 {
-  bridge_argon2id_t *bridge_argon2id = platform_context;
+  argon2_work_t *argon2_work = (argon2_work_t *) work_ctx;
 
-  const int unit_idx = device_param->bridge_link_device;
+  const argon2_t *argon2id = argon2_work->argon2id;
 
-  unit_t *unit_buf = &bridge_argon2id->units_buf[unit_idx];
-
-  argon2_t *esalts_buf = (argon2_t *) hashes->esalts_buf;
-
-  argon2_t *argon2id = &esalts_buf[salt_pos];
-
-  argon2_reference_tmp_t *argon2_reference_tmp = (argon2_reference_tmp_t *) device_param->h_tmps;
+  argon2_reference_tmp_t *argon2_reference_tmp = argon2_work->argon2_reference_tmp + pw_pos;
 
   argon2_context context;
 
@@ -272,9 +334,9 @@ bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_pa
   context.free_cbk      = NULL;
   context.flags         = ARGON2_DEFAULT_FLAGS;
   context.version       = ARGON2_VERSION_NUMBER;
-  context.memory        = unit_buf->memory;
+  context.memory        = argon2_work->memory[thread_idx];
 
-  for (u64 i = 0; i < pws_cnt; i++)
+  for (u64 i = 0; i < pw_cnt; i++)
   {
     context.out    = (uint8_t *) argon2_reference_tmp->h;
     context.outlen = (uint32_t)  argon2id->digest_len;
@@ -289,6 +351,23 @@ bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_pa
   return true;
 }
 
+bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_param_t *device_param, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes, MAYBE_UNUSED const u32 salt_pos, MAYBE_UNUSED const u64 pws_cnt)
+{
+  bridge_argon2id_t *bridge_argon2id = platform_context;
+
+  argon2_t *esalts_buf = (argon2_t *) hashes->esalts_buf;
+
+  argon2_work_t argon2_work_ctx;
+
+  argon2_work_ctx.argon2id             = &esalts_buf[salt_pos];
+  argon2_work_ctx.argon2_reference_tmp = (argon2_reference_tmp_t *) device_param->h_tmps;
+  argon2_work_ctx.memory               = bridge_argon2id->memory;
+
+  // one candidate per chunk, a candidate can take long and the next one is picked up by whichever thread is free first
+
+  return bridge_pool_run (bridge_argon2id->bridge_pool, pws_cnt, 1, argon2_work, &argon2_work_ctx);
+}
+
 void bridge_init (bridge_ctx_t *bridge_ctx)
 {
   bridge_ctx->bridge_context_size       = BRIDGE_CONTEXT_SIZE_CURRENT;
@@ -308,3 +387,5 @@ void bridge_init (bridge_ctx_t *bridge_ctx)
   bridge_ctx->st_update_hash      = BRIDGE_DEFAULT;
   bridge_ctx->st_update_pass      = BRIDGE_DEFAULT;
 }
+
+#endif // BRIDGE_ISA
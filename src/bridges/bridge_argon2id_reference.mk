@@ -2,6 +2,12 @@
 ARGON2_REFERENCE := deps/phc-winner-argon2-20190702
 ARGON2_REFERENCE_CFLAGS := -I$(ARGON2_REFERENCE)/_hashcat/
 
+ARGON2_REFERENCE_ISA :=
+
+ifeq ($(BRIDGE_ISA_DISPATCH),1)
+ARGON2_REFERENCE_ISA := sse2 avx2 avx512
+ARGON2_REFERENCE_CFLAGS += -DBRIDGE_ISA_DISPATCH
+else
 ifeq ($(MAINTAINER_MODE),0)
 ifeq ($(BUILD_MODE),cross)
 ARGON2_REFERENCE_CFLAGS += -mavx2
@@ -21,18 +27,21 @@ endif
 endif
 endif
 endif
+endif
+
+$(foreach isa,$(ARGON2_REFERENCE_ISA),$(eval $(call BRIDGE_ISA_VARIANT,argon2id_reference,$(isa),ARGON2_REFERENCE_CFLAGS)))
 
 ifeq ($(BUILD_MODE),cross)
-bridges/bridge_argon2id_reference.so:  src/bridges/bridge_argon2id_reference.c src/cpu_features.c obj/combined.LINUX.a
+bridges/bridge_argon2id_reference.so:  src/bridges/bridge_argon2id_reference.c src/cpu_features.c $(ARGON2_REFERENCE_ISA:%=obj/bridge_argon2id_reference.%.LINUX.o) obj/combined.LINUX.a
 	$(CC_LINUX) $(CCFLAGS) $(CFLAGS_CROSS_LINUX)  $^ -o $@ $(LFLAGS_CROSS_LINUX) -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_REFERENCE_CFLAGS)
-bridges/bridge_argon2id_reference.dll: src/bridges/bridge_argon2id_reference.c src/cpu_features.c obj/combined.WIN.a
+bridges/bridge_argon2id_reference.dll: src/bridges/bridge_argon2id_reference.c src/cpu_features.c $(ARGON2_REFERENCE_ISA:%=obj/bridge_argon2id_reference.%.WIN.o) obj/combined.WIN.a
 	$(CC_WIN)   $(CCFLAGS) $(CFLAGS_CROSS_WIN)    $^ -o $@ $(LFLAGS_CROSS_WIN)   -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_REFERENCE_CFLAGS)
 else
 ifeq ($(SHARED),1)
-bridges/bridge_argon2id_reference.$(BRIDGE_SUFFIX): src/bridges/bridge_argon2id_reference.c src/cpu_features.c $(HASHCAT_LIBRARY)
+bridges/bridge_argon2id_reference.$(BRIDGE_SUFFIX): src/bridges/bridge_argon2id_reference.c src/cpu_features.c $(ARGON2_REFERENCE_ISA:%=obj/bridge_argon2id_reference.%.NATIVE.o) $(HASHCAT_LIBRARY)
 	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_REFERENCE_CFLAGS)
 else
-bridges/bridge_argon2id_reference.$(BRIDGE_SUFFIX): src/bridges/bridge_argon2id_reference.c src/cpu_features.c obj/combined.NATIVE.a
+bridges/bridge_argon2id_reference.$(BRIDGE_SUFFIX): src/bridges/bridge_argon2id_reference.c src/cpu_features.c $(ARGON2_REFERENCE_ISA:%=obj/bridge_argon2id_reference.%.NATIVE.o) obj/combined.NATIVE.a
 	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(ARGON2_REFERENCE_CFLAGS)
 endif
 endif
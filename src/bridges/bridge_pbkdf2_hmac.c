@@ -0,0 +1,738 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "bridges.h"
+#include "memory.h"
+#include "shared.h"
+#include "cpu_features.h"
+
+// multi-buffer PBKDF2-HMAC-SHA1/SHA256/SHA512
+//
+// this bridge replaces the _loop kernel of the PBKDF2 based hash-modes, the _init and _comp kernels
+// still run on the backend device. each SIMD lane carries the HMAC state of a different password
+// candidate, so one transform of a vector register set iterates 4/8/16 candidates (SHA1, SHA256)
+// or 2/4/8 candidates (SHA512) at once for SSE2/AVX2/AVX512.
+
+typedef struct pbkdf2_job
+{
+  u8     *tmps;
+  size_t  tmp_size;
+
+  size_t  ipad_off;
+  size_t  opad_off;
+  size_t  dgst_off;
+  size_t  out_off;
+
+  u64     cnt;
+  u32     iter;
+
+} pbkdf2_job_t;
+
+typedef void pbkdf2_loop_fn_t (const pbkdf2_job_t *job);
+
+#if defined (BRIDGE_ISA) || !defined (BRIDGE_ISA_DISPATCH)
+
+// one ISA variant of the multi-buffer loops, see BRIDGE_ISA_DISPATCH in src/Makefile
+// the vector width follows the ISA the variant is compiled for, the compiler maps the vector extensions to it
+
+#if defined (__AVX512F__)
+#define MB_BYTES 64
+#elif defined (__AVX2__)
+#define MB_BYTES 32
+#else
+#define MB_BYTES 16
+#endif
+
+#define MB_LANES32 (MB_BYTES / 4)
+#define MB_LANES64 (MB_BYTES / 8)
+
+typedef u32 u32v __attribute__ ((vector_size (MB_BYTES)));
+typedef u64 u64v __attribute__ ((vector_size (MB_BYTES)));
+
+#define MB_ROTL32(x,n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define MB_ROTR32(x,n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define MB_ROTR64(x,n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+// sha1
+
+#define SHA1_F0(x,y,z) ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA1_F1(x,y,z) ((x) ^ (y) ^ (z))
+#define SHA1_F2(x,y,z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define SHA1_W(t) (((t) < 16) ? w[(t) & 15] : (w[(t) & 15] = MB_ROTL32 (w[((t) - 3) & 15] ^ w[((t) - 8) & 15] ^ w[((t) - 14) & 15] ^ w[(t) & 15], 1)))
+
+#define SHA1_STEP(f,a,b,c,d,e,k,t)                          \
+{                                                           \
+  (e) += (k) + SHA1_W (t) + f ((b), (c), (d)) + MB_ROTL32 ((a), 5); \
+  (b)  = MB_ROTL32 ((b), 30);                               \
+}
+
+#define SHA1_STEP5(f,k,t)                                   \
+{                                                           \
+  SHA1_STEP (f, a, b, c, d, e, k, (t) + 0);                 \
+  SHA1_STEP (f, e, a, b, c, d, k, (t) + 1);                 \
+  SHA1_STEP (f, d, e, a, b, c, k, (t) + 2);                 \
+  SHA1_STEP (f, c, d, e, a, b, k, (t) + 3);                 \
+  SHA1_STEP (f, b, c, d, e, a, k, (t) + 4);                 \
+}
+
+static inline void sha1_transform_mb (u32v *w, u32v *digest)
+{
+  u32v a = digest[0];
+  u32v b = digest[1];
+  u32v c = digest[2];
+  u32v d = digest[3];
+  u32v e = digest[4];
+
+  SHA1_STEP5 (SHA1_F0, 0x5a827999,  0);
+  SHA1_STEP5 (SHA1_F0, 0x5a827999,  5);
+  SHA1_STEP5 (SHA1_F0, 0x5a827999, 10);
+  SHA1_STEP5 (SHA1_F0, 0x5a827999, 15);
+  SHA1_STEP5 (SHA1_F1, 0x6ed9eba1, 20);
+  SHA1_STEP5 (SHA1_F1, 0x6ed9eba1, 25);
+  SHA1_STEP5 (SHA1_F1, 0x6ed9eba1, 30);
+  SHA1_STEP5 (SHA1_F1, 0x6ed9eba1, 35);
+  SHA1_STEP5 (SHA1_F2, 0x8f1bbcdc, 40);
+  SHA1_STEP5 (SHA1_F2, 0x8f1bbcdc, 45);
+  SHA1_STEP5 (SHA1_F2, 0x8f1bbcdc, 50);
+  SHA1_STEP5 (SHA1_F2, 0x8f1bbcdc, 55);
+  SHA1_STEP5 (SHA1_F1, 0xca62c1d6, 60);
+  SHA1_STEP5 (SHA1_F1, 0xca62c1d6, 65);
+  SHA1_STEP5 (SHA1_F1, 0xca62c1d6, 70);
+  SHA1_STEP5 (SHA1_F1, 0xca62c1d6, 75);
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+  digest[4] += e;
+}
+
+// sha256
+
+static const u32 k_sha256[64] =
+{
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define SHA256_S0(x) (MB_ROTR32 ((x),  2) ^ MB_ROTR32 ((x), 13) ^ MB_ROTR32 ((x), 22))
+#define SHA256_S1(x) (MB_ROTR32 ((x),  6) ^ MB_ROTR32 ((x), 11) ^ MB_ROTR32 ((x), 25))
+#define SHA256_s0(x) (MB_ROTR32 ((x),  7) ^ MB_ROTR32 ((x), 18) ^ ((x) >>  3))
+#define SHA256_s1(x) (MB_ROTR32 ((x), 17) ^ MB_ROTR32 ((x), 19) ^ ((x) >> 10))
+
+#define SHA_CH(x,y,z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA_MAJ(x,y,z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define SHA256_STEP(a,b,c,d,e,f,g,h,i)                                      \
+{                                                                           \
+  const u32v t1 = (h) + SHA256_S1 (e) + SHA_CH ((e), (f), (g)) + k_sha256[i] + w[(i) & 15]; \
+  (d) += t1;                                                                \
+  (h)  = t1 + SHA256_S0 (a) + SHA_MAJ ((a), (b), (c));                      \
+}
+
+static inline void sha256_transform_mb (u32v *w, u32v *digest)
+{
+  u32v a = digest[0];
+  u32v b = digest[1];
+  u32v c = digest[2];
+  u32v d = digest[3];
+  u32v e = digest[4];
+  u32v f = digest[5];
+  u32v g = digest[6];
+  u32v h = digest[7];
+
+  for (int i = 0; i < 64; i += 16)
+  {
+    if (i)
+    {
+      for (int j = 0; j < 16; j++)
+      {
+        w[j] += SHA256_s1 (w[(j + 14) & 15]) + w[(j + 9) & 15] + SHA256_s0 (w[(j + 1) & 15]);
+      }
+    }
+
+    SHA256_STEP (a, b, c, d, e, f, g, h, i +  0);
+    SHA256_STEP (h, a, b, c, d, e, f, g, i +  1);
+    SHA256_STEP (g, h, a, b, c, d, e, f, i +  2);
+    SHA256_STEP (f, g, h, a, b, c, d, e, i +  3);
+    SHA256_STEP (e, f, g, h, a, b, c, d, i +  4);
+    SHA256_STEP (d, e, f, g, h, a, b, c, i +  5);
+    SHA256_STEP (c, d, e, f, g, h, a, b, i +  6);
+    SHA256_STEP (b, c, d, e, f, g, h, a, i +  7);
+    SHA256_STEP (a, b, c, d, e, f, g, h, i +  8);
+    SHA256_STEP (h, a, b, c, d, e, f, g, i +  9);
+    SHA256_STEP (g, h, a, b, c, d, e, f, i + 10);
+    SHA256_STEP (f, g, h, a, b, c, d, e, i + 11);
+    SHA256_STEP (e, f, g, h, a, b, c, d, i + 12);
+    SHA256_STEP (d, e, f, g, h, a, b, c, i + 13);
+    SHA256_STEP (c, d, e, f, g, h, a, b, i + 14);
+    SHA256_STEP (b, c, d, e, f, g, h, a, i + 15);
+  }
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+  digest[4] += e;
+  digest[5] += f;
+  digest[6] += g;
+  digest[7] += h;
+}
+
+// sha512
+
+static const u64 k_sha512[80] =
+{
+  0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+  0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+  0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+  0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+  0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+  0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+  0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+  0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+  0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+  0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+  0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+  0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+  0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+  0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+  0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+  0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+  0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+  0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+  0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+  0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
+};
+
+#define SHA512_S0(x) (MB_ROTR64 ((x), 28) ^ MB_ROTR64 ((x), 34) ^ MB_ROTR64 ((x), 39))
+#define SHA512_S1(x) (MB_ROTR64 ((x), 14) ^ MB_ROTR64 ((x), 18) ^ MB_ROTR64 ((x), 41))
+#define SHA512_s0(x) (MB_ROTR64 ((x),  1) ^ MB_ROTR64 ((x),  8) ^ ((x) >> 7))
+#define SHA512_s1(x) (MB_ROTR64 ((x), 19) ^ MB_ROTR64 ((x), 61) ^ ((x) >> 6))
+
+#define SHA512_STEP(a,b,c,d,e,f,g,h,i)                                      \
+{                                                                           \
+  const u64v t1 = (h) + SHA512_S1 (e) + SHA_CH ((e), (f), (g)) + k_sha512[i] + w[(i) & 15]; \
+  (d) += t1;                                                                \
+  (h)  = t1 + SHA512_S0 (a) + SHA_MAJ ((a), (b), (c));                      \
+}
+
+static inline void sha512_transform_mb (u64v *w, u64v *digest)
+{
+  u64v a = digest[0];
+  u64v b = digest[1];
+  u64v c = digest[2];
+  u64v d = digest[3];
+  u64v e = digest[4];
+  u64v f = digest[5];
+  u64v g = digest[6];
+  u64v h = digest[7];
+
+  for (int i = 0; i < 80; i += 16)
+  {
+    if (i)
+    {
+      for (int j = 0; j < 16; j++)
+      {
+        w[j] += SHA512_s1 (w[(j + 14) & 15]) + w[(j + 9) & 15] + SHA512_s0 (w[(j + 1) & 15]);
+      }
+    }
+
+    SHA512_STEP (a, b, c, d, e, f, g, h, i +  0);
+    SHA512_STEP (h, a, b, c, d, e, f, g, i +  1);
+    SHA512_STEP (g, h, a, b, c, d, e, f, i +  2);
+    SHA512_STEP (f, g, h, a, b, c, d, e, i +  3);
+    SHA512_STEP (e, f, g, h, a, b, c, d, i +  4);
+    SHA512_STEP (d, e, f, g, h, a, b, c, i +  5);
+    SHA512_STEP (c, d, e, f, g, h, a, b, i +  6);
+    SHA512_STEP (b, c, d, e, f, g, h, a, i +  7);
+    SHA512_STEP (a, b, c, d, e, f, g, h, i +  8);
+    SHA512_STEP (h, a, b, c, d, e, f, g, i +  9);
+    SHA512_STEP (g, h, a, b, c, d, e, f, i + 10);
+    SHA512_STEP (f, g, h, a, b, c, d, e, i + 11);
+    SHA512_STEP (e, f, g, h, a, b, c, d, i + 12);
+    SHA512_STEP (d, e, f, g, h, a, b, c, i + 13);
+    SHA512_STEP (c, d, e, f, g, h, a, b, i + 14);
+    SHA512_STEP (b, c, d, e, f, g, h, a, i + 15);
+  }
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+  digest[4] += e;
+  digest[5] += f;
+  digest[6] += g;
+  digest[7] += h;
+}
+
+// the loops: load one candidate per lane, iterate, store the lanes back
+// the last group may not fill all lanes, the unused lanes work on a copy of the last candidate and are not stored
+
+#define MB_LOOP(name,T,TV,LANES,DGST_WORDS,TRANSFORM,PAD,LEN)                               \
+void CPU_ISA_FN (name) (const pbkdf2_job_t *job)                                              \
+{                                                                                             \
+  for (u64 pos = 0; pos < job->cnt; pos += LANES)                                             \
+  {                                                                                           \
+    TV ipad[8];                                                                               \
+    TV opad[8];                                                                               \
+    TV dgst[8];                                                                               \
+    TV out[8];                                                                                \
+                                                                                              \
+    for (int lane = 0; lane < LANES; lane++)                                                  \
+    {                                                                                         \
+      const u64 idx = MIN (pos + lane, job->cnt - 1);                                         \
+                                                                                              \
+      const u8 *tmp = job->tmps + (idx * job->tmp_size);                                      \
+                                                                                              \
+      const T *tmp_ipad = (const T *) (tmp + job->ipad_off);                                  \
+      const T *tmp_opad = (const T *) (tmp + job->opad_off);                                  \
+      const T *tmp_dgst = (const T *) (tmp + job->dgst_off);                                  \
+      const T *tmp_out  = (const T *) (tmp + job->out_off);                                   \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++)                                                    \
+      {                                                                                       \
+        ipad[i][lane] = tmp_ipad[i];                                                          \
+        opad[i][lane] = tmp_opad[i];                                                          \
+        dgst[i][lane] = tmp_dgst[i];                                                          \
+        out[i][lane]  = tmp_out[i];                                                           \
+      }                                                                                       \
+    }                                                                                         \
+                                                                                              \
+    for (u32 j = 0; j < job->iter; j++)                                                       \
+    {                                                                                         \
+      TV w[16];                                                                               \
+      TV s[8];                                                                                \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++) w[i] = dgst[i];                                    \
+                                                                                              \
+      w[DGST_WORDS] = (TV) {} + (T) (PAD);                                                    \
+                                                                                              \
+      for (int i = DGST_WORDS + 1; i < 15; i++) w[i] = (TV) {};                               \
+                                                                                              \
+      w[15] = (TV) {} + (T) (LEN);                                                            \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++) s[i] = ipad[i];                                    \
+                                                                                              \
+      TRANSFORM (w, s);                                                                       \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++) w[i] = s[i];                                       \
+                                                                                              \
+      w[DGST_WORDS] = (TV) {} + (T) (PAD);                                                    \
+                                                                                              \
+      for (int i = DGST_WORDS + 1; i < 15; i++) w[i] = (TV) {};                               \
+                                                                                              \
+      w[15] = (TV) {} + (T) (LEN);                                                            \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++) s[i] = opad[i];                                    \
+                                                                                              \
+      TRANSFORM (w, s);                                                                       \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++)                                                    \
+      {                                                                                       \
+        dgst[i]  = s[i];                                                                      \
+        out[i]  ^= s[i];                                                                      \
+      }                                                                                       \
+    }                                                                                         \
+                                                                                              \
+    for (int lane = 0; lane < LANES; lane++)                                                  \
+    {                                                                                         \
+      if ((pos + lane) >= job->cnt) break;                                                    \
+                                                                                              \
+      u8 *tmp = job->tmps + ((pos + lane) * job->tmp_size);                                   \
+                                                                                              \
+      T *tmp_dgst = (T *) (tmp + job->dgst_off);                                              \
+      T *tmp_out  = (T *) (tmp + job->out_off);                                               \
+                                                                                              \
+      for (int i = 0; i < DGST_WORDS; i++)                                                    \
+      {                                                                                       \
+        tmp_dgst[i] = dgst[i][lane];                                                          \
+        tmp_out[i]  = out[i][lane];                                                           \
+      }                                                                                       \
+    }                                                                                         \
+  }                                                                                           \
+}
+
+// the message of each transform is one digest, ipad/opad were already absorbed by _init
+
+MB_LOOP (pbkdf2_hmac_sha1_loop,   u32, u32v, MB_LANES32, 5, sha1_transform_mb,   0x80000000,         (64  + 20) * 8)
+MB_LOOP (pbkdf2_hmac_sha256_loop, u32, u32v, MB_LANES32, 8, sha256_transform_mb, 0x80000000,         (64  + 32) * 8)
+MB_LOOP (pbkdf2_hmac_sha512_loop, u64, u64v, MB_LANES64, 8, sha512_transform_mb, 0x8000000000000000, (128 + 64) * 8)
+
+#endif // BRIDGE_ISA || !BRIDGE_ISA_DISPATCH
+
+#if !defined (BRIDGE_ISA)
+
+#if defined (BRIDGE_ISA_DISPATCH)
+
+pbkdf2_loop_fn_t pbkdf2_hmac_sha1_loop_sse2;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha1_loop_avx2;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha1_loop_avx512;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha256_loop_sse2;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha256_loop_avx2;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha256_loop_avx512;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha512_loop_sse2;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha512_loop_avx2;
+pbkdf2_loop_fn_t pbkdf2_hmac_sha512_loop_avx512;
+
+static pbkdf2_loop_fn_t *pbkdf2_hmac_sha1_loop_isa   = pbkdf2_hmac_sha1_loop_sse2;
+static pbkdf2_loop_fn_t *pbkdf2_hmac_sha256_loop_isa = pbkdf2_hmac_sha256_loop_sse2;
+static pbkdf2_loop_fn_t *pbkdf2_hmac_sha512_loop_isa = pbkdf2_hmac_sha512_loop_sse2;
+static const char       *pbkdf2_hmac_isa_name        = "SSE2";
+static int               pbkdf2_hmac_isa_lanes       = 4;
+
+static void pbkdf2_hmac_select ()
+{
+  if (cpu_supports_avx512f () && cpu_supports_avx512vl ())
+  {
+    pbkdf2_hmac_sha1_loop_isa   = pbkdf2_hmac_sha1_loop_avx512;
+    pbkdf2_hmac_sha256_loop_isa = pbkdf2_hmac_sha256_loop_avx512;
+    pbkdf2_hmac_sha512_loop_isa = pbkdf2_hmac_sha512_loop_avx512;
+    pbkdf2_hmac_isa_name        = "AVX512";
+    pbkdf2_hmac_isa_lanes       = 16;
+  }
+  else if (cpu_supports_avx2 ())
+  {
+    pbkdf2_hmac_sha1_loop_isa   = pbkdf2_hmac_sha1_loop_avx2;
+    pbkdf2_hmac_sha256_loop_isa = pbkdf2_hmac_sha256_loop_avx2;
+    pbkdf2_hmac_sha512_loop_isa = pbkdf2_hmac_sha512_loop_avx2;
+    pbkdf2_hmac_isa_name        = "AVX2";
+    pbkdf2_hmac_isa_lanes       = 8;
+  }
+}
+
+#else
+
+static pbkdf2_loop_fn_t *pbkdf2_hmac_sha1_loop_isa   = pbkdf2_hmac_sha1_loop;
+static pbkdf2_loop_fn_t *pbkdf2_hmac_sha256_loop_isa = pbkdf2_hmac_sha256_loop;
+static pbkdf2_loop_fn_t *pbkdf2_hmac_sha512_loop_isa = pbkdf2_hmac_sha512_loop;
+static const char       *pbkdf2_hmac_isa_name        = "native";
+static int               pbkdf2_hmac_isa_lanes       = MB_LANES32;
+
+static void pbkdf2_hmac_select ()
+{
+}
+
+#endif
+
+// good: we can use this multiplier do reduce copy overhead to increase the guessing speed,
+// bad: but we also increase the password candidate batch size.
+// the multiplier must stay a multiple of the widest lane count, otherwise the last group of each launch runs half empty.
+
+#define N_ACCEL 64
+
+// the tmps layouts of the kernels we replace the _loop of, they must match the ones in the OpenCL/m*.cl files
+
+typedef struct pbkdf2_sha1_tmp
+{
+  u32 ipad[5];
+  u32 opad[5];
+
+  u32 dgst[32];
+  u32 out[32];
+
+} pbkdf2_sha1_tmp_t;
+
+typedef struct wpa_pbkdf2_tmp
+{
+  u32 ipad[5];
+  u32 opad[5];
+
+  u32 dgst[10];
+  u32 out[10];
+
+} wpa_pbkdf2_tmp_t;
+
+typedef struct pbkdf2_sha256_tmp
+{
+  u32 ipad[8];
+  u32 opad[8];
+
+  u32 dgst[32];
+  u32 out[32];
+
+} pbkdf2_sha256_tmp_t;
+
+typedef struct pbkdf2_sha512_tmp
+{
+  u64 ipad[8];
+  u64 opad[8];
+
+  u64 dgst[16];
+  u64 out[16];
+
+} pbkdf2_sha512_tmp_t;
+
+typedef enum pbkdf2_hmac_hash
+{
+  PBKDF2_HMAC_SHA1   = 1,
+  PBKDF2_HMAC_SHA256 = 2,
+  PBKDF2_HMAC_SHA512 = 3,
+
+} pbkdf2_hmac_hash_t;
+
+typedef struct pbkdf2_layout
+{
+  u32     kern_type;
+
+  int     hash;
+
+  size_t  tmp_size;
+
+  size_t  ipad_off;
+  size_t  opad_off;
+  size_t  dgst_off;
+  size_t  out_off;
+
+  // WPA derives 32 byte from PBKDF2-HMAC-SHA1, that's two independent blocks
+
+  int     blocks;
+  size_t  block_size;
+
+} pbkdf2_layout_t;
+
+static const pbkdf2_layout_t pbkdf2_layouts[] =
+{
+  { 12000, PBKDF2_HMAC_SHA1,   sizeof (pbkdf2_sha1_tmp_t),   offsetof (pbkdf2_sha1_tmp_t,   ipad), offsetof (pbkdf2_sha1_tmp_t,   opad), offsetof (pbkdf2_sha1_tmp_t,   dgst), offsetof (pbkdf2_sha1_tmp_t,   out), 1,  0 },
+  { 22000, PBKDF2_HMAC_SHA1,   sizeof (wpa_pbkdf2_tmp_t),    offsetof (wpa_pbkdf2_tmp_t,    ipad), offsetof (wpa_pbkdf2_tmp_t,    opad), offsetof (wpa_pbkdf2_tmp_t,    dgst), offsetof (wpa_pbkdf2_tmp_t,    out), 2, 20 },
+  { 10900, PBKDF2_HMAC_SHA256, sizeof (pbkdf2_sha256_tmp_t), offsetof (pbkdf2_sha256_tmp_t, ipad), offsetof (pbkdf2_sha256_tmp_t, opad), offsetof (pbkdf2_sha256_tmp_t, dgst), offsetof (pbkdf2_sha256_tmp_t, out), 1,  0 },
+  {  7100, PBKDF2_HMAC_SHA512, sizeof (pbkdf2_sha512_tmp_t), offsetof (pbkdf2_sha512_tmp_t, ipad), offsetof (pbkdf2_sha512_tmp_t, opad), offsetof (pbkdf2_sha512_tmp_t, dgst), offsetof (pbkdf2_sha512_tmp_t, out), 1,  0 },
+};
+
+typedef struct
+{
+  // implementation specific
+
+  char    unit_info_buf[1024];
+  int     unit_info_len;
+
+  u64     workitem_count;
+  size_t  workitem_size;
+
+} unit_t;
+
+typedef struct
+{
+  unit_t *units_buf;
+  int     units_cnt;
+
+  const pbkdf2_layout_t *layout;
+
+} bridge_pbkdf2_hmac_t;
+
+static bool units_init (bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac)
+{
+  #if defined (_WIN)
+
+  SYSTEM_INFO sysinfo;
+
+  GetSystemInfo (&sysinfo);
+
+  int num_devices = sysinfo.dwNumberOfProcessors;
+
+  #else
+
+  int num_devices = sysconf (_SC_NPROCESSORS_ONLN);
+
+  #endif
+
+  unit_t *units_buf = (unit_t *) hccalloc (num_devices, sizeof (unit_t));
+
+  int units_cnt = 0;
+
+  for (int i = 0; i < num_devices; i++)
+  {
+    unit_t *unit_buf = &units_buf[i];
+
+    unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
+      "PBKDF2-HMAC multi-buffer, %s, %d lanes",
+      pbkdf2_hmac_isa_name,
+      pbkdf2_hmac_isa_lanes);
+
+    unit_buf->unit_info_buf[unit_buf->unit_info_len] = 0;
+
+    unit_buf->workitem_count = N_ACCEL;
+
+    units_cnt++;
+  }
+
+  bridge_pbkdf2_hmac->units_buf = units_buf;
+  bridge_pbkdf2_hmac->units_cnt = units_cnt;
+
+  return true;
+}
+
+static void units_term (bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac)
+{
+  if (bridge_pbkdf2_hmac)
+  {
+    hcfree (bridge_pbkdf2_hmac->units_buf);
+  }
+}
+
+void *platform_init (MAYBE_UNUSED user_options_t *user_options)
+{
+  // Verify CPU features
+
+  if (cpu_chipset_test () == -1) return NULL;
+
+  pbkdf2_hmac_select ();
+
+  // Allocate platform context
+
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = (bridge_pbkdf2_hmac_t *) hcmalloc (sizeof (bridge_pbkdf2_hmac_t));
+
+  if (units_init (bridge_pbkdf2_hmac) == false)
+  {
+    hcfree (bridge_pbkdf2_hmac);
+
+    return NULL;
+  }
+
+  return bridge_pbkdf2_hmac;
+}
+
+void platform_term (void *platform_context)
+{
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = platform_context;
+
+  if (bridge_pbkdf2_hmac)
+  {
+    units_term (bridge_pbkdf2_hmac);
+
+    hcfree (bridge_pbkdf2_hmac);
+  }
+}
+
+int get_unit_count (void *platform_context)
+{
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = platform_context;
+
+  return bridge_pbkdf2_hmac->units_cnt;
+}
+
+// we support units of mixed speed, that's why the workitem count is unit specific
+
+int get_workitem_count (void *platform_context, const int unit_idx)
+{
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = platform_context;
+
+  unit_t *unit_buf = &bridge_pbkdf2_hmac->units_buf[unit_idx];
+
+  return unit_buf->workitem_count;
+}
+
+char *get_unit_info (void *platform_context, const int unit_idx)
+{
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = platform_context;
+
+  unit_t *unit_buf = &bridge_pbkdf2_hmac->units_buf[unit_idx];
+
+  return unit_buf->unit_info_buf;
+}
+
+bool salt_prepare (void *platform_context, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes)
+{
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = platform_context;
+
+  // the kernel type tells us the tmps layout, the module keeps the one of the mode it was derived from
+
+  bridge_pbkdf2_hmac->layout = NULL;
+
+  for (size_t i = 0; i < sizeof (pbkdf2_layouts) / sizeof (pbkdf2_layouts[0]); i++)
+  {
+    if (pbkdf2_layouts[i].kern_type != hashconfig->kern_type) continue;
+
+    bridge_pbkdf2_hmac->layout = &pbkdf2_layouts[i];
+
+    break;
+  }
+
+  if (bridge_pbkdf2_hmac->layout == NULL)
+  {
+    fprintf (stderr, "PBKDF2-HMAC bridge: unsupported kernel type %u\n", hashconfig->kern_type);
+
+    return false;
+  }
+
+  if (bridge_pbkdf2_hmac->layout->tmp_size != hashconfig->tmp_size)
+  {
+    fprintf (stderr, "PBKDF2-HMAC bridge: tmps size mismatch for kernel type %u\n", hashconfig->kern_type);
+
+    return false;
+  }
+
+  return true;
+}
+
+bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_param_t *device_param, MAYBE_UNUSED hashconfig_t *hashconfig, MAYBE_UNUSED hashes_t *hashes, MAYBE_UNUSED const u32 salt_pos, MAYBE_UNUSED const u64 pws_cnt)
+{
+  bridge_pbkdf2_hmac_t *bridge_pbkdf2_hmac = platform_context;
+
+  const pbkdf2_layout_t *layout = bridge_pbkdf2_hmac->layout;
+
+  pbkdf2_loop_fn_t *loop = NULL;
+
+  switch (layout->hash)
+  {
+    case PBKDF2_HMAC_SHA1:   loop = pbkdf2_hmac_sha1_loop_isa;   break;
+    case PBKDF2_HMAC_SHA256: loop = pbkdf2_hmac_sha256_loop_isa; break;
+    case PBKDF2_HMAC_SHA512: loop = pbkdf2_hmac_sha512_loop_isa; break;
+  }
+
+  if (loop == NULL) return false;
+
+  // hashcat guarantees h_tmps[] is 64 byte aligned
+  // we are called once per kernel_loops chunk, the iterations are position independent so loop_cnt is all we need
+
+  for (int block = 0; block < layout->blocks; block++)
+  {
+    pbkdf2_job_t job;
+
+    job.tmps     = (u8 *) device_param->h_tmps;
+    job.tmp_size = layout->tmp_size;
+    job.ipad_off = layout->ipad_off;
+    job.opad_off = layout->opad_off;
+    job.dgst_off = layout->dgst_off + (block * layout->block_size);
+    job.out_off  = layout->out_off  + (block * layout->block_size);
+    job.cnt      = pws_cnt;
+    job.iter     = device_param->kernel_param.loop_cnt;
+
+    loop (&job);
+  }
+
+  return true;
+}
+
+void bridge_init (bridge_ctx_t *bridge_ctx)
+{
+  bridge_ctx->bridge_context_size       = BRIDGE_CONTEXT_SIZE_CURRENT;
+  bridge_ctx->bridge_interface_version  = BRIDGE_INTERFACE_VERSION_CURRENT;
+
+  bridge_ctx->platform_init       = platform_init;
+  bridge_ctx->platform_term       = platform_term;
+  bridge_ctx->get_unit_count      = get_unit_count;
+  bridge_ctx->get_unit_info       = get_unit_info;
+  bridge_ctx->get_workitem_count  = get_workitem_count;
+  bridge_ctx->thread_init         = BRIDGE_DEFAULT;
+  bridge_ctx->thread_term         = BRIDGE_DEFAULT;
+  bridge_ctx->salt_prepare        = salt_prepare;
+  bridge_ctx->salt_destroy        = BRIDGE_DEFAULT;
+  bridge_ctx->launch_loop         = launch_loop;
+  bridge_ctx->launch_loop2        = BRIDGE_DEFAULT;
+  bridge_ctx->st_update_hash      = BRIDGE_DEFAULT;
+  bridge_ctx->st_update_pass      = BRIDGE_DEFAULT;
+}
+
+#endif // BRIDGE_ISA
@@ -0,0 +1,45 @@
+PBKDF2_HMAC_CFLAGS :=
+
+PBKDF2_HMAC_ISA :=
+
+ifeq ($(BRIDGE_ISA_DISPATCH),1)
+PBKDF2_HMAC_ISA := sse2 avx2 avx512
+PBKDF2_HMAC_CFLAGS += -DBRIDGE_ISA_DISPATCH
+else
+ifeq ($(MAINTAINER_MODE),0)
+ifeq ($(BUILD_MODE),cross)
+PBKDF2_HMAC_CFLAGS += -mavx2
+else
+ifeq ($(UNAME),Darwin)
+ifeq ($(IS_APPLE_SILICON),0)
+PBKDF2_HMAC_CFLAGS += -mavx2
+endif
+else
+ifeq ($(IS_PPC),1)
+PBKDF2_HMAC_CFLAGS += -mcpu=native
+PBKDF2_HMAC_CFLAGS += -mtune=native
+else
+PBKDF2_HMAC_CFLAGS += -march=native
+PBKDF2_HMAC_CFLAGS += -mtune=native
+endif
+endif
+endif
+endif
+endif
+
+$(foreach isa,$(PBKDF2_HMAC_ISA),$(eval $(call BRIDGE_ISA_VARIANT,pbkdf2_hmac,$(isa),PBKDF2_HMAC_CFLAGS)))
+
+ifeq ($(BUILD_MODE),cross)
+bridges/bridge_pbkdf2_hmac.so:  src/bridges/bridge_pbkdf2_hmac.c src/cpu_features.c $(PBKDF2_HMAC_ISA:%=obj/bridge_pbkdf2_hmac.%.LINUX.o) obj/combined.LINUX.a
+	$(CC_LINUX) $(CCFLAGS) $(CFLAGS_CROSS_LINUX)  $^ -o $@ $(LFLAGS_CROSS_LINUX) -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(PBKDF2_HMAC_CFLAGS)
+bridges/bridge_pbkdf2_hmac.dll: src/bridges/bridge_pbkdf2_hmac.c src/cpu_features.c $(PBKDF2_HMAC_ISA:%=obj/bridge_pbkdf2_hmac.%.WIN.o) obj/combined.WIN.a
+	$(CC_WIN)   $(CCFLAGS) $(CFLAGS_CROSS_WIN)    $^ -o $@ $(LFLAGS_CROSS_WIN)   -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(PBKDF2_HMAC_CFLAGS)
+else
+ifeq ($(SHARED),1)
+bridges/bridge_pbkdf2_hmac.$(BRIDGE_SUFFIX): src/bridges/bridge_pbkdf2_hmac.c src/cpu_features.c $(PBKDF2_HMAC_ISA:%=obj/bridge_pbkdf2_hmac.%.NATIVE.o) $(HASHCAT_LIBRARY)
+	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(PBKDF2_HMAC_CFLAGS)
+else
+bridges/bridge_pbkdf2_hmac.$(BRIDGE_SUFFIX): src/bridges/bridge_pbkdf2_hmac.c src/cpu_features.c $(PBKDF2_HMAC_ISA:%=obj/bridge_pbkdf2_hmac.%.NATIVE.o) obj/combined.NATIVE.a
+	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(PBKDF2_HMAC_CFLAGS)
+endif
+endif
@@ -14,6 +14,58 @@
 #include "code/scrypt-jane-hash.h"
 #include "code/scrypt-jane-romix.h"
 
+#if defined (BRIDGE_ISA_DISPATCH)
+
+// without SCRYPT_CHOOSE_COMPILETIME scrypt-jane builds all of its ROMix variants,
+// see BRIDGE_ISA_DISPATCH in src/Makefile
+
+static scrypt_ROMixfn scrypt_ROMix_isa      = scrypt_ROMix_basic;
+static const char    *scrypt_ROMix_isa_name = "Basic";
+
+static void scrypt_ROMix_select ()
+{
+  #if defined (SCRYPT_SALSA_XOP)
+  if (cpu_supports_xop ())
+  {
+    scrypt_ROMix_isa      = scrypt_ROMix_xop;
+    scrypt_ROMix_isa_name = "XOP";
+
+    return;
+  }
+  #endif
+
+  #if defined (SCRYPT_SALSA_AVX)
+  if (cpu_supports_avx ())
+  {
+    scrypt_ROMix_isa      = scrypt_ROMix_avx;
+    scrypt_ROMix_isa_name = "AVX";
+
+    return;
+  }
+  #endif
+
+  #if defined (SCRYPT_SALSA_SSE2)
+  if (cpu_supports_sse2 ())
+  {
+    scrypt_ROMix_isa      = scrypt_ROMix_sse2;
+    scrypt_ROMix_isa_name = "SSE2";
+
+    return;
+  }
+  #endif
+}
+
+#else
+
+static scrypt_ROMixfn scrypt_ROMix_isa      = scrypt_ROMix;
+static const char    *scrypt_ROMix_isa_name = "native";
+
+static void scrypt_ROMix_select ()
+{
+}
+
+#endif
+
 // good: we can use this multiplier do reduce copy overhead to increase the guessing speed,
 // bad: but we also increase the password candidate batch size.
 // slow hashes which make use of this bridge probably are used with smaller wordlists,
@@ -82,8 +134,8 @@ static bool units_init (bridge_scrypt_jane_t *bridge_scrypt_jane)
     unit_t *unit_buf = &units_buf[i];
 
     unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
-      "%s",
-      "Scrypt-Jane ROMix");
+      "Scrypt-Jane ROMix, %s",
+      scrypt_ROMix_isa_name);
 
     unit_buf->unit_info_buf[unit_buf->unit_info_len] = 0;
 
@@ -112,6 +164,8 @@ void *platform_init (MAYBE_UNUSED user_options_t *user_options)
 
   if (cpu_chipset_test () == -1) return NULL;
 
+  scrypt_ROMix_select ();
+
   // Allocate platform context
 
   bridge_scrypt_jane_t *bridge_scrypt_jane = (bridge_scrypt_jane_t *) hcmalloc (sizeof (bridge_scrypt_jane_t));
@@ -254,7 +308,7 @@ bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_pa
 
     for (u32 i = 0; i < p; i++)
     {
-      scrypt_ROMix ((scrypt_mix_word_t *) (X + (chunk_bytes * i)), (scrypt_mix_word_t *) Y, (scrypt_mix_word_t *) V, N, r);
+      scrypt_ROMix_isa ((scrypt_mix_word_t *) (X + (chunk_bytes * i)), (scrypt_mix_word_t *) Y, (scrypt_mix_word_t *) V, N, r);
     }
 
     scrypt_tmp++;
@@ -1,7 +1,13 @@
 
 SCRYPT_JANE := deps/scrypt-jane-master
-SCRYPT_JANE_CFLAGS := -I$(SCRYPT_JANE)/ -DSCRYPT_SHA256 -DSCRYPT_SALSA -DSCRYPT_CHOOSE_COMPILETIME -Wno-unused-function -Wno-unused-but-set-variable
+SCRYPT_JANE_CFLAGS := -I$(SCRYPT_JANE)/ -DSCRYPT_SHA256 -DSCRYPT_SALSA -Wno-unused-function -Wno-unused-but-set-variable
 
+# scrypt-jane has its own ROMix variants for each ISA level, there's no need for BRIDGE_ISA_VARIANT
+
+ifeq ($(BRIDGE_ISA_DISPATCH),1)
+SCRYPT_JANE_CFLAGS += -DBRIDGE_ISA_DISPATCH
+else
+SCRYPT_JANE_CFLAGS += -DSCRYPT_CHOOSE_COMPILETIME
 ifeq ($(MAINTAINER_MODE),0)
 ifeq ($(BUILD_MODE),cross)
 SCRYPT_JANE_CFLAGS += -mavx2
@@ -21,6 +27,7 @@ endif
 endif
 endif
 endif
+endif
 
 ifeq ($(ENABLE_LTO),1)
 ifeq ($(BUILD_MODE),cross)
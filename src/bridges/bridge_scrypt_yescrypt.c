@@ -10,12 +10,72 @@
 #include "shared.h"
 #include "cpu_features.h"
 
+#if defined (BRIDGE_ISA)
+
+// one ISA variant of yescrypt-opt.c, see BRIDGE_ISA_DISPATCH in src/Makefile
+
+#define smix                   CPU_ISA_FN (smix)
+#define yescrypt_kdf           CPU_ISA_FN (yescrypt_kdf)
+#define yescrypt_init_shared   CPU_ISA_FN (yescrypt_init_shared)
+#define yescrypt_digest_shared CPU_ISA_FN (yescrypt_digest_shared)
+#define yescrypt_free_shared   CPU_ISA_FN (yescrypt_free_shared)
+#define yescrypt_init_local    CPU_ISA_FN (yescrypt_init_local)
+#define yescrypt_free_local    CPU_ISA_FN (yescrypt_free_local)
+
+#include "yescrypt-opt.c"
+
+#else
+
 #include "yescrypt.h"
 
-void smix(uint8_t *B, size_t r, uint32_t N, uint32_t p, uint32_t t,
-          yescrypt_flags_t flags,
-          void *V, uint32_t NROM, const void *VROM,
-          void *XY, uint8_t *S, uint8_t *passwd);
+typedef void smix_fn_t (uint8_t *B, size_t r, uint32_t N, uint32_t p, uint32_t t,
+                        yescrypt_flags_t flags,
+                        void *V, uint32_t NROM, const void *VROM,
+                        void *XY, uint8_t *S, uint8_t *passwd);
+
+#if defined (BRIDGE_ISA_DISPATCH)
+
+smix_fn_t smix_sse2;
+smix_fn_t smix_avx;
+smix_fn_t smix_xop;
+smix_fn_t smix_avx512;
+
+static smix_fn_t  *smix_isa      = smix_sse2;
+static const char *smix_isa_name = "SSE2";
+
+// same order of preference as the compile-time selection in yescrypt-opt.c
+
+static void smix_select ()
+{
+  if (cpu_supports_xop ())
+  {
+    smix_isa      = smix_xop;
+    smix_isa_name = "XOP";
+  }
+  else if (cpu_supports_avx512f () && cpu_supports_avx512vl ())
+  {
+    smix_isa      = smix_avx512;
+    smix_isa_name = "AVX512VL";
+  }
+  else if (cpu_supports_avx ())
+  {
+    smix_isa      = smix_avx;
+    smix_isa_name = "AVX";
+  }
+}
+
+#else
+
+smix_fn_t smix;
+
+static smix_fn_t  *smix_isa      = smix;
+static const char *smix_isa_name = "native";
+
+static void smix_select ()
+{
+}
+
+#endif
 
 // good: we can use this multiplier do reduce copy overhead to increase the guessing speed,
 // bad: but we also increase the password candidate batch size.
@@ -84,8 +144,8 @@ static bool units_init (bridge_scrypt_yescrypt_t *bridge_scrypt_yescrypt)
     unit_t *unit_buf = &units_buf[i];
 
     unit_buf->unit_info_len = snprintf (unit_buf->unit_info_buf, sizeof (unit_buf->unit_info_buf) - 1,
-      "%s",
-      "Scrypt-Yescrypt");
+      "Scrypt-Yescrypt, %s",
+      smix_isa_name);
 
     unit_buf->unit_info_buf[unit_buf->unit_info_len] = 0;
 
@@ -114,6 +174,8 @@ void *platform_init (MAYBE_UNUSED user_options_t *user_options)
 
   if (cpu_chipset_test () == -1) return NULL;
 
+  smix_select ();
+
   // Allocate platform context
 
   bridge_scrypt_yescrypt_t *bridge_scrypt_yescrypt = (bridge_scrypt_yescrypt_t *) hcmalloc (sizeof (bridge_scrypt_yescrypt_t));
@@ -245,7 +307,7 @@ bool launch_loop (MAYBE_UNUSED void *platform_context, MAYBE_UNUSED hc_device_pa
       // Same here: using constants allows the compiler to optimize away branches in smix(),
       // so there's no need to call smix1()/smix2() directly and unnecessarily complicate the code.
 
-      smix (B, salt_buf->scrypt_r, salt_buf->scrypt_N, 1, 0, 0, unit_buf->V, 0, NULL, unit_buf->XY, NULL, NULL);
+      smix_isa (B, salt_buf->scrypt_r, salt_buf->scrypt_N, 1, 0, 0, unit_buf->V, 0, NULL, unit_buf->XY, NULL, NULL);
 
       B += 128 * salt_buf->scrypt_r;
     }
@@ -275,3 +337,5 @@ void bridge_init (bridge_ctx_t *bridge_ctx)
   bridge_ctx->st_update_hash      = BRIDGE_DEFAULT;
   bridge_ctx->st_update_pass      = BRIDGE_DEFAULT;
 }
+
+#endif // BRIDGE_ISA
@@ -2,6 +2,14 @@
 SCRYPT_YESCRYPT := deps/yescrypt-master
 SCRYPT_YESCRYPT_CFLAGS := -I$(SCRYPT_YESCRYPT)/ -DSKIP_MEMZERO -Wno-cpp -Wno-type-limits
 
+SCRYPT_YESCRYPT_ISA :=
+SCRYPT_YESCRYPT_SRC := $(SCRYPT_YESCRYPT)/yescrypt-opt.c
+
+ifeq ($(BRIDGE_ISA_DISPATCH),1)
+SCRYPT_YESCRYPT_ISA := sse2 avx xop avx512
+SCRYPT_YESCRYPT_SRC :=
+SCRYPT_YESCRYPT_CFLAGS += -DBRIDGE_ISA_DISPATCH
+else
 ifeq ($(MAINTAINER_MODE),0)
 ifeq ($(BUILD_MODE),cross)
 SCRYPT_YESCRYPT_CFLAGS += -mavx2
@@ -21,18 +29,21 @@ endif
 endif
 endif
 endif
+endif
+
+$(foreach isa,$(SCRYPT_YESCRYPT_ISA),$(eval $(call BRIDGE_ISA_VARIANT,scrypt_yescrypt,$(isa),SCRYPT_YESCRYPT_CFLAGS)))
 
 ifeq ($(BUILD_MODE),cross)
-bridges/bridge_scrypt_yescrypt.so:  src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT)/yescrypt-opt.c $(SCRYPT_YESCRYPT)/sha256.c obj/combined.LINUX.a
+bridges/bridge_scrypt_yescrypt.so:  src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT_SRC) $(SCRYPT_YESCRYPT_ISA:%=obj/bridge_scrypt_yescrypt.%.LINUX.o) $(SCRYPT_YESCRYPT)/sha256.c obj/combined.LINUX.a
 	$(CC_LINUX) $(CCFLAGS) $(CFLAGS_CROSS_LINUX)  $^ -o $@ $(LFLAGS_CROSS_LINUX) -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(SCRYPT_YESCRYPT_CFLAGS)
-bridges/bridge_scrypt_yescrypt.dll: src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT)/yescrypt-opt.c $(SCRYPT_YESCRYPT)/sha256.c obj/combined.WIN.a
+bridges/bridge_scrypt_yescrypt.dll: src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT_SRC) $(SCRYPT_YESCRYPT_ISA:%=obj/bridge_scrypt_yescrypt.%.WIN.o) $(SCRYPT_YESCRYPT)/sha256.c obj/combined.WIN.a
 	$(CC_WIN)   $(CCFLAGS) $(CFLAGS_CROSS_WIN)    $^ -o $@ $(LFLAGS_CROSS_WIN)   -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(SCRYPT_YESCRYPT_CFLAGS)
 else
 ifeq ($(SHARED),1)
-bridges/bridge_scrypt_yescrypt.$(BRIDGE_SUFFIX): src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT)/yescrypt-opt.c $(SCRYPT_YESCRYPT)/sha256.c $(HASHCAT_LIBRARY)
+bridges/bridge_scrypt_yescrypt.$(BRIDGE_SUFFIX): src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT_SRC) $(SCRYPT_YESCRYPT_ISA:%=obj/bridge_scrypt_yescrypt.%.NATIVE.o) $(SCRYPT_YESCRYPT)/sha256.c $(HASHCAT_LIBRARY)
 	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(SCRYPT_YESCRYPT_CFLAGS)
 else
-bridges/bridge_scrypt_yescrypt.$(BRIDGE_SUFFIX): src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT)/yescrypt-opt.c $(SCRYPT_YESCRYPT)/sha256.c obj/combined.NATIVE.a
+bridges/bridge_scrypt_yescrypt.$(BRIDGE_SUFFIX): src/bridges/bridge_scrypt_yescrypt.c src/cpu_features.c $(SCRYPT_YESCRYPT_SRC) $(SCRYPT_YESCRYPT_ISA:%=obj/bridge_scrypt_yescrypt.%.NATIVE.o) $(SCRYPT_YESCRYPT)/sha256.c obj/combined.NATIVE.a
 	$(CC)       $(CCFLAGS) $(CFLAGS_NATIVE)       $^ -o $@ $(LFLAGS_NATIVE)      -shared -fPIC -D BRIDGE_INTERFACE_VERSION_CURRENT=$(BRIDGE_INTERFACE_VERSION) $(SCRYPT_YESCRYPT_CFLAGS)
 endif
 endif
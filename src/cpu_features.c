@@ -12,6 +12,7 @@
 int cpu_supports_sse2 ()     { return 1; }
 int cpu_supports_ssse3 ()    { return 0; }
 int cpu_supports_xop ()      { return 0; }
+int cpu_supports_avx ()      { return 0; }
 int cpu_supports_avx2 ()     { return 0; }
 int cpu_supports_avx512f ()  { return 0; }
 int cpu_supports_avx512vl () { return 0; }
@@ -69,6 +70,20 @@ int cpu_supports_xop ()
   return (ecx & (1 << 11)) != 0; // No macro for XOP
 }
 
+int cpu_supports_avx ()
+{
+  u32 eax, ebx, ecx, edx;
+
+  cpuid (1, 0, &eax, &ebx, &ecx, &edx);
+
+  if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+  {
+    return 0;
+  }
+
+  return (xgetbv(0) & 0x6) == 0x6; // XMM and YMM state
+}
+
 int cpu_supports_avx2 ()
 {
   u32 eax, ebx, ecx, edx;
@@ -138,6 +153,7 @@ int cpu_supports_avx512vl ()
 int cpu_supports_sse2 ()     { return 0; }
 int cpu_supports_ssse3 ()    { return 0; }
 int cpu_supports_xop ()      { return 0; }
+int cpu_supports_avx ()      { return 0; }
 int cpu_supports_avx2 ()     { return 0; }
 int cpu_supports_avx512f ()  { return 0; }
 int cpu_supports_avx512vl () { return 0; }
@@ -173,6 +189,15 @@ int cpu_chipset_test ()
   }
   #endif
 
+  #ifdef __AVX__
+  if (cpu_supports_avx () == 0)
+  {
+    fprintf (stderr, "ERROR: Compiled with AVX but CPU does not support it.\n");
+
+    return -1;
+  }
+  #endif
+
   #ifdef __AVX2__
   if (cpu_supports_avx2 () == 0)
   {
@@ -0,0 +1,259 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "locking.h"
+#include "thread.h"
+#include "outfile.h"
+#include "potfile.h"
+#include "crack_sink.h"
+
+int crack_sink_init (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_sink_ctx_t *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+  user_options_t   *user_options   = hashcat_ctx->user_options;
+
+  crack_sink_ctx->enabled = false;
+
+  if (user_options->crack_sink_async == false) return 0;
+
+  if (user_options->benchmark     == true) return 0;
+  if (user_options->hash_info     == true) return 0;
+  if (user_options->keyspace      == true) return 0;
+  if (user_options->left          == true) return 0;
+  if (user_options->show          == true) return 0;
+  if (user_options->stdout_flag   == true) return 0;
+  if (user_options->speed_only    == true) return 0;
+  if (user_options->progress_only == true) return 0;
+  if (user_options->usage         >  0)    return 0;
+  if (user_options->version       == true) return 0;
+
+  crack_sink_ctx->enabled = true;
+
+  crack_sink_ctx->queue = (crack_sink_entry_t *) hccalloc (CRACK_SINK_QUEUE_INCR, sizeof (crack_sink_entry_t));
+  crack_sink_ctx->batch = (crack_sink_entry_t *) hccalloc (CRACK_SINK_QUEUE_INCR, sizeof (crack_sink_entry_t));
+
+  crack_sink_ctx->queue_cnt   = 0;
+  crack_sink_ctx->queue_alloc = CRACK_SINK_QUEUE_INCR;
+  crack_sink_ctx->batch_alloc = CRACK_SINK_QUEUE_INCR;
+
+  hc_thread_mutex_init (crack_sink_ctx->mux_queue);
+  hc_thread_mutex_init (crack_sink_ctx->mux_write);
+
+  return 0;
+}
+
+void crack_sink_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_sink_ctx_t *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+
+  if (crack_sink_ctx->enabled == false) return;
+
+  // the writer thread did the final flush before the potfile was closed, anything left here is lost
+
+  for (u32 queue_idx = 0; queue_idx < crack_sink_ctx->queue_cnt; queue_idx++)
+  {
+    hcfree (crack_sink_ctx->queue[queue_idx].buf);
+  }
+
+  hc_thread_mutex_delete (crack_sink_ctx->mux_queue);
+  hc_thread_mutex_delete (crack_sink_ctx->mux_write);
+
+  hcfree (crack_sink_ctx->queue);
+  hcfree (crack_sink_ctx->batch);
+
+  memset (crack_sink_ctx, 0, sizeof (crack_sink_ctx_t));
+}
+
+// the file access happens without mux_display, device threads take it in check_cracked ()
+// only the cracked events are sent under it, while the outfile is still open, same as in check_hash ()
+// lock order is mux_write, then mux_queue or mux_display, pushers only take mux_queue under mux_display
+
+static void crack_sink_write_batch (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_sink_ctx_t *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+  outfile_ctx_t    *outfile_ctx    = hashcat_ctx->outfile_ctx;
+  potfile_ctx_t    *potfile_ctx    = hashcat_ctx->potfile_ctx;
+  status_ctx_t     *status_ctx     = hashcat_ctx->status_ctx;
+
+  // mux_write keeps batches in order if the final flush races with the writer thread
+
+  hc_thread_mutex_lock (crack_sink_ctx->mux_write);
+
+  hc_thread_mutex_lock (crack_sink_ctx->mux_queue);
+
+  crack_sink_entry_t *batch = crack_sink_ctx->queue;
+
+  const u32 batch_cnt   = crack_sink_ctx->queue_cnt;
+  const u32 batch_alloc = crack_sink_ctx->queue_alloc;
+
+  crack_sink_ctx->queue       = crack_sink_ctx->batch;
+  crack_sink_ctx->queue_cnt   = 0;
+  crack_sink_ctx->queue_alloc = crack_sink_ctx->batch_alloc;
+
+  crack_sink_ctx->batch       = batch;
+  crack_sink_ctx->batch_alloc = batch_alloc;
+
+  hc_thread_mutex_unlock (crack_sink_ctx->mux_queue);
+
+  if (batch_cnt > 0)
+  {
+    // outfile, one open, lock and close for the whole batch
+
+    outfile_write_open (hashcat_ctx);
+
+    if (outfile_ctx->fp.pfp != NULL)
+    {
+      for (u32 batch_idx = 0; batch_idx < batch_cnt; batch_idx++)
+      {
+        const crack_sink_entry_t *entry = batch + batch_idx;
+
+        hc_fwrite (entry->buf, entry->out_len, 1, &outfile_ctx->fp);
+
+        hc_fwrite (EOL, strlen (EOL), 1, &outfile_ctx->fp);
+      }
+    }
+
+    // potfile, one lock and flush for the whole batch
+    // pot_len is 0 for all entries if the potfile is disabled
+
+    bool locked = false;
+
+    for (u32 batch_idx = 0; batch_idx < batch_cnt; batch_idx++)
+    {
+      const crack_sink_entry_t *entry = batch + batch_idx;
+
+      if (entry->pot_len == 0) continue;
+
+      if (locked == false)
+      {
+        hc_lockfile (&potfile_ctx->fp);
+
+        locked = true;
+      }
+
+      hc_fwrite (entry->buf + entry->out_len, entry->pot_len, 1, &potfile_ctx->fp);
+
+      hc_fwrite (EOL, strlen (EOL), 1, &potfile_ctx->fp);
+    }
+
+    if (locked == true)
+    {
+      hc_fflush (&potfile_ctx->fp);
+
+      if (hc_unlockfile (&potfile_ctx->fp))
+      {
+        event_log_error (hashcat_ctx, "%s: Failed to unlock file.", potfile_ctx->filename);
+      }
+    }
+
+    // the event handler checks the outfile fp to decide if the line still has to go to stdout
+
+    hc_thread_mutex_lock (status_ctx->mux_display);
+
+    for (u32 batch_idx = 0; batch_idx < batch_cnt; batch_idx++)
+    {
+      const crack_sink_entry_t *entry = batch + batch_idx;
+
+      EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, entry->buf, entry->out_len);
+    }
+
+    hc_thread_mutex_unlock (status_ctx->mux_display);
+
+    outfile_write_close (hashcat_ctx);
+
+    for (u32 batch_idx = 0; batch_idx < batch_cnt; batch_idx++)
+    {
+      hcfree (batch[batch_idx].buf);
+    }
+  }
+
+  hc_thread_mutex_unlock (crack_sink_ctx->mux_write);
+}
+
+int crack_sink_push (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, const char *pot_buf, const int pot_len, const u8 *plain_ptr, const u32 plain_len)
+{
+  crack_sink_ctx_t   *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+  const hashconfig_t *hashconfig     = hashcat_ctx->hashconfig;
+  potfile_ctx_t      *potfile_ctx    = hashcat_ctx->potfile_ctx;
+
+  // the potfile line is built here, the caller holds mux_display so potfile_ctx->tmp_buf is ours
+
+  int tmp_len = 0;
+
+  if ((potfile_ctx->enabled == true) && (hashconfig->potfile_disable == false))
+  {
+    tmp_len = potfile_format_line (hashcat_ctx, pot_buf, pot_len, plain_ptr, plain_len, potfile_ctx->tmp_buf);
+  }
+
+  char *buf = (char *) hcmalloc (out_len + tmp_len + 1);
+
+  memcpy (buf,           out_buf,               out_len);
+  memcpy (buf + out_len, potfile_ctx->tmp_buf,  tmp_len);
+
+  // we can't wait for the writer, it needs mux_display which our caller holds, so the queue grows instead
+  // it can't hold more than the hashes cracked between two writer runs
+
+  hc_thread_mutex_lock (crack_sink_ctx->mux_queue);
+
+  if (crack_sink_ctx->queue_cnt == crack_sink_ctx->queue_alloc)
+  {
+    crack_sink_ctx->queue = (crack_sink_entry_t *) hcrealloc (crack_sink_ctx->queue, crack_sink_ctx->queue_alloc * sizeof (crack_sink_entry_t), CRACK_SINK_QUEUE_INCR * sizeof (crack_sink_entry_t));
+
+    crack_sink_ctx->queue_alloc += CRACK_SINK_QUEUE_INCR;
+  }
+
+  crack_sink_entry_t *entry = crack_sink_ctx->queue + crack_sink_ctx->queue_cnt;
+
+  entry->buf     = buf;
+  entry->out_len = out_len;
+  entry->pot_len = tmp_len;
+
+  crack_sink_ctx->queue_cnt++;
+
+  hc_thread_mutex_unlock (crack_sink_ctx->mux_queue);
+
+  return 0;
+}
+
+void crack_sink_flush (hashcat_ctx_t *hashcat_ctx)
+{
+  crack_sink_ctx_t *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+
+  if (crack_sink_ctx->enabled == false) return;
+
+  crack_sink_write_batch (hashcat_ctx);
+}
+
+#if defined (_WIN32) || defined (__WIN32__)
+HC_API_CALL DWORD thread_crack_sink (void *p)
+#else
+HC_API_CALL void *thread_crack_sink (void *p)
+#endif
+{
+  hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) p;
+
+  crack_sink_ctx_t *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+  status_ctx_t     *status_ctx     = hashcat_ctx->status_ctx;
+
+  if (crack_sink_ctx->enabled == false) return 0;
+
+  while (status_ctx->shutdown_inner == false)
+  {
+    usleep (CRACK_SINK_SLEEP_US);
+
+    crack_sink_flush (hashcat_ctx);
+  }
+
+  // whatever was queued before the stop request
+
+  crack_sink_flush (hashcat_ctx);
+
+  return 0;
+}
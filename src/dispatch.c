@@ -14,10 +14,13 @@
 #include "filehandling.h"
 #include "rp.h"
 #include "rp_cpu.h"
+#include "mpsp.h"
 #include "slow_candidates.h"
 #include "dispatch.h"
 #include "generic.h"
 #include "convert.h"
+#include "loopback.h"
+#include "status.h"
 
 #ifdef WITH_BRAIN
 #include "brain.h"
@@ -150,7 +153,6 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
   user_options_t       *user_options       = hashcat_ctx->user_options;
   user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
   hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
-  hashes_t             *hashes             = hashcat_ctx->hashes;
   straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
   status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
 
@@ -296,10 +298,7 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
     {
       hc_thread_mutex_lock (status_ctx->mux_counter);
 
-      for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-      {
-        status_ctx->words_progress_rejected[salt_pos] += words_extra_total * straight_ctx->kernel_rules_cnt;
-      }
+      status_progress_add_rejected_all (hashcat_ctx, words_extra_total * straight_ctx->kernel_rules_cnt);
 
       hc_thread_mutex_unlock (status_ctx->mux_counter);
     }
@@ -413,12 +412,85 @@ HC_API_CALL void *thread_calc_stdin (void *p)
   return 0;
 }
 
+// the flush of the slow candidates paths, it runs the collected batch on the device and commits it to the brain
+
+static int calc_flush (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, MAYBE_UNUSED const bool pending)
+{
+  MAYBE_UNUSED user_options_t *user_options = hashcat_ctx->user_options;
+  MAYBE_UNUSED status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
+
+  const u64 pws_cnt = device_param->pws_cnt;
+
+  if (run_copy    (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
+  if (run_cracker (hashcat_ctx, device_param, -1, pws_cnt) == -1) return -1;
+
+  #ifdef WITH_BRAIN
+  if (user_options->brain_client == true)
+  {
+    if ((status_ctx->devices_status != STATUS_ABORTED)
+     && (status_ctx->devices_status != STATUS_ABORTED_RUNTIME)
+     && (status_ctx->devices_status != STATUS_QUIT)
+     && (status_ctx->devices_status != STATUS_BYPASS)
+     && (status_ctx->devices_status != STATUS_ERROR))
+    {
+      bool rc_commit = false;
+
+      if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_PIPELINE)
+      {
+        // a pending batch is the one before the batch whose lookup is in flight
+
+        const u32 batch = (pending == true) ? device_param->brain_link_batch - 1 : device_param->brain_link_batch;
+
+        rc_commit = brain_client_commit_batch (device_param, status_ctx, batch);
+      }
+      else
+      {
+        rc_commit = brain_client_commit (device_param, status_ctx);
+      }
+
+      if (rc_commit == false)
+      {
+        brain_client_disconnect (device_param);
+      }
+    }
+  }
+  #endif
+
+  device_param->pws_cnt      = 0;
+  device_param->pws_base_cnt = 0;
+
+  return 0;
+}
+
+#ifdef WITH_BRAIN
+static int calc_flush_pending (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_fin)
+{
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  if (calc_flush (hashcat_ctx, device_param, true) == -1) return -1;
+
+  memset (device_param->pws_comp,     0, device_param->size_pws_comp);
+  memset (device_param->pws_idx,      0, device_param->size_pws_idx);
+  memset (device_param->pws_base_buf, 0, device_param->size_pws_base);
+
+  // the restore point only moves once the batch has actually run
+
+  if (status_ctx->run_thread_level2 == true)
+  {
+    device_param->words_done = MAX (device_param->words_done, words_fin);
+
+    status_ctx->words_cur = get_highest_words_done (hashcat_ctx);
+  }
+
+  return 0;
+}
+#endif
+
 static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 {
   user_options_t       *user_options       = hashcat_ctx->user_options;
   user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
   hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
-  hashes_t             *hashes             = hashcat_ctx->hashes;
   mask_ctx_t           *mask_ctx           = hashcat_ctx->mask_ctx;
   straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
   combinator_ctx_t     *combinator_ctx     = hashcat_ctx->combinator_ctx;
@@ -435,13 +507,20 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
     const u32 brain_session = user_options->brain_session;
     const u32 brain_attack  = user_options->brain_attack;
 
+    const bool brain_pipeline = (user_options->brain_client == true) && (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_PIPELINE);
+
+    bool brain_pending     = false;
+    u64  brain_pending_fin = 0;
+
     u64 highest = 0;
 
     brain_client_disconnect (device_param);
 
     if (user_options->brain_client == true)
     {
-      const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel;
+      // in pipelined mode the short-term memory on the server holds the pending and the next batch
+
+      const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel * ((brain_pipeline == true) ? 2 : 1);
 
       if (brain_client_connect (device_param, status_ctx, user_options->brain_host, user_options->brain_port, user_options->brain_password, brain_session, brain_attack, passwords_max, &highest) == false)
       {
@@ -456,10 +535,11 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           status_ctx->words_off = highest;
 
-          for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-          {
-            status_ctx->words_progress_rejected[salt_pos] = status_ctx->words_off;
-          }
+          hc_thread_mutex_lock (status_ctx->mux_counter);
+
+          status_progress_set_rejected_all (hashcat_ctx, status_ctx->words_off);
+
+          hc_thread_mutex_unlock (status_ctx->mux_counter);
         }
 
         hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
@@ -507,9 +587,24 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
       {
         u64 words_fin = 0;
 
-        memset (device_param->pws_comp,     0, device_param->size_pws_comp);
-        memset (device_param->pws_idx,      0, device_param->size_pws_idx);
-        memset (device_param->pws_base_buf, 0, device_param->size_pws_base);
+        // a pending batch still owns the buffers, they are cleared once it's flushed
+
+        if (device_param->pws_cnt == 0)
+        {
+          memset (device_param->pws_comp,     0, device_param->size_pws_comp);
+          memset (device_param->pws_idx,      0, device_param->size_pws_idx);
+          memset (device_param->pws_base_buf, 0, device_param->size_pws_base);
+        }
+
+        #ifdef WITH_BRAIN
+        if (brain_pipeline == true)
+        {
+          if (brain_client_batch (device_param, status_ctx) == false)
+          {
+            brain_client_disconnect (device_param);
+          }
+        }
+        #endif
 
         u64 pre_rejects = -1;
 
@@ -542,7 +637,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             {
               if (device_param->brain_link_client_fd == -1)
               {
-                const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel;
+                const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel * ((brain_pipeline == true) ? 2 : 1);
 
                 if (brain_client_connect (device_param, status_ctx, user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session, user_options->brain_attack, passwords_max, &highest) == false)
                 {
@@ -617,7 +712,40 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           #ifdef WITH_BRAIN
           if (user_options->brain_client == true)
           {
-            if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+            if (brain_pipeline == true)
+            {
+              if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+              {
+                if (brain_client_lookup_send (device_param, status_ctx) == false)
+                {
+                  brain_client_disconnect (device_param);
+                }
+              }
+
+              if (brain_pending == true)
+              {
+                brain_pending = false;
+
+                if (calc_flush_pending (hashcat_ctx, device_param, brain_pending_fin) == -1)
+                {
+                  hc_fclose (&extra_info_straight.fp);
+
+                  hcfree (hashcat_ctx_tmp->wl_data);
+                  hcfree (hashcat_ctx_tmp);
+
+                  return -1;
+                }
+              }
+
+              if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+              {
+                if (brain_client_lookup_recv (device_param, status_ctx) == false)
+                {
+                  brain_client_disconnect (device_param);
+                }
+              }
+            }
+            else if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
             {
               if (brain_client_lookup (device_param, status_ctx) == false)
               {
@@ -677,10 +805,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           {
             hc_thread_mutex_lock (status_ctx->mux_counter);
 
-            for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total;
-            }
+            status_progress_add_rejected_all (hashcat_ctx, words_extra_total);
 
             hc_thread_mutex_unlock (status_ctx->mux_counter);
           }
@@ -692,19 +817,21 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
         const u64 pws_cnt = device_param->pws_cnt;
 
-        if (pws_cnt)
-        {
-          if (run_copy (hashcat_ctx, device_param, pws_cnt) == -1)
-          {
-            hc_fclose (&extra_info_straight.fp);
+        #ifdef WITH_BRAIN
+        // keep the batch, it runs on the device while the lookup of the next batch is in flight
 
-            hcfree (hashcat_ctx_tmp->wl_data);
-            hcfree (hashcat_ctx_tmp);
+        if ((brain_pipeline == true) && (pws_cnt > 0) && (words_fin > 0) && (status_ctx->run_thread_level1 == true) && (device_param->speed_only_finish == false))
+        {
+          brain_pending     = true;
+          brain_pending_fin = words_fin;
 
-            return -1;
-          }
+          continue;
+        }
+        #endif
 
-          if (run_cracker (hashcat_ctx, device_param, -1, pws_cnt) == -1)
+        if (pws_cnt)
+        {
+          if (calc_flush (hashcat_ctx, device_param, false) == -1)
           {
             hc_fclose (&extra_info_straight.fp);
 
@@ -713,26 +840,6 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
             return -1;
           }
-
-          #ifdef WITH_BRAIN
-          if (user_options->brain_client == true)
-          {
-            if ((status_ctx->devices_status != STATUS_ABORTED)
-             && (status_ctx->devices_status != STATUS_ABORTED_RUNTIME)
-             && (status_ctx->devices_status != STATUS_QUIT)
-             && (status_ctx->devices_status != STATUS_BYPASS)
-             && (status_ctx->devices_status != STATUS_ERROR))
-            {
-              if (brain_client_commit (device_param, status_ctx) == false)
-              {
-                brain_client_disconnect (device_param);
-              }
-            }
-          }
-          #endif
-
-          device_param->pws_cnt      = 0;
-          device_param->pws_base_cnt = 0;
         }
 
         if (device_param->speed_only_finish == true) break;
@@ -819,9 +926,24 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
       {
         u64 words_fin = 0;
 
-        memset (device_param->pws_comp,     0, device_param->size_pws_comp);
-        memset (device_param->pws_idx,      0, device_param->size_pws_idx);
-        memset (device_param->pws_base_buf, 0, device_param->size_pws_base);
+        // a pending batch still owns the buffers, they are cleared once it's flushed
+
+        if (device_param->pws_cnt == 0)
+        {
+          memset (device_param->pws_comp,     0, device_param->size_pws_comp);
+          memset (device_param->pws_idx,      0, device_param->size_pws_idx);
+          memset (device_param->pws_base_buf, 0, device_param->size_pws_base);
+        }
+
+        #ifdef WITH_BRAIN
+        if (brain_pipeline == true)
+        {
+          if (brain_client_batch (device_param, status_ctx) == false)
+          {
+            brain_client_disconnect (device_param);
+          }
+        }
+        #endif
 
         u64 pre_rejects = -1;
 
@@ -856,7 +978,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             {
               if (device_param->brain_link_client_fd == -1)
               {
-                const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel;
+                const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel * ((brain_pipeline == true) ? 2 : 1);
 
                 if (brain_client_connect (device_param, status_ctx, user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session, user_options->brain_attack, passwords_max, &highest) == false)
                 {
@@ -929,7 +1051,41 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           #ifdef WITH_BRAIN
           if (user_options->brain_client == true)
           {
-            if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+            if (brain_pipeline == true)
+            {
+              if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+              {
+                if (brain_client_lookup_send (device_param, status_ctx) == false)
+                {
+                  brain_client_disconnect (device_param);
+                }
+              }
+
+              if (brain_pending == true)
+              {
+                brain_pending = false;
+
+                if (calc_flush_pending (hashcat_ctx, device_param, brain_pending_fin) == -1)
+                {
+                  hc_fclose (&extra_info_combi.base_fp);
+                  hc_fclose (&extra_info_combi.combs_fp);
+
+                  hcfree (hashcat_ctx_tmp->wl_data);
+                  hcfree (hashcat_ctx_tmp);
+
+                  return -1;
+                }
+              }
+
+              if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+              {
+                if (brain_client_lookup_recv (device_param, status_ctx) == false)
+                {
+                  brain_client_disconnect (device_param);
+                }
+              }
+            }
+            else if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
             {
               if (brain_client_lookup (device_param, status_ctx) == false)
               {
@@ -989,10 +1145,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           {
             hc_thread_mutex_lock (status_ctx->mux_counter);
 
-            for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total;
-            }
+            status_progress_add_rejected_all (hashcat_ctx, words_extra_total);
 
             hc_thread_mutex_unlock (status_ctx->mux_counter);
           }
@@ -1004,20 +1157,21 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
         const u64 pws_cnt = device_param->pws_cnt;
 
-        if (pws_cnt)
-        {
-          if (run_copy (hashcat_ctx, device_param, pws_cnt) == -1)
-          {
-            hc_fclose (&extra_info_combi.base_fp);
-            hc_fclose (&extra_info_combi.combs_fp);
+        #ifdef WITH_BRAIN
+        // keep the batch, it runs on the device while the lookup of the next batch is in flight
 
-            hcfree (hashcat_ctx_tmp->wl_data);
-            hcfree (hashcat_ctx_tmp);
+        if ((brain_pipeline == true) && (pws_cnt > 0) && (words_fin > 0) && (status_ctx->run_thread_level1 == true) && (device_param->speed_only_finish == false))
+        {
+          brain_pending     = true;
+          brain_pending_fin = words_fin;
 
-            return -1;
-          }
+          continue;
+        }
+        #endif
 
-          if (run_cracker (hashcat_ctx, device_param, -1, pws_cnt) == -1)
+        if (pws_cnt)
+        {
+          if (calc_flush (hashcat_ctx, device_param, false) == -1)
           {
             hc_fclose (&extra_info_combi.base_fp);
             hc_fclose (&extra_info_combi.combs_fp);
@@ -1027,26 +1181,6 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
             return -1;
           }
-
-          #ifdef WITH_BRAIN
-          if (user_options->brain_client == true)
-          {
-            if ((status_ctx->devices_status != STATUS_ABORTED)
-             && (status_ctx->devices_status != STATUS_ABORTED_RUNTIME)
-             && (status_ctx->devices_status != STATUS_QUIT)
-             && (status_ctx->devices_status != STATUS_BYPASS)
-             && (status_ctx->devices_status != STATUS_ERROR))
-            {
-              if (brain_client_commit (device_param, status_ctx) == false)
-              {
-                brain_client_disconnect (device_param);
-              }
-            }
-          }
-          #endif
-
-          device_param->pws_cnt      = 0;
-          device_param->pws_base_cnt = 0;
         }
 
         if (device_param->speed_only_finish == true) break;
@@ -1085,8 +1219,23 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
       {
         u64 words_fin = 0;
 
-        memset (device_param->pws_comp, 0, device_param->size_pws_comp);
-        memset (device_param->pws_idx,  0, device_param->size_pws_idx);
+        // a pending batch still owns the buffers, they are cleared once it's flushed
+
+        if (device_param->pws_cnt == 0)
+        {
+          memset (device_param->pws_comp, 0, device_param->size_pws_comp);
+          memset (device_param->pws_idx,  0, device_param->size_pws_idx);
+        }
+
+        #ifdef WITH_BRAIN
+        if (brain_pipeline == true)
+        {
+          if (brain_client_batch (device_param, status_ctx) == false)
+          {
+            brain_client_disconnect (device_param);
+          }
+        }
+        #endif
 
         u64 pre_rejects = -1;
 
@@ -1121,7 +1270,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             {
               if (device_param->brain_link_client_fd == -1)
               {
-                const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel;
+                const i64 passwords_max = device_param->hardware_power * device_param->kernel_accel * ((brain_pipeline == true) ? 2 : 1);
 
                 if (brain_client_connect (device_param, status_ctx, user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session, user_options->brain_attack, passwords_max, &highest) == false)
                 {
@@ -1184,7 +1333,32 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           #ifdef WITH_BRAIN
           if (user_options->brain_client == true)
           {
-            if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+            if (brain_pipeline == true)
+            {
+              if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+              {
+                if (brain_client_lookup_send (device_param, status_ctx) == false)
+                {
+                  brain_client_disconnect (device_param);
+                }
+              }
+
+              if (brain_pending == true)
+              {
+                brain_pending = false;
+
+                if (calc_flush_pending (hashcat_ctx, device_param, brain_pending_fin) == -1) return -1;
+              }
+
+              if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
+              {
+                if (brain_client_lookup_recv (device_param, status_ctx) == false)
+                {
+                  brain_client_disconnect (device_param);
+                }
+              }
+            }
+            else if (user_options->brain_client_features & BRAIN_CLIENT_FEATURE_HASHES)
             {
               if (brain_client_lookup (device_param, status_ctx) == false)
               {
@@ -1238,10 +1412,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
           {
             hc_thread_mutex_lock (status_ctx->mux_counter);
 
-            for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total;
-            }
+            status_progress_add_rejected_all (hashcat_ctx, words_extra_total);
 
             hc_thread_mutex_unlock (status_ctx->mux_counter);
           }
@@ -1253,29 +1424,21 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
         const u64 pws_cnt = device_param->pws_cnt;
 
-        if (pws_cnt)
+        #ifdef WITH_BRAIN
+        // keep the batch, it runs on the device while the lookup of the next batch is in flight
+
+        if ((brain_pipeline == true) && (pws_cnt > 0) && (words_fin > 0) && (status_ctx->run_thread_level1 == true) && (device_param->speed_only_finish == false))
         {
-          if (run_copy    (hashcat_ctx, device_param, pws_cnt) == -1) return -1;
-          if (run_cracker (hashcat_ctx, device_param, -1, pws_cnt) == -1) return -1;
+          brain_pending     = true;
+          brain_pending_fin = words_fin;
 
-          #ifdef WITH_BRAIN
-          if (user_options->brain_client == true)
-          {
-            if ((status_ctx->devices_status != STATUS_ABORTED)
-             && (status_ctx->devices_status != STATUS_ABORTED_RUNTIME)
-             && (status_ctx->devices_status != STATUS_QUIT)
-             && (status_ctx->devices_status != STATUS_BYPASS)
-             && (status_ctx->devices_status != STATUS_ERROR))
-            {
-              if (brain_client_commit (device_param, status_ctx) == false)
-              {
-                brain_client_disconnect (device_param);
-              }
-            }
-          }
-          #endif
+          continue;
+        }
+        #endif
 
-          device_param->pws_cnt = 0;
+        if (pws_cnt)
+        {
+          if (calc_flush (hashcat_ctx, device_param, false) == -1) return -1;
         }
 
         if (device_param->speed_only_finish == true) break;
@@ -1506,10 +1669,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           hc_thread_mutex_lock (status_ctx->mux_counter);
 
-          for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-          {
-            status_ctx->words_progress_rejected[salt_pos] += words_extra_total * straight_ctx->kernel_rules_cnt;
-          }
+          status_progress_add_rejected_all (hashcat_ctx, words_extra_total * straight_ctx->kernel_rules_cnt);
 
           hc_thread_mutex_unlock (status_ctx->mux_counter);
         }
@@ -1626,6 +1786,13 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
       u64 words_cur = 0;
 
+      // --loopback-live: with new plains waiting, leave room for them in this batch
+
+      const bool loopback_live = (hashcat_ctx->loopback_ctx->live == true) && (attack_kern == ATTACK_KERN_STRAIGHT) && (attack_mode != ATTACK_MODE_ASSOCIATION);
+
+      u8 loopback_buf[PW_MAX];
+      u32 loopback_len = 0;
+
       while (status_ctx->run_thread_level1 == true)
       {
         u64 words_off = 0;
@@ -1633,6 +1800,13 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         u64 words_extra = -1U;
         u64 words_extra_total = 0;
 
+        if (loopback_live == true)
+        {
+          const u64 loopback_reserve = MIN ((u64) loopback_live_count (hashcat_ctx), device_param->kernel_power / 2);
+
+          if (loopback_reserve > 0) words_extra = device_param->kernel_power - loopback_reserve;
+        }
+
         memset (device_param->pws_comp, 0, device_param->size_pws_comp);
         memset (device_param->pws_idx,  0, device_param->size_pws_idx);
 
@@ -1755,21 +1929,55 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           hc_thread_mutex_lock (status_ctx->mux_counter);
 
-          for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+          if (attack_kern == ATTACK_KERN_STRAIGHT)
           {
-            if (attack_kern == ATTACK_KERN_STRAIGHT)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total * straight_ctx->kernel_rules_cnt;
-            }
-            else if (attack_kern == ATTACK_KERN_COMBI)
-            {
-              status_ctx->words_progress_rejected[salt_pos] += words_extra_total * combinator_ctx->combs_cnt;
-            }
+            status_progress_add_rejected_all (hashcat_ctx, words_extra_total * straight_ctx->kernel_rules_cnt);
+          }
+          else if (attack_kern == ATTACK_KERN_COMBI)
+          {
+            status_progress_add_rejected_all (hashcat_ctx, words_extra_total * combinator_ctx->combs_cnt);
           }
 
           hc_thread_mutex_unlock (status_ctx->mux_counter);
         }
 
+        // fill the free slots with new plains, they get the same -j rule and the kernel applies all rules
+
+        device_param->pws_loopback_cnt = 0;
+
+        if (loopback_live == true)
+        {
+          while (device_param->pws_cnt < device_param->kernel_power)
+          {
+            if (loopback_live_pop (hashcat_ctx, loopback_buf, &loopback_len) == false) break;
+
+            char *line_buf = (char *) loopback_buf;
+            u32   line_len = loopback_len;
+
+            char rule_buf_out[RP_PASSWORD_SIZE];
+
+            if (run_rule_engine ((int) user_options_extra->rule_len_l, user_options->rule_buf_l))
+            {
+              if (line_len >= RP_PASSWORD_SIZE) continue;
+
+              memset (rule_buf_out, 0, sizeof (rule_buf_out));
+
+              const int rule_len_out = _old_apply_rule (user_options->rule_buf_l, (int) user_options_extra->rule_len_l, line_buf, (int) line_len, rule_buf_out);
+
+              if (rule_len_out < 0) continue;
+
+              line_buf = rule_buf_out;
+              line_len = (u32) rule_len_out;
+            }
+
+            if ((line_len < hashconfig->pw_min) || (line_len > hashconfig->pw_max)) continue;
+
+            pw_add (device_param, (const u8 *) line_buf, (const int) line_len);
+
+            device_param->pws_loopback_cnt++;
+          }
+        }
+
         //
         // flush
         //
@@ -1804,6 +2012,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
           device_param->pws_cnt = 0;
 
+          device_param->pws_loopback_cnt = 0;
+
           /*
           still required?
           if (attack_kern == ATTACK_KERN_STRAIGHT)
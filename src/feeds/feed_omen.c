@@ -0,0 +1,741 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "filehandling.h"
+#include "shared.h"
+#include "generic.h"
+#include "feed_omen.h"
+
+// OMEN (Ordered Markov ENumerator) style candidates in global probability order
+//
+// an n-gram model is trained from the corpus and every probability is turned into a small integer level,
+// level = floor (-log2 (p)) clamped to 10. the level of a candidate is the level of its first ngram-1 characters
+// plus the level of every following character given the ngram-1 characters before it. candidates are emitted
+// by ascending total level (most probable first), and for each level by ascending length.
+//
+// to make seeking possible, the number of ways to append t characters to a context with a total level of
+// exactly l is counted once at startup. with that table both the size of a (level, length) block and the
+// position of any candidate inside a block can be computed, so thread_seek decodes an offset directly,
+// without enumerating the candidates before it. thread_next walks the same order incrementally and only
+// revisits the characters right of the one that changed.
+//
+// usage: -a 8 feeds/feed_omen.so corpus [ngram=N] [len-min=N] [len-max=N] [level-max=N]
+
+const int GENERIC_PLUGIN_VERSION = GENERIC_PLUGIN_VERSION_REQ;
+
+const int GENERIC_PLUGIN_OPTIONS = GENERIC_PLUGIN_OPTIONS_ICONV
+                                 | GENERIC_PLUGIN_OPTIONS_RULES;
+
+// additive smoothing, so unseen n-grams are possible but expensive
+
+static const double OMEN_SMOOTHING = 0.01;
+
+// -1ULL means "keyspace unknown" to hashcat, so saturate one below it
+
+#define OMEN_KS_SAT (-1ULL - 1)
+
+static void error_set (generic_global_ctx_t *global_ctx, const char *fmt, ...)
+{
+  global_ctx->error = true;
+
+  va_list ap;
+  va_start (ap, fmt);
+
+  vsnprintf (global_ctx->error_msg, sizeof (global_ctx->error_msg), fmt, ap);
+
+  va_end (ap);
+}
+
+static u64 ks_add (const u64 a, const u64 b)
+{
+  if (a > OMEN_KS_SAT - b) return OMEN_KS_SAT;
+
+  return a + b;
+}
+
+static bool parse_param (generic_global_ctx_t *global_ctx, feed_global_t *feed_global, const char *param)
+{
+  const char *eq = strchr (param, '=');
+
+  if (eq == NULL)
+  {
+    error_set (global_ctx, "Invalid parameter '%s'. Expected key=value.", param);
+
+    return false;
+  }
+
+  const size_t key_len = eq - param;
+
+  const char *val = eq + 1;
+
+  char *end = NULL;
+
+  const u64 num = hc_strtoull (val, &end, 10);
+
+  if ((*val == 0) || (*end != 0))
+  {
+    error_set (global_ctx, "Invalid value in parameter '%s'.", param);
+
+    return false;
+  }
+
+  const u32 num32 = (u32) MIN (num, 0xffffffff);
+
+  #define KEY_IS(s) ((key_len == strlen (s)) && (strncmp (param, (s), key_len) == 0))
+
+  if      (KEY_IS ("ngram"))     feed_global->ngram     = num32;
+  else if (KEY_IS ("len-min"))   feed_global->len_min   = num32;
+  else if (KEY_IS ("len-max"))   feed_global->len_max   = num32;
+  else if (KEY_IS ("level-max")) feed_global->level_max = num32;
+  else
+  {
+    error_set (global_ctx, "Unknown parameter '%s'. Supported: ngram, len-min, len-max, level-max.", param);
+
+    return false;
+  }
+
+  #undef KEY_IS
+
+  return true;
+}
+
+static u32 prob_to_level (const double cnt, const double total, const double outcomes)
+{
+  const double p = (cnt + OMEN_SMOOTHING) / (total + (OMEN_SMOOTHING * outcomes));
+
+  const double lvl = floor (-log2 (p));
+
+  if (lvl <= 0) return 0;
+
+  if (lvl >= OMEN_LEVEL_STEP_MAX) return OMEN_LEVEL_STEP_MAX;
+
+  return (u32) lvl;
+}
+
+static int sort_by_ip_level (const void *p1, const void *p2, void *v3)
+{
+  const u32 c1 = *(const u32 *) p1;
+  const u32 c2 = *(const u32 *) p2;
+
+  const feed_global_t *feed_global = (const feed_global_t *) v3;
+
+  const u8 l1 = feed_global->ip_lvl[c1];
+  const u8 l2 = feed_global->ip_lvl[c2];
+
+  if (l1 != l2) return (l1 < l2) ? -1 : 1;
+
+  return (c1 < c2) ? -1 : (c1 > c2);
+}
+
+static bool train (generic_global_ctx_t *global_ctx, feed_global_t *feed_global)
+{
+  HCFILE fp;
+
+  if (hc_fopen (&fp, feed_global->corpus, "rb") == false)
+  {
+    error_set (global_ctx, "%s: %s", feed_global->corpus, strerror (errno));
+
+    return false;
+  }
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  // pass 1: alphabet
+
+  bool seen[256] = { 0 };
+
+  while (!hc_feof (&fp))
+  {
+    const size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE - 1);
+
+    for (size_t i = 0; i < line_len; i++) seen[(u8) line_buf[i]] = true;
+  }
+
+  u8 alpha_idx[256];
+
+  feed_global->alpha_cnt = 0;
+
+  for (u32 c = 0; c < 256; c++)
+  {
+    if (seen[c] == false) continue;
+
+    alpha_idx[c] = (u8) feed_global->alpha_cnt;
+
+    feed_global->alpha_buf[feed_global->alpha_cnt++] = (u8) c;
+  }
+
+  if (feed_global->alpha_cnt == 0)
+  {
+    error_set (global_ctx, "%s: empty corpus", feed_global->corpus);
+
+    hcfree (line_buf);
+
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  const u64 alpha_cnt = feed_global->alpha_cnt;
+
+  u64 ctx_cnt = 1;
+
+  for (u32 i = 0; i < feed_global->ngram - 1; i++)
+  {
+    ctx_cnt *= alpha_cnt;
+
+    if (ctx_cnt * alpha_cnt > OMEN_TABLE_MAX)
+    {
+      error_set (global_ctx, "%s: n-gram table too large for %u characters. Use a lower ngram.", feed_global->corpus, feed_global->alpha_cnt);
+
+      hcfree (line_buf);
+
+      hc_fclose (&fp);
+
+      return false;
+    }
+  }
+
+  feed_global->ctx_cnt = ctx_cnt;
+  feed_global->ctx_div = ctx_cnt / alpha_cnt;
+
+  // pass 2: counts
+
+  u64 *ip_cnt = (u64 *) hccalloc (ctx_cnt, sizeof (u64));
+  u64 *cp_cnt = (u64 *) hccalloc (ctx_cnt * alpha_cnt, sizeof (u64));
+
+  u64 ip_total = 0;
+
+  hc_rewind (&fp);
+
+  const u32 ctx_len = feed_global->ngram - 1;
+
+  while (!hc_feof (&fp))
+  {
+    const size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE - 1);
+
+    if (line_len < ctx_len) continue;
+
+    u64 ctx = 0;
+
+    for (u32 i = 0; i < ctx_len; i++) ctx = (ctx * alpha_cnt) + alpha_idx[(u8) line_buf[i]];
+
+    ip_cnt[ctx]++;
+
+    ip_total++;
+
+    for (size_t i = ctx_len; i < line_len; i++)
+    {
+      const u64 c = alpha_idx[(u8) line_buf[i]];
+
+      cp_cnt[(ctx * alpha_cnt) + c]++;
+
+      ctx = ((ctx % feed_global->ctx_div) * alpha_cnt) + c;
+    }
+  }
+
+  hcfree (line_buf);
+
+  hc_fclose (&fp);
+
+  // levels
+
+  feed_global->ip_lvl = (u8 *)  hcmalloc (ctx_cnt);
+  feed_global->ip_ord = (u32 *) hcmalloc (ctx_cnt * sizeof (u32));
+  feed_global->cp_lvl = (u8 *)  hcmalloc (ctx_cnt * alpha_cnt);
+  feed_global->cp_ord = (u8 *)  hcmalloc (ctx_cnt * alpha_cnt);
+
+  for (u64 ctx = 0; ctx < ctx_cnt; ctx++)
+  {
+    feed_global->ip_lvl[ctx] = (u8) prob_to_level ((double) ip_cnt[ctx], (double) ip_total, (double) ctx_cnt);
+    feed_global->ip_ord[ctx] = (u32) ctx;
+
+    const u64 *cnt = cp_cnt + (ctx * alpha_cnt);
+
+    u64 total = 0;
+
+    for (u64 c = 0; c < alpha_cnt; c++) total += cnt[c];
+
+    u8 *lvl = feed_global->cp_lvl + (ctx * alpha_cnt);
+    u8 *ord = feed_global->cp_ord + (ctx * alpha_cnt);
+
+    for (u64 c = 0; c < alpha_cnt; c++) lvl[c] = (u8) prob_to_level ((double) cnt[c], (double) total, (double) alpha_cnt);
+
+    // counting sort by level keeps byte order within a level
+
+    u32 pos = 0;
+
+    for (u32 l = 0; l <= OMEN_LEVEL_STEP_MAX; l++)
+    {
+      for (u64 c = 0; c < alpha_cnt; c++)
+      {
+        if (lvl[c] == l) ord[pos++] = (u8) c;
+      }
+    }
+  }
+
+  hc_qsort_r (feed_global->ip_ord, ctx_cnt, sizeof (u32), sort_by_ip_level, feed_global);
+
+  hcfree (ip_cnt);
+  hcfree (cp_cnt);
+
+  return true;
+}
+
+static inline u64 *cnt_ptr (const feed_global_t *feed_global, const u64 t, const u64 ctx)
+{
+  return feed_global->cnt + (((t * feed_global->ctx_cnt) + ctx) * (feed_global->level_max + 1));
+}
+
+static inline u64 ctx_next (const feed_global_t *feed_global, const u64 ctx, const u64 c)
+{
+  return ((ctx % feed_global->ctx_div) * feed_global->alpha_cnt) + c;
+}
+
+static bool build_counts (generic_global_ctx_t *global_ctx, feed_global_t *feed_global)
+{
+  const u64 alpha_cnt = feed_global->alpha_cnt;
+  const u64 ctx_cnt   = feed_global->ctx_cnt;
+  const u64 lvl_cnt   = feed_global->level_max + 1;
+  const u64 t_max     = feed_global->len_max - (feed_global->ngram - 1);
+
+  const u64 cnt_size = (t_max + 1) * ctx_cnt * lvl_cnt;
+
+  if (cnt_size > OMEN_TABLE_MAX)
+  {
+    error_set (global_ctx, "Level table too large (%" PRIu64 " entries). Use a lower ngram, len-max or level-max.", cnt_size);
+
+    return false;
+  }
+
+  feed_global->cnt = (u64 *) hccalloc (cnt_size, sizeof (u64));
+
+  for (u64 ctx = 0; ctx < ctx_cnt; ctx++) cnt_ptr (feed_global, 0, ctx)[0] = 1;
+
+  for (u64 t = 1; t <= t_max; t++)
+  {
+    for (u64 ctx = 0; ctx < ctx_cnt; ctx++)
+    {
+      u64 *dst = cnt_ptr (feed_global, t, ctx);
+
+      const u8 *lvl = feed_global->cp_lvl + (ctx * alpha_cnt);
+      const u8 *ord = feed_global->cp_ord + (ctx * alpha_cnt);
+
+      for (u64 i = 0; i < alpha_cnt; i++)
+      {
+        const u64 c = ord[i];
+        const u64 l = lvl[c];
+
+        if (l > feed_global->level_max) break;
+
+        const u64 *src = cnt_ptr (feed_global, t - 1, ctx_next (feed_global, ctx, c));
+
+        for (u64 r = l; r < lvl_cnt; r++) dst[r] = ks_add (dst[r], src[r - l]);
+      }
+    }
+  }
+
+  // blocks
+
+  const u64 lens_cnt = feed_global->len_max - feed_global->len_min + 1;
+
+  feed_global->blocks_cnt = lvl_cnt * lens_cnt;
+
+  feed_global->block_cnt = (u64 *) hccalloc (feed_global->blocks_cnt, sizeof (u64));
+  feed_global->block_off = (u64 *) hccalloc (feed_global->blocks_cnt, sizeof (u64));
+
+  u64 ks_off = 0;
+
+  for (u64 b = 0; b < feed_global->blocks_cnt; b++)
+  {
+    const u64 level = b / lens_cnt;
+    const u64 len   = feed_global->len_min + (b % lens_cnt);
+
+    const u64 t = len - (feed_global->ngram - 1);
+
+    u64 block_cnt = 0;
+
+    for (u64 ctx = 0; ctx < ctx_cnt; ctx++)
+    {
+      const u64 ip = feed_global->ip_lvl[ctx];
+
+      if (ip > level) continue;
+
+      block_cnt = ks_add (block_cnt, cnt_ptr (feed_global, t, ctx)[level - ip]);
+    }
+
+    feed_global->block_cnt[b] = block_cnt;
+    feed_global->block_off[b] = ks_off;
+
+    ks_off = ks_add (ks_off, block_cnt);
+  }
+
+  if (ks_off == 0)
+  {
+    error_set (global_ctx, "No candidates up to level-max=%u. Use a higher level-max.", feed_global->level_max);
+
+    return false;
+  }
+
+  feed_global->keyspace = ks_off;
+
+  return true;
+}
+
+bool global_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  // create our own context
+
+  feed_global_t *feed_global = hcmalloc (sizeof (feed_global_t));
+
+  global_ctx->gbldata = feed_global;
+
+  // check user command line arguments
+
+  if (global_ctx->workc < 2)
+  {
+    error_set (global_ctx, "Invalid parameter count: %d. Count must be at least 2.", global_ctx->workc);
+
+    return false;
+  }
+
+  feed_global->corpus    = global_ctx->workv[1];
+  feed_global->ngram     = OMEN_NGRAM;
+  feed_global->len_min   = OMEN_LEN_MIN;
+  feed_global->len_max   = OMEN_LEN_MAX;
+  feed_global->level_max = OMEN_LEVEL_MAX;
+
+  for (int i = 2; i < global_ctx->workc; i++)
+  {
+    if (parse_param (global_ctx, feed_global, global_ctx->workv[i]) == false) return false;
+  }
+
+  if ((feed_global->ngram < OMEN_NGRAM_MIN) || (feed_global->ngram > OMEN_NGRAM_MAX))
+  {
+    error_set (global_ctx, "Invalid ngram: %u. Must be %u to %u.", feed_global->ngram, OMEN_NGRAM_MIN, OMEN_NGRAM_MAX);
+
+    return false;
+  }
+
+  if ((feed_global->len_min < feed_global->ngram - 1) || (feed_global->len_max > OMEN_LEN_MAX_LIMIT) || (feed_global->len_min > feed_global->len_max))
+  {
+    error_set (global_ctx, "Invalid len-min/len-max: %u/%u. Must satisfy ngram-1 <= len-min <= len-max <= %u.", feed_global->len_min, feed_global->len_max, OMEN_LEN_MAX_LIMIT);
+
+    return false;
+  }
+
+  if (feed_global->level_max > OMEN_LEVEL_MAX_LIMIT)
+  {
+    error_set (global_ctx, "Invalid level-max: %u. Must be at most %u.", feed_global->level_max, OMEN_LEVEL_MAX_LIMIT);
+
+    return false;
+  }
+
+  if (train (global_ctx, feed_global) == false) return false;
+
+  if (build_counts (global_ctx, feed_global) == false) return false;
+
+  return true;
+}
+
+void global_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_global == NULL) return;
+
+  hcfree (feed_global->ip_lvl);
+  hcfree (feed_global->ip_ord);
+  hcfree (feed_global->cp_lvl);
+  hcfree (feed_global->cp_ord);
+  hcfree (feed_global->cnt);
+  hcfree (feed_global->block_cnt);
+  hcfree (feed_global->block_off);
+
+  hcfree (feed_global);
+
+  global_ctx->gbldata = NULL;
+}
+
+u64 global_keyspace (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  return feed_global->keyspace;
+}
+
+bool thread_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = hcmalloc (sizeof (feed_thread_t));
+
+  if (feed_thread == NULL)
+  {
+    error_set (global_ctx, "hcmalloc failed");
+
+    return false;
+  }
+
+  thread_ctx->thrdata = feed_thread;
+
+  feed_thread->done = true; // until the first seek
+
+  return true;
+}
+
+void thread_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+
+  hcfree (feed_thread);
+
+  thread_ctx->thrdata = NULL;
+}
+
+static u64 block_len (const feed_global_t *feed_global, const u64 block_idx)
+{
+  return feed_global->len_min + (block_idx % (feed_global->len_max - feed_global->len_min + 1));
+}
+
+static u64 block_level (const feed_global_t *feed_global, const u64 block_idx)
+{
+  return block_idx / (feed_global->len_max - feed_global->len_min + 1);
+}
+
+static void set_ip (const feed_global_t *feed_global, feed_thread_t *feed_thread, const u64 ip_idx)
+{
+  const u64 ctx = feed_global->ip_ord[ip_idx];
+
+  feed_thread->ip_idx = ip_idx;
+  feed_thread->ctx[0] = ctx;
+  feed_thread->rem[0] = (u32) (block_level (feed_global, feed_thread->block_idx) - feed_global->ip_lvl[ctx]);
+
+  u64 v = ctx;
+
+  for (int i = (int) feed_global->ngram - 2; i >= 0; i--)
+  {
+    feed_thread->buf[i] = feed_global->alpha_buf[v % feed_global->alpha_cnt];
+
+    v /= feed_global->alpha_cnt;
+  }
+}
+
+// true if ip_idx starts at least one candidate in the current block
+
+static bool ip_usable (const feed_global_t *feed_global, const feed_thread_t *feed_thread, const u64 ip_idx, const u64 t_cnt)
+{
+  const u64 ctx   = feed_global->ip_ord[ip_idx];
+  const u64 ip    = feed_global->ip_lvl[ctx];
+  const u64 level = block_level (feed_global, feed_thread->block_idx);
+
+  if (ip > level) return false;
+
+  return cnt_ptr (feed_global, t_cnt, ctx)[level - ip] > 0;
+}
+
+// pick the first choice >= choice_min for transition t which leaves a completable suffix
+
+static bool pick (const feed_global_t *feed_global, feed_thread_t *feed_thread, const u32 t, const u32 t_cnt, const u32 choice_min)
+{
+  const u64 alpha_cnt = feed_global->alpha_cnt;
+
+  const u64 ctx = feed_thread->ctx[t];
+  const u32 rem = feed_thread->rem[t];
+
+  const u8 *lvl = feed_global->cp_lvl + (ctx * alpha_cnt);
+  const u8 *ord = feed_global->cp_ord + (ctx * alpha_cnt);
+
+  for (u32 i = choice_min; i < alpha_cnt; i++)
+  {
+    const u64 c = ord[i];
+    const u32 l = lvl[c];
+
+    if (l > rem) break;
+
+    const u64 nx = ctx_next (feed_global, ctx, c);
+
+    if (cnt_ptr (feed_global, t_cnt - 1 - t, nx)[rem - l] == 0) continue;
+
+    feed_thread->choice[t]  = i;
+    feed_thread->ctx[t + 1] = nx;
+    feed_thread->rem[t + 1] = rem - l;
+
+    feed_thread->buf[feed_global->ngram - 1 + t] = feed_global->alpha_buf[c];
+
+    return true;
+  }
+
+  return false;
+}
+
+static void fill (const feed_global_t *feed_global, feed_thread_t *feed_thread, const u32 t_start, const u32 t_cnt)
+{
+  for (u32 t = t_start; t < t_cnt; t++) pick (feed_global, feed_thread, t, t_cnt, 0);
+}
+
+static void advance (const feed_global_t *feed_global, feed_thread_t *feed_thread)
+{
+  u32 t_cnt = (u32) (block_len (feed_global, feed_thread->block_idx) - (feed_global->ngram - 1));
+
+  for (int t = (int) t_cnt - 1; t >= 0; t--)
+  {
+    if (pick (feed_global, feed_thread, t, t_cnt, feed_thread->choice[t] + 1) == false) continue;
+
+    fill (feed_global, feed_thread, t + 1, t_cnt);
+
+    return;
+  }
+
+  u64 ip_idx = feed_thread->ip_idx + 1;
+
+  while (true)
+  {
+    for (; ip_idx < feed_global->ctx_cnt; ip_idx++)
+    {
+      if (ip_usable (feed_global, feed_thread, ip_idx, t_cnt) == false) continue;
+
+      set_ip (feed_global, feed_thread, ip_idx);
+
+      fill (feed_global, feed_thread, 0, t_cnt);
+
+      return;
+    }
+
+    do
+    {
+      feed_thread->block_idx++;
+
+      if (feed_thread->block_idx == feed_global->blocks_cnt)
+      {
+        feed_thread->done = true;
+
+        return;
+      }
+
+    } while (feed_global->block_cnt[feed_thread->block_idx] == 0);
+
+    t_cnt = (u32) (block_len (feed_global, feed_thread->block_idx) - (feed_global->ngram - 1));
+
+    ip_idx = 0;
+  }
+}
+
+int thread_next (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_thread->done == true) return -1;
+
+  const int pw_len = (int) block_len (feed_global, feed_thread->block_idx);
+
+  memcpy (out_buf, feed_thread->buf, pw_len);
+
+  advance (feed_global, feed_thread);
+
+  return pw_len;
+}
+
+bool thread_seek (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (offset >= feed_global->keyspace)
+  {
+    error_set (global_ctx, "seek target past keyspace: %" PRIu64, offset);
+
+    return false;
+  }
+
+  // last block with block_off <= offset, which is never an empty one
+
+  u64 lo = 0;
+  u64 hi = feed_global->blocks_cnt - 1;
+
+  while (lo < hi)
+  {
+    const u64 mid = lo + ((hi - lo + 1) / 2);
+
+    if (feed_global->block_off[mid] <= offset)
+    {
+      lo = mid;
+    }
+    else
+    {
+      hi = mid - 1;
+    }
+  }
+
+  feed_thread->block_idx = lo;
+  feed_thread->done      = false;
+
+  u64 rem = offset - feed_global->block_off[lo];
+
+  const u64 level = block_level (feed_global, lo);
+  const u32 t_cnt = (u32) (block_len (feed_global, lo) - (feed_global->ngram - 1));
+
+  // first ngram-1 characters
+
+  for (u64 ip_idx = 0; ip_idx < feed_global->ctx_cnt; ip_idx++)
+  {
+    const u64 ctx = feed_global->ip_ord[ip_idx];
+    const u64 ip  = feed_global->ip_lvl[ctx];
+
+    if (ip > level) break;
+
+    const u64 cnt = cnt_ptr (feed_global, t_cnt, ctx)[level - ip];
+
+    if (rem < cnt)
+    {
+      set_ip (feed_global, feed_thread, ip_idx);
+
+      break;
+    }
+
+    rem -= cnt;
+  }
+
+  // remaining characters, same order as pick ()
+
+  const u64 alpha_cnt = feed_global->alpha_cnt;
+
+  for (u32 t = 0; t < t_cnt; t++)
+  {
+    const u64 ctx = feed_thread->ctx[t];
+    const u32 lr  = feed_thread->rem[t];
+
+    const u8 *lvl = feed_global->cp_lvl + (ctx * alpha_cnt);
+    const u8 *ord = feed_global->cp_ord + (ctx * alpha_cnt);
+
+    for (u32 i = 0; i < alpha_cnt; i++)
+    {
+      const u64 c = ord[i];
+      const u32 l = lvl[c];
+
+      if (l > lr) break;
+
+      const u64 nx = ctx_next (feed_global, ctx, c);
+
+      const u64 cnt = cnt_ptr (feed_global, t_cnt - 1 - t, nx)[lr - l];
+
+      if (rem < cnt)
+      {
+        feed_thread->choice[t]  = i;
+        feed_thread->ctx[t + 1] = nx;
+        feed_thread->rem[t + 1] = lr - l;
+
+        feed_thread->buf[feed_global->ngram - 1 + t] = feed_global->alpha_buf[c];
+
+        break;
+      }
+
+      rem -= cnt;
+    }
+  }
+
+  return true;
+}
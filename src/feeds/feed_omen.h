@@ -0,0 +1,82 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef FEED_OMEN_H
+#define FEED_OMEN_H
+
+#define OMEN_NGRAM           3
+#define OMEN_NGRAM_MIN       2
+#define OMEN_NGRAM_MAX       5
+#define OMEN_LEN_MIN         4
+#define OMEN_LEN_MAX         12
+#define OMEN_LEN_MAX_LIMIT   32
+#define OMEN_LEVEL_MAX       40
+#define OMEN_LEVEL_MAX_LIMIT 250
+#define OMEN_LEVEL_STEP_MAX  10          // a single n-gram never costs more than this, as in OMEN
+#define OMEN_TABLE_MAX       (64 * 1024 * 1024)
+
+typedef struct feed_global
+{
+  char *corpus;
+
+  u32   ngram;
+  u32   len_min;
+  u32   len_max;
+  u32   level_max;
+
+  // alphabet: all bytes seen in the corpus, in byte order
+
+  u8    alpha_buf[256];
+  u32   alpha_cnt;
+
+  // a context is the last ngram-1 characters as a base alpha_cnt number
+
+  u64   ctx_cnt;
+  u64   ctx_div;          // alpha_cnt ^ (ngram - 2), drops the oldest character of a context
+
+  u8   *ip_lvl;           // [ctx]             level of a context as the first ngram-1 characters
+  u32  *ip_ord;           // [ctx]             contexts sorted by ip level
+  u8   *cp_lvl;           // [ctx * alpha + c] level of character c following a context
+  u8   *cp_ord;           // [ctx * alpha + i] characters sorted by cp level within a context
+
+  // cnt[(t * ctx_cnt + ctx) * (level_max + 1) + l]: number of ways to append t characters to ctx with a total level of exactly l, saturated
+
+  u64  *cnt;
+
+  // a block is all candidates of one total level and one length, level outer
+
+  u64  *block_cnt;
+  u64  *block_off;
+  u64   blocks_cnt;
+
+  u64   keyspace;
+
+} feed_global_t;
+
+typedef struct feed_thread
+{
+  u64  block_idx;
+  u64  ip_idx;
+
+  u64  ctx[OMEN_LEN_MAX_LIMIT + 1];     // context before transition t
+  u32  rem[OMEN_LEN_MAX_LIMIT + 1];     // level left for transitions t and later
+  u32  choice[OMEN_LEN_MAX_LIMIT];      // index into cp_ord of transition t
+
+  bool done;
+
+  u8   buf[OMEN_LEN_MAX_LIMIT];
+
+} feed_thread_t;
+
+bool global_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+void global_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+u64  global_keyspace  (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+
+bool thread_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+void thread_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+int  thread_next      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf);
+bool thread_seek      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset);
+
+#endif // FEED_OMEN_H
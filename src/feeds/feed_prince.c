@@ -0,0 +1,568 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "filehandling.h"
+#include "shared.h"
+#include "xxhash.h"
+#include "generic.h"
+#include "feed_prince.h"
+
+// PRINCE (PRobability INfinite Chained Elements) candidates generated in-process
+//
+// the words of the wordlist are the elements. a chain is a sequence of element lengths, for example 3-1-4,
+// and expands to every combination of one word of length 3, one of length 1 and one of length 4. the keyspace
+// of a chain is the product of the word counts of its element lengths, so the global keyspace is known exactly
+// (saturated at u64) and any candidate index can be decoded directly: a binary search over the chain offsets
+// finds the chain, and the remainder is a mixed-radix number with one digit per element.
+//
+// unlike princeprocessor, which interleaves the chains of all password lengths, all chains are emitted one
+// after the other, smallest keyspace first. this keeps seek O(log chains) and the order identical on every
+// device, which is what the dispatcher needs for --skip, --limit and restore.
+//
+// usage: -a 8 feeds/feed_prince.so wordlist [pw-min=N] [pw-max=N] [elem-cnt-min=N] [elem-cnt-max=N] [wl-max=N]
+
+const int GENERIC_PLUGIN_VERSION = GENERIC_PLUGIN_VERSION_REQ;
+
+const int GENERIC_PLUGIN_OPTIONS = GENERIC_PLUGIN_OPTIONS_ICONV
+                                 | GENERIC_PLUGIN_OPTIONS_RULES;
+
+static void error_set (generic_global_ctx_t *global_ctx, const char *fmt, ...)
+{
+  global_ctx->error = true;
+
+  va_list ap;
+  va_start (ap, fmt);
+
+  vsnprintf (global_ctx->error_msg, sizeof (global_ctx->error_msg), fmt, ap);
+
+  va_end (ap);
+}
+
+// -1ULL means "keyspace unknown" to hashcat, so saturate one below it
+
+#define PRINCE_KS_SAT (-1ULL - 1)
+
+static u64 ks_mul (const u64 a, const u64 b)
+{
+  if ((a == 0) || (b == 0)) return 0;
+
+  if (a > PRINCE_KS_SAT / b) return PRINCE_KS_SAT;
+
+  return a * b;
+}
+
+static u64 ks_add (const u64 a, const u64 b)
+{
+  if (a > PRINCE_KS_SAT - b) return PRINCE_KS_SAT;
+
+  return a + b;
+}
+
+static bool parse_param (generic_global_ctx_t *global_ctx, feed_global_t *feed_global, const char *param)
+{
+  const char *eq = strchr (param, '=');
+
+  if (eq == NULL)
+  {
+    error_set (global_ctx, "Invalid parameter '%s'. Expected key=value.", param);
+
+    return false;
+  }
+
+  const size_t key_len = eq - param;
+
+  const char *val = eq + 1;
+
+  char *end = NULL;
+
+  const u64 num = hc_strtoull (val, &end, 10);
+
+  if ((*val == 0) || (*end != 0))
+  {
+    error_set (global_ctx, "Invalid value in parameter '%s'.", param);
+
+    return false;
+  }
+
+  #define KEY_IS(s) ((key_len == strlen (s)) && (strncmp (param, (s), key_len) == 0))
+
+  if      (KEY_IS ("pw-min"))       feed_global->pw_min       = (u32) MIN (num, 0xffffffff);
+  else if (KEY_IS ("pw-max"))       feed_global->pw_max       = (u32) MIN (num, 0xffffffff);
+  else if (KEY_IS ("elem-cnt-min")) feed_global->elem_cnt_min = (u32) MIN (num, 0xffffffff);
+  else if (KEY_IS ("elem-cnt-max")) feed_global->elem_cnt_max = (u32) MIN (num, 0xffffffff);
+  else if (KEY_IS ("wl-max"))       feed_global->wl_max       = num;
+  else
+  {
+    error_set (global_ctx, "Unknown parameter '%s'. Supported: pw-min, pw-max, elem-cnt-min, elem-cnt-max, wl-max.", param);
+
+    return false;
+  }
+
+  #undef KEY_IS
+
+  return true;
+}
+
+// duplicate words would produce duplicate candidates in every chain they take part in, so drop them while loading.
+// a slot holds (length << 40) | (index + 1) of the first copy, 0 is free.
+
+static u64 word_hash (const u8 *buf, const u32 len)
+{
+  return XXH64 (buf, len, len);
+}
+
+static bool word_dupe_add (feed_global_t *feed_global, u64 **slots, u64 *slots_mask, const u8 *buf, const u32 len)
+{
+  u64 *tbl  = *slots;
+  u64  mask = *slots_mask;
+
+  u64 pos = word_hash (buf, len) & mask;
+
+  while (tbl[pos])
+  {
+    const u32 slot_len = (u32) (tbl[pos] >> 40);
+    const u64 slot_idx = (tbl[pos] & 0xffffffffffULL) - 1;
+
+    if ((slot_len == len) && (memcmp (feed_global->words_buf[len] + (slot_idx * len), buf, len) == 0)) return false;
+
+    pos = (pos + 1) & mask;
+  }
+
+  tbl[pos] = ((u64) len << 40) | (feed_global->words_cnt[len] + 1);
+
+  return true;
+}
+
+static void word_dupe_grow (feed_global_t *feed_global, u64 **slots, u64 *slots_mask)
+{
+  const u64 old_mask = *slots_mask;
+
+  u64 *old_tbl = *slots;
+
+  const u64 new_mask = (old_mask * 2) + 1;
+
+  u64 *new_tbl = (u64 *) hccalloc (new_mask + 1, sizeof (u64));
+
+  for (u64 i = 0; i <= old_mask; i++)
+  {
+    if (old_tbl[i] == 0) continue;
+
+    const u32 len = (u32) (old_tbl[i] >> 40);
+    const u64 idx = (old_tbl[i] & 0xffffffffffULL) - 1;
+
+    u64 pos = word_hash (feed_global->words_buf[len] + (idx * len), len) & new_mask;
+
+    while (new_tbl[pos]) pos = (pos + 1) & new_mask;
+
+    new_tbl[pos] = old_tbl[i];
+  }
+
+  hcfree (old_tbl);
+
+  *slots      = new_tbl;
+  *slots_mask = new_mask;
+}
+
+static bool load_words (generic_global_ctx_t *global_ctx, feed_global_t *feed_global)
+{
+  HCFILE fp;
+
+  if (hc_fopen (&fp, feed_global->wordlist, "rb") == false)
+  {
+    error_set (global_ctx, "%s: %s", feed_global->wordlist, strerror (errno));
+
+    return false;
+  }
+
+  u64  slots_mask = 0xffff;
+  u64 *slots      = (u64 *) hccalloc (slots_mask + 1, sizeof (u64));
+  u64  slots_used = 0;
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  u64 words_total = 0;
+
+  while (!hc_feof (&fp))
+  {
+    if (words_total >= feed_global->wl_max) break;
+
+    const u32 line_len = (u32) fgetl (&fp, line_buf, HCBUFSIZ_LARGE - 1);
+
+    if (line_len == 0) continue;
+
+    if (line_len > feed_global->pw_max) continue;
+
+    if (word_dupe_add (feed_global, &slots, &slots_mask, (const u8 *) line_buf, line_len) == false) continue;
+
+    if (feed_global->words_cnt[line_len] == feed_global->words_alloc[line_len])
+    {
+      feed_global->words_alloc[line_len] = MAX (feed_global->words_alloc[line_len] * 2, 1024);
+
+      feed_global->words_buf[line_len] = (u8 *) hcrealloc (feed_global->words_buf[line_len], feed_global->words_cnt[line_len] * line_len, (feed_global->words_alloc[line_len] - feed_global->words_cnt[line_len]) * line_len);
+    }
+
+    memcpy (feed_global->words_buf[line_len] + (feed_global->words_cnt[line_len] * line_len), line_buf, line_len);
+
+    feed_global->words_cnt[line_len]++;
+
+    words_total++;
+
+    slots_used++;
+
+    if ((slots_used * 2) > slots_mask) word_dupe_grow (feed_global, &slots, &slots_mask);
+  }
+
+  hcfree (line_buf);
+  hcfree (slots);
+
+  hc_fclose (&fp);
+
+  if (words_total == 0)
+  {
+    error_set (global_ctx, "%s: no usable words of length 1 to %u", feed_global->wordlist, feed_global->pw_max);
+
+    return false;
+  }
+
+  return true;
+}
+
+// enumerate all compositions of pw_len into element lengths which have at least one word
+
+static bool chain_add (generic_global_ctx_t *global_ctx, feed_global_t *feed_global, const u8 *elem_len, const u32 elem_cnt, const u32 pw_len)
+{
+  if (feed_global->chains_cnt == PRINCE_CHAINS_MAX)
+  {
+    error_set (global_ctx, "Too many chains (more than %u). Use a lower pw-max or elem-cnt-max.", PRINCE_CHAINS_MAX);
+
+    return false;
+  }
+
+  if (feed_global->chains_cnt == feed_global->chains_alloc)
+  {
+    const u64 chains_alloc = MAX (feed_global->chains_alloc * 2, 1024);
+
+    feed_global->chains_buf = (prince_chain_t *) hcrealloc (feed_global->chains_buf, feed_global->chains_alloc * sizeof (prince_chain_t), (chains_alloc - feed_global->chains_alloc) * sizeof (prince_chain_t));
+
+    feed_global->chains_alloc = chains_alloc;
+  }
+
+  prince_chain_t *chain = feed_global->chains_buf + feed_global->chains_cnt;
+
+  memset (chain, 0, sizeof (prince_chain_t));
+
+  u64 ks_cnt = 1;
+  u32 pos    = 0;
+
+  for (u32 i = 0; i < elem_cnt; i++)
+  {
+    chain->elem_len[i] = elem_len[i];
+    chain->elem_pos[i] = (u8) pos;
+
+    ks_cnt = ks_mul (ks_cnt, feed_global->words_cnt[elem_len[i]]);
+
+    pos += elem_len[i];
+  }
+
+  chain->elem_cnt = (u8) elem_cnt;
+  chain->pw_len   = (u8) pw_len;
+  chain->ks_cnt   = ks_cnt;
+
+  feed_global->chains_cnt++;
+
+  return true;
+}
+
+static bool chain_gen (generic_global_ctx_t *global_ctx, feed_global_t *feed_global, u8 *elem_len, const u32 elem_cnt, const u32 pw_len, const u32 pw_left)
+{
+  if (pw_left == 0)
+  {
+    if (elem_cnt < feed_global->elem_cnt_min) return true;
+
+    return chain_add (global_ctx, feed_global, elem_len, elem_cnt, pw_len);
+  }
+
+  if (elem_cnt == feed_global->elem_cnt_max) return true;
+
+  for (u32 len = 1; len <= pw_left; len++)
+  {
+    if (feed_global->words_cnt[len] == 0) continue;
+
+    elem_len[elem_cnt] = (u8) len;
+
+    if (chain_gen (global_ctx, feed_global, elem_len, elem_cnt + 1, pw_len, pw_left - len) == false) return false;
+  }
+
+  return true;
+}
+
+static int sort_by_chain (const void *p1, const void *p2)
+{
+  const prince_chain_t *c1 = (const prince_chain_t *) p1;
+  const prince_chain_t *c2 = (const prince_chain_t *) p2;
+
+  if (c1->ks_cnt < c2->ks_cnt) return -1;
+  if (c1->ks_cnt > c2->ks_cnt) return  1;
+
+  if (c1->pw_len < c2->pw_len) return -1;
+  if (c1->pw_len > c2->pw_len) return  1;
+
+  if (c1->elem_cnt < c2->elem_cnt) return -1;
+  if (c1->elem_cnt > c2->elem_cnt) return  1;
+
+  return memcmp (c1->elem_len, c2->elem_len, c1->elem_cnt);
+}
+
+static bool build_chains (generic_global_ctx_t *global_ctx, feed_global_t *feed_global)
+{
+  u8 elem_len[PRINCE_ELEM_CNT_MAX];
+
+  for (u32 pw_len = feed_global->pw_min; pw_len <= feed_global->pw_max; pw_len++)
+  {
+    if (chain_gen (global_ctx, feed_global, elem_len, 0, pw_len, pw_len) == false) return false;
+  }
+
+  if (feed_global->chains_cnt == 0)
+  {
+    error_set (global_ctx, "%s: no chains possible for pw-min=%u pw-max=%u elem-cnt-min=%u elem-cnt-max=%u", feed_global->wordlist, feed_global->pw_min, feed_global->pw_max, feed_global->elem_cnt_min, feed_global->elem_cnt_max);
+
+    return false;
+  }
+
+  qsort (feed_global->chains_buf, feed_global->chains_cnt, sizeof (prince_chain_t), sort_by_chain);
+
+  u64 ks_off = 0;
+
+  for (u64 i = 0; i < feed_global->chains_cnt; i++)
+  {
+    prince_chain_t *chain = feed_global->chains_buf + i;
+
+    chain->ks_off = ks_off;
+
+    ks_off = ks_add (ks_off, chain->ks_cnt);
+  }
+
+  feed_global->keyspace = ks_off;
+
+  return true;
+}
+
+bool global_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  // create our own context
+
+  feed_global_t *feed_global = hcmalloc (sizeof (feed_global_t));
+
+  global_ctx->gbldata = feed_global;
+
+  // check user command line arguments
+
+  if (global_ctx->workc < 2)
+  {
+    error_set (global_ctx, "Invalid parameter count: %d. Count must be at least 2.", global_ctx->workc);
+
+    return false;
+  }
+
+  feed_global->wordlist     = global_ctx->workv[1];
+  feed_global->pw_min       = PRINCE_PW_MIN;
+  feed_global->pw_max       = PRINCE_PW_MAX;
+  feed_global->elem_cnt_min = PRINCE_ELEM_CNT_MIN;
+  feed_global->elem_cnt_max = PRINCE_ELEM_CNT_MAX;
+  feed_global->wl_max       = PRINCE_WL_MAX;
+
+  for (int i = 2; i < global_ctx->workc; i++)
+  {
+    if (parse_param (global_ctx, feed_global, global_ctx->workv[i]) == false) return false;
+  }
+
+  if ((feed_global->pw_min < 1) || (feed_global->pw_max > PRINCE_PW_MAX_LIMIT) || (feed_global->pw_min > feed_global->pw_max))
+  {
+    error_set (global_ctx, "Invalid pw-min/pw-max: %u/%u. Must satisfy 1 <= pw-min <= pw-max <= %u.", feed_global->pw_min, feed_global->pw_max, PRINCE_PW_MAX_LIMIT);
+
+    return false;
+  }
+
+  if ((feed_global->elem_cnt_min < 1) || (feed_global->elem_cnt_max > PRINCE_ELEM_CNT_MAX) || (feed_global->elem_cnt_min > feed_global->elem_cnt_max))
+  {
+    error_set (global_ctx, "Invalid elem-cnt-min/elem-cnt-max: %u/%u. Must satisfy 1 <= elem-cnt-min <= elem-cnt-max <= %u.", feed_global->elem_cnt_min, feed_global->elem_cnt_max, PRINCE_ELEM_CNT_MAX);
+
+    return false;
+  }
+
+  if (feed_global->wl_max == 0)
+  {
+    error_set (global_ctx, "Invalid wl-max: 0");
+
+    return false;
+  }
+
+  if (load_words (global_ctx, feed_global) == false) return false;
+
+  if (build_chains (global_ctx, feed_global) == false) return false;
+
+  return true;
+}
+
+void global_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_global == NULL) return;
+
+  for (u32 len = 0; len <= PRINCE_PW_MAX_LIMIT; len++)
+  {
+    hcfree (feed_global->words_buf[len]);
+  }
+
+  hcfree (feed_global->chains_buf);
+
+  hcfree (feed_global);
+
+  global_ctx->gbldata = NULL;
+}
+
+u64 global_keyspace (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  return feed_global->keyspace;
+}
+
+bool thread_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = hcmalloc (sizeof (feed_thread_t));
+
+  if (feed_thread == NULL)
+  {
+    error_set (global_ctx, "hcmalloc failed");
+
+    return false;
+  }
+
+  thread_ctx->thrdata = feed_thread;
+
+  feed_thread->chain_idx = 0;
+  feed_thread->dirty     = 0;
+  feed_thread->done      = false;
+
+  return true;
+}
+
+void thread_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+
+  hcfree (feed_thread);
+
+  thread_ctx->thrdata = NULL;
+}
+
+int thread_next (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_thread->done == true) return -1;
+
+  const prince_chain_t *chain = feed_global->chains_buf + feed_thread->chain_idx;
+
+  // only the elements right of the last carry changed, the prefix in buf is still valid
+
+  for (u32 i = feed_thread->dirty; i < chain->elem_cnt; i++)
+  {
+    const u32 len = chain->elem_len[i];
+
+    memcpy (feed_thread->buf + chain->elem_pos[i], feed_global->words_buf[len] + (feed_thread->elem_idx[i] * len), len);
+  }
+
+  const int pw_len = chain->pw_len;
+
+  memcpy (out_buf, feed_thread->buf, pw_len);
+
+  // advance, last element fastest
+
+  int i;
+
+  for (i = chain->elem_cnt - 1; i >= 0; i--)
+  {
+    feed_thread->elem_idx[i]++;
+
+    if (feed_thread->elem_idx[i] < feed_global->words_cnt[chain->elem_len[i]]) break;
+
+    feed_thread->elem_idx[i] = 0;
+  }
+
+  if (i >= 0)
+  {
+    feed_thread->dirty = (u32) i;
+  }
+  else
+  {
+    feed_thread->chain_idx++;
+
+    memset (feed_thread->elem_idx, 0, sizeof (feed_thread->elem_idx));
+
+    feed_thread->dirty = 0;
+
+    if (feed_thread->chain_idx == feed_global->chains_cnt) feed_thread->done = true;
+  }
+
+  return pw_len;
+}
+
+bool thread_seek (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (offset >= feed_global->keyspace)
+  {
+    error_set (global_ctx, "seek target past keyspace: %" PRIu64, offset);
+
+    return false;
+  }
+
+  // last chain with ks_off <= offset
+
+  u64 lo = 0;
+  u64 hi = feed_global->chains_cnt - 1;
+
+  while (lo < hi)
+  {
+    const u64 mid = lo + ((hi - lo + 1) / 2);
+
+    if (feed_global->chains_buf[mid].ks_off <= offset)
+    {
+      lo = mid;
+    }
+    else
+    {
+      hi = mid - 1;
+    }
+  }
+
+  const prince_chain_t *chain = feed_global->chains_buf + lo;
+
+  u64 rem = offset - chain->ks_off;
+
+  for (int i = chain->elem_cnt - 1; i >= 0; i--)
+  {
+    const u64 cnt = feed_global->words_cnt[chain->elem_len[i]];
+
+    feed_thread->elem_idx[i] = rem % cnt;
+
+    rem /= cnt;
+  }
+
+  feed_thread->chain_idx = lo;
+  feed_thread->dirty     = 0;
+  feed_thread->done      = false;
+
+  return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef FEED_PRINCE_H
+#define FEED_PRINCE_H
+
+#define PRINCE_PW_MIN        1
+#define PRINCE_PW_MAX        16
+#define PRINCE_PW_MAX_LIMIT  32
+#define PRINCE_ELEM_CNT_MIN  1
+#define PRINCE_ELEM_CNT_MAX  8
+#define PRINCE_WL_MAX        10000000
+#define PRINCE_CHAINS_MAX    (4 * 1024 * 1024)
+
+typedef struct prince_chain
+{
+  u64 ks_cnt; // candidates in this chain, saturated
+  u64 ks_off; // candidates in all chains before this one, saturated
+
+  u8  elem_len[PRINCE_ELEM_CNT_MAX];
+  u8  elem_pos[PRINCE_ELEM_CNT_MAX];
+  u8  elem_cnt;
+  u8  pw_len;
+
+} prince_chain_t;
+
+typedef struct feed_global
+{
+  char *wordlist;
+
+  u32   pw_min;
+  u32   pw_max;
+  u32   elem_cnt_min;
+  u32   elem_cnt_max;
+  u64   wl_max;
+
+  // words of the same length are stored back to back, element j of length l is at words_buf[l] + j * l
+
+  u8   *words_buf[PRINCE_PW_MAX_LIMIT + 1];
+  u64   words_cnt[PRINCE_PW_MAX_LIMIT + 1];
+  u64   words_alloc[PRINCE_PW_MAX_LIMIT + 1];
+
+  prince_chain_t *chains_buf;
+  u64             chains_cnt;
+  u64             chains_alloc;
+
+  u64   keyspace;
+
+} feed_global_t;
+
+typedef struct feed_thread
+{
+  u64  chain_idx;
+  u64  elem_idx[PRINCE_ELEM_CNT_MAX];
+
+  u32  dirty; // first element which changed since the last candidate
+  bool done;
+
+  u8   buf[PRINCE_PW_MAX_LIMIT];
+
+} feed_thread_t;
+
+bool global_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+void global_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+u64  global_keyspace  (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+
+bool thread_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+void thread_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+int  thread_next      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf);
+bool thread_seek      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset);
+
+#endif // FEED_PRINCE_H
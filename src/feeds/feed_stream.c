@@ -0,0 +1,657 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "shared.h"
+#include "thread.h"
+#include "generic.h"
+#include "feed_stream.h"
+
+#if !defined (_WIN)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+// candidates streamed from another process over a unix socket or a named pipe
+//
+// with stdin, one device thread at a time reads lines under the dispatcher lock while the others wait.
+// here a single reader thread parses the stream into blocks of candidates and every device takes whole
+// blocks from a shared queue, so the lock is taken once per block (thousands of candidates) and never
+// while a device copies its candidates.
+//
+// framing: each candidate is a little-endian u16 length followed by that many bytes. candidates can be
+// binary, lengths above 256 (PW_MAX) are truncated like in every other attack mode. the stream ends when
+// the writer closes it. the keyspace is unknown, so like stdin, a stream cannot be skipped or restored.
+//
+// usage: -a 8 feeds/feed_stream.so path
+//
+// if path is a named pipe (mkfifo) it is opened for reading, otherwise a unix socket is created at path
+// and hashcat waits for one generator to connect.
+
+const int GENERIC_PLUGIN_VERSION = GENERIC_PLUGIN_VERSION_REQ;
+
+const int GENERIC_PLUGIN_OPTIONS = GENERIC_PLUGIN_OPTIONS_ICONV
+                                 | GENERIC_PLUGIN_OPTIONS_RULES;
+
+static void error_set (generic_global_ctx_t *global_ctx, const char *fmt, ...)
+{
+  global_ctx->error = true;
+
+  va_list ap;
+  va_start (ap, fmt);
+
+  vsnprintf (global_ctx->error_msg, sizeof (global_ctx->error_msg), fmt, ap);
+
+  va_end (ap);
+}
+
+#if !defined (_WIN)
+
+// true once hashcat is stopping or global_term asked the reader to stop, every blocking wait checks it at least every STREAM_POLL_MS
+
+static bool stream_cancelled (const feed_global_t *feed_global)
+{
+  if (feed_global->stop == true) return true;
+
+  if (feed_global->status_ctx->run_thread_level1 == false) return true;
+
+  return false;
+}
+
+// false if the wait was cancelled before the semaphore was posted
+
+static bool stream_sem_wait (const feed_global_t *feed_global, hc_thread_semaphore_t *sem)
+{
+  while (stream_cancelled (feed_global) == false)
+  {
+    #if defined (__APPLE__)
+
+    if (sem_trywait (sem) == 0) return true;
+
+    poll (NULL, 0, 1);
+
+    #else
+
+    struct timespec ts;
+
+    clock_gettime (CLOCK_REALTIME, &ts);
+
+    ts.tv_nsec += (STREAM_POLL_MS % 1000) * 1000000;
+    ts.tv_sec  += (STREAM_POLL_MS / 1000) + (ts.tv_nsec / 1000000000);
+    ts.tv_nsec %= 1000000000;
+
+    if (sem_timedwait (sem, &ts) == 0) return true;
+
+    #endif
+  }
+
+  return false;
+}
+
+// wait for fd to become readable, false if cancelled or on error
+
+static bool stream_poll_in (generic_global_ctx_t *global_ctx, const feed_global_t *feed_global, const int fd, const char *what)
+{
+  while (stream_cancelled (feed_global) == false)
+  {
+    struct pollfd pfd;
+
+    pfd.fd      = fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    const int rc = poll (&pfd, 1, STREAM_POLL_MS);
+
+    if (rc == 0) continue;
+
+    if (rc == -1)
+    {
+      if (errno == EINTR) continue;
+
+      error_set (global_ctx, "%s: %s: %s", feed_global->path, what, strerror (errno));
+
+      return false;
+    }
+
+    return true;
+  }
+
+  error_set (global_ctx, "%s: Aborted while waiting for the generator", feed_global->path);
+
+  return false;
+}
+
+static bool stream_open (generic_global_ctx_t *global_ctx, feed_global_t *feed_global)
+{
+  struct stat st;
+
+  if (stat (feed_global->path, &st) == 0)
+  {
+    if (S_ISFIFO (st.st_mode))
+    {
+      feed_global->is_fifo = true;
+
+      // a blocking open would wait for the generator with no way to abort, so open without blocking
+      // and poll until it opened the pipe for writing and wrote something or closed it again
+
+      feed_global->fd = open (feed_global->path, O_RDONLY | O_NONBLOCK);
+
+      if (feed_global->fd == -1)
+      {
+        error_set (global_ctx, "%s: %s", feed_global->path, strerror (errno));
+
+        return false;
+      }
+
+      if (stream_poll_in (global_ctx, feed_global, feed_global->fd, "poll") == false) return false;
+
+      const int flags = fcntl (feed_global->fd, F_GETFL);
+
+      if ((flags == -1) || (fcntl (feed_global->fd, F_SETFL, flags & ~O_NONBLOCK) == -1))
+      {
+        error_set (global_ctx, "%s: fcntl: %s", feed_global->path, strerror (errno));
+
+        return false;
+      }
+
+      return true;
+    }
+
+    if (S_ISSOCK (st.st_mode) == false)
+    {
+      error_set (global_ctx, "%s: Not a named pipe or socket", feed_global->path);
+
+      return false;
+    }
+
+    unlink (feed_global->path); // stale socket from an earlier session
+  }
+
+  struct sockaddr_un sa;
+
+  memset (&sa, 0, sizeof (sa));
+
+  if (strlen (feed_global->path) >= sizeof (sa.sun_path))
+  {
+    error_set (global_ctx, "%s: Socket path too long", feed_global->path);
+
+    return false;
+  }
+
+  sa.sun_family = AF_UNIX;
+
+  strncpy (sa.sun_path, feed_global->path, sizeof (sa.sun_path) - 1);
+
+  feed_global->listen_fd = socket (AF_UNIX, SOCK_STREAM, 0);
+
+  if (feed_global->listen_fd == -1)
+  {
+    error_set (global_ctx, "socket: %s", strerror (errno));
+
+    return false;
+  }
+
+  if (bind (feed_global->listen_fd, (struct sockaddr *) &sa, sizeof (sa)) == -1)
+  {
+    error_set (global_ctx, "%s: bind: %s", feed_global->path, strerror (errno));
+
+    return false;
+  }
+
+  if (listen (feed_global->listen_fd, 1) == -1)
+  {
+    error_set (global_ctx, "%s: listen: %s", feed_global->path, strerror (errno));
+
+    return false;
+  }
+
+  // wait for the generator to connect, but keep checking for an abort
+
+  if (stream_poll_in (global_ctx, feed_global, feed_global->listen_fd, "accept") == false) return false;
+
+  do
+  {
+    feed_global->fd = accept (feed_global->listen_fd, NULL, NULL);
+
+  } while ((feed_global->fd == -1) && (errno == EINTR));
+
+  if (feed_global->fd == -1)
+  {
+    error_set (global_ctx, "%s: accept: %s", feed_global->path, strerror (errno));
+
+    return false;
+  }
+
+  return true;
+}
+
+// refill the read buffer, false on end of stream, shutdown or error
+
+static bool stream_fill (feed_global_t *feed_global)
+{
+  while (stream_cancelled (feed_global) == false)
+  {
+    struct pollfd pfd;
+
+    pfd.fd      = feed_global->fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    const int rc = poll (&pfd, 1, STREAM_POLL_MS);
+
+    if (rc == 0) continue;
+
+    if (rc == -1)
+    {
+      if (errno == EINTR) continue;
+
+      snprintf (feed_global->reader_error, sizeof (feed_global->reader_error), "%s: poll: %s", feed_global->path, strerror (errno));
+
+      return false;
+    }
+
+    const ssize_t nread = read (feed_global->fd, feed_global->read_buf, STREAM_READ_SIZE);
+
+    if (nread == -1)
+    {
+      if ((errno == EINTR) || (errno == EAGAIN)) continue;
+
+      snprintf (feed_global->reader_error, sizeof (feed_global->reader_error), "%s: read: %s", feed_global->path, strerror (errno));
+
+      return false;
+    }
+
+    if (nread == 0) return false;
+
+    feed_global->read_pos = 0;
+    feed_global->read_len = (size_t) nread;
+
+    return true;
+  }
+
+  return false;
+}
+
+// copy exactly len bytes from the stream into dst, or skip them if dst is NULL. returns the bytes available
+
+static size_t stream_read (feed_global_t *feed_global, u8 *dst, const size_t len)
+{
+  size_t done = 0;
+
+  while (done < len)
+  {
+    if (feed_global->read_pos == feed_global->read_len)
+    {
+      if (stream_fill (feed_global) == false) break;
+    }
+
+    const size_t avail = MIN (len - done, feed_global->read_len - feed_global->read_pos);
+
+    if (dst) memcpy (dst + done, feed_global->read_buf + feed_global->read_pos, avail);
+
+    feed_global->read_pos += avail;
+
+    done += avail;
+  }
+
+  return done;
+}
+
+static void block_publish (feed_global_t *feed_global, const u32 block_idx)
+{
+  hc_thread_mutex_lock (feed_global->mux_blocks);
+
+  feed_global->full_idx[(feed_global->full_pos + feed_global->full_cnt) % STREAM_BLOCKS_CNT] = block_idx;
+
+  feed_global->full_cnt++;
+
+  hc_thread_mutex_unlock (feed_global->mux_blocks);
+
+  hc_thread_sem_post (feed_global->sem_full);
+}
+
+static bool block_acquire_free (feed_global_t *feed_global, u32 *block_idx)
+{
+  if (stream_sem_wait (feed_global, &feed_global->sem_free) == false) return false;
+
+  if (feed_global->stop == true) return false;
+
+  hc_thread_mutex_lock (feed_global->mux_blocks);
+
+  *block_idx = feed_global->free_idx[--feed_global->free_cnt];
+
+  hc_thread_mutex_unlock (feed_global->mux_blocks);
+
+  return true;
+}
+
+static void block_release (feed_global_t *feed_global, const u32 block_idx)
+{
+  hc_thread_mutex_lock (feed_global->mux_blocks);
+
+  feed_global->free_idx[feed_global->free_cnt++] = block_idx;
+
+  hc_thread_mutex_unlock (feed_global->mux_blocks);
+
+  hc_thread_sem_post (feed_global->sem_free);
+}
+
+static void *stream_reader (void *p)
+{
+  feed_global_t *feed_global = (feed_global_t *) p;
+
+  stream_block_t *block = NULL;
+
+  u32 block_idx = 0;
+
+  while (true)
+  {
+    // about to wait for the generator: hand out what we have, so a slow generator does not starve the devices
+
+    if ((block != NULL) && (block->cnt > 0) && (feed_global->read_pos == feed_global->read_len))
+    {
+      block_publish (feed_global, block_idx);
+
+      block = NULL;
+    }
+
+    u8 hdr[2];
+
+    const size_t hdr_len = stream_read (feed_global, hdr, 2);
+
+    if (hdr_len == 0) break;
+
+    if (hdr_len == 1)
+    {
+      snprintf (feed_global->reader_error, sizeof (feed_global->reader_error), "%s: Truncated frame at end of stream", feed_global->path);
+
+      break;
+    }
+
+    const u32 len = (u32) hdr[0] | ((u32) hdr[1] << 8);
+
+    const u32 copy_len = MIN (len, PW_MAX);
+
+    if (block == NULL)
+    {
+      if (block_acquire_free (feed_global, &block_idx) == false) break;
+
+      block = feed_global->blocks_buf + block_idx;
+
+      block->used = 0;
+      block->cnt  = 0;
+    }
+
+    u8 *ptr = block->buf + block->used;
+
+    ptr[0] = (u8) (copy_len >> 0);
+    ptr[1] = (u8) (copy_len >> 8);
+
+    size_t got = stream_read (feed_global, ptr + 2, copy_len);
+
+    if (len > copy_len) got += stream_read (feed_global, NULL, len - copy_len);
+
+    if (got < len)
+    {
+      if ((feed_global->reader_error[0] == 0) && (stream_cancelled (feed_global) == false))
+      {
+        snprintf (feed_global->reader_error, sizeof (feed_global->reader_error), "%s: Truncated frame at end of stream", feed_global->path);
+      }
+
+      break;
+    }
+
+    block->used += 2 + copy_len;
+    block->cnt++;
+
+    if ((block->used + 2 + PW_MAX) > STREAM_BLOCK_SIZE)
+    {
+      block_publish (feed_global, block_idx);
+
+      block = NULL;
+    }
+  }
+
+  if ((block != NULL) && (block->cnt > 0))
+  {
+    block_publish (feed_global, block_idx);
+  }
+
+  // wake one consumer, each one that finds the queue drained passes the wakeup on
+
+  hc_thread_mutex_lock (feed_global->mux_blocks);
+
+  feed_global->eof = true;
+
+  hc_thread_mutex_unlock (feed_global->mux_blocks);
+
+  hc_thread_sem_post (feed_global->sem_full);
+
+  return NULL;
+}
+
+#endif
+
+bool global_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  // create our own context
+
+  feed_global_t *feed_global = hcmalloc (sizeof (feed_global_t));
+
+  global_ctx->gbldata = feed_global;
+
+  feed_global->listen_fd = -1;
+  feed_global->fd        = -1;
+
+  feed_global->status_ctx = hashcat_ctx->status_ctx;
+
+  // check user command line arguments
+
+  if (global_ctx->workc != 2)
+  {
+    error_set (global_ctx, "Invalid parameter count: %d. Count must be 2.", global_ctx->workc);
+
+    return false;
+  }
+
+  feed_global->path = global_ctx->workv[1];
+
+  #if defined (_WIN)
+
+  error_set (global_ctx, "%s: Streaming feed is not supported on Windows", feed_global->path);
+
+  return false;
+
+  #else
+
+  if (stream_open (global_ctx, feed_global) == false) return false;
+
+  feed_global->read_buf   = (u8 *) hcmalloc (STREAM_READ_SIZE);
+  feed_global->blocks_buf = (stream_block_t *) hcmalloc (STREAM_BLOCKS_CNT * sizeof (stream_block_t));
+
+  hc_thread_mutex_init (feed_global->mux_blocks);
+
+  hc_thread_sem_init (feed_global->sem_full);
+  hc_thread_sem_init (feed_global->sem_free);
+
+  for (u32 i = 0; i < STREAM_BLOCKS_CNT; i++)
+  {
+    feed_global->free_idx[feed_global->free_cnt++] = i;
+
+    hc_thread_sem_post (feed_global->sem_free);
+  }
+
+  hc_thread_create (feed_global->reader_thread, stream_reader, feed_global);
+
+  feed_global->reader_running = true;
+
+  return true;
+
+  #endif
+}
+
+void global_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_global == NULL) return;
+
+  #if !defined (_WIN)
+
+  if (feed_global->reader_running == true)
+  {
+    // the reader checks stop at least every STREAM_POLL_MS, or right away when it waits for a free block
+
+    feed_global->stop = true;
+
+    hc_thread_sem_post (feed_global->sem_free);
+
+    hc_thread_wait (1, &feed_global->reader_thread);
+
+    hc_thread_mutex_delete (feed_global->mux_blocks);
+
+    hc_thread_sem_close (feed_global->sem_full);
+    hc_thread_sem_close (feed_global->sem_free);
+  }
+
+  if (feed_global->fd != -1) close (feed_global->fd);
+
+  if (feed_global->listen_fd != -1)
+  {
+    close (feed_global->listen_fd);
+
+    unlink (feed_global->path);
+  }
+
+  #endif
+
+  hcfree (feed_global->read_buf);
+  hcfree (feed_global->blocks_buf);
+
+  hcfree (feed_global);
+
+  global_ctx->gbldata = NULL;
+}
+
+u64 global_keyspace (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  return -1ULL;
+}
+
+bool thread_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = hcmalloc (sizeof (feed_thread_t));
+
+  if (feed_thread == NULL)
+  {
+    error_set (global_ctx, "hcmalloc failed");
+
+    return false;
+  }
+
+  thread_ctx->thrdata = feed_thread;
+
+  return true;
+}
+
+void thread_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+
+  #if !defined (_WIN)
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_thread->block != NULL) block_release (feed_global, feed_thread->block_idx);
+  #endif
+
+  hcfree (feed_thread);
+
+  thread_ctx->thrdata = NULL;
+}
+
+int thread_next (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+
+  if (feed_thread->done == true) return -1;
+
+  #if defined (_WIN)
+
+  return -1;
+
+  #else
+
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_thread->block_left == 0)
+  {
+    if (feed_thread->block != NULL)
+    {
+      block_release (feed_global, feed_thread->block_idx);
+
+      feed_thread->block = NULL;
+    }
+
+    // devices are only joined after they return, so this must not wait past an abort
+
+    if (stream_sem_wait (feed_global, &feed_global->sem_full) == false)
+    {
+      feed_thread->done = true;
+
+      return -1;
+    }
+
+    hc_thread_mutex_lock (feed_global->mux_blocks);
+
+    if (feed_global->full_cnt == 0)
+    {
+      // only possible after eof, pass the wakeup on to the next device
+
+      hc_thread_mutex_unlock (feed_global->mux_blocks);
+
+      hc_thread_sem_post (feed_global->sem_full);
+
+      feed_thread->done = true;
+
+      if (feed_global->reader_error[0] != 0) error_set (global_ctx, "%s", feed_global->reader_error);
+
+      return -1;
+    }
+
+    feed_thread->block_idx = feed_global->full_idx[feed_global->full_pos];
+
+    feed_global->full_pos = (feed_global->full_pos + 1) % STREAM_BLOCKS_CNT;
+    feed_global->full_cnt--;
+
+    hc_thread_mutex_unlock (feed_global->mux_blocks);
+
+    feed_thread->block      = feed_global->blocks_buf + feed_thread->block_idx;
+    feed_thread->block_pos  = 0;
+    feed_thread->block_left = feed_thread->block->cnt;
+  }
+
+  const u8 *ptr = feed_thread->block->buf + feed_thread->block_pos;
+
+  const u32 len = (u32) ptr[0] | ((u32) ptr[1] << 8);
+
+  memcpy (out_buf, ptr + 2, len);
+
+  feed_thread->block_pos += 2 + len;
+  feed_thread->block_left--;
+
+  return (int) len;
+
+  #endif
+}
+
+bool thread_seek (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, MAYBE_UNUSED const u64 offset)
+{
+  // a stream has no positions, every device simply continues with the next block
+
+  return true;
+}
@@ -0,0 +1,84 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef FEED_STREAM_H
+#define FEED_STREAM_H
+
+#define STREAM_BLOCK_SIZE   (256 * 1024)  // candidates are packed into blocks as <u16 length><bytes>
+#define STREAM_BLOCKS_CNT   32
+#define STREAM_READ_SIZE    (1024 * 1024)
+#define STREAM_POLL_MS      200           // how often a waiting reader or device checks for shutdown
+
+typedef struct stream_block
+{
+  u32 used;   // bytes
+  u32 cnt;    // candidates
+
+  u8  buf[STREAM_BLOCK_SIZE];
+
+} stream_block_t;
+
+typedef struct feed_global
+{
+  char  *path;
+  bool   is_fifo;
+
+  const status_ctx_t *status_ctx; // run_thread_level1 turns false on abort or quit
+
+  int    listen_fd;
+  int    fd;
+
+  // block pool: free blocks on a stack, filled blocks in a FIFO, both guarded by mux_blocks
+
+  stream_block_t *blocks_buf;
+
+  u32    free_idx[STREAM_BLOCKS_CNT];
+  u32    free_cnt;
+
+  u32    full_idx[STREAM_BLOCKS_CNT];
+  u32    full_pos;
+  u32    full_cnt;
+
+  bool   eof;
+  bool   stop;
+
+  hc_thread_mutex_t      mux_blocks;
+  hc_thread_semaphore_t  sem_full;
+  hc_thread_semaphore_t  sem_free;
+
+  hc_thread_t  reader_thread;
+  bool         reader_running;
+
+  char   reader_error[256];
+
+  // reader side read buffer
+
+  u8    *read_buf;
+  size_t read_pos;
+  size_t read_len;
+
+} feed_global_t;
+
+typedef struct feed_thread
+{
+  stream_block_t *block;    // block this device is consuming, NULL if none
+  u32             block_idx;
+  u32             block_pos;
+  u32             block_left;
+
+  bool            done;
+
+} feed_thread_t;
+
+bool global_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+void global_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+u64  global_keyspace  (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+
+bool thread_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+void thread_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+int  thread_next      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf);
+bool thread_seek      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset);
+
+#endif // FEED_STREAM_H
@@ -23,6 +23,7 @@
 #endif
 
 #include "seekdb.c"
+#include "readahead.c"
 
 const int GENERIC_PLUGIN_VERSION = GENERIC_PLUGIN_VERSION_REQ;
 
@@ -207,6 +208,8 @@ bool thread_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED ge
   #endif
   #endif
 
+  readahead_init (feed_thread);
+
   return true;
 }
 
@@ -238,6 +241,8 @@ int thread_next (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED gen
     return -1;
   }
 
+  readahead_next (feed_thread);
+
   hc_memchr_t hc_memchr = hc_memchr_get ();
 
   size_t remaining = fd_len - fd_off;
@@ -278,6 +283,8 @@ bool thread_seek (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED ge
     return false;
   }
 
+  readahead_release (feed_thread);
+
   u64 idx = offset / SEEKDB_STEP;
 
   if ((feed_global->seek_db) && (idx < feed_global->seek_count))
@@ -305,5 +312,7 @@ bool thread_seek (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED ge
     feed_thread->fd_line++;
   }
 
+  readahead_start (feed_thread);
+
   return true;
 }
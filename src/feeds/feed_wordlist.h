@@ -30,6 +30,12 @@ typedef struct feed_thread
   void  *fd_mem;
   u64    fd_line;
 
+  size_t ra_off;      // start of the range consumed since the last seek
+  size_t ra_end;      // read-ahead requested up to here
+  size_t ra_len;      // read-ahead window, learned from the previous chunk
+  bool   ra_drop;     // also drop consumed ranges from the page cache
+  bool   ra_strided;  // sequential advice replaced after the first seek
+
 } feed_thread_t;
 
 bool global_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
@@ -0,0 +1,517 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "convert.h"
+#include "filehandling.h"
+#include "folder.h"
+#include "shared.h"
+#include "timer.h"
+#include "event.h"
+#include "xxhash.h"
+#include "generic.h"
+#include "feed_wordlists.h"
+
+#if defined (_WIN)
+#include "mmap_windows.c"
+#else
+#include <sys/mman.h>
+#endif
+
+#include "seekdb.c"
+#include "readahead.c"
+
+// several wordlists or directories of wordlists as one keyspace
+//
+// -a 0 with a directory runs a full inner loop (count, autotune, dispatch, tail) per file, which dominates
+// the runtime on folders with many small files. this feed concatenates all files instead. every file keeps
+// its own seekdb (shared with feed_wordlist.so), and the list of files with their first global line number
+// forms a composite seekdb: a global line is found with a binary search over the files and then a seek
+// inside the file. a thread only has the file it is currently reading mapped.
+//
+// usage: -a 8 feeds/feed_wordlists.so wordlist|directory [wordlist|directory ...]
+
+const int GENERIC_PLUGIN_VERSION = GENERIC_PLUGIN_VERSION_REQ;
+
+const int GENERIC_PLUGIN_OPTIONS = GENERIC_PLUGIN_OPTIONS_AUTOHEX
+                                 | GENERIC_PLUGIN_OPTIONS_ICONV
+                                 | GENERIC_PLUGIN_OPTIONS_RULES;
+
+static void error_set (generic_global_ctx_t *global_ctx, const char *fmt, ...)
+{
+  global_ctx->error = true;
+
+  va_list ap;
+  va_start (ap, fmt);
+
+  vsnprintf (global_ctx->error_msg, sizeof (global_ctx->error_msg), fmt, ap);
+
+  va_end (ap);
+}
+
+static size_t process_word (const u8 *buf, const size_t len, u8 *out_buf)
+{
+  size_t word_len = len;
+
+  while ((word_len > 0) && (buf[word_len - 1] == '\r')) word_len--;
+
+  // important: the output buffer, provided by hashcat, has only space for PW_MAX (256)
+
+  const size_t report_len = MIN (word_len, PW_MAX);
+
+  memcpy ((char *) out_buf, buf, report_len);
+
+  return report_len;
+}
+
+static bool files_add (generic_global_ctx_t *global_ctx, feed_global_t *feed_global, char *path)
+{
+  if (hc_path_read (path) == false)
+  {
+    error_set (global_ctx, "%s: %s", path, strerror (errno));
+
+    return false;
+  }
+
+  // like -a 0, empty files are skipped silently
+
+  struct stat st;
+
+  if ((stat (path, &st) == -1) || (st.st_size == 0)) return true;
+
+  if (feed_global->files_cnt == feed_global->files_alloc)
+  {
+    const u32 files_alloc = MAX (feed_global->files_alloc * 2, 64);
+
+    feed_global->files_buf = (feed_file_t *) hcrealloc (feed_global->files_buf, feed_global->files_alloc * sizeof (feed_file_t), (files_alloc - feed_global->files_alloc) * sizeof (feed_file_t));
+
+    feed_global->files_alloc = files_alloc;
+  }
+
+  feed_file_t *feed_file = feed_global->files_buf + feed_global->files_cnt;
+
+  memset (feed_file, 0, sizeof (feed_file_t));
+
+  feed_file->path = hcstrdup (path);
+
+  feed_global->files_cnt++;
+
+  return true;
+}
+
+bool global_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  // create our own context
+
+  feed_global_t *feed_global = hcmalloc (sizeof (feed_global_t));
+
+  global_ctx->gbldata = feed_global;
+
+  // check user command line arguments
+
+  if (global_ctx->workc < 2)
+  {
+    error_set (global_ctx, "Invalid parameter count: %d. Count must be at least 2.", global_ctx->workc);
+
+    return false;
+  }
+
+  // same expansion as -a 0: arguments in command line order, the files of a directory sorted by name
+
+  for (int i = 1; i < global_ctx->workc; i++)
+  {
+    char *l0_filename = global_ctx->workv[i];
+
+    if (hc_path_exist (l0_filename) == false)
+    {
+      error_set (global_ctx, "%s: %s", l0_filename, strerror (errno));
+
+      return false;
+    }
+
+    char **dictionary_files = scan_directory (l0_filename);
+
+    if (dictionary_files == NULL) continue;
+
+    qsort (dictionary_files, (size_t) count_dictionaries (dictionary_files), sizeof (char *), sort_by_stringptr);
+
+    bool rc = true;
+
+    for (int d = 0; dictionary_files[d] != NULL; d++)
+    {
+      if ((rc == true) && (hc_path_is_file (dictionary_files[d]) == true))
+      {
+        rc = files_add (global_ctx, feed_global, dictionary_files[d]);
+      }
+
+      hcfree (dictionary_files[d]);
+    }
+
+    hcfree (dictionary_files);
+
+    if (rc == false) return false;
+  }
+
+  if (feed_global->files_cnt == 0)
+  {
+    error_set (global_ctx, "No usable wordlists found");
+
+    return false;
+  }
+
+  return true;
+}
+
+void global_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_global == NULL) return;
+
+  for (u32 i = 0; i < feed_global->files_cnt; i++)
+  {
+    feed_file_t *feed_file = feed_global->files_buf + i;
+
+    hcfree (feed_file->seek_db);
+    hcfree (feed_file->path);
+  }
+
+  hcfree (feed_global->files_buf);
+
+  hcfree (feed_global);
+
+  global_ctx->gbldata = NULL;
+}
+
+static bool file_map (generic_global_ctx_t *global_ctx, feed_thread_t *feed_thread, const u32 file_idx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  feed_file_t *feed_file = feed_global->files_buf + file_idx;
+
+  if (hc_fopen_raw (&feed_thread->hcfile, feed_file->path, "rb") == false)
+  {
+    error_set (global_ctx, "%s: %s", feed_file->path, strerror (errno));
+
+    return false;
+  }
+
+  struct stat s;
+
+  if (hc_fstat (&feed_thread->hcfile, &s) == -1)
+  {
+    error_set (global_ctx, "%s: %s", feed_file->path, strerror (errno));
+
+    hc_fclose (&feed_thread->hcfile);
+
+    return false;
+  }
+
+  if (s.st_size == 0)
+  {
+    error_set (global_ctx, "%s: zero size", feed_file->path);
+
+    hc_fclose (&feed_thread->hcfile);
+
+    return false;
+  }
+
+  void *fd_mem = mmap (NULL, s.st_size, PROT_READ, MAP_PRIVATE, feed_thread->hcfile.fd, 0);
+
+  if (fd_mem == MAP_FAILED)
+  {
+    error_set (global_ctx, "%s: mmap failed", feed_file->path);
+
+    hc_fclose (&feed_thread->hcfile);
+
+    return false;
+  }
+
+  feed_thread->file_idx = file_idx;
+  feed_thread->fd_mem   = fd_mem;
+  feed_thread->fd_len   = s.st_size;
+  feed_thread->fd_off   = 0;
+  feed_thread->fd_line  = 0;
+
+  // kernel advice
+
+  #if !defined (_WIN)
+  #ifdef POSIX_MADV_SEQUENTIAL
+  posix_madvise (feed_thread->fd_mem, feed_thread->fd_len, POSIX_MADV_SEQUENTIAL);
+  #endif
+  #endif
+
+  readahead_init (feed_thread);
+
+  return true;
+}
+
+static void file_unmap (MAYBE_UNUSED generic_global_ctx_t *global_ctx, feed_thread_t *feed_thread)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_thread->file_idx == feed_global->files_cnt) return;
+
+  readahead_release (feed_thread);
+
+  munmap (feed_thread->fd_mem, feed_thread->fd_len);
+
+  hc_fclose (&feed_thread->hcfile);
+
+  feed_thread->file_idx = feed_global->files_cnt;
+}
+
+u64 global_keyspace (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  // with thousands of files, report the cache state once for the whole set
+
+  u64 bytes_total = 0;
+  u32 files_built = 0;
+
+  hc_timer_t start;
+
+  hc_timer_set (&start);
+
+  feed_thread_t feed_thread;
+
+  memset (&feed_thread, 0, sizeof (feed_thread));
+
+  feed_thread.file_idx = feed_global->files_cnt;
+
+  for (u32 i = 0; i < feed_global->files_cnt; i++)
+  {
+    feed_file_t *feed_file = feed_global->files_buf + i;
+
+    char *seekdb_file = seekdb_path (global_ctx, feed_file->path);
+
+    if (seekdb_file == NULL)
+    {
+      error_set (global_ctx, "%s: %s", feed_file->path, strerror (errno));
+
+      return -1ULL;
+    }
+
+    feed_file->seek_db = seekdb_load (seekdb_file, &feed_file->seek_count, &feed_file->line_count, &feed_file->size);
+
+    if (feed_file->seek_db == NULL)
+    {
+      if (file_map (global_ctx, &feed_thread, i) == false)
+      {
+        hcfree (seekdb_file);
+
+        return -1ULL;
+      }
+
+      feed_file->seek_db = seekdb_build (&feed_thread, seekdb_file, feed_file->path, &feed_file->seek_count, &feed_file->line_count, &feed_file->size, hashcat_ctx);
+
+      file_unmap (global_ctx, &feed_thread);
+
+      files_built++;
+    }
+
+    hcfree (seekdb_file);
+
+    feed_file->line_off = feed_global->line_count;
+
+    feed_global->line_count += feed_file->line_count;
+
+    bytes_total += feed_file->size;
+  }
+
+  if (files_built == 0)
+  {
+    cache_hit_t cache_hit;
+
+    cache_hit.dictfile      = global_ctx->workv[1];
+    cache_hit.stat.st_size  = bytes_total;
+    cache_hit.cached_cnt    = feed_global->line_count;
+    cache_hit.keyspace      = feed_global->line_count;
+
+    EVENT_DATA (EVENT_WORDLIST_CACHE_HIT, &cache_hit, sizeof (cache_hit));
+  }
+  else
+  {
+    cache_generate_t cache_generate;
+
+    cache_generate.dictfile    = global_ctx->workv[1];
+    cache_generate.comp        = bytes_total;
+    cache_generate.percent     = 100;
+    cache_generate.cnt         = feed_global->line_count;
+    cache_generate.cnt2        = feed_global->line_count;
+    cache_generate.runtime     = MAX (hc_timer_get (start), 0.001);
+
+    EVENT_DATA (EVENT_WORDLIST_CACHE_GENERATE, &cache_generate, sizeof (cache_generate));
+  }
+
+  return feed_global->line_count;
+}
+
+bool thread_init (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  feed_thread_t *feed_thread = hcmalloc (sizeof (feed_thread_t));
+
+  if (feed_thread == NULL)
+  {
+    error_set (global_ctx, "hcmalloc failed");
+
+    return false;
+  }
+
+  thread_ctx->thrdata = feed_thread;
+
+  feed_thread->file_idx = feed_global->files_cnt;
+
+  return true;
+}
+
+void thread_term (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+
+  file_unmap (global_ctx, feed_thread);
+
+  hcfree (feed_thread);
+
+  thread_ctx->thrdata = NULL;
+}
+
+int thread_next (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (feed_thread->file_idx == feed_global->files_cnt) return -1;
+
+  // the line count of the seekdb decides where a file ends, so the keyspace and the stream always agree
+
+  if (feed_thread->fd_line == feed_global->files_buf[feed_thread->file_idx].line_count)
+  {
+    const u32 file_idx = feed_thread->file_idx + 1;
+
+    file_unmap (global_ctx, feed_thread);
+
+    if (file_idx == feed_global->files_cnt) return -1;
+
+    if (file_map (global_ctx, feed_thread, file_idx) == false) return -1;
+  }
+
+  const u8      *fd_mem = feed_thread->fd_mem;
+  const size_t   fd_len = feed_thread->fd_len;
+  const size_t   fd_off = feed_thread->fd_off;
+
+  if (fd_off >= fd_len)
+  {
+    error_set (global_ctx, "%s: next fd_off >= fd_len: %zu:%zu", feed_global->files_buf[feed_thread->file_idx].path, fd_off, fd_len);
+
+    return -1;
+  }
+
+  readahead_next (feed_thread);
+
+  hc_memchr_t hc_memchr = hc_memchr_get ();
+
+  const size_t remaining = fd_len - fd_off;
+  const size_t step      = hc_memchr (fd_mem + fd_off, '\n', remaining);
+
+  const size_t word_len = process_word (fd_mem + fd_off, step, out_buf);
+
+  // if no newline, process till EOF
+
+  feed_thread->fd_off += (step == remaining) ? step : step + 1; // +1 = skip '\n'
+  feed_thread->fd_line++;
+
+  return (int) word_len;
+}
+
+bool thread_seek (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset)
+{
+  feed_thread_t *feed_thread = thread_ctx->thrdata;
+  feed_global_t *feed_global = global_ctx->gbldata;
+
+  if (offset >= feed_global->line_count)
+  {
+    error_set (global_ctx, "seek target past EOF: %zu", (size_t) offset);
+
+    return false;
+  }
+
+  // composite seekdb: last file with line_off <= offset, never an empty one since those are skipped at init
+
+  u32 lo = 0;
+  u32 hi = feed_global->files_cnt - 1;
+
+  while (lo < hi)
+  {
+    const u32 mid = lo + ((hi - lo + 1) / 2);
+
+    if (feed_global->files_buf[mid].line_off <= offset)
+    {
+      lo = mid;
+    }
+    else
+    {
+      hi = mid - 1;
+    }
+  }
+
+  const feed_file_t *feed_file = feed_global->files_buf + lo;
+
+  const u64 file_offset = offset - feed_file->line_off;
+
+  // a forward seek inside the mapped file continues from the current position
+
+  const bool reuse = (feed_thread->file_idx == lo) && (feed_thread->fd_line <= file_offset);
+
+  if (reuse == true)
+  {
+    readahead_release (feed_thread);
+  }
+  else
+  {
+    file_unmap (global_ctx, feed_thread);
+
+    if (file_map (global_ctx, feed_thread, lo) == false) return false;
+  }
+
+  u64 idx = file_offset / SEEKDB_STEP;
+
+  if ((feed_file->seek_db) && (idx < feed_file->seek_count) && ((idx * SEEKDB_STEP) > feed_thread->fd_line))
+  {
+    feed_thread->fd_off  = feed_file->seek_db[idx];
+    feed_thread->fd_line = idx * SEEKDB_STEP;
+  }
+
+  const u8      *fd_mem = feed_thread->fd_mem;
+  const size_t   fd_len = feed_thread->fd_len;
+
+  hc_memchr_t hc_memchr = hc_memchr_get ();
+
+  while (feed_thread->fd_line < file_offset)
+  {
+    size_t remaining = fd_len - feed_thread->fd_off;
+
+    if (remaining == 0)
+    {
+      error_set (global_ctx, "%s: Seek past EOF", feed_file->path);
+
+      return false;
+    }
+
+    size_t step = hc_memchr (fd_mem + feed_thread->fd_off, '\n', remaining);
+
+    feed_thread->fd_off += step + 1; // +1 for '\n'
+    feed_thread->fd_line++;
+  }
+
+  readahead_start (feed_thread);
+
+  return true;
+}
@@ -0,0 +1,66 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef FEED_WORDLISTS_H
+#define FEED_WORDLISTS_H
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+typedef struct feed_file
+{
+  char  *path;
+
+  u64    line_off;    // global line number of the first line of this file
+  u64    line_count;
+  u64    size;
+
+  u64   *seek_db;     // per-file seekdb, line_off + i * SEEKDB_STEP is at byte seek_db[i]
+  u64    seek_count;
+
+} feed_file_t;
+
+typedef struct feed_global
+{
+  // the composite seekdb: all files in command line order, directories expanded and sorted
+
+  feed_file_t *files_buf;
+  u32          files_cnt;
+  u32          files_alloc;
+
+  u64          line_count;
+
+} feed_global_t;
+
+typedef struct feed_thread
+{
+  u32    file_idx;    // currently mapped file, files_cnt if none
+
+  HCFILE hcfile;
+
+  size_t fd_off;
+  size_t fd_len;
+  void  *fd_mem;
+  u64    fd_line;     // line number inside the current file
+
+  size_t ra_off;      // start of the range consumed since the last seek
+  size_t ra_end;      // read-ahead requested up to here
+  size_t ra_len;      // read-ahead window, learned from the previous chunk
+  bool   ra_drop;     // also drop consumed ranges from the page cache
+  bool   ra_strided;  // sequential advice replaced after the first seek
+
+} feed_thread_t;
+
+bool global_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+void global_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+u64  global_keyspace  (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t **thread_ctx, MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx);
+
+bool thread_init      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+void thread_term      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx);
+int  thread_next      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, u8 *out_buf);
+bool thread_seek      (MAYBE_UNUSED generic_global_ctx_t *global_ctx, MAYBE_UNUSED generic_thread_ctx_t *thread_ctx, const u64 offset);
+
+#endif // FEED_WORDLISTS_H
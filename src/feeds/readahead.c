@@ -0,0 +1,143 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+// explicit read-ahead for the mmap based feeds
+//
+// the dispatcher hands each device non-contiguous chunks of the wordlist, so from the kernel's point of view
+// every thread jumps around in the file and its read-ahead heuristic guesses wrong. instead, after each
+// thread_seek, which is the start of a chunk reservation, the pages from the seek target on are requested
+// with MADV_WILLNEED, and the window is moved forward while thread_next consumes it. the window size is
+// learned from the size of the previous chunk of the same thread.
+//
+// the range consumed since the last seek is released with MADV_DONTNEED. for files too large to stay in
+// the page cache anyway it is also dropped with POSIX_FADV_DONTNEED, so a huge list does not evict the
+// rest of the page cache.
+//
+// expects feed_thread_t with fd_mem, fd_len, fd_off, hcfile and the ra_* fields.
+
+static const size_t READAHEAD_MIN = 1 * 1024 * 1024;
+static const size_t READAHEAD_MAX = 64 * 1024 * 1024;
+
+#if !defined (_WIN)
+
+static size_t readahead_page_size (void)
+{
+  const long page_size = sysconf (_SC_PAGESIZE);
+
+  return (page_size > 0) ? (size_t) page_size : 4096;
+}
+
+static bool readahead_drop_default (const size_t fd_len)
+{
+  #if defined (_SC_PHYS_PAGES)
+  const long pages = sysconf (_SC_PHYS_PAGES);
+
+  if (pages <= 0) return false;
+
+  const u64 phys_mem = (u64) pages * readahead_page_size ();
+
+  return ((u64) fd_len > (phys_mem / 2));
+  #else
+  return false;
+  #endif
+}
+
+#endif
+
+static void readahead_init (feed_thread_t *feed_thread)
+{
+  feed_thread->ra_off     = feed_thread->fd_off;
+  feed_thread->ra_end     = feed_thread->fd_off;
+  feed_thread->ra_len     = READAHEAD_MIN;
+  feed_thread->ra_strided = false;
+
+  #if !defined (_WIN)
+  feed_thread->ra_drop = readahead_drop_default (feed_thread->fd_len);
+  #else
+  feed_thread->ra_drop = false;
+  #endif
+}
+
+static void readahead_advance (feed_thread_t *feed_thread)
+{
+  const size_t end = MIN (feed_thread->ra_end + feed_thread->ra_len, feed_thread->fd_len);
+
+  #if !defined (_WIN)
+  const size_t page_size = readahead_page_size ();
+
+  const size_t beg = feed_thread->ra_end & ~(page_size - 1);
+
+  if (end > beg)
+  {
+    madvise ((u8 *) feed_thread->fd_mem + beg, end - beg, MADV_WILLNEED);
+  }
+  #endif
+
+  feed_thread->ra_end = end;
+}
+
+// call from thread_next, cheap unless the window needs to move
+
+static inline void readahead_next (feed_thread_t *feed_thread)
+{
+  if ((feed_thread->fd_off + (feed_thread->ra_len / 2)) < feed_thread->ra_end) return;
+
+  if (feed_thread->ra_end == feed_thread->fd_len) return;
+
+  readahead_advance (feed_thread);
+}
+
+// release what this thread consumed since the previous seek, only whole pages so neighbour chunks are not affected
+
+static void readahead_release (feed_thread_t *feed_thread)
+{
+  const size_t used_beg = feed_thread->ra_off;
+  const size_t used_end = MIN (feed_thread->fd_off, feed_thread->fd_len);
+
+  if (used_end <= used_beg) return;
+
+  feed_thread->ra_len = MIN (MAX (used_end - used_beg, READAHEAD_MIN), READAHEAD_MAX);
+
+  #if !defined (_WIN)
+  const size_t page_size = readahead_page_size ();
+
+  const size_t beg = (used_beg + page_size - 1) & ~(page_size - 1);
+  const size_t end = used_end & ~(page_size - 1);
+
+  if (end <= beg) return;
+
+  madvise ((u8 *) feed_thread->fd_mem + beg, end - beg, MADV_DONTNEED);
+
+  #if defined (POSIX_FADV_DONTNEED)
+  if (feed_thread->ra_drop == true)
+  {
+    posix_fadvise (feed_thread->hcfile.fd, (off_t) beg, (off_t) (end - beg), POSIX_FADV_DONTNEED);
+  }
+  #endif
+  #endif
+}
+
+// call from thread_seek, release before moving fd_off and start after
+
+static void readahead_start (feed_thread_t *feed_thread)
+{
+  // thread_init set POSIX_MADV_SEQUENTIAL, which suits the seekdb scan but not strided chunks
+
+  #if !defined (_WIN)
+  #ifdef POSIX_MADV_NORMAL
+  if (feed_thread->ra_strided == false)
+  {
+    posix_madvise (feed_thread->fd_mem, feed_thread->fd_len, POSIX_MADV_NORMAL);
+  }
+  #endif
+  #endif
+
+  feed_thread->ra_strided = true;
+
+  feed_thread->ra_off = feed_thread->fd_off;
+  feed_thread->ra_end = feed_thread->fd_off;
+
+  readahead_advance (feed_thread);
+}
@@ -32,6 +32,9 @@
 #include "hlfmt.h"
 #include "induct.h"
 #include "interface.h"
+#include "kernel_cache.h"
+#include "crack_sink.h"
+#include "module_registry.h"
 #include "logfile.h"
 #include "loopback.h"
 #include "monitor.h"
@@ -42,6 +45,7 @@
 #include "pidfile.h"
 #include "potfile.h"
 #include "restore.h"
+#include "rulestats.h"
 #include "selftest.h"
 #include "status.h"
 #include "generic.h"
@@ -157,7 +161,7 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
     for (u32 i = 0; i < status_ctx->words_off; i++)
     {
-      status_ctx->words_progress_restored[i] = progress_restored;
+      status_progress_set_restored (hashcat_ctx, i, progress_restored);
     }
   }
   else
@@ -166,7 +170,7 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
     for (u32 i = 0; i < hashes->salts_cnt; i++)
     {
-      status_ctx->words_progress_restored[i] = progress_restored;
+      status_progress_set_restored (hashcat_ctx, i, progress_restored);
     }
   }
 
@@ -352,6 +356,14 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   hcfree (threads_param);
 
+  // write out queued cracks before the final status
+
+  crack_sink_flush (hashcat_ctx);
+
+  // words tested by each rule
+
+  rulestats_tested_add (hashcat_ctx);
+
   if ((status_ctx->devices_status == STATUS_RUNNING) && (status_ctx->checkpoint_shutdown == true))
   {
     myabort_checkpoint (hashcat_ctx);
@@ -519,6 +531,7 @@ static int inner1_loop (hashcat_ctx_t *hashcat_ctx)
 
 static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
 {
+  crack_sink_ctx_t     *crack_sink_ctx      = hashcat_ctx->crack_sink_ctx;
   hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
   hashes_t             *hashes              = hashcat_ctx->hashes;
   mask_ctx_t           *mask_ctx            = hashcat_ctx->mask_ctx;
@@ -806,6 +819,12 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
 
   if (generic_ctx_init (hashcat_ctx) == -1) return -1;
 
+  /**
+   * rule stats, needs the final rules of straight or generic mode
+   */
+
+  if (rulestats_rules_init (hashcat_ctx) == -1) return -1;
+
   /**
    * prevent the user from using --skip/--limit together with maskfile and/or multiple word lists
    */
@@ -910,6 +929,7 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
         mask_ctx_destroy        (hashcat_ctx);
         status_progress_destroy (hashcat_ctx);
         generic_ctx_destroy     (hashcat_ctx);
+        rulestats_rules_destroy (hashcat_ctx);
         straight_ctx_destroy    (hashcat_ctx);
         wl_data_destroy         (hashcat_ctx);
 
@@ -923,34 +943,52 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
   EVENT (EVENT_BACKEND_SESSION_POST);
 
   /**
-   * create self-test threads
+   * --kernel-cache-prewarm only wants the kernels to be built and cached
    */
 
-  if ((hashconfig->opts_type & OPTS_TYPE_SELF_TEST_DISABLE) == 0)
+  if (user_options->kernel_cache_prewarm == true)
   {
-    EVENT (EVENT_SELFTEST_STARTING);
+    // finalize backend session
 
-    thread_param_t *threads_param = (thread_param_t *) hccalloc (backend_ctx->backend_devices_cnt, sizeof (thread_param_t));
+    backend_session_destroy (hashcat_ctx);
 
-    hc_thread_t *selftest_threads = (hc_thread_t *) hccalloc (backend_ctx->backend_devices_cnt, sizeof (hc_thread_t));
+    // clean up
 
-    status_ctx->devices_status = STATUS_SELFTEST;
+    #ifdef WITH_BRAIN
+    brain_ctx_destroy       (hashcat_ctx);
+    #endif
 
-    for (int backend_devices_idx = 0; backend_devices_idx < backend_ctx->backend_devices_cnt; backend_devices_idx++)
-    {
-      thread_param_t *thread_param = threads_param + backend_devices_idx;
+    bridges_salt_destroy    (hashcat_ctx);
+    bridges_destroy         (hashcat_ctx);
+    bitmap_ctx_destroy      (hashcat_ctx);
+    combinator_ctx_destroy  (hashcat_ctx);
+    cpt_ctx_destroy         (hashcat_ctx);
+    hashconfig_destroy      (hashcat_ctx);
+    hashes_destroy          (hashcat_ctx);
+    mask_ctx_destroy        (hashcat_ctx);
+    status_progress_destroy (hashcat_ctx);
+    generic_ctx_destroy     (hashcat_ctx);
+    rulestats_rules_destroy (hashcat_ctx);
+    straight_ctx_destroy    (hashcat_ctx);
+    wl_data_destroy         (hashcat_ctx);
 
-      thread_param->hashcat_ctx = hashcat_ctx;
-      thread_param->tid         = backend_devices_idx;
+    return 0;
+  }
 
-      hc_thread_create (selftest_threads[backend_devices_idx], thread_selftest, thread_param);
-    }
+  /**
+   * collect self-test results, each device ran its self-test right after its own setup in backend_session_begin()
+   */
 
-    hc_thread_wait (backend_ctx->backend_devices_cnt, selftest_threads);
+  if ((hashconfig->opts_type & OPTS_TYPE_SELF_TEST_DISABLE) == 0)
+  {
+    // no device got far enough to announce it
 
-    hcfree (threads_param);
+    if (backend_ctx->selftest_started == false)
+    {
+      EVENT (EVENT_SELFTEST_STARTING);
 
-    hcfree (selftest_threads);
+      status_ctx->devices_status = STATUS_SELFTEST;
+    }
 
     // check for any selftest failures
 
@@ -1014,6 +1052,13 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
       inner_threads_cnt++;
     }
 
+    if (crack_sink_ctx->enabled == true)
+    {
+      hc_thread_create (inner_threads[inner_threads_cnt], thread_crack_sink, hashcat_ctx);
+
+      inner_threads_cnt++;
+    }
+
     if (module_ctx->module_advice_notice != MODULE_DEFAULT && user_options->quiet == false)
     {
       char *t_module_advice_notice = (char *) module_ctx->module_advice_notice (hashconfig, hashcat_ctx->user_options, user_options_extra);
@@ -1077,6 +1122,10 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
 
   potfile_write_close (hashcat_ctx);
 
+  // rule stats, merged with the ones of previous sessions
+
+  rulestats_write (hashcat_ctx);
+
   // finalize backend session
 
   backend_session_destroy (hashcat_ctx);
@@ -1097,6 +1146,7 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx, const int iteration)
   mask_ctx_destroy        (hashcat_ctx);
   status_progress_destroy (hashcat_ctx);
   generic_ctx_destroy     (hashcat_ctx);
+  rulestats_rules_destroy (hashcat_ctx);
   straight_ctx_destroy    (hashcat_ctx);
   wl_data_destroy         (hashcat_ctx);
 
@@ -1124,6 +1174,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->bridge_ctx         = (bridge_ctx_t *)          hcmalloc (sizeof (bridge_ctx_t));
   hashcat_ctx->combinator_ctx     = (combinator_ctx_t *)      hcmalloc (sizeof (combinator_ctx_t));
   hashcat_ctx->cpt_ctx            = (cpt_ctx_t *)             hcmalloc (sizeof (cpt_ctx_t));
+  hashcat_ctx->crack_sink_ctx     = (crack_sink_ctx_t *)      hcmalloc (sizeof (crack_sink_ctx_t));
   hashcat_ctx->debugfile_ctx      = (debugfile_ctx_t *)       hcmalloc (sizeof (debugfile_ctx_t));
   hashcat_ctx->dictstat_ctx       = (dictstat_ctx_t *)        hcmalloc (sizeof (dictstat_ctx_t));
   hashcat_ctx->event_ctx          = (event_ctx_t *)           hcmalloc (sizeof (event_ctx_t));
@@ -1134,6 +1185,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->hashes             = (hashes_t *)              hcmalloc (sizeof (hashes_t));
   hashcat_ctx->hwmon_ctx          = (hwmon_ctx_t *)           hcmalloc (sizeof (hwmon_ctx_t));
   hashcat_ctx->induct_ctx         = (induct_ctx_t *)          hcmalloc (sizeof (induct_ctx_t));
+  hashcat_ctx->kernel_cache_ctx   = (kernel_cache_ctx_t *)    hcmalloc (sizeof (kernel_cache_ctx_t));
   hashcat_ctx->logfile_ctx        = (logfile_ctx_t *)         hcmalloc (sizeof (logfile_ctx_t));
   hashcat_ctx->loopback_ctx       = (loopback_ctx_t *)        hcmalloc (sizeof (loopback_ctx_t));
   hashcat_ctx->mask_ctx           = (mask_ctx_t *)            hcmalloc (sizeof (mask_ctx_t));
@@ -1144,6 +1196,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->pidfile_ctx        = (pidfile_ctx_t *)         hcmalloc (sizeof (pidfile_ctx_t));
   hashcat_ctx->potfile_ctx        = (potfile_ctx_t *)         hcmalloc (sizeof (potfile_ctx_t));
   hashcat_ctx->restore_ctx        = (restore_ctx_t *)         hcmalloc (sizeof (restore_ctx_t));
+  hashcat_ctx->rulestats_ctx      = (rulestats_ctx_t *)       hcmalloc (sizeof (rulestats_ctx_t));
   hashcat_ctx->status_ctx         = (status_ctx_t *)          hcmalloc (sizeof (status_ctx_t));
   hashcat_ctx->straight_ctx       = (straight_ctx_t *)        hcmalloc (sizeof (straight_ctx_t));
   hashcat_ctx->tuning_db          = (tuning_db_t *)           hcmalloc (sizeof (tuning_db_t));
@@ -1161,6 +1214,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->bridge_ctx);
   hcfree (hashcat_ctx->combinator_ctx);
   hcfree (hashcat_ctx->cpt_ctx);
+  hcfree (hashcat_ctx->crack_sink_ctx);
   hcfree (hashcat_ctx->debugfile_ctx);
   hcfree (hashcat_ctx->dictstat_ctx);
   hcfree (hashcat_ctx->event_ctx);
@@ -1171,6 +1225,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->hashes);
   hcfree (hashcat_ctx->hwmon_ctx);
   hcfree (hashcat_ctx->induct_ctx);
+  hcfree (hashcat_ctx->kernel_cache_ctx);
   hcfree (hashcat_ctx->logfile_ctx);
   hcfree (hashcat_ctx->loopback_ctx);
   hcfree (hashcat_ctx->mask_ctx);
@@ -1181,6 +1236,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->pidfile_ctx);
   hcfree (hashcat_ctx->potfile_ctx);
   hcfree (hashcat_ctx->restore_ctx);
+  hcfree (hashcat_ctx->rulestats_ctx);
   hcfree (hashcat_ctx->status_ctx);
   hcfree (hashcat_ctx->straight_ctx);
   hcfree (hashcat_ctx->tuning_db);
@@ -1327,12 +1383,24 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder
 
   if (potfile_init (hashcat_ctx) == -1) return -1;
 
+  /**
+   * crack sink init
+   */
+
+  if (crack_sink_init (hashcat_ctx) == -1) return -1;
+
   /**
    * dictstat init
    */
 
   if (dictstat_init (hashcat_ctx) == -1) return -1;
 
+  /**
+   * kernel cache init
+   */
+
+  if (kernel_cache_init (hashcat_ctx) == -1) return -1;
+
   /**
    * loopback init
    */
@@ -1345,6 +1413,12 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, const char *install_folder
 
   if (debugfile_init (hashcat_ctx) == -1) return -1;
 
+  /**
+   * rule stats init
+   */
+
+  if (rulestats_init (hashcat_ctx) == -1) return -1;
+
   /**
    * Try to detect if all the files we're going to use are accessible in the mode we want them
    */
@@ -1629,10 +1703,83 @@ bool autodetect_hashmode_test (hashcat_ctx_t *hashcat_ctx)
   return success;
 }
 
+static void autodetect_hashmode (hashcat_ctx_t *hashcat_ctx, const u32 hash_mode, usage_sort_t *usage_sort_buf, int *usage_sort_cnt)
+{
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  user_options->hash_mode = hash_mode;
+
+  const int hashconfig_init_rc = hashconfig_init (hashcat_ctx);
+
+  if (hashconfig_init_rc == 0)
+  {
+    const bool test_rc = autodetect_hashmode_test (hashcat_ctx);
+
+    if (test_rc == true)
+    {
+      usage_sort_buf[*usage_sort_cnt].hash_mode     = hashcat_ctx->hashconfig->hash_mode;
+      usage_sort_buf[*usage_sort_cnt].hash_name     = hcstrdup (hashcat_ctx->hashconfig->hash_name);
+      usage_sort_buf[*usage_sort_cnt].hash_category = hashcat_ctx->hashconfig->hash_category;
+
+      *usage_sort_cnt += 1;
+    }
+  }
+
+  // clean up
+
+  hashconfig_destroy (hashcat_ctx);
+}
+
+// read the first lines of the hashfile (or take the hash from the command line) for the registry prefilter
+
+static int autodetect_probes (hashcat_ctx_t *hashcat_ctx, char **probe_buf, const int probe_max)
+{
+  const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  const char *hc_hash = user_options_extra->hc_hash;
+
+  if (hc_hash == NULL) return 0;
+
+  if (hc_path_exist (hc_hash) == false)
+  {
+    probe_buf[0] = hcstrdup (hc_hash);
+
+    return 1;
+  }
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, hc_hash, "rb") == false) return 0;
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  int probe_cnt = 0;
+
+  while (!hc_feof (&fp))
+  {
+    if (probe_cnt == probe_max) break;
+
+    const size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE);
+
+    if (line_len == 0) continue;
+
+    probe_buf[probe_cnt] = hcstrdup (line_buf);
+
+    probe_cnt++;
+  }
+
+  hcfree (line_buf);
+
+  hc_fclose (&fp);
+
+  return probe_cnt;
+}
+
 int autodetect_hashmodes (hashcat_ctx_t *hashcat_ctx, usage_sort_t *usage_sort_buf)
 {
-  folder_config_t *folder_config = hashcat_ctx->folder_config;
-  user_options_t  *user_options  = hashcat_ctx->user_options;
+  folder_config_t      *folder_config      = hashcat_ctx->folder_config;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
 
   int usage_sort_cnt = 0;
 
@@ -1644,46 +1791,84 @@ int autodetect_hashmodes (hashcat_ctx_t *hashcat_ctx, usage_sort_t *usage_sort_b
 
   user_options->quiet = true;
 
-  char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
+  // the module registry tells us which modes exist and lets us skip the modules which can not match without loading them
 
-  if (modulefile == NULL) return -1;
+  module_registry_entry_t *registry = NULL;
 
-  // brute force all the modes
+  const int registry_cnt = module_registry_load (hashcat_ctx, &registry);
 
-  for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
+  if (registry_cnt > 0)
   {
-    user_options->hash_mode = i;
-
-    // this is just to find out of that hash-mode exists or not
+    #define AUTODETECT_PROBES 100
 
-    module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+    char **probe_buf = (char **) hccalloc (AUTODETECT_PROBES, sizeof (char *));
 
-    if (hc_path_exist (modulefile) == false) continue;
+    const int probe_cnt = autodetect_probes (hashcat_ctx, probe_buf, AUTODETECT_PROBES);
 
-    // we know it exists, so load the plugin
+    const bool is_file = hc_path_read (user_options_extra->hc_hash);
 
-    const int hashconfig_init_rc = hashconfig_init (hashcat_ctx);
+    bool *sig_skipped = (bool *) hccalloc (registry_cnt, sizeof (bool));
 
-    if (hashconfig_init_rc == 0)
+    for (int registry_idx = 0; registry_idx < registry_cnt; registry_idx++)
     {
-      const bool test_rc = autodetect_hashmode_test (hashcat_ctx);
+      const module_registry_entry_t *entry = registry + registry_idx;
 
-      if (test_rc == true)
+      if (module_registry_prefilter (entry, probe_buf, probe_cnt, is_file) == false)
       {
-        usage_sort_buf[usage_sort_cnt].hash_mode     = hashcat_ctx->hashconfig->hash_mode;
-        usage_sort_buf[usage_sort_cnt].hash_name     = hcstrdup (hashcat_ctx->hashconfig->hash_name);
-        usage_sort_buf[usage_sort_cnt].hash_category = hashcat_ctx->hashconfig->hash_category;
+        // remember the ones we dropped only because of their signature, see below
 
-        usage_sort_cnt++;
+        if ((entry->opts_type & (OPTS_TYPE_AUTODETECT_DISABLE | OPTS_TYPE_BINARY_HASHFILE)) == 0) sig_skipped[registry_idx] = true;
+
+        continue;
       }
+
+      autodetect_hashmode (hashcat_ctx, entry->hash_mode, usage_sort_buf, &usage_sort_cnt);
     }
 
-    // clean up
+    // the signature is taken from the self-test hash only, but some modules accept more than one (like $P$ and $H$)
+    // if nothing matched, give those modules a chance before we give up
+
+    if (usage_sort_cnt == 0)
+    {
+      for (int registry_idx = 0; registry_idx < registry_cnt; registry_idx++)
+      {
+        if (sig_skipped[registry_idx] == false) continue;
+
+        autodetect_hashmode (hashcat_ctx, registry[registry_idx].hash_mode, usage_sort_buf, &usage_sort_cnt);
+      }
+    }
+
+    hcfree (sig_skipped);
+
+    for (int probe_idx = 0; probe_idx < probe_cnt; probe_idx++) hcfree (probe_buf[probe_idx]);
 
-    hashconfig_destroy (hashcat_ctx);
+    hcfree (probe_buf);
+
+    hcfree (registry);
   }
+  else
+  {
+    char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
 
-  hcfree (modulefile);
+    if (modulefile == NULL) return -1;
+
+    // brute force all the modes
+
+    for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
+    {
+      // this is just to find out of that hash-mode exists or not
+
+      module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+
+      if (hc_path_exist (modulefile) == false) continue;
+
+      // we know it exists, so load the plugin
+
+      autodetect_hashmode (hashcat_ctx, i, usage_sort_buf, &usage_sort_cnt);
+    }
+
+    hcfree (modulefile);
+  }
 
   qsort (usage_sort_buf, usage_sort_cnt, sizeof (usage_sort_t), sort_by_usage);
 
@@ -1896,6 +2081,13 @@ int hashcat_session_execute (hashcat_ctx_t *hashcat_ctx)
 
   dictstat_write (hashcat_ctx);
 
+  // merge the kernels built or used by --kernel-cache-prewarm into the shared pack
+
+  if (user_options->kernel_cache_prewarm == true)
+  {
+    if (kernel_cache_pack_write (hashcat_ctx) == -1) rc_final = -1;
+  }
+
   // final logfile entry
 
   const time_t proc_stop = time (NULL);
@@ -1990,11 +2182,13 @@ int hashcat_session_destroy (hashcat_ctx_t *hashcat_ctx)
   #endif
   #endif
 
+  crack_sink_destroy          (hashcat_ctx);
   debugfile_destroy           (hashcat_ctx);
   dictstat_destroy            (hashcat_ctx);
   folder_config_destroy       (hashcat_ctx);
   hwmon_ctx_destroy           (hashcat_ctx);
   induct_ctx_destroy          (hashcat_ctx);
+  kernel_cache_destroy        (hashcat_ctx);
   logfile_destroy             (hashcat_ctx);
   loopback_destroy            (hashcat_ctx);
   backend_ctx_devices_destroy (hashcat_ctx);
@@ -2004,6 +2198,7 @@ int hashcat_session_destroy (hashcat_ctx_t *hashcat_ctx)
   pidfile_ctx_destroy         (hashcat_ctx);
   potfile_destroy             (hashcat_ctx);
   restore_ctx_destroy         (hashcat_ctx);
+  rulestats_destroy           (hashcat_ctx);
   tuning_db_destroy           (hashcat_ctx);
   user_options_destroy        (hashcat_ctx);
   user_options_extra_destroy  (hashcat_ctx);
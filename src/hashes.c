@@ -8,6 +8,7 @@
 #include "memory.h"
 #include "event.h"
 #include "convert.h"
+#include "crack_sink.h"
 #include "debugfile.h"
 #include "filehandling.h"
 #include "hlfmt.h"
@@ -18,10 +19,12 @@
 #include "outfile.h"
 #include "potfile.h"
 #include "rp.h"
+#include "rulestats.h"
 #include "shared.h"
 #include "thread.h"
 #include "locking.h"
 #include "hashes.h"
+#include "status.h"
 
 #ifdef WITH_BRAIN
 #include "brain.h"
@@ -322,11 +325,12 @@ int save_hash (hashcat_ctx_t *hashcat_ctx)
 
 int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain)
 {
-  const debugfile_ctx_t *debugfile_ctx = hashcat_ctx->debugfile_ctx;
-  const hashes_t        *hashes        = hashcat_ctx->hashes;
-  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
-  const loopback_ctx_t  *loopback_ctx  = hashcat_ctx->loopback_ctx;
-  const module_ctx_t    *module_ctx    = hashcat_ctx->module_ctx;
+  const crack_sink_ctx_t *crack_sink_ctx = hashcat_ctx->crack_sink_ctx;
+  const debugfile_ctx_t  *debugfile_ctx  = hashcat_ctx->debugfile_ctx;
+  const hashes_t         *hashes         = hashcat_ctx->hashes;
+  const hashconfig_t     *hashconfig     = hashcat_ctx->hashconfig;
+  const loopback_ctx_t   *loopback_ctx   = hashcat_ctx->loopback_ctx;
+  const module_ctx_t     *module_ctx     = hashcat_ctx->module_ctx;
 
   const u32 salt_pos    = plain->salt_pos;
   const u32 digest_pos  = plain->digest_pos;  // relative
@@ -467,21 +471,35 @@ int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pla
 
   build_debugdata (hashcat_ctx, device_param, plain, debug_rule_buf, &debug_rule_len, debug_plain_ptr, &debug_plain_len);
 
+  // rule stats
+
+  rulestats_add (hashcat_ctx, device_param, plain);
+
   // outfile, can be either to file or stdout
   // if an error occurs opening the file, send to stdout as fallback
   // the fp gets opened for each cracked hash so that the user can modify (move) the outfile while hashcat runs
-
-  outfile_write_open (hashcat_ctx);
+  // with --crack-sink-async only the line is built here, the writer thread does the file access and the event
 
   u8 *tmp_buf = hashes->tmp_buf;
 
   tmp_buf[0] = 0;
 
-  const int tmp_len = outfile_write (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len, crackpos, NULL, 0, true, (char *) tmp_buf);
+  int tmp_len = 0;
+
+  if (crack_sink_ctx->enabled == true)
+  {
+    tmp_len = outfile_format_line (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len, crackpos, NULL, 0, (char *) tmp_buf);
+  }
+  else
+  {
+    outfile_write_open (hashcat_ctx);
+
+    tmp_len = outfile_write (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len, crackpos, NULL, 0, true, (char *) tmp_buf);
 
-  EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, tmp_buf, tmp_len);
+    EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, tmp_buf, tmp_len);
 
-  outfile_write_close (hashcat_ctx);
+    outfile_write_close (hashcat_ctx);
+  }
 
   // potfile
   // we can have either used-defined hooks or reuse the same format as input format
@@ -545,11 +563,21 @@ int check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pla
     out_buf[out_len] = 0;
   }
 
-  potfile_write_append (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len);
+  if (crack_sink_ctx->enabled == true)
+  {
+    crack_sink_push (hashcat_ctx, (char *) tmp_buf, tmp_len, (char *) out_buf, out_len, plain_ptr, plain_len);
+  }
+  else
+  {
+    potfile_write_append (hashcat_ctx, (char *) out_buf, out_len, plain_ptr, plain_len);
+  }
+
+  // if enabled, hand the plain to the running attack
+  // if enabled, update also the loopback file, but only with plains the running attack did not take
 
-  // if enabled, update also the loopback file
+  const bool loopback_live = loopback_live_push (hashcat_ctx, plain_ptr, plain_len);
 
-  if (loopback_ctx->fp.pfp != NULL)
+  if ((loopback_ctx->fp.pfp != NULL) && (loopback_live == false))
   {
     loopback_write_append (hashcat_ctx, plain_ptr, plain_len);
   }
@@ -719,7 +747,7 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
       if (salt_buf->digests_done == salt_buf->digests_cnt)
       {
-        hashes->salts_shown[salt_pos] = 1;
+        status_progress_salt_shown (hashcat_ctx, salt_pos);
 
         hashes->salts_done++;
       }
@@ -0,0 +1,808 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "thread.h"
+#include "shared.h"
+#include "filehandling.h"
+#include "emu_inc_hash_md5.h"
+#include "kernel_cache.h"
+
+int sort_by_kernel_cache_entry (const void *s1, const void *s2)
+{
+  const kernel_cache_entry_t *e1 = (const kernel_cache_entry_t *) s1;
+  const kernel_cache_entry_t *e2 = (const kernel_cache_entry_t *) s2;
+
+  for (int i = 0; i < 4; i++)
+  {
+    if (e1->key[i] > e2->key[i]) return  1;
+    if (e1->key[i] < e2->key[i]) return -1;
+  }
+
+  return 0;
+}
+
+static bool kernel_cache_pack_read_index (hashcat_ctx_t *hashcat_ctx)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, kernel_cache_ctx->pack_file, "rb") == false) return false;
+
+  // parse header, the whole pack (header and index) is stored in host order, which is little-endian for all supported hosts
+
+  u64 v;
+  u64 n;
+
+  const size_t nread1 = hc_fread (&v, sizeof (u64), 1, &fp);
+  const size_t nread2 = hc_fread (&n, sizeof (u64), 1, &fp);
+
+  if ((nread1 != 1) || (nread2 != 1))
+  {
+    event_log_error (hashcat_ctx, "%s: Invalid header", kernel_cache_ctx->pack_file);
+
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  if (v != KERNEL_CACHE_PACK_VERSION)
+  {
+    event_log_warning (hashcat_ctx, "%s: Invalid or outdated header version, ignoring content", kernel_cache_ctx->pack_file);
+
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  if (n > KERNEL_CACHE_PACK_MAX)
+  {
+    event_log_error (hashcat_ctx, "%s: Invalid number of entries", kernel_cache_ctx->pack_file);
+
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  // parse index, it was written sorted
+
+  kernel_cache_entry_t *entries = (kernel_cache_entry_t *) hccalloc (n + 1, sizeof (kernel_cache_entry_t));
+
+  const size_t nread3 = hc_fread (entries, sizeof (kernel_cache_entry_t), n, &fp);
+
+  hc_fclose (&fp);
+
+  if (nread3 != n)
+  {
+    event_log_error (hashcat_ctx, "%s: Truncated index", kernel_cache_ctx->pack_file);
+
+    hcfree (entries);
+
+    return false;
+  }
+
+  kernel_cache_ctx->entries     = entries;
+  kernel_cache_ctx->entries_cnt = (u32) n;
+
+  return true;
+}
+
+int kernel_cache_init (hashcat_ctx_t *hashcat_ctx)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+  user_options_t     *user_options     = hashcat_ctx->user_options;
+
+  memset (kernel_cache_ctx, 0, sizeof (kernel_cache_ctx_t));
+
+  if (user_options->usage          > 0)    return 0;
+  if (user_options->backend_info   > 0)    return 0;
+  if (user_options->hash_info      > 0)    return 0;
+
+  if (user_options->keyspace      == true) return 0;
+  if (user_options->left          == true) return 0;
+  if (user_options->show          == true) return 0;
+  if (user_options->stdout_flag   == true) return 0;
+  if (user_options->version       == true) return 0;
+  if (user_options->identify      == true) return 0;
+
+  kernel_cache_ctx->enabled = true;
+
+  hc_thread_mutex_init (kernel_cache_ctx->mux_local);
+
+  if (user_options->kernel_cache_pack == NULL) return 0;
+
+  kernel_cache_ctx->pack_file = hcstrdup (user_options->kernel_cache_pack);
+
+  if (hc_path_exist (kernel_cache_ctx->pack_file) == false)
+  {
+    // --kernel-cache-prewarm is going to create it
+
+    if (user_options->kernel_cache_prewarm == true) return 0;
+
+    event_log_error (hashcat_ctx, "%s: %s", kernel_cache_ctx->pack_file, strerror (errno));
+
+    return -1;
+  }
+
+  if (hc_path_read (kernel_cache_ctx->pack_file) == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", kernel_cache_ctx->pack_file, strerror (errno));
+
+    return -1;
+  }
+
+  kernel_cache_pack_read_index (hashcat_ctx);
+
+  return 0;
+}
+
+void kernel_cache_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+
+  if (kernel_cache_ctx->enabled == false) return;
+
+  for (u32 i = 0; i < kernel_cache_ctx->local_cnt; i++)
+  {
+    hcfree (kernel_cache_ctx->local[i].cached_file);
+  }
+
+  for (u32 i = 0; i < kernel_cache_ctx->sources_cnt; i++)
+  {
+    hcfree (kernel_cache_ctx->sources[i].source_file);
+  }
+
+  hcfree (kernel_cache_ctx->local);
+  hcfree (kernel_cache_ctx->sources);
+  hcfree (kernel_cache_ctx->entries);
+  hcfree (kernel_cache_ctx->pack_file);
+
+  hc_thread_mutex_delete (kernel_cache_ctx->mux_local);
+
+  memset (kernel_cache_ctx, 0, sizeof (kernel_cache_ctx_t));
+}
+
+/**
+ * the key covers everything the compiler sees:
+ * - the kernel source and, recursively, every file it may include from the OpenCL folder
+ * - the build options
+ * - the device and driver/runtime fingerprint
+ * unlike device_name_chksum it does not contain the hashcat build time, so a rebuild with unchanged kernels keeps its cache
+ */
+
+// md5_update () reads whole 64 byte blocks, so the input goes through a zeroed copy with at least one block after its end
+
+static void kernel_cache_md5_update (md5_ctx_t *md5_ctx, const void *buf, const size_t len)
+{
+  const size_t pad_len = ((len / 64) + 1) * 64;
+
+  u32 *pad_buf = (u32 *) hccalloc (pad_len, 1);
+
+  memcpy (pad_buf, buf, len);
+
+  md5_update (md5_ctx, pad_buf, (int) len);
+
+  hcfree (pad_buf);
+}
+
+static bool kernel_cache_hash_file (const char *path, md5_ctx_t *md5_ctx, char **includes, int *includes_cnt)
+{
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, path, "rb") == false) return false;
+
+  struct stat st;
+
+  if (hc_fstat (&fp, &st) == -1)
+  {
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  const size_t len = st.st_size;
+
+  char *buf = (char *) hcmalloc (len + 4);
+
+  const size_t nread = hc_fread (buf, 1, len, &fp);
+
+  hc_fclose (&fp);
+
+  if (nread != len)
+  {
+    hcfree (buf);
+
+    return false;
+  }
+
+  buf[len] = 0;
+
+  kernel_cache_md5_update (md5_ctx, buf, len);
+
+  // collect include candidates, both "#include M2S(INCLUDE_PATH/x)" and the macros defining such paths, and plain #include "x"
+
+  const char *pattern = "INCLUDE_PATH/";
+
+  const size_t pattern_len = strlen (pattern);
+
+  for (char *p = strstr (buf, pattern); p != NULL; p = strstr (p, pattern))
+  {
+    p += pattern_len;
+
+    const size_t name_len = strcspn (p, ")\"\r\n");
+
+    if ((name_len == 0) || (name_len >= 256)) continue;
+
+    char *name = hcstrdup (p);
+
+    name[name_len] = 0;
+
+    bool known = false;
+
+    for (int i = 0; i < *includes_cnt; i++)
+    {
+      if (strcmp (includes[i], name) == 0) { known = true; break; }
+    }
+
+    if ((known == true) || (*includes_cnt == KERNEL_CACHE_INCLUDES_MAX))
+    {
+      hcfree (name);
+
+      continue;
+    }
+
+    includes[(*includes_cnt)++] = name;
+  }
+
+  for (char *p = strstr (buf, "#include \""); p != NULL; p = strstr (p, "#include \""))
+  {
+    p += 10;
+
+    const size_t name_len = strcspn (p, "\"\r\n");
+
+    if ((name_len == 0) || (name_len >= 256)) continue;
+
+    char *name = hcstrdup (p);
+
+    name[name_len] = 0;
+
+    bool known = false;
+
+    for (int i = 0; i < *includes_cnt; i++)
+    {
+      if (strcmp (includes[i], name) == 0) { known = true; break; }
+    }
+
+    if ((known == true) || (*includes_cnt == KERNEL_CACHE_INCLUDES_MAX))
+    {
+      hcfree (name);
+
+      continue;
+    }
+
+    includes[(*includes_cnt)++] = name;
+  }
+
+  hcfree (buf);
+
+  return true;
+}
+
+static bool kernel_cache_source_hash (hashcat_ctx_t *hashcat_ctx, const char *source_file, u32 *digest)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  md5_ctx_t md5_ctx;
+
+  memset   (&md5_ctx, 0, sizeof (md5_ctx_t));
+  md5_init (&md5_ctx);
+
+  char **includes = (char **) hccalloc (KERNEL_CACHE_INCLUDES_MAX, sizeof (char *));
+
+  int includes_cnt = 0;
+
+  bool rc = kernel_cache_hash_file (source_file, &md5_ctx, includes, &includes_cnt);
+
+  char *include_file = (char *) hcmalloc (HCBUFSIZ_TINY);
+
+  // includes_cnt grows while we walk it, this is what makes the scan recursive
+
+  for (int i = 0; (rc == true) && (i < includes_cnt); i++)
+  {
+    snprintf (include_file, HCBUFSIZ_TINY, "%s/OpenCL/%s", folder_config->shared_dir, includes[i]);
+
+    // some matches are just part of comments or macro definitions for optional files, skip what does not exist
+
+    if (hc_path_read (include_file) == false) continue;
+
+    kernel_cache_md5_update (&md5_ctx, includes[i], strlen (includes[i]));
+
+    rc = kernel_cache_hash_file (include_file, &md5_ctx, includes, &includes_cnt);
+  }
+
+  for (int i = 0; i < includes_cnt; i++) hcfree (includes[i]);
+
+  hcfree (includes);
+  hcfree (include_file);
+
+  if (rc == false) return false;
+
+  md5_final (&md5_ctx);
+
+  digest[0] = md5_ctx.h[0];
+  digest[1] = md5_ctx.h[1];
+  digest[2] = md5_ctx.h[2];
+  digest[3] = md5_ctx.h[3];
+
+  return true;
+}
+
+// every device and kernel of a session shares the same few source files, so read and hash them only once
+
+static bool kernel_cache_source_digest (hashcat_ctx_t *hashcat_ctx, const char *source_file, u32 *digest)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+
+  if (kernel_cache_ctx->enabled == false) return kernel_cache_source_hash (hashcat_ctx, source_file, digest);
+
+  hc_thread_mutex_lock (kernel_cache_ctx->mux_local);
+
+  for (u32 i = 0; i < kernel_cache_ctx->sources_cnt; i++)
+  {
+    const kernel_cache_source_t *source = kernel_cache_ctx->sources + i;
+
+    if (strcmp (source->source_file, source_file) != 0) continue;
+
+    memcpy (digest, source->digest, sizeof (source->digest));
+
+    hc_thread_mutex_unlock (kernel_cache_ctx->mux_local);
+
+    return true;
+  }
+
+  hc_thread_mutex_unlock (kernel_cache_ctx->mux_local);
+
+  // two devices may hash the same file at the same time, the result is the same so the second one is just not stored
+
+  if (kernel_cache_source_hash (hashcat_ctx, source_file, digest) == false) return false;
+
+  hc_thread_mutex_lock (kernel_cache_ctx->mux_local);
+
+  bool known = false;
+
+  for (u32 i = 0; i < kernel_cache_ctx->sources_cnt; i++)
+  {
+    if (strcmp (kernel_cache_ctx->sources[i].source_file, source_file) == 0) { known = true; break; }
+  }
+
+  if (known == false)
+  {
+    if (kernel_cache_ctx->sources_cnt == kernel_cache_ctx->sources_alloc)
+    {
+      kernel_cache_ctx->sources_alloc += 16;
+
+      kernel_cache_ctx->sources = (kernel_cache_source_t *) hcrealloc (kernel_cache_ctx->sources, kernel_cache_ctx->sources_cnt * sizeof (kernel_cache_source_t), 16 * sizeof (kernel_cache_source_t));
+    }
+
+    kernel_cache_source_t *source = kernel_cache_ctx->sources + kernel_cache_ctx->sources_cnt;
+
+    source->source_file = hcstrdup (source_file);
+
+    memcpy (source->digest, digest, sizeof (source->digest));
+
+    kernel_cache_ctx->sources_cnt++;
+  }
+
+  hc_thread_mutex_unlock (kernel_cache_ctx->mux_local);
+
+  return true;
+}
+
+bool kernel_cache_key (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const char *kernel_name, const char *source_file, const char *build_options_buf, u32 *key)
+{
+  const backend_ctx_t   *backend_ctx   = hashcat_ctx->backend_ctx;
+  const user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  // kernel source and its includes
+
+  u32 source_digest[4];
+
+  if (kernel_cache_source_digest (hashcat_ctx, source_file, source_digest) == false) return false;
+
+  md5_ctx_t md5_ctx;
+
+  memset   (&md5_ctx, 0, sizeof (md5_ctx_t));
+  md5_init (&md5_ctx);
+
+  // device and driver/runtime fingerprint
+
+  char *fingerprint = (char *) hcmalloc (HCBUFSIZ_TINY);
+
+  const int fingerprint_len = snprintf (fingerprint, HCBUFSIZ_TINY, "%s-%d-%d-%d-%d-%u-%u-%u-%s-%d-%d-%d-%d-%u-%s-%s-%s-%d-%u-%u-%s",
+    kernel_name,
+    backend_ctx->cuda_driver_version,
+    backend_ctx->nvrtc_driver_version,
+    backend_ctx->hip_runtimeVersion,
+    backend_ctx->hip_driverVersion,
+    backend_ctx->metal_runtimeVersion,
+    device_param->sm_major,
+    device_param->sm_minor,
+    (device_param->is_hip == true) ? device_param->gcnArchName : "",
+    device_param->is_cuda,
+    device_param->is_hip,
+    device_param->is_metal,
+    device_param->is_opencl,
+    device_param->opencl_platform_vendor_id,
+    device_param->device_name,
+    (device_param->is_opencl == true) ? device_param->opencl_device_version : "",
+    (device_param->is_opencl == true) ? device_param->opencl_driver_version : "",
+    device_param->vector_width,
+    (user_options->kernel_threads_chgd == true) ? user_options->kernel_threads : device_param->kernel_threads_max,
+    get_current_arch (),
+    build_options_buf);
+
+  kernel_cache_md5_update (&md5_ctx, fingerprint, MIN (fingerprint_len, HCBUFSIZ_TINY - 1));
+
+  hcfree (fingerprint);
+
+  kernel_cache_md5_update (&md5_ctx, source_digest, sizeof (source_digest));
+
+  md5_final (&md5_ctx);
+
+  key[0] = md5_ctx.h[0];
+  key[1] = md5_ctx.h[1];
+  key[2] = md5_ctx.h[2];
+  key[3] = md5_ctx.h[3];
+
+  return true;
+}
+
+void kernel_cache_filename (const folder_config_t *folder_config, const u32 *key, const bool is_metal, char *cached_file, const size_t cached_file_sz)
+{
+  snprintf (cached_file, cached_file_sz, "%s/kernels/%08x%08x%08x%08x.%s", folder_config->cache_dir, key[0], key[1], key[2], key[3], (is_metal == true) ? "metallib" : "kernel");
+}
+
+bool kernel_cache_pack_extract (hashcat_ctx_t *hashcat_ctx, const u32 *key, const char *cached_file)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+
+  if (kernel_cache_ctx->enabled == false) return false;
+
+  if (kernel_cache_ctx->entries_cnt == 0) return false;
+
+  kernel_cache_entry_t e;
+
+  memset (&e, 0, sizeof (kernel_cache_entry_t));
+
+  memcpy (e.key, key, sizeof (e.key));
+
+  const kernel_cache_entry_t *found = (const kernel_cache_entry_t *) bsearch (&e, kernel_cache_ctx->entries, kernel_cache_ctx->entries_cnt, sizeof (kernel_cache_entry_t), sort_by_kernel_cache_entry);
+
+  if (found == NULL) return false;
+
+  // the pack is shared read-only, every lookup uses its own handle
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, kernel_cache_ctx->pack_file, "rb") == false) return false;
+
+  if (hc_fseek (&fp, (off_t) found->offset, SEEK_SET) == -1)
+  {
+    hc_fclose (&fp);
+
+    return false;
+  }
+
+  char *binary = (char *) hcmalloc (found->length);
+
+  const size_t nread = hc_fread (binary, 1, found->length, &fp);
+
+  hc_fclose (&fp);
+
+  if (nread != found->length)
+  {
+    event_log_warning (hashcat_ctx, "%s: Truncated entry, ignoring it", kernel_cache_ctx->pack_file);
+
+    hcfree (binary);
+
+    return false;
+  }
+
+  // like the pack itself, the kernel is written next to its final name and renamed into place,
+  // so neither a crash nor a concurrent hashcat can ever see a partial kernel binary
+
+  char *tmp_file = NULL;
+
+  hc_asprintf (&tmp_file, "%s.%d.tmp", cached_file, (int) getpid ());
+
+  HCFILE out;
+
+  if (hc_fopen_raw (&out, tmp_file, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tmp_file, strerror (errno));
+
+    hcfree (tmp_file);
+    hcfree (binary);
+
+    return false;
+  }
+
+  const size_t nwritten = hc_fwrite (binary, 1, found->length, &out);
+
+  hc_fflush (&out);
+
+  hc_fclose (&out);
+
+  hcfree (binary);
+
+  if (nwritten != found->length)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tmp_file, strerror (errno));
+
+    unlink (tmp_file);
+
+    hcfree (tmp_file);
+
+    return false;
+  }
+
+  if (rename (tmp_file, cached_file) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", cached_file, strerror (errno));
+
+    unlink (tmp_file);
+
+    hcfree (tmp_file);
+
+    return false;
+  }
+
+  hcfree (tmp_file);
+
+  return true;
+}
+
+void kernel_cache_remember (hashcat_ctx_t *hashcat_ctx, const u32 *key, const char *cached_file)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+  user_options_t     *user_options     = hashcat_ctx->user_options;
+
+  if (kernel_cache_ctx->enabled == false) return;
+
+  // only --kernel-cache-prewarm needs to know which entries to put into the pack
+
+  if (user_options->kernel_cache_prewarm == false) return;
+
+  hc_thread_mutex_lock (kernel_cache_ctx->mux_local);
+
+  for (u32 i = 0; i < kernel_cache_ctx->local_cnt; i++)
+  {
+    if (memcmp (kernel_cache_ctx->local[i].key, key, sizeof (kernel_cache_ctx->local[i].key)) == 0)
+    {
+      hc_thread_mutex_unlock (kernel_cache_ctx->mux_local);
+
+      return;
+    }
+  }
+
+  if (kernel_cache_ctx->local_cnt == kernel_cache_ctx->local_alloc)
+  {
+    kernel_cache_ctx->local_alloc += 64;
+
+    kernel_cache_ctx->local = (kernel_cache_local_t *) hcrealloc (kernel_cache_ctx->local, kernel_cache_ctx->local_cnt * sizeof (kernel_cache_local_t), 64 * sizeof (kernel_cache_local_t));
+  }
+
+  kernel_cache_local_t *local = kernel_cache_ctx->local + kernel_cache_ctx->local_cnt;
+
+  memcpy (local->key, key, sizeof (local->key));
+
+  local->cached_file = hcstrdup (cached_file);
+
+  kernel_cache_ctx->local_cnt++;
+
+  hc_thread_mutex_unlock (kernel_cache_ctx->mux_local);
+}
+
+static bool kernel_cache_copy_blob (HCFILE *dst, HCFILE *src, const u64 length)
+{
+  char *buf = (char *) hcmalloc (HCBUFSIZ_SMALL);
+
+  u64 left = length;
+
+  while (left)
+  {
+    const size_t chunk = (size_t) MIN (left, HCBUFSIZ_SMALL);
+
+    const size_t nread = hc_fread (buf, 1, chunk, src);
+
+    if (nread != chunk) break;
+
+    hc_fwrite (buf, 1, chunk, dst);
+
+    left -= chunk;
+  }
+
+  hcfree (buf);
+
+  return (left == 0);
+}
+
+int kernel_cache_pack_write (hashcat_ctx_t *hashcat_ctx)
+{
+  kernel_cache_ctx_t *kernel_cache_ctx = hashcat_ctx->kernel_cache_ctx;
+
+  if (kernel_cache_ctx->enabled == false) return 0;
+
+  if (kernel_cache_ctx->pack_file == NULL) return 0;
+
+  // merge: everything from the old pack plus what was built (or loaded) in this session
+  // the result is written next to the pack and renamed into place, so readers on other nodes never see a partial file
+
+  const u32 merged_alloc = kernel_cache_ctx->entries_cnt + kernel_cache_ctx->local_cnt;
+
+  kernel_cache_entry_t *merged = (kernel_cache_entry_t *) hccalloc (merged_alloc + 1, sizeof (kernel_cache_entry_t));
+
+  // length == 0 marks entries taken from the local cache folder, their source index is stored in offset
+
+  u32 merged_cnt = 0;
+
+  for (u32 i = 0; i < kernel_cache_ctx->local_cnt; i++)
+  {
+    const kernel_cache_local_t *local = kernel_cache_ctx->local + i;
+
+    struct stat st;
+
+    if (stat (local->cached_file, &st) == -1) continue;
+
+    if (st.st_size == 0) continue;
+
+    kernel_cache_entry_t *e = merged + merged_cnt;
+
+    memcpy (e->key, local->key, sizeof (e->key));
+
+    e->offset = i;
+    e->length = 0;
+
+    merged_cnt++;
+  }
+
+  for (u32 i = 0; i < kernel_cache_ctx->entries_cnt; i++)
+  {
+    const kernel_cache_entry_t *old = kernel_cache_ctx->entries + i;
+
+    bool known = false;
+
+    for (u32 j = 0; j < merged_cnt; j++)
+    {
+      if (sort_by_kernel_cache_entry (old, merged + j) == 0) { known = true; break; }
+    }
+
+    if (known == true) continue;
+
+    merged[merged_cnt++] = *old;
+  }
+
+  qsort (merged, merged_cnt, sizeof (kernel_cache_entry_t), sort_by_kernel_cache_entry);
+
+  char *tmp_file = NULL;
+
+  hc_asprintf (&tmp_file, "%s.tmp", kernel_cache_ctx->pack_file);
+
+  HCFILE fp;
+
+  if (hc_fopen_raw (&fp, tmp_file, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tmp_file, strerror (errno));
+
+    hcfree (tmp_file);
+    hcfree (merged);
+
+    return -1;
+  }
+
+  HCFILE fp_old;
+
+  const bool have_old = (kernel_cache_ctx->entries_cnt > 0) ? hc_fopen_raw (&fp_old, kernel_cache_ctx->pack_file, "rb") : false;
+
+  // header and a placeholder index, the final offsets are known only after copying the blobs
+
+  u64 v = KERNEL_CACHE_PACK_VERSION;
+  u64 n = (u64) merged_cnt;
+
+  hc_fwrite (&v, sizeof (u64), 1, &fp);
+  hc_fwrite (&n, sizeof (u64), 1, &fp);
+
+  hc_fwrite (merged, sizeof (kernel_cache_entry_t), merged_cnt, &fp);
+
+  u64 offset = (2 * sizeof (u64)) + ((u64) merged_cnt * sizeof (kernel_cache_entry_t));
+
+  bool rc = true;
+
+  for (u32 i = 0; (rc == true) && (i < merged_cnt); i++)
+  {
+    kernel_cache_entry_t *e = merged + i;
+
+    if (e->length == 0)
+    {
+      const kernel_cache_local_t *local = kernel_cache_ctx->local + e->offset;
+
+      HCFILE fp_local;
+
+      if (hc_fopen_raw (&fp_local, local->cached_file, "rb") == false) { rc = false; break; }
+
+      struct stat st;
+
+      hc_fstat (&fp_local, &st);
+
+      e->length = (u64) st.st_size;
+
+      rc = kernel_cache_copy_blob (&fp, &fp_local, e->length);
+
+      hc_fclose (&fp_local);
+    }
+    else
+    {
+      if ((have_old == false) || (hc_fseek (&fp_old, (off_t) e->offset, SEEK_SET) == -1)) { rc = false; break; }
+
+      rc = kernel_cache_copy_blob (&fp, &fp_old, e->length);
+    }
+
+    e->offset = offset;
+
+    offset += e->length;
+  }
+
+  if (have_old == true) hc_fclose (&fp_old);
+
+  if (rc == true)
+  {
+    hc_fseek (&fp, (off_t) (2 * sizeof (u64)), SEEK_SET);
+
+    hc_fwrite (merged, sizeof (kernel_cache_entry_t), merged_cnt, &fp);
+
+    hc_fflush (&fp);
+  }
+
+  hc_fclose (&fp);
+
+  if (rc == false)
+  {
+    event_log_error (hashcat_ctx, "%s: Failed to assemble kernel cache pack", tmp_file);
+
+    unlink (tmp_file);
+
+    hcfree (tmp_file);
+    hcfree (merged);
+
+    return -1;
+  }
+
+  if (rename (tmp_file, kernel_cache_ctx->pack_file) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", kernel_cache_ctx->pack_file, strerror (errno));
+
+    unlink (tmp_file);
+
+    hcfree (tmp_file);
+    hcfree (merged);
+
+    return -1;
+  }
+
+  hcfree (tmp_file);
+
+  // keep the in-memory index in sync
+
+  hcfree (kernel_cache_ctx->entries);
+
+  kernel_cache_ctx->entries     = merged;
+  kernel_cache_ctx->entries_cnt = merged_cnt;
+
+  return 0;
+}
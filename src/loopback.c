@@ -9,6 +9,7 @@
 #include "event.h"
 #include "shared.h"
 #include "locking.h"
+#include "thread.h"
 #include "loopback.h"
 
 static void loopback_format_plain (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len)
@@ -78,15 +79,56 @@ int loopback_init (hashcat_ctx_t *hashcat_ctx)
   loopback_ctx->fp.pfp   = NULL;
   loopback_ctx->filename = (char *) hcmalloc (HCBUFSIZ_TINY);
 
+  if (user_options->loopback_live == true)
+  {
+    loopback_ctx->live = true;
+
+    loopback_ctx->live_buf        = (loopback_live_t *) hccalloc (LOOPBACK_LIVE_MAX, sizeof (loopback_live_t));
+    loopback_ctx->live_head       = 0;
+    loopback_ctx->live_cnt        = 0;
+    loopback_ctx->live_seen       = (loopback_seen_t *) hccalloc (LOOPBACK_LIVE_SEEN, sizeof (loopback_seen_t));
+    loopback_ctx->live_seen_cnt   = 0;
+
+    hc_thread_mutex_init (loopback_ctx->mux_live);
+  }
+
   return 0;
 }
 
+static void loopback_live_seen_clear (hashcat_ctx_t *hashcat_ctx)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  for (u32 slot = 0; slot < LOOPBACK_LIVE_SEEN; slot++)
+  {
+    loopback_seen_t *seen = loopback_ctx->live_seen + slot;
+
+    if (seen->buf == NULL) continue;
+
+    hcfree (seen->buf);
+
+    seen->buf = NULL;
+  }
+
+  loopback_ctx->live_seen_cnt = 0;
+}
+
 void loopback_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
 
   if (loopback_ctx->enabled == false) return;
 
+  if (loopback_ctx->live == true)
+  {
+    loopback_live_seen_clear (hashcat_ctx);
+
+    hcfree (loopback_ctx->live_buf);
+    hcfree (loopback_ctx->live_seen);
+
+    hc_thread_mutex_delete (loopback_ctx->mux_live);
+  }
+
   memset (loopback_ctx, 0, sizeof (loopback_ctx_t));
 }
 
@@ -97,6 +139,17 @@ int loopback_write_open (hashcat_ctx_t *hashcat_ctx)
 
   if (loopback_ctx->enabled == false) return 0;
 
+  // a new pass replays the plains of the previous one from its loopback file, they may be fed live again
+
+  if (loopback_ctx->live == true)
+  {
+    hc_thread_mutex_lock (loopback_ctx->mux_live);
+
+    loopback_live_seen_clear (hashcat_ctx);
+
+    hc_thread_mutex_unlock (loopback_ctx->mux_live);
+  }
+
   if (induct_ctx->enabled == false) return 0;
 
   time_t now;
@@ -138,6 +191,30 @@ void loopback_write_close (hashcat_ctx_t *hashcat_ctx)
 
   if (loopback_ctx->fp.pfp == NULL) return;
 
+  // plains still queued for --loopback-live were not fed to the attack, the loopback file replays them instead
+
+  if (loopback_ctx->live == true)
+  {
+    hc_thread_mutex_lock (loopback_ctx->mux_live);
+
+    while (loopback_ctx->live_cnt)
+    {
+      const loopback_live_t *live = loopback_ctx->live_buf + loopback_ctx->live_head;
+
+      loopback_format_plain (hashcat_ctx, live->buf, live->len);
+
+      hc_fwrite (EOL, strlen (EOL), 1, &loopback_ctx->fp);
+
+      loopback_ctx->live_head = (loopback_ctx->live_head + 1) % LOOPBACK_LIVE_MAX;
+
+      loopback_ctx->live_cnt--;
+
+      loopback_ctx->unused = false;
+    }
+
+    hc_thread_mutex_unlock (loopback_ctx->mux_live);
+  }
+
   hc_fclose (&loopback_ctx->fp);
 
   if (loopback_ctx->unused == true)
@@ -164,3 +241,127 @@ void loopback_write_append (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, con
 
   loopback_ctx->unused = false;
 }
+
+static u64 loopback_live_hash (const u8 *plain_ptr, const unsigned int plain_len)
+{
+  // FNV-1a, only used to recognize plains we have queued already
+
+  u64 hash = 0xcbf29ce484222325;
+
+  for (u32 i = 0; i < plain_len; i++)
+  {
+    hash ^= plain_ptr[i];
+    hash *= 0x100000001b3;
+  }
+
+  return hash;
+}
+
+// returns true if the plain is taken care of by the live queue, then it must not go to the loopback file as well
+
+bool loopback_live_push (hashcat_ctx_t *hashcat_ctx, const u8 *plain_ptr, const unsigned int plain_len)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  if (loopback_ctx->live == false) return false;
+
+  if (plain_len > PW_MAX) return false;
+
+  const u64 hash = loopback_live_hash (plain_ptr, plain_len);
+
+  hc_thread_mutex_lock (loopback_ctx->mux_live);
+
+  // linear probing, skip known plains, a matching hash alone could be a collision of two different plains
+
+  u32 slot = (u32) (hash & (LOOPBACK_LIVE_SEEN - 1));
+
+  while (loopback_ctx->live_seen[slot].buf != NULL)
+  {
+    const loopback_seen_t *seen = loopback_ctx->live_seen + slot;
+
+    if ((seen->hash == hash) && (seen->len == plain_len) && (memcmp (seen->buf, plain_ptr, plain_len) == 0))
+    {
+      hc_thread_mutex_unlock (loopback_ctx->mux_live);
+
+      return true;
+    }
+
+    slot = (slot + 1) & (LOOPBACK_LIVE_SEEN - 1);
+  }
+
+  // if the queue or the set is full the plain is not lost, the loopback file replays it after the attack
+
+  if ((loopback_ctx->live_cnt == LOOPBACK_LIVE_MAX) || (loopback_ctx->live_seen_cnt == (LOOPBACK_LIVE_SEEN / 2)))
+  {
+    hc_thread_mutex_unlock (loopback_ctx->mux_live);
+
+    return false;
+  }
+
+  loopback_seen_t *seen = loopback_ctx->live_seen + slot;
+
+  seen->hash = hash;
+  seen->len  = plain_len;
+  seen->buf  = (u8 *) hcmalloc (plain_len + 1);
+
+  memcpy (seen->buf, plain_ptr, plain_len);
+
+  loopback_ctx->live_seen_cnt++;
+
+  loopback_live_t *live = loopback_ctx->live_buf + ((loopback_ctx->live_head + loopback_ctx->live_cnt) % LOOPBACK_LIVE_MAX);
+
+  memcpy (live->buf, plain_ptr, plain_len);
+
+  live->len = plain_len;
+
+  loopback_ctx->live_cnt++;
+
+  hc_thread_mutex_unlock (loopback_ctx->mux_live);
+
+  return true;
+}
+
+bool loopback_live_pop (hashcat_ctx_t *hashcat_ctx, u8 *plain_ptr, u32 *plain_len)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  if (loopback_ctx->live == false) return false;
+
+  hc_thread_mutex_lock (loopback_ctx->mux_live);
+
+  if (loopback_ctx->live_cnt == 0)
+  {
+    hc_thread_mutex_unlock (loopback_ctx->mux_live);
+
+    return false;
+  }
+
+  const loopback_live_t *live = loopback_ctx->live_buf + loopback_ctx->live_head;
+
+  memcpy (plain_ptr, live->buf, live->len);
+
+  *plain_len = live->len;
+
+  loopback_ctx->live_head = (loopback_ctx->live_head + 1) % LOOPBACK_LIVE_MAX;
+
+  loopback_ctx->live_cnt--;
+
+  hc_thread_mutex_unlock (loopback_ctx->mux_live);
+
+  return true;
+}
+
+u32 loopback_live_count (hashcat_ctx_t *hashcat_ctx)
+{
+  loopback_ctx_t *loopback_ctx = hashcat_ctx->loopback_ctx;
+
+  if (loopback_ctx->live == false) return 0;
+
+  hc_thread_mutex_lock (loopback_ctx->mux_live);
+
+  const u32 live_cnt = loopback_ctx->live_cnt;
+
+  hc_thread_mutex_unlock (loopback_ctx->mux_live);
+
+  return live_cnt;
+}
@@ -19,6 +19,7 @@
 #include "status.h"
 #include "shared.h"
 #include "event.h"
+#include "benchmark_host.h"
 
 #ifdef WITH_BRAIN
 #include "brain.h"
@@ -1408,7 +1409,7 @@ int main (int argc, char **argv)
   #ifdef WITH_BRAIN
   if (user_options->brain_server == true)
   {
-    const int rc = brain_server (user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session_whitelist, user_options->brain_server_timer);
+    const int rc = brain_server (user_options->brain_host, user_options->brain_port, user_options->brain_password, user_options->brain_session_whitelist, user_options->brain_server_timer, user_options->brain_server_filter, user_options->brain_server_filter_bits);
 
     hcfree (hashcat_ctx);
 
@@ -1416,6 +1417,17 @@ int main (int argc, char **argv)
   }
   #endif
 
+  if (user_options->benchmark_host == true)
+  {
+    const int rc = benchmark_host (hashcat_ctx, install_folder, shared_folder);
+
+    hashcat_destroy (hashcat_ctx);
+
+    hcfree (hashcat_ctx);
+
+    return rc;
+  }
+
   if (user_options->version == true)
   {
     printf ("%s\n", VERSION_TAG);
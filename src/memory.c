@@ -7,8 +7,38 @@
 #include "types.h"
 #include "memory.h"
 
+// allocation counter used by --benchmark-host
+// any thread can allocate while a stage runs, so the counter is updated with atomic builtins
+// it counts all threads, the host benchmark stages themselves run single-threaded
+
+static bool alloc_count_enabled = false;
+static u64  alloc_count         = 0;
+
+static inline void hc_alloc_count_add (void)
+{
+  if (__atomic_load_n (&alloc_count_enabled, __ATOMIC_RELAXED) == false) return;
+
+  __atomic_fetch_add (&alloc_count, 1, __ATOMIC_RELAXED);
+}
+
+void hc_alloc_count_start (void)
+{
+  __atomic_store_n (&alloc_count, 0, __ATOMIC_SEQ_CST);
+
+  __atomic_store_n (&alloc_count_enabled, true, __ATOMIC_SEQ_CST);
+}
+
+u64 hc_alloc_count_stop (void)
+{
+  __atomic_store_n (&alloc_count_enabled, false, __ATOMIC_SEQ_CST);
+
+  return __atomic_load_n (&alloc_count, __ATOMIC_SEQ_CST);
+}
+
 void *hccalloc (const size_t nmemb, const size_t sz)
 {
+  hc_alloc_count_add ();
+
   void *p = calloc (nmemb, sz);
 
   if (p == NULL)
@@ -31,6 +61,8 @@ void *hcmalloc (const size_t sz)
 
 void *hcrealloc (void *ptr, const size_t oldsz, const size_t addsz)
 {
+  hc_alloc_count_add ();
+
   void *p = realloc (ptr, oldsz + addsz);
 
   if (p == NULL)
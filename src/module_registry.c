@@ -0,0 +1,523 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "bitops.h"
+#include "convert.h"
+#include "event.h"
+#include "folder.h"
+#include "interface.h"
+#include "shared.h"
+#include "module_registry.h"
+
+int sort_by_module_registry_entry (const void *s1, const void *s2)
+{
+  const module_registry_entry_t *e1 = (const module_registry_entry_t *) s1;
+  const module_registry_entry_t *e2 = (const module_registry_entry_t *) s2;
+
+  if (e1->hash_mode > e2->hash_mode) return  1;
+  if (e1->hash_mode < e2->hash_mode) return -1;
+
+  return 0;
+}
+
+// adding or removing a module (including a rebuild, the linker replaces the file) changes the mtime of the folder
+
+static u64 module_registry_stamp (const folder_config_t *folder_config)
+{
+  char *modules_dir = NULL;
+
+  hc_asprintf (&modules_dir, "%s/modules", folder_config->shared_dir);
+
+  struct stat st;
+
+  u64 stamp = 0;
+
+  if (stat (modules_dir, &st) == 0) stamp = (u64) st.st_mtime;
+
+  hcfree (modules_dir);
+
+  return stamp;
+}
+
+static bool module_registry_decode (hashcat_ctx_t *hashcat_ctx, const char *hash_buf, const int hash_len)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  const module_ctx_t *module_ctx = hashcat_ctx->module_ctx;
+
+  void   *digest    =            hccalloc (1, hashconfig->dgst_size);
+  salt_t *salt      = (salt_t *) hccalloc (1, sizeof (salt_t));
+  void   *esalt     = NULL;
+  void   *hook_salt = NULL;
+
+  if (hashconfig->esalt_size > 0)
+  {
+    esalt = hccalloc (1, hashconfig->esalt_size);
+  }
+
+  if (hashconfig->hook_salt_size > 0)
+  {
+    hook_salt = hccalloc (1, hashconfig->hook_salt_size);
+  }
+
+  hashinfo_t *hash_info = (hashinfo_t *) hcmalloc (sizeof (hashinfo_t));
+
+  hash_info->dynamicx = (dynamicx_t *) hcmalloc (sizeof (dynamicx_t));
+  hash_info->user     = (user_t *)     hcmalloc (sizeof (user_t));
+  hash_info->orighash = (char *)       hcmalloc (256);
+  hash_info->split    = (split_t *)    hcmalloc (sizeof (split_t));
+
+  const int parser_status = module_ctx->module_hash_decode (hashconfig, digest, salt, esalt, hook_salt, hash_info, hash_buf, hash_len);
+
+  hcfree (hash_info->dynamicx);
+  hcfree (hash_info->user);
+  hcfree (hash_info->orighash);
+  hcfree (hash_info->split);
+  hcfree (hash_info);
+
+  hcfree (digest);
+  hcfree (salt);
+  hcfree (esalt);
+  hcfree (hook_salt);
+
+  return (parser_status == PARSER_OK);
+}
+
+// find the signature at the start of the self-test hash, like $6$, {SSHA} or WPA*
+// it is only used for filtering if the module rejects the hash with the signature garbled and with it removed
+
+static void module_registry_sig (hashcat_ctx_t *hashcat_ctx, module_registry_entry_t *entry)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+
+  entry->sig_required = false;
+
+  memset (entry->sig, 0, sizeof (entry->sig));
+
+  if (hashconfig->opts_type & OPTS_TYPE_BINARY_HASHFILE) return;
+
+  const char *st_hash = hashconfig->st_hash;
+
+  if (st_hash == NULL) return;
+
+  const int st_len = (const int) strlen (st_hash);
+
+  int token_len    = 0;
+  int garble_start = 1;
+
+  if ((st_hash[0] == '$') || (st_hash[0] == '{'))
+  {
+    const char term = (st_hash[0] == '$') ? '$' : '}';
+
+    for (int i = 1; i < st_len && i < 32; i++)
+    {
+      const char c = st_hash[i];
+
+      if (c == term)
+      {
+        if (i > 1) token_len = i + 1;
+
+        break;
+      }
+
+      if ((isalnum ((int) c) == 0) && (c != '_') && (c != '-') && (c != '.')) break;
+    }
+  }
+  else
+  {
+    // plain words only, a hex digest followed by '*' is not a signature
+
+    bool has_non_hex = false;
+
+    for (int i = 0; i < st_len && i < 32; i++)
+    {
+      const char c = st_hash[i];
+
+      if ((c == '*') || (c == '$'))
+      {
+        if ((i > 1) && (has_non_hex == true)) token_len = i + 1;
+
+        break;
+      }
+
+      if ((isalnum ((int) c) == 0) && (c != '_') && (c != '-')) break;
+
+      if (is_valid_hex_char ((const u8) c) == false) has_non_hex = true;
+    }
+
+    garble_start = 0;
+  }
+
+  if (token_len == 0) return;
+
+  if (module_registry_decode (hashcat_ctx, st_hash, st_len) == false) return;
+
+  char *garbled = hcstrdup (st_hash);
+
+  for (int i = garble_start; i < token_len - 1; i++) garbled[i] = '~';
+
+  const bool garbled_ok  = module_registry_decode (hashcat_ctx, garbled, st_len);
+  const bool stripped_ok = module_registry_decode (hashcat_ctx, st_hash + token_len, st_len - token_len);
+
+  hcfree (garbled);
+
+  if ((garbled_ok == true) || (stripped_ok == true)) return;
+
+  entry->sig_required = true;
+
+  memcpy (entry->sig, st_hash, MIN (token_len, MODULE_REGISTRY_SIG_LEN - 1));
+}
+
+// raw hex hashes have no signature, but the decoder accepts only a few lengths
+// find them by feeding it hex strings of every length up to twice the self-test hash (at least MODULE_REGISTRY_LEN_PROBE)
+
+static void module_registry_bounds (hashcat_ctx_t *hashcat_ctx, module_registry_entry_t *entry)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+
+  entry->hex_only     = false;
+  entry->hash_len_min = 0;
+  entry->hash_len_max = 0;
+
+  if (hashconfig->opts_type & OPTS_TYPE_BINARY_HASHFILE) return;
+
+  const char *st_hash = hashconfig->st_hash;
+
+  if (st_hash == NULL) return;
+
+  const int st_len = (const int) strlen (st_hash);
+
+  if (st_len == 0) return;
+
+  if (is_valid_hex_string ((const u8 *) st_hash, st_len) == false) return;
+
+  const int probe_max = MAX (st_len * 2, MODULE_REGISTRY_LEN_PROBE);
+
+  char *probe = (char *) hcmalloc (probe_max + 1);
+
+  for (int i = 0; i < probe_max; i++) probe[i] = st_hash[i % st_len];
+
+  int len_min = 0;
+  int len_max = 0;
+
+  for (int len = 1; len <= probe_max; len++)
+  {
+    const char sav = probe[len];
+
+    probe[len] = 0;
+
+    const bool ok = module_registry_decode (hashcat_ctx, probe, len);
+
+    probe[len] = sav;
+
+    if (ok == false) continue;
+
+    if (len_min == 0) len_min = len;
+
+    len_max = len;
+  }
+
+  hcfree (probe);
+
+  if (len_min == 0) return;
+
+  entry->hex_only     = true;
+  entry->hash_len_min = (u32) len_min;
+  entry->hash_len_max = (len_max == probe_max) ? 0xffffffff : (u32) len_max; // accepts the longest probe, so assume there's no limit
+}
+
+static int module_registry_build (hashcat_ctx_t *hashcat_ctx, module_registry_entry_t **entries)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+  const hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
+        user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  #if defined (_WIN) || defined (__CYGWIN__)
+  const char *module_ext = ".dll";
+  #else
+  const char *module_ext = ".so";
+  #endif
+
+  char *modules_dir = NULL;
+
+  hc_asprintf (&modules_dir, "%s/modules", folder_config->shared_dir);
+
+  char **files = scan_directory (modules_dir);
+
+  hcfree (modules_dir);
+
+  int files_cnt = 0;
+
+  while (files[files_cnt] != NULL) files_cnt++;
+
+  module_registry_entry_t *buf = (module_registry_entry_t *) hccalloc (files_cnt + 1, sizeof (module_registry_entry_t));
+
+  int cnt = 0;
+
+  const u32  hash_mode_sav = user_options->hash_mode;
+  const bool quiet_sav     = user_options->quiet;
+
+  user_options->quiet = true;
+
+  for (int files_idx = 0; files_idx < files_cnt; files_idx++)
+  {
+    const char *name = strrchr (files[files_idx], '/');
+
+    name = (name == NULL) ? files[files_idx] : name + 1;
+
+    if (strncmp (name, "module_", 7) != 0) continue;
+
+    char *end = NULL;
+
+    const long hash_mode = strtol (name + 7, &end, 10);
+
+    if ((end - (name + 7)) != 5) continue;
+
+    if (strcmp (end, module_ext) != 0) continue;
+
+    user_options->hash_mode = (u32) hash_mode;
+
+    if (hashconfig_init (hashcat_ctx) == 0)
+    {
+      module_registry_entry_t *entry = buf + cnt;
+
+      entry->hash_mode     = hashconfig->hash_mode;
+      entry->hash_category = hashconfig->hash_category;
+      entry->salt_type     = hashconfig->salt_type;
+      entry->attack_exec   = hashconfig->attack_exec;
+      entry->opts_type     = hashconfig->opts_type;
+      entry->separator     = hashconfig->separator;
+
+      strncpy (entry->hash_name, hashconfig->hash_name, sizeof (entry->hash_name) - 1);
+
+      module_registry_sig    (hashcat_ctx, entry);
+      module_registry_bounds (hashcat_ctx, entry);
+
+      cnt++;
+    }
+
+    hashconfig_destroy (hashcat_ctx);
+  }
+
+  user_options->hash_mode = hash_mode_sav;
+  user_options->quiet     = quiet_sav;
+
+  for (int files_idx = 0; files_idx < files_cnt; files_idx++) hcfree (files[files_idx]);
+
+  hcfree (files);
+
+  qsort (buf, cnt, sizeof (module_registry_entry_t), sort_by_module_registry_entry);
+
+  *entries = buf;
+
+  return cnt;
+}
+
+static int module_registry_read (hashcat_ctx_t *hashcat_ctx, const char *filename, const u64 stamp, module_registry_entry_t **entries)
+{
+  HCFILE fp;
+
+  if (hc_fopen (&fp, filename, "rb") == false) return -1;
+
+  u64 v;
+  u64 s;
+  u64 c;
+
+  const size_t nread1 = hc_fread (&v, sizeof (u64), 1, &fp);
+  const size_t nread2 = hc_fread (&s, sizeof (u64), 1, &fp);
+  const size_t nread3 = hc_fread (&c, sizeof (u64), 1, &fp);
+
+  if ((nread1 != 1) || (nread2 != 1) || (nread3 != 1))
+  {
+    event_log_error (hashcat_ctx, "%s: Invalid header", filename);
+
+    hc_fclose (&fp);
+
+    return -1;
+  }
+
+  v = byte_swap_64 (v);
+  s = byte_swap_64 (s);
+  c = byte_swap_64 (c);
+
+  // a different version or a changed modules folder just means we have to rebuild it, no need to complain
+
+  if ((v != MODULE_REGISTRY_VERSION) || (s != stamp) || (c == 0) || (c > (u64) MODULE_HASH_MODES_MAXIMUM))
+  {
+    hc_fclose (&fp);
+
+    return -1;
+  }
+
+  module_registry_entry_t *buf = (module_registry_entry_t *) hccalloc (c, sizeof (module_registry_entry_t));
+
+  const size_t nread = hc_fread (buf, sizeof (module_registry_entry_t), c, &fp);
+
+  hc_fclose (&fp);
+
+  if (nread != c)
+  {
+    event_log_error (hashcat_ctx, "%s: Truncated file, rebuilding", filename);
+
+    hcfree (buf);
+
+    return -1;
+  }
+
+  *entries = buf;
+
+  return (int) c;
+}
+
+static int module_registry_write (hashcat_ctx_t *hashcat_ctx, const char *filename, const u64 stamp, const module_registry_entry_t *entries, const int cnt)
+{
+  // readers and concurrent instances must never see a truncated file, so build it next to the old one and rename it over
+
+  char *tmp_file = NULL;
+
+  hc_asprintf (&tmp_file, "%s.tmp.%d", filename, (int) getpid ());
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, tmp_file, "wb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tmp_file, strerror (errno));
+
+    hcfree (tmp_file);
+
+    return -1;
+  }
+
+  u64 v = byte_swap_64 (MODULE_REGISTRY_VERSION);
+  u64 s = byte_swap_64 (stamp);
+  u64 c = byte_swap_64 ((u64) cnt);
+
+  size_t nwrite = 0;
+
+  nwrite += hc_fwrite (&v, sizeof (u64), 1, &fp);
+  nwrite += hc_fwrite (&s, sizeof (u64), 1, &fp);
+  nwrite += hc_fwrite (&c, sizeof (u64), 1, &fp);
+
+  nwrite += hc_fwrite (entries, sizeof (module_registry_entry_t), cnt, &fp);
+
+  hc_fflush (&fp);
+  hc_fsync  (&fp);
+  hc_fclose (&fp);
+
+  if ((nwrite != (size_t) (3 + cnt)) || (rename (tmp_file, filename) == -1))
+  {
+    event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
+
+    unlink (tmp_file);
+
+    hcfree (tmp_file);
+
+    return -1;
+  }
+
+  hcfree (tmp_file);
+
+  return 0;
+}
+
+int module_registry_load (hashcat_ctx_t *hashcat_ctx, module_registry_entry_t **entries)
+{
+  const folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  const u64 stamp = module_registry_stamp (folder_config);
+
+  if (stamp == 0) return -1;
+
+  char *filename = NULL;
+
+  hc_asprintf (&filename, "%s/%s", folder_config->cache_dir, MODULE_REGISTRY_FILENAME);
+
+  int cnt = module_registry_read (hashcat_ctx, filename, stamp, entries);
+
+  if (cnt == -1)
+  {
+    // first run or modules changed, this is the only time all modules have to be loaded
+
+    cnt = module_registry_build (hashcat_ctx, entries);
+
+    if (cnt > 0) module_registry_write (hashcat_ctx, filename, stamp, *entries, cnt);
+  }
+
+  hcfree (filename);
+
+  if (cnt <= 0)
+  {
+    hcfree (*entries);
+
+    *entries = NULL;
+
+    return -1;
+  }
+
+  return cnt;
+}
+
+static bool module_registry_hex_fits (const module_registry_entry_t *entry, const char *buf, const size_t len)
+{
+  if (len < entry->hash_len_min) return false;
+  if (len > entry->hash_len_max) return false;
+
+  return is_valid_hex_string ((const u8 *) buf, len);
+}
+
+// false means the module can not match any of the probes and does not need to be loaded for autodetect
+
+bool module_registry_prefilter (const module_registry_entry_t *entry, char **probe_buf, const int probe_cnt, const bool is_file)
+{
+  if (entry->opts_type & OPTS_TYPE_AUTODETECT_DISABLE) return false;
+
+  if (entry->opts_type & OPTS_TYPE_BINARY_HASHFILE)
+  {
+    if ((entry->opts_type & OPTS_TYPE_BINARY_HASHFILE_OPTIONAL) == 0)
+    {
+      if (is_file == false) return false;
+    }
+
+    return true;
+  }
+
+  if (probe_cnt == 0) return true;
+
+  if (entry->sig_required == true)
+  {
+    // the signature can be anywhere, for instance after the username of a pwdump or passwd line
+
+    for (int probe_idx = 0; probe_idx < probe_cnt; probe_idx++)
+    {
+      if (strstr (probe_buf[probe_idx], entry->sig) != NULL) return true;
+    }
+
+    return false;
+  }
+
+  if (entry->hex_only == true)
+  {
+    // the hash is either the whole line or the last field, for instance after a username
+
+    for (int probe_idx = 0; probe_idx < probe_cnt; probe_idx++)
+    {
+      const char *probe = probe_buf[probe_idx];
+
+      if (module_registry_hex_fits (entry, probe, strlen (probe)) == true) return true;
+
+      const char *last = strrchr (probe, entry->separator);
+
+      if (last == NULL) continue;
+
+      if (module_registry_hex_fits (entry, last + 1, strlen (last + 1)) == true) return true;
+    }
+
+    return false;
+  }
+
+  return true;
+}
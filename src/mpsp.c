@@ -1110,6 +1110,86 @@ void sp_exec (u64 ctx, char *pw_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u
   }
 }
 
+/**
+ * sp_exec() decodes the index as a mixed-radix number, the first position being the least significant digit
+ * the radix of a position does not depend on the previous character, sp_tbl_to_css() fills every markov row of a position
+ * with the same number of characters, only the order differs
+ * this allows to decode the index once and then count up the digits like an odometer
+ */
+
+void sp_iter_init (sp_iter_t *sp_iter, u64 ctx, char *pw_buf, cs_t *root_css_buf, cs_t *markov_css_buf, u32 start, u32 stop)
+{
+  sp_iter->pw_buf         = pw_buf;
+  sp_iter->root_css_buf   = root_css_buf;
+  sp_iter->markov_css_buf = markov_css_buf;
+  sp_iter->start          = start;
+  sp_iter->stop           = stop;
+
+  u64 v = ctx;
+
+  cs_t *cs = &root_css_buf[start];
+
+  for (u32 i = start; i < stop; i++)
+  {
+    const u64 m = v % cs->cs_len;
+    const u64 d = v / cs->cs_len;
+
+    v = d;
+
+    sp_iter->digits[i - start] = (u32) m;
+    sp_iter->lens[i - start]   = cs->cs_len;
+
+    const u32 k = cs->cs_buf[m];
+
+    pw_buf[i - start] = (char) k;
+
+    cs = &markov_css_buf[(i * CHARSIZ) + k];
+  }
+}
+
+void sp_iter_next (sp_iter_t *sp_iter)
+{
+  const u32 start = sp_iter->start;
+  const u32 cnt   = sp_iter->stop - start;
+
+  if (cnt == 0) return;
+
+  u32 *digits = sp_iter->digits;
+
+  // count up, top is the highest digit which changed
+
+  u32 top;
+
+  for (top = 0; top < cnt; top++)
+  {
+    if (++digits[top] < sp_iter->lens[top]) break;
+
+    digits[top] = 0;
+  }
+
+  if (top == cnt) top = cnt - 1; // wrapped around
+
+  // a changed character selects a different markov row for the next position, so we need to follow the chain
+  // but as soon as we are above top and a character did not change, the rest of the candidate stays the same
+
+  char *pw_buf = sp_iter->pw_buf;
+
+  cs_t *cs = &sp_iter->root_css_buf[start];
+
+  for (u32 i = 0; i < cnt; i++)
+  {
+    const u32 k = cs->cs_buf[digits[i]];
+
+    const bool same = ((u8) pw_buf[i] == k);
+
+    pw_buf[i] = (char) k;
+
+    if ((i >= top) && (same == true)) break;
+
+    cs = &sp_iter->markov_css_buf[((start + i) * CHARSIZ) + k];
+  }
+}
+
 static int mask_append_final (hashcat_ctx_t *hashcat_ctx, const char *mask)
 {
   mask_ctx_t *mask_ctx = hashcat_ctx->mask_ctx;
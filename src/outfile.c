@@ -397,7 +397,12 @@ int build_crackpos (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   {
     if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
     {
-      crackpos += gidvid;
+      // --loopback-live plains follow the wordlist words in the batch and have no keyspace position of their own
+      // they report the position of the first wordlist word after the batch, with the rule that cracked them
+
+      const u64 pws_words_cnt = device_param->pws_cnt - device_param->pws_loopback_cnt;
+
+      crackpos += MIN (gidvid, pws_words_cnt);
       crackpos *= straight_ctx->kernel_rules_cnt;
       crackpos += device_param->innerloop_pos + il_pos;
     }
@@ -420,6 +425,31 @@ int build_crackpos (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   return 0;
 }
 
+int build_ruleidx (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain, u64 *out_idx)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  const u64 gidvid = plain->gidvid;
+  const u32 il_pos = plain->il_pos;
+
+  u64 rule_idx = 0;
+
+  if (user_options->slow_candidates == true)
+  {
+    pw_pre_t *pw_base = device_param->pws_base_buf + gidvid;
+
+    rule_idx = pw_base->rule_idx;
+  }
+  else
+  {
+    rule_idx = device_param->innerloop_pos + il_pos;
+  }
+
+  *out_idx = rule_idx;
+
+  return 0;
+}
+
 int build_debugdata (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain, u8 *debug_rule_buf, int *debug_rule_len, u8 *debug_plain_ptr, int *debug_plain_len)
 {
   const debugfile_ctx_t *debugfile_ctx = hashcat_ctx->debugfile_ctx;
@@ -427,7 +457,6 @@ int build_debugdata (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
   const user_options_t  *user_options  = hashcat_ctx->user_options;
 
   const u64 gidvid = plain->gidvid;
-  const u32 il_pos = plain->il_pos;
 
   if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_GENERIC) && (user_options->attack_mode != ATTACK_MODE_ASSOCIATION)) return 0;
 
@@ -435,6 +464,10 @@ int build_debugdata (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
 
   if (debug_mode == 0) return 0;
 
+  u64 rule_idx = 0;
+
+  build_ruleidx (hashcat_ctx, device_param, plain, &rule_idx);
+
   if (user_options->slow_candidates == true)
   {
     pw_pre_t *pw_base = device_param->pws_base_buf + gidvid;
@@ -442,7 +475,7 @@ int build_debugdata (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
     // save rule
     if ((debug_mode == 1) || (debug_mode == 3) || (debug_mode == 4) || (debug_mode == 5))
     {
-      const int len = kernel_rule_to_cpu_rule ((char *) debug_rule_buf, &straight_ctx->kernel_rules_buf[pw_base->rule_idx]);
+      const int len = kernel_rule_to_cpu_rule ((char *) debug_rule_buf, &straight_ctx->kernel_rules_buf[rule_idx]);
 
       debug_rule_buf[len] = 0;
 
@@ -469,12 +502,10 @@ int build_debugdata (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
 
     int plain_len = (int) pw.pw_len;
 
-    const u64 off = device_param->innerloop_pos + il_pos;
-
     // save rule
     if ((debug_mode == 1) || (debug_mode == 3) || (debug_mode == 4) || (debug_mode == 5))
     {
-      const int len = kernel_rule_to_cpu_rule ((char *) debug_rule_buf, &straight_ctx->kernel_rules_buf[off]);
+      const int len = kernel_rule_to_cpu_rule ((char *) debug_rule_buf, &straight_ctx->kernel_rules_buf[rule_idx]);
 
       debug_rule_buf[len] = 0;
 
@@ -573,12 +604,12 @@ void outfile_write_close (hashcat_ctx_t *hashcat_ctx)
   hc_fclose (&outfile_ctx->fp);
 }
 
-int outfile_write (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, const unsigned char *plain_ptr, const u32 plain_len, const u64 crackpos, const unsigned char *username, const u32 user_len, const bool print_eol, char *tmp_buf)
+int outfile_format_line (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, const unsigned char *plain_ptr, const u32 plain_len, const u64 crackpos, const unsigned char *username, const u32 user_len, char *tmp_buf)
 {
   const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
   const hashes_t       *hashes       = hashcat_ctx->hashes;
   const user_options_t *user_options = hashcat_ctx->user_options;
-  outfile_ctx_t        *outfile_ctx  = hashcat_ctx->outfile_ctx;
+  const outfile_ctx_t  *outfile_ctx  = hashcat_ctx->outfile_ctx;
   status_ctx_t         *status_ctx   = hashcat_ctx->status_ctx;
 
   int tmp_len = 0;
@@ -787,6 +818,15 @@ int outfile_write (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int ou
 
   tmp_buf[tmp_len] = 0;
 
+  return tmp_len;
+}
+
+int outfile_write (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, const unsigned char *plain_ptr, const u32 plain_len, const u64 crackpos, const unsigned char *username, const u32 user_len, const bool print_eol, char *tmp_buf)
+{
+  outfile_ctx_t *outfile_ctx = hashcat_ctx->outfile_ctx;
+
+  const int tmp_len = outfile_format_line (hashcat_ctx, out_buf, out_len, plain_ptr, plain_len, crackpos, username, user_len, tmp_buf);
+
   if (outfile_ctx->fp.pfp != NULL)
   {
     hc_fwrite (tmp_buf, tmp_len, 1, &outfile_ctx->fp);
@@ -12,6 +12,7 @@
 #include "hashes.h"
 #include "shared.h"
 #include "thread.h"
+#include "status.h"
 #include "outfile_check.h"
 
 static int sort_by_salt_buf (const void *v1, const void *v2, MAYBE_UNUSED void * v3)
@@ -276,7 +277,7 @@ static int outfile_remove (hashcat_ctx_t *hashcat_ctx)
 
             if (salt_buf->digests_done == salt_buf->digests_cnt)
             {
-              hashes->salts_shown[salt_pos] = 1;
+              status_progress_salt_shown (hashcat_ctx, salt_pos);
 
               hashes->salts_done++;
 
@@ -249,16 +249,9 @@ void potfile_write_close (hashcat_ctx_t *hashcat_ctx)
   hc_fclose (&potfile_ctx->fp);
 }
 
-void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len)
+int potfile_format_line (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, const u8 *plain_ptr, const unsigned int plain_len, u8 *tmp_buf)
 {
-  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
-        potfile_ctx_t  *potfile_ctx  = hashcat_ctx->potfile_ctx;
-
-  if (potfile_ctx->enabled == false) return;
-
-  if (hashconfig->potfile_disable == true) return;
-
-  u8 *tmp_buf = potfile_ctx->tmp_buf;
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
 
   int tmp_len = 0;
 
@@ -301,6 +294,22 @@ void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, cons
 
   tmp_buf[tmp_len] = 0;
 
+  return tmp_len;
+}
+
+void potfile_write_append (hashcat_ctx_t *hashcat_ctx, const char *out_buf, const int out_len, u8 *plain_ptr, unsigned int plain_len)
+{
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+        potfile_ctx_t  *potfile_ctx  = hashcat_ctx->potfile_ctx;
+
+  if (potfile_ctx->enabled == false) return;
+
+  if (hashconfig->potfile_disable == true) return;
+
+  u8 *tmp_buf = potfile_ctx->tmp_buf;
+
+  potfile_format_line (hashcat_ctx, out_buf, out_len, plain_ptr, plain_len, tmp_buf);
+
   hc_lockfile (&potfile_ctx->fp);
 
   hc_fprintf (&potfile_ctx->fp, "%s" EOL, tmp_buf);
@@ -878,6 +878,332 @@ bool kernel_rules_has_noop (const kernel_rule_t *kernel_rules_buf, const u32 ker
   return false;
 }
 
+int sort_by_rule_dedup (const void *s1, const void *s2)
+{
+  const rule_dedup_t *r1 = (const rule_dedup_t *) s1;
+  const rule_dedup_t *r2 = (const rule_dedup_t *) s2;
+
+  if (r1->hash > r2->hash) return  1;
+  if (r1->hash < r2->hash) return -1;
+
+  if (r1->idx > r2->idx) return  1;
+  if (r1->idx < r2->idx) return -1;
+
+  return 0;
+}
+
+static bool rule_op_is_case (const u32 cmd)
+{
+  switch (cmd & 0xff)
+  {
+    case RULE_OP_MANGLE_LREST:         return true;
+    case RULE_OP_MANGLE_UREST:         return true;
+    case RULE_OP_MANGLE_LREST_UFIRST:  return true;
+    case RULE_OP_MANGLE_UREST_LFIRST:  return true;
+    case RULE_OP_MANGLE_TREST:         return true;
+    case RULE_OP_MANGLE_TOGGLE_AT:     return true;
+    case RULE_OP_MANGLE_TITLE:         return true;
+  }
+
+  return false;
+}
+
+static bool rule_op_sets_case (const u32 cmd)
+{
+  // the result of these only depends on the letters, not on their case
+
+  switch (cmd & 0xff)
+  {
+    case RULE_OP_MANGLE_LREST:         return true;
+    case RULE_OP_MANGLE_UREST:         return true;
+    case RULE_OP_MANGLE_LREST_UFIRST:  return true;
+    case RULE_OP_MANGLE_UREST_LFIRST:  return true;
+    case RULE_OP_MANGLE_TITLE:         return true;
+  }
+
+  return false;
+}
+
+static bool rule_pair_cancels (const u32 cmd1, const u32 cmd2)
+{
+  const u32 op1 = cmd1 & 0xff;
+  const u32 op2 = cmd2 & 0xff;
+
+  switch (op1)
+  {
+    case RULE_OP_MANGLE_REVERSE:       return (op2 == RULE_OP_MANGLE_REVERSE);
+    case RULE_OP_MANGLE_TREST:         return (op2 == RULE_OP_MANGLE_TREST);
+    case RULE_OP_MANGLE_SWITCH_FIRST:  return (op2 == RULE_OP_MANGLE_SWITCH_FIRST);
+    case RULE_OP_MANGLE_SWITCH_LAST:   return (op2 == RULE_OP_MANGLE_SWITCH_LAST);
+    case RULE_OP_MANGLE_ROTATE_LEFT:   return (op2 == RULE_OP_MANGLE_ROTATE_RIGHT);
+    case RULE_OP_MANGLE_ROTATE_RIGHT:  return (op2 == RULE_OP_MANGLE_ROTATE_LEFT);
+    case RULE_OP_MANGLE_TOGGLE_AT:     return (cmd2 == cmd1);
+    case RULE_OP_MANGLE_APPEND:        return (op2 == RULE_OP_MANGLE_DELETE_LAST);
+    case RULE_OP_MANGLE_PREPEND:       return (op2 == RULE_OP_MANGLE_DELETE_FIRST);
+  }
+
+  return false;
+}
+
+static bool rule_pair_swaps (const u32 cmd1, const u32 cmd2)
+{
+  const u32 op1 = cmd1 & 0xff;
+  const u32 op2 = cmd2 & 0xff;
+
+  // case changes are moved in front of adding a non-letter
+  // prepend and append are not independent, at the maximum password length only the first of them succeeds
+
+  if ((op1 != RULE_OP_MANGLE_APPEND) && (op1 != RULE_OP_MANGLE_PREPEND)) return false;
+
+  const u8 c = (cmd1 >> 8) & 0xff;
+
+  if (class_alpha (c) == true) return false;
+
+  if (c == ' ') return false;
+
+  switch (op2)
+  {
+    case RULE_OP_MANGLE_LREST:         return true;
+    case RULE_OP_MANGLE_UREST:         return true;
+    case RULE_OP_MANGLE_TREST:         return true;
+    case RULE_OP_MANGLE_LREST_UFIRST:  return (op1 == RULE_OP_MANGLE_APPEND);
+    case RULE_OP_MANGLE_UREST_LFIRST:  return (op1 == RULE_OP_MANGLE_APPEND);
+    case RULE_OP_MANGLE_TITLE:         return (op1 == RULE_OP_MANGLE_APPEND);
+  }
+
+  return false;
+}
+
+static u32 rule_canonicalize (const kernel_rule_t *rule, u32 canon[RULES_MAX])
+{
+  u32 canon_cnt = 0;
+
+  for (u32 rule_pos = 0; rule_pos < RULES_MAX && rule->cmds[rule_pos]; rule_pos++)
+  {
+    if (rule->cmds[rule_pos] == RULE_OP_MANGLE_NOOP) continue;
+
+    canon[canon_cnt++] = rule->cmds[rule_pos];
+  }
+
+  // peephole passes until nothing changes, every step either shortens the rule or moves an op to the left
+
+  bool changed = true;
+
+  while (changed == true)
+  {
+    changed = false;
+
+    for (u32 canon_pos = 0; canon_pos + 1 < canon_cnt; canon_pos++)
+    {
+      const u32 cmd1 = canon[canon_pos + 0];
+      const u32 cmd2 = canon[canon_pos + 1];
+
+      if (rule_pair_cancels (cmd1, cmd2) == true)
+      {
+        memmove (canon + canon_pos, canon + canon_pos + 2, (canon_cnt - canon_pos - 2) * sizeof (u32));
+
+        canon_cnt -= 2;
+
+        changed = true;
+      }
+      else if ((rule_op_is_case (cmd1) == true) && (rule_op_sets_case (cmd2) == true))
+      {
+        memmove (canon + canon_pos, canon + canon_pos + 1, (canon_cnt - canon_pos - 1) * sizeof (u32));
+
+        canon_cnt -= 1;
+
+        changed = true;
+      }
+      else if (rule_pair_swaps (cmd1, cmd2) == true)
+      {
+        canon[canon_pos + 0] = cmd2;
+        canon[canon_pos + 1] = cmd1;
+
+        changed = true;
+      }
+
+      if (changed == true) break;
+    }
+  }
+
+  return canon_cnt;
+}
+
+static u64 rule_canonical_hash (const kernel_rule_t *rule)
+{
+  u32 canon[RULES_MAX];
+
+  const u32 canon_cnt = rule_canonicalize (rule, canon);
+
+  u64 hash = 0xcbf29ce484222325;
+
+  for (u32 canon_pos = 0; canon_pos < canon_cnt; canon_pos++)
+  {
+    hash ^= canon[canon_pos];
+    hash *= 0x100000001b3;
+  }
+
+  return hash;
+}
+
+static bool rule_canonical_equal (const kernel_rule_t *rule1, const kernel_rule_t *rule2)
+{
+  u32 canon1[RULES_MAX];
+  u32 canon2[RULES_MAX];
+
+  const u32 canon1_cnt = rule_canonicalize (rule1, canon1);
+  const u32 canon2_cnt = rule_canonicalize (rule2, canon2);
+
+  if (canon1_cnt != canon2_cnt) return false;
+
+  return (memcmp (canon1, canon2, canon1_cnt * sizeof (u32)) == 0);
+}
+
+static bool rule_probe_equal (const kernel_rule_t *rule1, const kernel_rule_t *rule2, char *rule_buf1, char *rule_buf2)
+{
+  // the canonical form is only trusted if both rules also produce the same output on the cpu rule engine
+  // the probes cover empty words, case, spaces, digits and the length limits where append and prepend fail
+
+  static const char *probes[] =
+  {
+    "",
+    "a",
+    "Z",
+    "7",
+    "ab",
+    "pass",
+    "Password",
+    "password1",
+    "P@ssw0rd!",
+    "hello world",
+    "hELLO wORLD 2",
+    "aBcDeFgHiJkLmNoPqRsTuVwXyZ",
+    "1234567890",
+  };
+
+  static const int probe_lens[] = { 15, 16, 31, 32, 55, 56, 127, 128, 254, 255, 256 };
+
+  const int probes_cnt     = sizeof (probes)     / sizeof (probes[0]);
+  const int probe_lens_cnt = sizeof (probe_lens) / sizeof (probe_lens[0]);
+
+  memset (rule_buf1, 0, HCBUFSIZ_LARGE);
+  memset (rule_buf2, 0, HCBUFSIZ_LARGE);
+
+  const int rule_len1 = kernel_rule_to_cpu_rule (rule_buf1, (kernel_rule_t *) rule1);
+  const int rule_len2 = kernel_rule_to_cpu_rule (rule_buf2, (kernel_rule_t *) rule2);
+
+  if ((rule_len1 == -1) || (rule_len2 == -1)) return false;
+
+  char in[RP_PASSWORD_SIZE];
+  char out1[RP_PASSWORD_SIZE];
+  char out2[RP_PASSWORD_SIZE];
+
+  for (int probe_idx = 0; probe_idx < probes_cnt + probe_lens_cnt; probe_idx++)
+  {
+    int in_len;
+
+    if (probe_idx < probes_cnt)
+    {
+      in_len = (int) strlen (probes[probe_idx]);
+
+      memcpy (in, probes[probe_idx], in_len);
+    }
+    else
+    {
+      in_len = probe_lens[probe_idx - probes_cnt];
+
+      for (int in_pos = 0; in_pos < in_len; in_pos++) in[in_pos] = "aB3$xY9 "[in_pos % 8];
+    }
+
+    memset (out1, 0, sizeof (out1));
+    memset (out2, 0, sizeof (out2));
+
+    const int out_len1 = _old_apply_rule (rule_buf1, rule_len1, in, in_len, out1);
+    const int out_len2 = _old_apply_rule (rule_buf2, rule_len2, in, in_len, out2);
+
+    if (out_len1 != out_len2) return false;
+
+    if (out_len1 < 0) continue;
+
+    if (memcmp (out1, out2, out_len1) != 0) return false;
+  }
+
+  return true;
+}
+
+static u32 kernel_rules_dedup (kernel_rule_t *kernel_rules_buf, const u32 kernel_rules_cnt)
+{
+  if (kernel_rules_cnt < 2) return kernel_rules_cnt;
+
+  rule_dedup_t *rule_dedup = (rule_dedup_t *) hccalloc (kernel_rules_cnt, sizeof (rule_dedup_t));
+
+  for (u32 kernel_rules_pos = 0; kernel_rules_pos < kernel_rules_cnt; kernel_rules_pos++)
+  {
+    rule_dedup[kernel_rules_pos].hash = rule_canonical_hash (&kernel_rules_buf[kernel_rules_pos]);
+    rule_dedup[kernel_rules_pos].idx  = kernel_rules_pos;
+  }
+
+  qsort (rule_dedup, kernel_rules_cnt, sizeof (rule_dedup_t), sort_by_rule_dedup);
+
+  u8 *removed = (u8 *) hccalloc (kernel_rules_cnt, sizeof (u8));
+
+  char *rule_buf1 = (char *) hcmalloc (HCBUFSIZ_LARGE);
+  char *rule_buf2 = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  // within a group of equal hashes the lowest index comes first, so it's always the first occurrence that is kept
+
+  for (u32 group_start = 0, group_end = 0; group_start < kernel_rules_cnt; group_start = group_end)
+  {
+    for (group_end = group_start + 1; group_end < kernel_rules_cnt; group_end++)
+    {
+      if (rule_dedup[group_end].hash != rule_dedup[group_start].hash) break;
+    }
+
+    for (u32 dup_pos = group_start + 1; dup_pos < group_end; dup_pos++)
+    {
+      const kernel_rule_t *dup = &kernel_rules_buf[rule_dedup[dup_pos].idx];
+
+      for (u32 keep_pos = group_start; keep_pos < dup_pos; keep_pos++)
+      {
+        if (removed[rule_dedup[keep_pos].idx] == 1) continue;
+
+        const kernel_rule_t *keep = &kernel_rules_buf[rule_dedup[keep_pos].idx];
+
+        if (rule_canonical_equal (keep, dup) == false) continue;
+
+        if (rule_probe_equal (keep, dup, rule_buf1, rule_buf2) == false) continue;
+
+        removed[rule_dedup[dup_pos].idx] = 1;
+
+        break;
+      }
+    }
+  }
+
+  hcfree (rule_buf1);
+  hcfree (rule_buf2);
+
+  hcfree (rule_dedup);
+
+  u32 kept_cnt = 0;
+
+  for (u32 kernel_rules_pos = 0; kernel_rules_pos < kernel_rules_cnt; kernel_rules_pos++)
+  {
+    if (removed[kernel_rules_pos] == 1) continue;
+
+    if (kept_cnt != kernel_rules_pos)
+    {
+      memcpy (&kernel_rules_buf[kept_cnt], &kernel_rules_buf[kernel_rules_pos], sizeof (kernel_rule_t));
+    }
+
+    kept_cnt++;
+  }
+
+  hcfree (removed);
+
+  return kept_cnt;
+}
+
 int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt)
 {
   const user_options_t *user_options = hashcat_ctx->user_options;
@@ -901,6 +1227,8 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
 
   u32 rule_len = 0;
 
+  u64 rules_loaded_cnt = 1;
+
   for (u32 i = 0; i < user_options->rp_files_cnt; i++)
   {
     u32 kernel_rules_avail = 0;
@@ -1015,6 +1343,13 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
 
     hc_fclose (&fp);
 
+    rules_loaded_cnt *= kernel_rules_cnt;
+
+    if (user_options->rules_dedup == true)
+    {
+      kernel_rules_cnt = kernel_rules_dedup (kernel_rules_buf, kernel_rules_cnt);
+    }
+
     all_kernel_rules_cnt[i] = kernel_rules_cnt;
     all_kernel_rules_buf[i] = kernel_rules_buf;
   }
@@ -1056,6 +1391,8 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
     repeats[i + 1] = kernel_rules_cnt;
   }
 
+  const u64 rules_merged_cnt = kernel_rules_cnt;
+
   kernel_rule_t *kernel_rules_buf = (kernel_rule_t *) hccalloc (kernel_rules_cnt, sizeof (kernel_rule_t));
 
   if (kernel_rules_buf == NULL)
@@ -1127,6 +1464,29 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
     return -1;
   }
 
+  if (user_options->rules_dedup == true)
+  {
+    // a chain can be equivalent to another one even if none of its parts was, like "$1" + "l" and "l" + "$1"
+
+    const u32 kernel_rules_cnt_chained = kernel_rules_cnt;
+
+    if (user_options->rp_files_cnt > 1)
+    {
+      kernel_rules_cnt = kernel_rules_dedup (kernel_rules_buf, kernel_rules_cnt);
+    }
+
+    if ((user_options->quiet == false) && (user_options->stdout_flag == false) && (user_options->keyspace == false))
+    {
+      const u64 rules_removed_cnt = (rules_loaded_cnt - rules_merged_cnt) + (kernel_rules_cnt_chained - kernel_rules_cnt);
+
+      if (rules_removed_cnt > 0)
+      {
+        event_log_info (hashcat_ctx, "Rules: Removed %" PRIu64 " of %" PRIu64 " rules as equivalent to an earlier rule (%.2f%%)", rules_removed_cnt, rules_loaded_cnt, ((double) rules_removed_cnt / (double) rules_loaded_cnt) * 100);
+        event_log_info (hashcat_ctx, NULL);
+      }
+    }
+  }
+
   *out_cnt = kernel_rules_cnt;
   *out_buf = kernel_rules_buf;
 
@@ -0,0 +1,395 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "locking.h"
+#include "shared.h"
+#include "filehandling.h"
+#include "outfile.h"
+#include "status.h"
+#include "rp.h"
+#include "rulestats.h"
+
+int sort_by_rulestats_rule (const void *s1, const void *s2)
+{
+  const rulestats_entry_t *r1 = (const rulestats_entry_t *) s1;
+  const rulestats_entry_t *r2 = (const rulestats_entry_t *) s2;
+
+  return strcmp (r1->rule_buf, r2->rule_buf);
+}
+
+int sort_by_rulestats_hits (const void *s1, const void *s2)
+{
+  const rulestats_entry_t *r1 = (const rulestats_entry_t *) s1;
+  const rulestats_entry_t *r2 = (const rulestats_entry_t *) s2;
+
+  if (r1->hits < r2->hits) return  1;
+  if (r1->hits > r2->hits) return -1;
+
+  return strcmp (r1->rule_buf, r2->rule_buf);
+}
+
+static char *rulestats_format_rule (const kernel_rule_t *kernel_rule)
+{
+  // control characters, tab and non-ascii in hex notation, the line stays usable as a rule
+
+  char rule_buf[RP_RULE_SIZE];
+
+  memset (rule_buf, 0, sizeof (rule_buf));
+
+  const int rule_len = kernel_rule_to_cpu_rule (rule_buf, (kernel_rule_t *) kernel_rule);
+
+  char *out_buf = (char *) hcmalloc ((rule_len * 4) + 1);
+
+  int out_len = 0;
+
+  for (int rule_pos = 0; rule_pos < rule_len; rule_pos++)
+  {
+    const u8 c = (u8) rule_buf[rule_pos];
+
+    if ((c < 0x20) || (c > 0x7e))
+    {
+      out_len += snprintf (out_buf + out_len, 5, "\\x%02x", c);
+    }
+    else
+    {
+      out_buf[out_len++] = (char) c;
+    }
+  }
+
+  out_buf[out_len] = 0;
+
+  return out_buf;
+}
+
+int rulestats_init (hashcat_ctx_t *hashcat_ctx)
+{
+  rulestats_ctx_t *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+  user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  rulestats_ctx->enabled = false;
+
+  if (user_options->rule_stats_file == NULL) return 0;
+
+  if (user_options->usage          > 0)    return 0;
+  if (user_options->backend_info   > 0)    return 0;
+  if (user_options->hash_info      > 0)    return 0;
+
+  if (user_options->benchmark     == true) return 0;
+  if (user_options->keyspace      == true) return 0;
+  if (user_options->left          == true) return 0;
+  if (user_options->show          == true) return 0;
+  if (user_options->stdout_flag   == true) return 0;
+  if (user_options->speed_only    == true) return 0;
+  if (user_options->progress_only == true) return 0;
+  if (user_options->version       == true) return 0;
+  if (user_options->identify      == true) return 0;
+
+  rulestats_ctx->enabled = true;
+
+  rulestats_ctx->filename = user_options->rule_stats_file;
+
+  rulestats_ctx->hits_buf = NULL;
+  rulestats_ctx->hits_cnt = 0;
+  rulestats_ctx->tested   = 0;
+
+  return 0;
+}
+
+void rulestats_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  rulestats_ctx_t *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+
+  if (rulestats_ctx->enabled == false) return;
+
+  hcfree (rulestats_ctx->hits_buf);
+
+  memset (rulestats_ctx, 0, sizeof (rulestats_ctx_t));
+}
+
+int rulestats_rules_init (hashcat_ctx_t *hashcat_ctx)
+{
+  rulestats_ctx_t      *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+  const straight_ctx_t *straight_ctx  = hashcat_ctx->straight_ctx;
+
+  if (rulestats_ctx->enabled == false) return 0;
+
+  if (straight_ctx->kernel_rules_cnt == 0) return 0;
+
+  rulestats_ctx->hits_buf = (u64 *) hccalloc (straight_ctx->kernel_rules_cnt, sizeof (u64));
+  rulestats_ctx->hits_cnt = straight_ctx->kernel_rules_cnt;
+  rulestats_ctx->tested   = 0;
+
+  return 0;
+}
+
+void rulestats_rules_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  rulestats_ctx_t *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+
+  if (rulestats_ctx->enabled == false) return;
+
+  hcfree (rulestats_ctx->hits_buf);
+
+  rulestats_ctx->hits_buf = NULL;
+  rulestats_ctx->hits_cnt = 0;
+  rulestats_ctx->tested   = 0;
+}
+
+void rulestats_add (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plain)
+{
+  rulestats_ctx_t *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+
+  // called from check_hash (), mux_display is held
+
+  if (rulestats_ctx->enabled == false) return;
+
+  if (rulestats_ctx->hits_buf == NULL) return;
+
+  u64 rule_idx = 0;
+
+  build_ruleidx (hashcat_ctx, device_param, plain, &rule_idx);
+
+  if (rule_idx >= rulestats_ctx->hits_cnt) return;
+
+  rulestats_ctx->hits_buf[rule_idx]++;
+}
+
+void rulestats_tested_add (hashcat_ctx_t *hashcat_ctx)
+{
+  rulestats_ctx_t      *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+  const hashes_t       *hashes        = hashcat_ctx->hashes;
+  const straight_ctx_t *straight_ctx  = hashcat_ctx->straight_ctx;
+
+  if (rulestats_ctx->enabled == false) return;
+
+  if (rulestats_ctx->hits_buf == NULL) return;
+
+  // the progress counts every word once per salt and every rule is applied to every word,
+  // so the progress of this inner loop splits evenly across the salts and the rules
+
+  const u64 progress_done     = status_get_progress_done     (hashcat_ctx);
+  const u64 progress_rejected = status_get_progress_rejected (hashcat_ctx);
+
+  rulestats_ctx->tested += (progress_done + progress_rejected) / hashes->salts_cnt / straight_ctx->kernel_rules_cnt;
+}
+
+static int rulestats_read (hashcat_ctx_t *hashcat_ctx, rulestats_entry_t **entries_buf, u32 *entries_cnt_buf, u32 *entries_avail)
+{
+  rulestats_ctx_t *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+
+  // previous sessions, format is hits<TAB>tested<TAB>rule
+
+  if (hc_path_exist (rulestats_ctx->filename) == false) return 0;
+
+  HCFILE fp;
+
+  if (hc_fopen (&fp, rulestats_ctx->filename, "rb") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", rulestats_ctx->filename, strerror (errno));
+
+    return -1;
+  }
+
+  rulestats_entry_t *entries = *entries_buf;
+
+  u32 entries_cnt = *entries_cnt_buf;
+
+  char *line_buf = (char *) hcmalloc (HCBUFSIZ_LARGE);
+
+  while (!hc_feof (&fp))
+  {
+    const size_t line_len = fgetl (&fp, line_buf, HCBUFSIZ_LARGE);
+
+    if (line_len == 0) continue;
+
+    char *hits_pos = line_buf;
+
+    char *tested_pos = strchr (hits_pos, '\t');
+
+    if (tested_pos == NULL) continue;
+
+    *tested_pos++ = 0;
+
+    char *rule_pos = strchr (tested_pos, '\t');
+
+    if (rule_pos == NULL) continue;
+
+    *rule_pos++ = 0;
+
+    if (hc_string_is_digit (hits_pos)   == false) continue;
+    if (hc_string_is_digit (tested_pos) == false) continue;
+
+    if (entries_cnt == *entries_avail)
+    {
+      entries = (rulestats_entry_t *) hcrealloc (entries, *entries_avail * sizeof (rulestats_entry_t), INCR_RULES * sizeof (rulestats_entry_t));
+
+      *entries_avail += INCR_RULES;
+    }
+
+    rulestats_entry_t *entry = entries + entries_cnt;
+
+    entry->rule_buf = hcstrdup (rule_pos);
+    entry->hits     = strtoull (hits_pos,   NULL, 10);
+    entry->tested   = strtoull (tested_pos, NULL, 10);
+
+    entries_cnt++;
+  }
+
+  hcfree (line_buf);
+
+  hc_fclose (&fp);
+
+  *entries_buf     = entries;
+  *entries_cnt_buf = entries_cnt;
+
+  return 0;
+}
+
+static u32 rulestats_merge (rulestats_entry_t *entries, const u32 entries_cnt, const bool add_tested)
+{
+  qsort (entries, entries_cnt, sizeof (rulestats_entry_t), sort_by_rulestats_rule);
+
+  u32 merged_cnt = 0;
+
+  for (u32 entries_idx = 0; entries_idx < entries_cnt; entries_idx++)
+  {
+    rulestats_entry_t *entry = entries + entries_idx;
+
+    if ((merged_cnt > 0) && (strcmp (entries[merged_cnt - 1].rule_buf, entry->rule_buf) == 0))
+    {
+      entries[merged_cnt - 1].hits += entry->hits;
+
+      if (add_tested == true) entries[merged_cnt - 1].tested += entry->tested;
+
+      hcfree (entry->rule_buf);
+
+      continue;
+    }
+
+    entries[merged_cnt++] = *entry;
+  }
+
+  return merged_cnt;
+}
+
+int rulestats_write (hashcat_ctx_t *hashcat_ctx)
+{
+  rulestats_ctx_t      *rulestats_ctx = hashcat_ctx->rulestats_ctx;
+  const straight_ctx_t *straight_ctx  = hashcat_ctx->straight_ctx;
+
+  if (rulestats_ctx->enabled == false) return 0;
+
+  if (rulestats_ctx->hits_buf == NULL) return 0;
+
+  u32 entries_cnt   = 0;
+  u32 entries_avail = rulestats_ctx->hits_cnt;
+
+  rulestats_entry_t *entries = (rulestats_entry_t *) hccalloc (entries_avail, sizeof (rulestats_entry_t));
+
+  // this session
+
+  for (u32 rule_idx = 0; rule_idx < rulestats_ctx->hits_cnt; rule_idx++)
+  {
+    rulestats_entry_t *entry = entries + entries_cnt;
+
+    entry->rule_buf = rulestats_format_rule (&straight_ctx->kernel_rules_buf[rule_idx]);
+    entry->hits     = rulestats_ctx->hits_buf[rule_idx];
+    entry->tested   = rulestats_ctx->tested;
+
+    entries_cnt++;
+  }
+
+  // a rule listed more than once was tried on the same words each time, its hits add up but its tested count does not
+
+  entries_cnt = rulestats_merge (entries, entries_cnt, false);
+
+  // sessions sharing the file can finish at the same time, the lock is held on a separate file from reading
+  // the old stats until the new ones are renamed over them, so a waiting session never reads a replaced file
+
+  char *lock_file = NULL;
+  char *tmp_file  = NULL;
+
+  hc_asprintf (&lock_file, "%s.lock", rulestats_ctx->filename);
+  hc_asprintf (&tmp_file,  "%s.%d",   rulestats_ctx->filename, (int) getpid ());
+
+  int rc = 0;
+
+  HCFILE lock_fp;
+
+  if (hc_fopen (&lock_fp, lock_file, "ab") == false)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", lock_file, strerror (errno));
+
+    rc = -1;
+  }
+  else
+  {
+    if (hc_lockfile (&lock_fp) == -1)
+    {
+      event_log_error (hashcat_ctx, "%s: Failed to lock file.", lock_file);
+    }
+
+    HCFILE fp;
+
+    if (rulestats_read (hashcat_ctx, &entries, &entries_cnt, &entries_avail) == -1)
+    {
+      rc = -1;
+    }
+    else if (hc_fopen (&fp, tmp_file, "wb") == false)
+    {
+      event_log_error (hashcat_ctx, "%s: %s", tmp_file, strerror (errno));
+
+      rc = -1;
+    }
+    else
+    {
+      entries_cnt = rulestats_merge (entries, entries_cnt, true);
+
+      // best rules first, rules without hits at the end
+
+      qsort (entries, entries_cnt, sizeof (rulestats_entry_t), sort_by_rulestats_hits);
+
+      for (u32 entries_idx = 0; entries_idx < entries_cnt; entries_idx++)
+      {
+        const rulestats_entry_t *entry = entries + entries_idx;
+
+        hc_fprintf (&fp, "%" PRIu64 "\t%" PRIu64 "\t%s" EOL, entry->hits, entry->tested, entry->rule_buf);
+      }
+
+      hc_fflush (&fp);
+
+      hc_fclose (&fp);
+
+      if (rename (tmp_file, rulestats_ctx->filename) == -1)
+      {
+        event_log_error (hashcat_ctx, "%s: %s", rulestats_ctx->filename, strerror (errno));
+
+        unlink (tmp_file);
+
+        rc = -1;
+      }
+    }
+
+    if (hc_unlockfile (&lock_fp))
+    {
+      event_log_error (hashcat_ctx, "%s: Failed to unlock file.", lock_file);
+    }
+
+    hc_fclose (&lock_fp);
+  }
+
+  hcfree (lock_file);
+  hcfree (tmp_file);
+
+  for (u32 entries_idx = 0; entries_idx < entries_cnt; entries_idx++) hcfree (entries[entries_idx].rule_buf);
+
+  hcfree (entries);
+
+  return rc;
+}
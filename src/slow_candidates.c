@@ -344,6 +344,17 @@ void slow_candidates_next (hashcat_ctx_t *hashcat_ctx, void *extra_info)
   {
     extra_info_mask_t *extra_info_mask = (extra_info_mask_t *) extra_info;
 
-    sp_exec (extra_info_mask->pos, (char *) extra_info_mask->out_buf, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, 0, mask_ctx->css_cnt);
+    if ((extra_info_mask->sp_iter_valid == true) && (extra_info_mask->pos == extra_info_mask->sp_iter_pos + 1))
+    {
+      sp_iter_next (&extra_info_mask->sp_iter);
+    }
+    else
+    {
+      sp_iter_init (&extra_info_mask->sp_iter, extra_info_mask->pos, (char *) extra_info_mask->out_buf, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, 0, mask_ctx->css_cnt);
+
+      extra_info_mask->sp_iter_valid = true;
+    }
+
+    extra_info_mask->sp_iter_pos = extra_info_mask->pos;
   }
 }
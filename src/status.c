@@ -1296,32 +1296,16 @@ double status_get_progress_finished_percent (const hashcat_ctx_t *hashcat_ctx)
 
 u64 status_get_progress_done (const hashcat_ctx_t *hashcat_ctx)
 {
-  const hashes_t     *hashes     = hashcat_ctx->hashes;
   const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
-  u64 progress_done = 0;
-
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-  {
-    progress_done += status_ctx->words_progress_done[salt_pos];
-  }
-
-  return progress_done;
+  return status_ctx->words_progress_done_total;
 }
 
 u64 status_get_progress_rejected (const hashcat_ctx_t *hashcat_ctx)
 {
-  const hashes_t     *hashes     = hashcat_ctx->hashes;
   const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
-  u64 progress_rejected = 0;
-
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-  {
-    progress_rejected += status_ctx->words_progress_rejected[salt_pos];
-  }
-
-  return progress_rejected;
+  return status_ctx->words_progress_rejected_total;
 }
 
 double status_get_progress_rejected_percent (const hashcat_ctx_t *hashcat_ctx)
@@ -1341,17 +1325,9 @@ double status_get_progress_rejected_percent (const hashcat_ctx_t *hashcat_ctx)
 
 u64 status_get_progress_restored (const hashcat_ctx_t *hashcat_ctx)
 {
-  const hashes_t     *hashes     = hashcat_ctx->hashes;
   const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
-  u64 progress_restored = 0;
-
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-  {
-    progress_restored += status_ctx->words_progress_restored[salt_pos];
-  }
-
-  return progress_restored;
+  return status_ctx->words_progress_restored_total;
 }
 
 u64 status_get_progress_cur (const hashcat_ctx_t *hashcat_ctx)
@@ -1367,7 +1343,6 @@ u64 status_get_progress_cur (const hashcat_ctx_t *hashcat_ctx)
 
 u64 status_get_progress_ignore (const hashcat_ctx_t *hashcat_ctx)
 {
-  const hashes_t             *hashes             = hashcat_ctx->hashes;
   const status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
   const user_options_t       *user_options       = hashcat_ctx->user_options;
   const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
@@ -1404,22 +1379,9 @@ u64 status_get_progress_ignore (const hashcat_ctx_t *hashcat_ctx)
     }
   }
   // Important for ETA only
+  // sum of (words_cnt - progress of salt) over all shown salts
 
-  u64 progress_ignore = 0;
-
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-  {
-    if (hashes->salts_shown[salt_pos] == 1)
-    {
-      const u64 all = status_ctx->words_progress_done[salt_pos]
-                    + status_ctx->words_progress_rejected[salt_pos]
-                    + status_ctx->words_progress_restored[salt_pos];
-
-      const u64 left = words_cnt - all;
-
-      progress_ignore += left;
-    }
-  }
+  const u64 progress_ignore = ((u64) status_ctx->words_progress_shown_cnt * words_cnt) - status_ctx->words_progress_shown_total;
 
   return progress_ignore;
 }
@@ -2347,6 +2309,19 @@ int status_progress_init (hashcat_ctx_t *hashcat_ctx)
   status_ctx->words_progress_rejected = (u64 *) hccalloc (hashes->salts_cnt, sizeof (u64));
   status_ctx->words_progress_restored = (u64 *) hccalloc (hashes->salts_cnt, sizeof (u64));
 
+  status_ctx->words_progress_done_total     = 0;
+  status_ctx->words_progress_rejected_total = 0;
+  status_ctx->words_progress_restored_total = 0;
+  status_ctx->words_progress_shown_total    = 0;
+  status_ctx->words_progress_shown_cnt      = 0;
+
+  // salts already cracked by the potfile are flagged before the progress arrays exist
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    if (hashes->salts_shown[salt_pos] == 1) status_ctx->words_progress_shown_cnt++;
+  }
+
   return 0;
 }
 
@@ -2371,6 +2346,116 @@ void status_progress_reset (hashcat_ctx_t *hashcat_ctx)
   memset (status_ctx->words_progress_done,     0, hashes->salts_cnt * sizeof (u64));
   memset (status_ctx->words_progress_rejected, 0, hashes->salts_cnt * sizeof (u64));
   memset (status_ctx->words_progress_restored, 0, hashes->salts_cnt * sizeof (u64));
+
+  status_ctx->words_progress_done_total     = 0;
+  status_ctx->words_progress_rejected_total = 0;
+  status_ctx->words_progress_restored_total = 0;
+  status_ctx->words_progress_shown_total    = 0;
+}
+
+/**
+ * the per salt progress arrays are kept for the restore and the salt based skips,
+ * the running totals next to them keep the status getters O(1) for any number of salts.
+ * all add/set functions expect the caller to hold mux_counter.
+ */
+
+void status_progress_add_done (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u64 cnt)
+{
+  const hashes_t *hashes     = hashcat_ctx->hashes;
+  status_ctx_t   *status_ctx = hashcat_ctx->status_ctx;
+
+  status_ctx->words_progress_done[salt_pos] += cnt;
+
+  status_ctx->words_progress_done_total += cnt;
+
+  if (hashes->salts_shown[salt_pos] == 1) status_ctx->words_progress_shown_total += cnt;
+}
+
+void status_progress_add_rejected (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u64 cnt)
+{
+  const hashes_t *hashes     = hashcat_ctx->hashes;
+  status_ctx_t   *status_ctx = hashcat_ctx->status_ctx;
+
+  status_ctx->words_progress_rejected[salt_pos] += cnt;
+
+  status_ctx->words_progress_rejected_total += cnt;
+
+  if (hashes->salts_shown[salt_pos] == 1) status_ctx->words_progress_shown_total += cnt;
+}
+
+void status_progress_add_rejected_all (hashcat_ctx_t *hashcat_ctx, const u64 cnt)
+{
+  const hashes_t *hashes     = hashcat_ctx->hashes;
+  status_ctx_t   *status_ctx = hashcat_ctx->status_ctx;
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    status_ctx->words_progress_rejected[salt_pos] += cnt;
+  }
+
+  status_ctx->words_progress_rejected_total += cnt * hashes->salts_cnt;
+  status_ctx->words_progress_shown_total    += cnt * status_ctx->words_progress_shown_cnt;
+}
+
+void status_progress_set_rejected_all (hashcat_ctx_t *hashcat_ctx, const u64 cnt)
+{
+  const hashes_t *hashes     = hashcat_ctx->hashes;
+  status_ctx_t   *status_ctx = hashcat_ctx->status_ctx;
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    const u64 old = status_ctx->words_progress_rejected[salt_pos];
+
+    status_ctx->words_progress_rejected[salt_pos] = cnt;
+
+    status_ctx->words_progress_rejected_total += cnt - old;
+
+    if (hashes->salts_shown[salt_pos] == 1) status_ctx->words_progress_shown_total += cnt - old;
+  }
+}
+
+void status_progress_set_restored (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u64 cnt)
+{
+  const hashes_t *hashes     = hashcat_ctx->hashes;
+  status_ctx_t   *status_ctx = hashcat_ctx->status_ctx;
+
+  const u64 old = status_ctx->words_progress_restored[salt_pos];
+
+  status_ctx->words_progress_restored[salt_pos] = cnt;
+
+  status_ctx->words_progress_restored_total += cnt - old;
+
+  if (hashes->salts_shown[salt_pos] == 1) status_ctx->words_progress_shown_total += cnt - old;
+}
+
+// flags a salt as shown, takes mux_counter itself so the flag and the shown sums change together
+
+void status_progress_salt_shown (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos)
+{
+  hashes_t     *hashes     = hashcat_ctx->hashes;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  if (status_ctx->words_progress_done == NULL)
+  {
+    hashes->salts_shown[salt_pos] = 1;
+
+    return;
+  }
+
+  hc_thread_mutex_lock (status_ctx->mux_counter);
+
+  if (hashes->salts_shown[salt_pos] == 0)
+  {
+    hashes->salts_shown[salt_pos] = 1;
+
+    status_ctx->words_progress_shown_total += status_ctx->words_progress_done[salt_pos]
+                                            + status_ctx->words_progress_rejected[salt_pos]
+                                            + status_ctx->words_progress_restored[salt_pos];
+
+    status_ctx->words_progress_shown_cnt++;
+  }
+
+  hc_thread_mutex_unlock (status_ctx->mux_counter);
 }
 
 int status_ctx_init (hashcat_ctx_t *hashcat_ctx)
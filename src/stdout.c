@@ -117,25 +117,32 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
   int rc = 0;
 
+  // the mask part which changes with il_pos is generated by sp_iter_next(), the part which only depends on gidvid once per gidvid
+
+  sp_iter_t sp_iter;
+
   if (user_options->attack_mode == ATTACK_MODE_BF)
   {
+    const u32 l_start = device_param->kernel_params_mp_l_buf32[5];
+    const u32 r_start = device_param->kernel_params_mp_r_buf32[5];
+
+    const u32 l_stop = device_param->kernel_params_mp_l_buf32[4];
+    const u32 r_stop = device_param->kernel_params_mp_r_buf32[4];
+
+    plain_len = mask_ctx->css_cnt;
+
     for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
     {
-      for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
-      {
-        u64 l_off = device_param->kernel_params_mp_l_buf64[3] + gidvid;
-        u64 r_off = device_param->kernel_params_mp_r_buf64[3] + il_pos;
-
-        u32 l_start = device_param->kernel_params_mp_l_buf32[5];
-        u32 r_start = device_param->kernel_params_mp_r_buf32[5];
+      const u64 l_off = device_param->kernel_params_mp_l_buf64[3] + gidvid;
+      const u64 r_off = device_param->kernel_params_mp_r_buf64[3];
 
-        u32 l_stop = device_param->kernel_params_mp_l_buf32[4];
-        u32 r_stop = device_param->kernel_params_mp_r_buf32[4];
+      sp_exec (l_off, (char *) plain_ptr + l_start, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, l_start, l_start + l_stop);
 
-        sp_exec (l_off, (char *) plain_ptr + l_start, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, l_start, l_start + l_stop);
-        sp_exec (r_off, (char *) plain_ptr + r_start, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, r_start, r_start + r_stop);
+      sp_iter_init (&sp_iter, r_off, (char *) plain_ptr + r_start, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, r_start, r_start + r_stop);
 
-        plain_len = mask_ctx->css_cnt;
+      for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
+      {
+        if (il_pos) sp_iter_next (&sp_iter);
 
         out_push (&out, plain_ptr, plain_len);
       }
@@ -145,15 +152,15 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
   {
     for (u64 gidvid = 0; gidvid < pws_cnt; gidvid++)
     {
-      for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
-      {
-        u64 off = device_param->kernel_params_mp_buf64[3] + gidvid;
+      const u64 off = device_param->kernel_params_mp_buf64[3] + gidvid;
 
-        u32 start = 0;
-        u32 stop  = device_param->kernel_params_mp_buf32[4];
+      const u32 start = 0;
+      const u32 stop  = device_param->kernel_params_mp_buf32[4];
 
-        sp_exec (off, (char *) plain_ptr, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + stop);
+      sp_exec (off, (char *) plain_ptr, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + stop);
 
+      for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
+      {
         plain_len = stop;
 
         char *comb_buf = (char *) device_param->combs_buf[il_pos].i;
@@ -279,27 +286,29 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
       }
       else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
       {
+        const u64 off = device_param->kernel_params_mp_buf64[3];
+
+        const u32 start = 0;
+        const u32 stop  = device_param->kernel_params_mp_buf32[4];
+
         while (pw_idx <= pw_idx_last)
         {
           u32 *pw = pws_comp_blk + (pw_idx->off - off_blk);
 
-          for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
+          for (u32 i = 0; i < pw_idx->cnt; i++)
           {
-            for (u32 i = 0; i < pw_idx->cnt; i++)
-            {
-              plain_buf[i] = pw[i];
-            }
-
-            plain_len = pw_idx->len;
+            plain_buf[i] = pw[i];
+          }
 
-            u64 off = device_param->kernel_params_mp_buf64[3] + il_pos;
+          plain_len = pw_idx->len;
 
-            u32 start = 0;
-            u32 stop  = device_param->kernel_params_mp_buf32[4];
+          sp_iter_init (&sp_iter, off, (char *) plain_ptr + plain_len, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + stop);
 
-            sp_exec (off, (char *) plain_ptr + plain_len, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + stop);
+          plain_len += start + stop;
 
-            plain_len += start + stop;
+          for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
+          {
+            if (il_pos) sp_iter_next (&sp_iter);
 
             out_push (&out, plain_ptr, plain_len);
           }
@@ -309,18 +318,20 @@ int process_stdout (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
       }
       else if ((user_options->attack_mode == ATTACK_MODE_HYBRID2) && (hashconfig->opti_type & OPTI_TYPE_OPTIMIZED_KERNEL))
       {
+        const u64 off = device_param->kernel_params_mp_buf64[3];
+
+        const u32 start = 0;
+        const u32 stop  = device_param->kernel_params_mp_buf32[4];
+
         while (pw_idx <= pw_idx_last)
         {
           char *pw = (char *) (pws_comp_blk + (pw_idx->off - off_blk));
 
+          sp_iter_init (&sp_iter, off, (char *) plain_ptr, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + stop);
+
           for (u32 il_pos = 0; il_pos < il_cnt; il_pos++)
           {
-            u64 off = device_param->kernel_params_mp_buf64[3] + il_pos;
-
-            u32 start = 0;
-            u32 stop  = device_param->kernel_params_mp_buf32[4];
-
-            sp_exec (off, (char *) plain_ptr, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + stop);
+            if (il_pos) sp_iter_next (&sp_iter);
 
             plain_len = stop;
 
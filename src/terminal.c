@@ -13,6 +13,7 @@
 #include "shared.h"
 #include "hwmon.h"
 #include "interface.h"
+#include "module_registry.h"
 #include "hashcat.h"
 #include "timer.h"
 #include "terminal.h"
@@ -1232,6 +1233,28 @@ void hash_info_single (hashcat_ctx_t *hashcat_ctx, user_options_extra_t *user_op
   hashconfig_destroy (hashcat_ctx);
 }
 
+static void hash_info_mode (hashcat_ctx_t *hashcat_ctx, const u32 hash_mode)
+{
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  user_options->hash_mode = hash_mode;
+
+  if (user_options->machine_readable == true)
+  {
+    if (hash_mode != 0)
+    {
+      printf (", ");
+    }
+
+    hash_info_single_json (hashcat_ctx, user_options_extra);
+  }
+  else
+  {
+    hash_info_single (hashcat_ctx, user_options_extra);
+  }
+}
+
 void hash_info (hashcat_ctx_t *hashcat_ctx)
 {
   folder_config_t      *folder_config      = hashcat_ctx->folder_config;
@@ -1260,36 +1283,40 @@ void hash_info (hashcat_ctx_t *hashcat_ctx)
   }
   else
   {
-    char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
-
     if (user_options->machine_readable == true) printf ("{ ");
 
-    for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
-    {
-      user_options->hash_mode = i;
+    // the module registry saves us from probing for all possible module filenames
 
-      module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+    module_registry_entry_t *registry = NULL;
 
-      if (hc_path_exist (modulefile) == false) continue;
+    const int registry_cnt = module_registry_load (hashcat_ctx, &registry);
 
-      if (user_options->machine_readable == true)
+    if (registry_cnt > 0)
+    {
+      for (int registry_idx = 0; registry_idx < registry_cnt; registry_idx++)
       {
-        if (i != 0)
-        {
-          printf (", ");
-        }
-
-        hash_info_single_json (hashcat_ctx, user_options_extra);
+        hash_info_mode (hashcat_ctx, registry[registry_idx].hash_mode);
       }
-      else
+
+      hcfree (registry);
+    }
+    else
+    {
+      char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
+
+      for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
       {
-        hash_info_single (hashcat_ctx, user_options_extra);
+        module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+
+        if (hc_path_exist (modulefile) == false) continue;
+
+        hash_info_mode (hashcat_ctx, i);
       }
+
+      hcfree (modulefile);
     }
 
     if (user_options->machine_readable == true) printf (" }");
-
-    hcfree (modulefile);
   }
 }
 
@@ -8,6 +8,7 @@
 #include "memory.h"
 #include "shared.h"
 #include "interface.h"
+#include "module_registry.h"
 #include "usage.h"
 
 static const char *const USAGE_MINI[] =
@@ -44,6 +45,7 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --keep-guessing            |      | Keep guessing the hash after it has been cracked     |",
   "     --self-test-disable        |      | Disable self-test functionality on startup           |",
   "     --loopback                 |      | Add new plains to induct directory                   |",
+  "     --loopback-live            |      | Add new plains to the running attack, too            |",
   "     --markov-hcstat2           | File | Specify hcstat2 file to use                          | --markov-hcstat2=my.hcstat2",
   "     --markov-disable           |      | Disables markov-chains, emulates classic brute-force |",
   "     --markov-classic           |      | Enables classic markov-chains, no per-position       |",
@@ -71,6 +73,7 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --remove-timer             | Num  | Update input hash file each X seconds                | --remove-timer=30",
   "     --potfile-disable          |      | Do not write potfile                                 |",
   "     --potfile-path             | File | Specific path to potfile                             | --potfile-path=my.pot",
+  "     --crack-sink-async         |      | Write cracks to outfile/potfile from a writer thread |",
   "     --encoding-from            | Code | Force internal wordlist encoding from X              | --encoding-from=iso-8859-15",
   "     --encoding-to              | Code | Force internal wordlist encoding to X                | --encoding-to=utf-32le",
   "     --debug-mode               | Num  | Defines the debug mode (hybrid only by using rules)  | --debug-mode=4",
@@ -89,6 +92,9 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   "     --benchmark-all            |      | Run benchmark of all hash-modes (requires -b)        |",
   "     --benchmark-min            |      | Set benchmark min hash-mode (requires -b)            | --benchmark-min=100",
   "     --benchmark-max            |      | Set benchmark max hash-mode (requires -b)            | --benchmark-max=1000",
+  "     --benchmark-host           |      | Run micro-benchmark of host-side pipeline stages     |",
+  "     --benchmark-host-size      | Num  | Number of synthetic items per host benchmark stage   | --benchmark-host-size=100000",
+  "     --benchmark-host-baseline  | File | Compare host benchmark against saved JSON output     | --benchmark-host-baseline=host.json",
   "     --speed-only               |      | Return expected speed of the attack, then quit       |",
   "     --progress-only            |      | Return ideal progress step size and time to process  |",
   " -c, --segment-size             | Num  | Sets size in MB to cache from the wordfile to X      | -c 32",
@@ -119,6 +125,8 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -u, --kernel-loops             | Num  | Manual workload tuning, set innerloop step size to X | -u 256",
   " -T, --kernel-threads           | Num  | Manual workload tuning, set thread count to X        | -T 64",
   "     --backend-vector-width     | Num  | Manually override backend vector-width to X          | --backend-vector-width=4",
+  "     --kernel-cache-pack        | File | Shared kernel binary cache pack (read, or prewarm)   | --kernel-cache-pack=k.hcpack",
+  "     --kernel-cache-prewarm     |      | Build kernels of selected hash-modes into the pack   |",
   "     --spin-damp                | Num  | Use CPU for device synchronization, in percent       | --spin-damp=10",
   "     --hwmon-disable            |      | Disable temperature and fanspeed reads and triggers  |",
   "     --hwmon-temp-abort         | Num  | Abort if temperature reaches X degrees Celsius       | --hwmon-temp-abort=100",
@@ -131,6 +139,8 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -k, --rule-right               | Rule | Single rule applied to each word from right wordlist | -k '^-'",
   " -r, --rules-file               | File | Multiple rules applied to each word from wordlists   | -r rules/best66.rule",
   " -g, --generate-rules           | Num  | Generate X random rules                              | -g 10000",
+  "     --rules-dedup              |      | Drop rules that are equivalent to an earlier rule    |",
+  "     --rule-stats-file          | File | Count cracks per rule, merged into this file         | --rule-stats-file=rules.stats",
   "     --generate-rules-func-min  | Num  | Force min X functions per rule                       |",
   "     --generate-rules-func-max  | Num  | Force max X functions per rule                       |",
   "     --generate-rules-func-sel  | Str  | Pool of rule operators valid for random rule engine  | --generate-rules-func-sel=ioTlc",
@@ -148,12 +158,15 @@ static const char *const USAGE_BIG_PRE_HASHMODES[] =
   " -ii,--increment-inverse        |      | Increment from right-to-left                         |",
   "     --increment-min            | Num  | Start mask incrementing at X                         | --increment-min=4",
   "     --increment-max            | Num  | Stop mask incrementing at X                          | --increment-max=8",
+  "     --mask-batch               |      | Cache autotune results across masks of a mask file   |",
   " -S, --slow-candidates          |      | Enable slower (but advanced) candidate generators    |",
   "     --bypass-delay             | Num  | Seconds delay between checking bypass threshold      | --bypass-delay=5",
   "     --bypass-threshold         | Num  | Minimum amount of founds to avoid being bypassed     | --bypass-threshold=5",
   #ifdef WITH_BRAIN
   "     --brain-server             |      | Enable brain server                                  |",
   "     --brain-server-timer       | Num  | Update the brain server dump each X seconds (min:60) | --brain-server-timer=300",
+  "     --brain-server-filter      | Hex  | Store given sessions in a filter, comma separated    | --brain-server-filter=0x2ae611db",
+  "     --brain-server-filter-bits | Num  | Fingerprint bits of --brain-server-filter [8|16|32]  | --brain-server-filter-bits=8",
   " -z, --brain-client             |      | Enable brain client, activates -S                    |",
   "     --brain-client-features    | Num  | Define brain client features, see below              | --brain-client-features=3",
   "     --brain-host               | Str  | Brain server host (IP or domain)                     | --brain-host=127.0.0.1",
@@ -197,6 +210,7 @@ static const char *const USAGE_BIG_POST_HASHMODES[] =
   "  1 | Send hashed passwords",
   "  2 | Send attack positions",
   "  3 | Send hashed passwords and attack positions",
+  "  4 | Pipeline lookups with device runs (add to 1 or 3)",
   "",
   #endif
   "- [ Outfile Formats ] -",
@@ -349,34 +363,54 @@ void usage_big_print (hashcat_ctx_t *hashcat_ctx)
 
   if (user_options->usage > 1)
   {
-    char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
-
     usage_sort_buf = (usage_sort_t *) hccalloc (MODULE_HASH_MODES_MAXIMUM, sizeof (usage_sort_t));
 
-    for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
+    // the module registry has everything we need, no plugin has to be loaded
+
+    module_registry_entry_t *registry = NULL;
+
+    const int registry_cnt = module_registry_load (hashcat_ctx, &registry);
+
+    for (int registry_idx = 0; registry_idx < registry_cnt; registry_idx++)
     {
-      user_options->hash_mode = i;
+      usage_sort_buf[usage_sort_cnt].hash_mode     = registry[registry_idx].hash_mode;
+      usage_sort_buf[usage_sort_cnt].hash_name     = hcstrdup (registry[registry_idx].hash_name);
+      usage_sort_buf[usage_sort_cnt].hash_category = registry[registry_idx].hash_category;
 
-      module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+      usage_sort_cnt++;
+    }
 
-      if (hc_path_exist (modulefile) == false) continue;
+    hcfree (registry);
 
-      const int rc = hashconfig_init (hashcat_ctx);
+    if (registry_cnt <= 0)
+    {
+      char *modulefile = (char *) hcmalloc (HCBUFSIZ_TINY);
 
-      if (rc == 0)
+      for (int i = 0; i < MODULE_HASH_MODES_MAXIMUM; i++)
       {
-        usage_sort_buf[usage_sort_cnt].hash_mode     = hashconfig->hash_mode;
-        usage_sort_buf[usage_sort_cnt].hash_name     = hcstrdup (hashconfig->hash_name);
-        usage_sort_buf[usage_sort_cnt].hash_category = hashconfig->hash_category;
+        user_options->hash_mode = i;
 
-        usage_sort_cnt++;
+        module_filename (folder_config, i, modulefile, HCBUFSIZ_TINY);
+
+        if (hc_path_exist (modulefile) == false) continue;
+
+        const int rc = hashconfig_init (hashcat_ctx);
+
+        if (rc == 0)
+        {
+          usage_sort_buf[usage_sort_cnt].hash_mode     = hashconfig->hash_mode;
+          usage_sort_buf[usage_sort_cnt].hash_name     = hcstrdup (hashconfig->hash_name);
+          usage_sort_buf[usage_sort_cnt].hash_category = hashconfig->hash_category;
+
+          usage_sort_cnt++;
+        }
+
+        hashconfig_destroy (hashcat_ctx);
       }
 
-      hashconfig_destroy (hashcat_ctx);
+      hcfree (modulefile);
     }
 
-    hcfree (modulefile);
-
     qsort (usage_sort_buf, usage_sort_cnt, sizeof (usage_sort_t), sort_by_usage);
   }
 
@@ -52,6 +52,9 @@ static const struct option long_options[] =
   {"benchmark-max",             required_argument, NULL, IDX_BENCHMARK_MAX},
   {"benchmark-min",             required_argument, NULL, IDX_BENCHMARK_MIN},
   {"benchmark",                 no_argument,       NULL, IDX_BENCHMARK},
+  {"benchmark-host",            no_argument,       NULL, IDX_BENCHMARK_HOST},
+  {"benchmark-host-baseline",   required_argument, NULL, IDX_BENCHMARK_HOST_BASELINE},
+  {"benchmark-host-size",       required_argument, NULL, IDX_BENCHMARK_HOST_SIZE},
   {"bitmap-max",                required_argument, NULL, IDX_BITMAP_MAX},
   {"bitmap-min",                required_argument, NULL, IDX_BITMAP_MIN},
   {"bridge-parameter1",         required_argument, NULL, IDX_BRIDGE_PARAMETER1},
@@ -99,6 +102,8 @@ static const struct option long_options[] =
   {"induction-dir",             required_argument, NULL, IDX_INDUCTION_DIR},
   {"keep-guessing",             no_argument,       NULL, IDX_KEEP_GUESSING},
   {"kernel-accel",              required_argument, NULL, IDX_KERNEL_ACCEL},
+  {"kernel-cache-pack",         required_argument, NULL, IDX_KERNEL_CACHE_PACK},
+  {"kernel-cache-prewarm",      no_argument,       NULL, IDX_KERNEL_CACHE_PREWARM},
   {"kernel-loops",              required_argument, NULL, IDX_KERNEL_LOOPS},
   {"kernel-threads",            required_argument, NULL, IDX_KERNEL_THREADS},
   {"keyboard-layout-mapping",   required_argument, NULL, IDX_KEYBOARD_LAYOUT_MAPPING},
@@ -108,7 +113,9 @@ static const struct option long_options[] =
   {"limit",                     required_argument, NULL, IDX_LIMIT},
   {"logfile-disable",           no_argument,       NULL, IDX_LOGFILE_DISABLE},
   {"loopback",                  no_argument,       NULL, IDX_LOOPBACK},
+  {"loopback-live",             no_argument,       NULL, IDX_LOOPBACK_LIVE},
   {"machine-readable",          no_argument,       NULL, IDX_MACHINE_READABLE},
+  {"mask-batch",                no_argument,       NULL, IDX_MASK_BATCH},
   {"markov-classic",            no_argument,       NULL, IDX_MARKOV_CLASSIC},
   {"markov-disable",            no_argument,       NULL, IDX_MARKOV_DISABLE},
   {"markov-hcstat2",            required_argument, NULL, IDX_MARKOV_HCSTAT2},
@@ -137,6 +144,8 @@ static const struct option long_options[] =
   {"rule-left",                 required_argument, NULL, IDX_RULE_BUF_L},
   {"rule-right",                required_argument, NULL, IDX_RULE_BUF_R},
   {"rules-file",                required_argument, NULL, IDX_RP_FILE},
+  {"rules-dedup",               no_argument,       NULL, IDX_RULES_DEDUP},
+  {"rule-stats-file",           required_argument, NULL, IDX_RULE_STATS_FILE},
   {"runtime",                   required_argument, NULL, IDX_RUNTIME},
   {"scrypt-tmto",               required_argument, NULL, IDX_SCRYPT_TMTO},
   {"segment-size",              required_argument, NULL, IDX_SEGMENT_SIZE},
@@ -167,6 +176,8 @@ static const struct option long_options[] =
   {"brain-client-features",     required_argument, NULL, IDX_BRAIN_CLIENT_FEATURES},
   {"brain-server",              no_argument,       NULL, IDX_BRAIN_SERVER},
   {"brain-server-timer",        required_argument, NULL, IDX_BRAIN_SERVER_TIMER},
+  {"brain-server-filter",       required_argument, NULL, IDX_BRAIN_SERVER_FILTER},
+  {"brain-server-filter-bits",  required_argument, NULL, IDX_BRAIN_SERVER_FILTER_BITS},
   {"brain-host",                required_argument, NULL, IDX_BRAIN_HOST},
   {"brain-port",                required_argument, NULL, IDX_BRAIN_PORT},
   {"brain-password",            required_argument, NULL, IDX_BRAIN_PASSWORD},
@@ -174,6 +185,7 @@ static const struct option long_options[] =
   {"brain-session-whitelist",   required_argument, NULL, IDX_BRAIN_SESSION_WHITELIST},
   #endif
   {"color-cracked",             no_argument,       NULL, IDX_COLOR_CRACKED},
+  {"crack-sink-async",          no_argument,       NULL, IDX_CRACK_SINK_ASYNC},
   {NULL,                        0,                 NULL, 0 }
 };
 
@@ -210,6 +222,9 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->benchmark_max             = BENCHMARK_MAX;
   user_options->benchmark_min             = BENCHMARK_MIN;
   user_options->benchmark                 = BENCHMARK;
+  user_options->benchmark_host            = BENCHMARK_HOST;
+  user_options->benchmark_host_baseline   = NULL;
+  user_options->benchmark_host_size       = BENCHMARK_HOST_SIZE;
   user_options->bitmap_max                = BITMAP_MAX;
   user_options->bitmap_min                = BITMAP_MIN;
   #ifdef WITH_BRAIN
@@ -219,10 +234,13 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->brain_port                = BRAIN_PORT;
   user_options->brain_server              = BRAIN_SERVER;
   user_options->brain_server_timer        = BRAIN_SERVER_TIMER;
+  user_options->brain_server_filter       = NULL;
+  user_options->brain_server_filter_bits  = BRAIN_SERVER_FILTER_BITS;
   user_options->brain_session             = BRAIN_SESSION;
   user_options->brain_session_whitelist   = NULL;
   #endif
   user_options->color_cracked             = COLOR_CRACKED;
+  user_options->crack_sink_async          = CRACK_SINK_ASYNC;
   user_options->bridge_parameter1         = NULL;
   user_options->bridge_parameter2         = NULL;
   user_options->bridge_parameter3         = NULL;
@@ -260,6 +278,8 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->induction_dir             = NULL;
   user_options->keep_guessing             = KEEP_GUESSING;
   user_options->kernel_accel              = KERNEL_ACCEL;
+  user_options->kernel_cache_pack         = NULL;
+  user_options->kernel_cache_prewarm      = KERNEL_CACHE_PREWARM;
   user_options->kernel_loops              = KERNEL_LOOPS;
   user_options->kernel_threads            = KERNEL_THREADS;
   user_options->keyboard_layout_mapping   = NULL;
@@ -269,7 +289,9 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->limit                     = LIMIT;
   user_options->logfile                   = LOGFILE;
   user_options->loopback                  = LOOPBACK;
+  user_options->loopback_live             = LOOPBACK_LIVE;
   user_options->machine_readable          = MACHINE_READABLE;
+  user_options->mask_batch                = MASK_BATCH;
   user_options->markov_classic            = MARKOV_CLASSIC;
   user_options->markov                    = MARKOV;
   user_options->markov_hcstat2            = NULL;
@@ -306,6 +328,8 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->runtime                   = RUNTIME;
   user_options->scrypt_tmto               = SCRYPT_TMTO;
   user_options->segment_size              = SEGMENT_SIZE;
+  user_options->rule_stats_file           = NULL;
+  user_options->rules_dedup               = RULES_DEDUP;
   user_options->self_test                 = SELF_TEST;
   user_options->separator                 = SEPARATOR;
   user_options->session                   = PROGNAME;
@@ -409,8 +433,10 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_BACKEND_DEVICES_KEEPFREE:
       case IDX_BENCHMARK_MAX:
       case IDX_BENCHMARK_MIN:
+      case IDX_BENCHMARK_HOST_SIZE:
       #ifdef WITH_BRAIN
       case IDX_BRAIN_PORT:
+      case IDX_BRAIN_SERVER_FILTER_BITS:
       #endif
 
       if (hc_string_is_digit (optarg) == false)
@@ -463,18 +489,25 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_OUTFILE_CHECK_DIR:         user_options->outfile_check_dir         = optarg;                          break;
       case IDX_HASH_INFO:                 user_options->hash_info++;                                                 break;
       case IDX_FORCE:                     user_options->force                     = true;                            break;
+      case IDX_RULE_STATS_FILE:           user_options->rule_stats_file           = optarg;                          break;
+      case IDX_RULES_DEDUP:               user_options->rules_dedup               = true;                            break;
       case IDX_SELF_TEST_DISABLE:         user_options->self_test                 = false;                           break;
       case IDX_SKIP:                      user_options->skip                      = hc_strtoull (optarg, NULL, 10);
                                           user_options->skip_chgd                 = true;                            break;
       case IDX_LIMIT:                     user_options->limit                     = hc_strtoull (optarg, NULL, 10);
                                           user_options->limit_chgd                = true;                            break;
       case IDX_KEEP_GUESSING:             user_options->keep_guessing             = true;                            break;
+      case IDX_KERNEL_CACHE_PACK:         user_options->kernel_cache_pack         = optarg;                          break;
+      case IDX_KERNEL_CACHE_PREWARM:      user_options->kernel_cache_prewarm      = true;                            break;
       case IDX_KEYSPACE:                  user_options->keyspace                  = true;                            break;
       case IDX_TOTAL_CANDIDATES:          user_options->total_candidates          = true;                            break;
       case IDX_BENCHMARK:                 user_options->benchmark                 = true;                            break;
       case IDX_BENCHMARK_ALL:             user_options->benchmark_all             = true;                            break;
       case IDX_BENCHMARK_MAX:             user_options->benchmark_max             = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_BENCHMARK_MIN:             user_options->benchmark_min             = hc_strtoul (optarg, NULL, 10);   break;
+      case IDX_BENCHMARK_HOST:            user_options->benchmark_host            = true;                            break;
+      case IDX_BENCHMARK_HOST_BASELINE:   user_options->benchmark_host_baseline   = optarg;                          break;
+      case IDX_BENCHMARK_HOST_SIZE:       user_options->benchmark_host_size       = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_STDOUT_FLAG:               user_options->stdout_flag               = true;                            break;
       case IDX_STDIN_TIMEOUT_ABORT:       user_options->stdin_timeout_abort       = hc_strtoul (optarg, NULL, 10);
                                           user_options->stdin_timeout_abort_chgd  = true;                            break;
@@ -488,6 +521,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_STATUS_TIMER:              user_options->status_timer              = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_MACHINE_READABLE:          user_options->machine_readable          = true;                            break;
       case IDX_LOOPBACK:                  user_options->loopback                  = true;                            break;
+      case IDX_LOOPBACK_LIVE:             user_options->loopback_live             = true;                            break;
       case IDX_SESSION:                   user_options->session                   = optarg;
                                           user_options->session_chgd              = true;                            break;
       case IDX_HASH_MODE:                 user_options->hash_mode                 = hc_strtoul (optarg, NULL, 10);
@@ -510,6 +544,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_RULE_BUF_R:                user_options->rule_buf_r                = optarg;
                                           user_options->rule_buf_r_chgd           = true;                            break;
       case IDX_MARKOV_DISABLE:            user_options->markov                    = false;                           break;
+      case IDX_MASK_BATCH:                user_options->mask_batch                = true;                            break;
       case IDX_MARKOV_CLASSIC:            user_options->markov_classic            = true;                            break;
       case IDX_MARKOV_INVERSE:            user_options->markov_inverse            = true;                            break;
       case IDX_MARKOV_THRESHOLD:          user_options->markov_threshold          = hc_strtoul (optarg, NULL, 10);   break;
@@ -604,6 +639,8 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_BRAIN_SERVER:              user_options->brain_server              = true;                            break;
       case IDX_BRAIN_SERVER_TIMER:        user_options->brain_server_timer        = hc_strtoul (optarg, NULL, 10);
                                           user_options->brain_server_timer_chgd   = true;                            break;
+      case IDX_BRAIN_SERVER_FILTER:       user_options->brain_server_filter       = optarg;                          break;
+      case IDX_BRAIN_SERVER_FILTER_BITS:  user_options->brain_server_filter_bits  = hc_strtoul (optarg, NULL, 10);   break;
       case IDX_BRAIN_PASSWORD:            user_options->brain_password            = optarg;
                                           user_options->brain_password_chgd       = true;                            break;
       case IDX_BRAIN_HOST:                user_options->brain_host                = optarg;
@@ -614,6 +651,7 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_BRAIN_SESSION_WHITELIST:   user_options->brain_session_whitelist   = optarg;                          break;
       #endif
       case IDX_COLOR_CRACKED:             user_options->color_cracked             = true;                            break;
+      case IDX_CRACK_SINK_ASYNC:          user_options->crack_sink_async          = true;                            break;
       case IDX_HASH_COPY:                 user_options->hash_copy                 = true;                            break;
     }
   }
@@ -659,7 +697,7 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
-  if ((user_options->brain_client_features < 1) || (user_options->brain_client_features > 3))
+  if ((user_options->brain_client_features < 1) || (user_options->brain_client_features > 7))
   {
     event_log_error (hashcat_ctx, "Invalid --brain-client-feature argument.");
 
@@ -699,6 +737,20 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       }
     }
   }
+
+  if ((user_options->brain_server_filter != NULL) && (user_options->brain_server == false))
+  {
+    event_log_error (hashcat_ctx, "The --brain-server-filter flag requires --brain-server.");
+
+    return -1;
+  }
+
+  if ((user_options->brain_server_filter_bits != 8) && (user_options->brain_server_filter_bits != 16) && (user_options->brain_server_filter_bits != 32))
+  {
+    event_log_error (hashcat_ctx, "Invalid --brain-server-filter-bits value specified - must be 8, 16 or 32.");
+
+    return -1;
+  }
   #endif
 
   if (user_options->separator_chgd == true)
@@ -830,6 +882,20 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
+  if (user_options->loopback_live == true)
+  {
+    // the plains which did not make it into the running attack are still replayed from the loopback file
+
+    user_options->loopback = true;
+
+    if (user_options->slow_candidates == true)
+    {
+      event_log_error (hashcat_ctx, "Use of --loopback-live is not allowed in combination with --slow-candidates.");
+
+      return -1;
+    }
+  }
+
   if (user_options->limit_chgd == true && user_options->loopback == true)
   {
     event_log_error (hashcat_ctx, "Combining --limit with --loopback is not allowed.");
@@ -1308,6 +1374,30 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->rule_stats_file != NULL)
+  {
+    if (strlen (user_options->rule_stats_file) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --rule-stats-file value - must not be empty.");
+
+      return -1;
+    }
+
+    if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_GENERIC))
+    {
+      event_log_error (hashcat_ctx, "Parameter --rule-stats-file is only allowed in attack mode 0 (straight) or 8 (generic).");
+
+      return -1;
+    }
+
+    if ((user_options->rp_files_cnt == 0) && (user_options->rp_gen == 0))
+    {
+      event_log_error (hashcat_ctx, "Use of --rule-stats-file requires -r/--rules-file or -g/--rules-generate.");
+
+      return -1;
+    }
+  }
+
   if (user_options->debug_mode > 5)
   {
     event_log_error (hashcat_ctx, "Invalid --debug-mode value specified.");
@@ -1349,11 +1439,59 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->kernel_cache_prewarm == true)
+  {
+    if (user_options->kernel_cache_pack == NULL)
+    {
+      event_log_error (hashcat_ctx, "Use of --kernel-cache-prewarm requires --kernel-cache-pack.");
+
+      return -1;
+    }
+
+    // the list of hash-modes to build kernels for is selected the same way as in benchmark mode
+
+    user_options->benchmark = true;
+  }
+
   if (user_options->benchmark_all == true)
   {
     user_options->benchmark = true;
   }
 
+  if (user_options->benchmark_host == true)
+  {
+    if (user_options->benchmark == true)
+    {
+      event_log_error (hashcat_ctx, "Use of --benchmark-host is not allowed in benchmark mode.");
+
+      return -1;
+    }
+
+    if (user_options->benchmark_host_size == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --benchmark-host-size value specified (must be greater than 0).");
+
+      return -1;
+    }
+  }
+
+  if (user_options->benchmark_host_baseline != NULL)
+  {
+    if (user_options->benchmark_host == false)
+    {
+      event_log_error (hashcat_ctx, "Use of --benchmark-host-baseline requires --benchmark-host.");
+
+      return -1;
+    }
+
+    if (strlen (user_options->benchmark_host_baseline) == 0)
+    {
+      event_log_error (hashcat_ctx, "Invalid --benchmark-host-baseline value - must not be empty.");
+
+      return -1;
+    }
+  }
+
   if (user_options->benchmark == true)
   {
     // sanity checks based on automatically overwritten configuration variables by
@@ -1817,6 +1955,13 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       show_error = false;
     }
   }
+  else if (user_options->benchmark_host == true)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
   else if (user_options->backend_info > 0)
   {
     if (user_options->hc_argc == 0)
@@ -2034,6 +2179,11 @@ void user_options_session_auto (hashcat_ctx_t *hashcat_ctx)
       user_options->session = "hash_info";
     }
 
+    if (user_options->benchmark_host == true)
+    {
+      user_options->session = "benchmark_host";
+    }
+
     if (user_options->usage > 0)
     {
       user_options->session = "usage";
@@ -2132,6 +2282,7 @@ void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
    || user_options->progress_only    == true
    || user_options->identify         == true
    || user_options->usage             > 0
+   || user_options->benchmark_host    == true
    || user_options->hash_info         > 0
    || user_options->backend_info      > 0)
   {
@@ -2194,6 +2345,11 @@ void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
     user_options->quiet = true;
   }
 
+  if (user_options->benchmark_host == true)
+  {
+    user_options->quiet = true;
+  }
+
   if (user_options->progress_only == true)
   {
     user_options->speed_only = true;
@@ -2605,6 +2761,10 @@ void user_options_extra_init (hashcat_ctx_t *hashcat_ctx)
   else if (user_options->hash_info > 0)
   {
 
+  }
+  else if (user_options->benchmark_host == true)
+  {
+
   }
   else if (user_options->backend_info > 0)
   {
@@ -3642,11 +3802,13 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
 
   #ifdef WITH_BRAIN
   logfile_top_string (user_options->brain_session_whitelist);
+  logfile_top_string (user_options->brain_server_filter);
   #endif
   logfile_top_string (user_options->bridge_parameter1);
   logfile_top_string (user_options->bridge_parameter2);
   logfile_top_string (user_options->bridge_parameter3);
   logfile_top_string (user_options->bridge_parameter4);
+  logfile_top_string (user_options->benchmark_host_baseline);
   logfile_top_string (user_options->cpu_affinity);
   logfile_top_string (user_options->custom_charset_1);
   logfile_top_string (user_options->custom_charset_2);
@@ -3660,6 +3822,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_string (user_options->encoding_from);
   logfile_top_string (user_options->encoding_to);
   logfile_top_string (user_options->induction_dir);
+  logfile_top_string (user_options->kernel_cache_pack);
   logfile_top_string (user_options->keyboard_layout_mapping);
   logfile_top_string (user_options->markov_hcstat2);
   logfile_top_string (user_options->backend_devices);
@@ -3670,6 +3833,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_string (user_options->restore_file_path);
   logfile_top_string (user_options->rp_files[0]);
   logfile_top_string (user_options->rp_gen_func_sel);
+  logfile_top_string (user_options->rule_stats_file);
   logfile_top_string (user_options->rule_buf_l);
   logfile_top_string (user_options->rule_buf_r);
   logfile_top_string (user_options->session);
@@ -3689,6 +3853,8 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->benchmark_all);
   logfile_top_uint   (user_options->benchmark_max);
   logfile_top_uint   (user_options->benchmark_min);
+  logfile_top_uint   (user_options->benchmark_host);
+  logfile_top_uint   (user_options->benchmark_host_size);
   logfile_top_uint   (user_options->bitmap_max);
   logfile_top_uint   (user_options->bitmap_min);
   logfile_top_uint   (user_options->debug_mode);
@@ -3708,6 +3874,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->increment_min);
   logfile_top_uint   (user_options->keep_guessing);
   logfile_top_uint   (user_options->kernel_accel);
+  logfile_top_uint   (user_options->kernel_cache_prewarm);
   logfile_top_uint   (user_options->kernel_loops);
   logfile_top_uint   (user_options->kernel_threads);
   logfile_top_uint   (user_options->keyspace);
@@ -3715,7 +3882,10 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->left);
   logfile_top_uint   (user_options->logfile);
   logfile_top_uint   (user_options->loopback);
+  logfile_top_uint   (user_options->loopback_live);
+  logfile_top_uint   (user_options->crack_sink_async);
   logfile_top_uint   (user_options->machine_readable);
+  logfile_top_uint   (user_options->mask_batch);
   logfile_top_uint   (user_options->markov_classic);
   logfile_top_uint   (user_options->markov);
   logfile_top_uint   (user_options->markov_inverse);
@@ -3746,6 +3916,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->runtime);
   logfile_top_uint   (user_options->scrypt_tmto);
   logfile_top_uint   (user_options->segment_size);
+  logfile_top_uint   (user_options->rules_dedup);
   logfile_top_uint   (user_options->self_test);
   logfile_top_uint   (user_options->slow_candidates);
   logfile_top_uint   (user_options->show);
@@ -3766,6 +3937,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->brain_client_features);
   logfile_top_uint   (user_options->brain_server);
   logfile_top_uint   (user_options->brain_server_timer);
+  logfile_top_uint   (user_options->brain_server_filter_bits);
   logfile_top_uint   (user_options->brain_port);
   logfile_top_uint   (user_options->brain_session);
   #endif
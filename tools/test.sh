@@ -3839,6 +3839,9 @@ OPTIONS:
 
   -s    Use this session name instead of the default one (default : "hashcat")
 
+  -u    Use this kernel-loops value, e.g. below the iteration count of the test hashes
+        to run bridged loops in several chunks (default : autotuned)
+
   -c    Disables markov-chains
 
   -f    Use --force to ignore hashcat warnings (default : disabled)
@@ -3874,7 +3877,7 @@ PACKAGE=0
 OPTIMIZED=1
 GENERATE_CONTAINERS=0
 
-while getopts "V:t:m:a:b:hcpd:x:o:d:D:F:POI:s:fr:g" opt; do
+while getopts "V:t:m:a:b:hcpd:x:o:d:D:F:POI:s:fr:gu:" opt; do
 
   case ${opt} in
     "V")
@@ -3980,6 +3983,10 @@ while getopts "V:t:m:a:b:hcpd:x:o:d:D:F:POI:s:fr:g" opt; do
       OPTS="${OPTS} -d ${OPTARG}"
       ;;
 
+    "u")
+      OPTS="${OPTS} -u ${OPTARG}"
+      ;;
+
     "D")
       if [ "${OPTARG}" = "1" ]; then
         OPTS="${OPTS} -D 1"